@@ -0,0 +1,43 @@
+#ifndef ALTERNATIVES_H
+#define ALTERNATIVES_H
+
+#include "osm_reader.h"
+#include "dijkstra.h"
+#include "graph.h"
+#include <stddef.h>
+
+// Uma rota do conjunto de alternativas
+typedef struct {
+    ResultadoDijkstra *caminho;  // Custo na métrica em distancia_total; nos_visitados
+                                 // soma os pontos estabelecidos desde a rota
+                                 // encontrada antes desta
+    double sobreposicao;         // Fração do custo em arcos da melhor rota (0 na melhor)
+    double tempo_ms;             // Tempo gasto desde a rota encontrada antes desta
+                                 // (na primeira, inclui a busca reversa)
+} RotaAlternativa;
+
+typedef struct {
+    size_t num_rotas;
+    RotaAlternativa *rotas;      // Da mais barata para a mais cara
+    size_t caminhos_examinados;  // Caminhos gerados por Yen, aceitos ou não
+    size_t buscas_desvio;        // Buscas A* a partir dos pontos de desvio
+    size_t buscas_penalidade;    // Buscas A* com pesos penalizados
+    size_t pontos_estabelecidos; // Em todas as buscas, inclusive a reversa
+} Alternativas;
+
+// Até k rotas sem ciclos da origem ao destino, em ordem de custo na métrica
+// (Yen). Uma única busca reversa a partir do destino dá a distância exata de
+// cada ponto até ele; como remover arcos e pontos só aumenta distâncias, ela
+// serve de heurística admissível para o A* de cada desvio, que assim explora
+// pouco além do próprio caminho em vez de refazer uma busca completa.
+// Caminhos que compartilham mais que max_sobreposicao do custo com alguma
+// rota já aceita são descartados (>= 1: os k caminhos mais curtos). Se Yen
+// não achar rotas diferentes o bastante em 10 caminhos por rota pedida, as
+// restantes vêm de buscas com os arcos já usados penalizados. Retorna NULL
+// com id desconhecido ou erro; sem caminho, num_rotas = 0.
+Alternativas* rotas_alternativas(Grafo *grafo, long origem_id, long destino_id, size_t k,
+                                 Metrica metrica, double max_sobreposicao);
+
+void liberar_alternativas(Alternativas *alternativas);
+
+#endif // ALTERNATIVES_H
@@ -4,6 +4,13 @@
 #include <gtk/gtk.h>
 #include "graph.h"
 #include "edit.h"
+#include "tree_pruning.h"
+#include "components.h"
+#include "isochrone.h"
+#include "voronoi.h"
+#include "alternatives.h"
+#include "snapping.h"
+#include "spatial_index.h"
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -16,6 +23,8 @@ typedef struct {
     GtkWidget *stats_label;
     GtkWidget *start_entry;
     GtkWidget *end_entry;
+    GtkWidget *metric_combo;
+    GtkWidget *isochrone_spin;
     GtkWidget *results_text;
     GtkWidget *graph_area;
     GtkWidget *statusbar;
@@ -24,6 +33,18 @@ typedef struct {
     Grafo *grafo;
     char *current_file;
     
+    // Núcleo de roteamento (só a poda de becos sem saída, sem compressão de
+    // cadeias), usado nas buscas (NULL se desatualizado)
+    NucleoRoteamento *nucleo_roteamento;
+    
+    // Busca no núcleo mantida entre consultas com a mesma origem, para que
+    // trocar só o destino não recomece do zero (NULL se não houver)
+    BuscaIncremental *busca_incremental;
+    
+    // Renumerar os pontos pela curva de Hilbert ao carregar um mapa (passo
+    // opcional, em File → Reorder Nodes on Load)
+    gboolean reorder_on_load;
+    
     // Variáveis para zoom e pan
     double zoom_factor;
     double pan_x, pan_y;
@@ -36,6 +57,10 @@ typedef struct {
     gboolean has_start_point;
     gboolean has_end_point;
     
+    // Paradas intermediárias, na ordem, entre o início e o fim da rota
+    long *waypoint_ids;
+    size_t num_waypoints;
+    
     // Variáveis para exibição do caminho mais curto
     long *shortest_path;
     int shortest_path_length;
@@ -43,6 +68,41 @@ typedef struct {
     
     // Estado de edição
     EditState edit_state;
+    
+    // Colorir pontos pela componente fortemente conexa
+    gboolean color_by_component;
+    
+    // Isócrona a partir do ponto inicial: arestas coloridas por faixa de custo.
+    // O espaço de busca é mantido para que mover a origem não realoque nada.
+    gboolean show_isochrone;
+    gboolean isochrone_valid;
+    EspacoBusca *isochrone_space;
+    RegiaoAlcancavel *isochrone_region;
+    
+    // Partição de Voronoi pela rede: pontos coloridos pela instalação mais
+    // próxima (instalações marcadas com Shift+clique, partição NULL se desatualizada)
+    gboolean show_voronoi;
+    long *facility_ids;
+    size_t num_facilities;
+    ParticaoVoronoi *voronoi;
+    
+    // Rotas alternativas ao caminho mais curto, calculadas em Find Path quando
+    // ativadas e sem paradas intermediárias (NULL se não houver)
+    gboolean show_alternatives;
+    Alternativas *alternatives;
+    
+    // Início e fim clicados no meio de uma via (projetados pelo índice
+    // espacial) guardam a projeção; selected_*_id fica com o ponto mais
+    // próximo dela.
+    gboolean start_snapped;
+    gboolean end_snapped;
+    ProjecaoAresta start_snap;
+    ProjecaoAresta end_snap;
+    gboolean snapped_route;  // shortest_path vai das projeções, com pedaços de aresta nas pontas
+    
+    // Itens visíveis do quadro sendo desenhado, pelo índice espacial
+    // (edit_state.indice_espacial); o vetor é reaproveitado entre quadros
+    ListaIndices *visible_items;
 } AppData;
 
 #endif // APP_DATA_H
@@ -0,0 +1,29 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+// Alocador por blocos (arena): as alocações avançam um ponteiro dentro do
+// bloco atual e novos blocos são encadeados quando ele se esgota. Não há
+// liberação individual; tudo é devolvido de uma vez em arena_liberar().
+typedef struct BlocoArena BlocoArena;
+
+typedef struct {
+    BlocoArena *blocos;      // Bloco atual (início da lista encadeada)
+    size_t tamanho_bloco;    // Tamanho mínimo de cada novo bloco
+    size_t total_alocado;    // Bytes entregues (para estatísticas)
+} Arena;
+
+// Cria uma arena; tamanho_bloco funciona como dica de reserva (0 = padrão)
+Arena* arena_criar(size_t tamanho_bloco);
+
+// Aloca memória alinhada para qualquer tipo (NULL em caso de erro)
+void* arena_alocar(Arena *arena, size_t bytes);
+
+// Como arena_alocar, mas com a memória zerada
+void* arena_alocar_zerado(Arena *arena, size_t bytes);
+
+// Devolve todos os blocos e a própria arena
+void arena_liberar(Arena *arena);
+
+#endif // ARENA_H
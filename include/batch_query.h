@@ -0,0 +1,41 @@
+#ifndef BATCH_QUERY_H
+#define BATCH_QUERY_H
+
+#include "osm_reader.h"
+#include "dijkstra.h"
+#include "graph.h"
+#include <stddef.h>
+
+typedef struct {
+    long origem;
+    long destino;
+} ParConsulta;
+
+typedef struct {
+    ResultadoDijkstra *resultado;  // Como em dijkstra(): NULL se algum id não existe
+    double tempo_ms;               // Tempo gasto só nesta consulta
+    int trabalhador;               // Thread que a executou
+} ResultadoConsulta;
+
+typedef struct {
+    size_t num_consultas;
+    ResultadoConsulta *consultas;  // Na mesma ordem dos pares de entrada
+    int num_threads;
+    size_t roubos;                 // Quantas vezes um trabalhador tomou consultas de outro
+    double tempo_total_ms;
+} ResultadoLote;
+
+// Executa os pares em paralelo. Cada trabalhador começa com uma fatia
+// contígua dos pares e tem o próprio espaço de busca; quem termina a sua
+// rouba metade do que resta na fatia de outro. O grafo é apenas lido e não
+// pode ser alterado durante o lote. num_threads <= 0 usa o número de
+// processadores. Até 2^32 - 1 pares por lote. Retorna NULL em caso de erro.
+ResultadoLote* executar_lote(Grafo *grafo, const ParConsulta *pares, size_t num_pares, int num_threads);
+
+// Mesmo que executar_lote(), minimizando a métrica dada em vez da distância
+ResultadoLote* executar_lote_metrica(Grafo *grafo, const ParConsulta *pares, size_t num_pares,
+                                     Metrica metrica, int num_threads);
+
+void liberar_resultado_lote(ResultadoLote *lote);
+
+#endif // BATCH_QUERY_H
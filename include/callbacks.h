@@ -9,9 +9,15 @@ void on_open_osm_clicked(GtkMenuItem *menuitem, gpointer user_data);
 // Callback para load OSM via toolbar
 void on_load_osm_clicked(GtkToolButton *toolbutton, gpointer user_data);
 
+// Callback para casar trajetos GPS (arquivo GPX) com as vias do mapa
+void on_match_traces_clicked(GtkMenuItem *menuitem, gpointer user_data);
+
 // Callback para encontrar caminho mais curto
 void on_find_path_clicked(GtkButton *button, gpointer user_data);
 
+// Callback para otimizar a ordem de visita das paradas
+void on_optimize_tour_clicked(GtkButton *button, gpointer user_data);
+
 // Callback para limpar
 void on_clear_clicked(GtkToolButton *toolbutton, gpointer user_data);
 
@@ -27,6 +33,22 @@ void on_edit_delete_clicked(GtkToolButton *toolbutton, gpointer user_data);
 void on_edit_connect_clicked(GtkToolButton *toolbutton, gpointer user_data);
 void on_edit_normal_clicked(GtkToolButton *toolbutton, gpointer user_data);
 
+// Callback para ligar ou desligar a reordenação de Hilbert no carregamento
+void on_reorder_on_load_toggled(GtkCheckMenuItem *menu_item, gpointer user_data);
+
+// Callback para colorir pontos por componente
+void on_components_toggled(GtkToggleToolButton *toggle_button, gpointer user_data);
+
+// Callbacks da isócrona (ativar e mudar alcance ou métrica)
+void on_isochrone_toggled(GtkToggleToolButton *toggle_button, gpointer user_data);
+void on_isochrone_settings_changed(GtkWidget *widget, gpointer user_data);
+
+// Callback para colorir pontos pela instalação mais próxima (Voronoi)
+void on_voronoi_toggled(GtkToggleToolButton *toggle_button, gpointer user_data);
+
+// Callback para mostrar rotas alternativas no cálculo do caminho
+void on_alternatives_toggled(GtkToggleToolButton *toggle_button, gpointer user_data);
+
 // Callback para exportar PNG
 void on_export_png_clicked(GtkToolButton *toolbutton, gpointer user_data);
 
@@ -0,0 +1,102 @@
+#ifndef COMPACT_GRAPH_H
+#define COMPACT_GRAPH_H
+
+#include "osm_reader.h"
+#include "dijkstra.h"
+#include <stddef.h>
+#include <stdint.h>
+
+// Sentidos de uma entrada da adjacência compacta (2 bits)
+#define SENTIDO_SAIDA   1u  // Pode-se ir do ponto ao vizinho
+#define SENTIDO_ENTRADA 2u  // Pode-se ir do vizinho ao ponto
+
+// Pontos por bloco de deslocamentos (potência de 2)
+#define BITS_BLOCO_COMPACTO 6
+
+// Adjacência compacta: para cada ponto, a lista de vizinhos incidentes
+// ordenada por índice, com cada entrada codificada em varint como
+// ((delta do índice) << 2 | sentidos) seguido do peso em decímetros.
+// O primeiro delta de cada lista é relativo ao próprio ponto (zigzag);
+// os demais são relativos ao vizinho anterior. Cada via aparece na lista
+// das duas extremidades, com os bits de sentido espelhados, de modo que a
+// mesma estrutura atende buscas para frente e para trás.
+typedef struct {
+    size_t num_pontos;
+    size_t num_entradas;        // Entradas codificadas (duas por via)
+    uint8_t *dados;             // Listas codificadas, na ordem dos pontos
+    size_t tamanho_dados;
+    // Início da lista do ponto v: inicio_bloco[v >> BITS_BLOCO_COMPACTO] + deslocamento[v]
+    uint64_t *inicio_bloco;
+    uint32_t *deslocamento;     // num_pontos + 1 posições
+} AdjacenciaCompacta;
+
+// Vizinho decodificado
+typedef struct {
+    size_t destino;             // Índice do vizinho em grafo->pontos
+    uint32_t peso_dm;           // Peso em decímetros
+    unsigned sentidos;          // Combinação de SENTIDO_SAIDA / SENTIDO_ENTRADA
+} VizinhoCompacto;
+
+// Cursor sobre a lista de um ponto, decodificada sob demanda
+typedef struct {
+    const uint8_t *atual;
+    const uint8_t *fim;
+    size_t ponto;
+    size_t anterior;
+    int primeiro;
+} IteradorCompacto;
+
+// Constrói a adjacência compacta a partir das arestas do grafo. Não usa os
+// índices CSR do grafo, para que eles não precisem existir ao mesmo tempo.
+AdjacenciaCompacta* compactar_adjacencia(const Grafo *grafo);
+
+// Libera a adjacência compacta
+void liberar_adjacencia_compacta(AdjacenciaCompacta *adjacencia);
+
+// Bytes ocupados pela estrutura (dados codificados e deslocamentos)
+size_t bytes_adjacencia_compacta(const AdjacenciaCompacta *adjacencia);
+
+// Posiciona o iterador no início da lista do ponto
+void iniciar_iterador_compacto(const AdjacenciaCompacta *adjacencia, size_t ponto, IteradorCompacto *it);
+
+// Decodifica o próximo vizinho; retorna 0 ao fim da lista
+static inline int proximo_vizinho_compacto(IteradorCompacto *it, VizinhoCompacto *vizinho) {
+    if (it->atual >= it->fim) return 0;
+
+    uint64_t chave = 0, peso = 0;
+    unsigned deslocamento = 0;
+    uint8_t byte;
+    do {
+        byte = *it->atual++;
+        chave |= (uint64_t)(byte & 0x7f) << deslocamento;
+        deslocamento += 7;
+    } while (byte & 0x80);
+    deslocamento = 0;
+    do {
+        byte = *it->atual++;
+        peso |= (uint64_t)(byte & 0x7f) << deslocamento;
+        deslocamento += 7;
+    } while (byte & 0x80);
+
+    uint64_t delta = chave >> 2;
+    if (it->primeiro) {
+        // Zigzag: bit menos significativo guarda o sinal
+        int64_t relativo = (int64_t)(delta >> 1) ^ -(int64_t)(delta & 1);
+        it->anterior = (size_t)((int64_t)it->ponto + relativo);
+        it->primeiro = 0;
+    } else {
+        it->anterior += (size_t)delta;
+    }
+    vizinho->destino = it->anterior;
+    vizinho->peso_dm = (uint32_t)peso;
+    vizinho->sentidos = (unsigned)(chave & 3u);
+    return 1;
+}
+
+// Dijkstra sobre a adjacência compacta, entre índices de pontos. O grafo só é
+// usado para converter o caminho em IDs; a distância é somada em decímetros
+// e devolvida em km, como em dijkstra().
+ResultadoDijkstra* dijkstra_compacto(const AdjacenciaCompacta *adjacencia, const Grafo *grafo,
+                                     size_t origem, size_t destino);
+
+#endif // COMPACT_GRAPH_H
@@ -0,0 +1,17 @@
+#ifndef COMPONENTS_H
+#define COMPONENTS_H
+
+#include "graph.h"
+#include <stddef.h>
+
+// Calcula (uma vez por versão dos índices) as componentes fortemente conexas
+// e as fracamente conexas de cada ponto. Retorna os índices com os campos de
+// componentes preenchidos, ou NULL em caso de erro.
+const IndicesGrafo* obter_componentes(Grafo* grafo);
+
+// Indica se existe a possibilidade de um caminho entre dois pontos (índices em
+// grafo->pontos). Retorna 0 apenas quando o destino é comprovadamente
+// inalcançável; em caso de dúvida (por exemplo, falta de memória) retorna 1.
+int alcance_possivel(Grafo* grafo, size_t origem, size_t destino);
+
+#endif // COMPONENTS_H
@@ -0,0 +1,39 @@
+#ifndef COMPRESSION_H
+#define COMPRESSION_H
+
+#include "osm_reader.h"
+#include "dijkstra.h"
+#include <stddef.h>
+#include <sys/types.h>
+
+// Grafo com as cadeias de nós de grau 2 (pontos de forma no meio das ruas)
+// colapsadas em arestas únicas. A geometria intermediária é mantida à parte
+// para que o caminho devolvido contenha todos os pontos originais.
+typedef struct {
+    Grafo *original;            // Grafo de origem (não pertence a esta estrutura)
+    Grafo *nucleo;              // Apenas nós de junção; cada aresta é uma cadeia
+
+    // Geometria das cadeias: pontos intermediários (índices em original->pontos)
+    // da aresta e do núcleo ficam em geometria[inicio_geometria[e] .. inicio_geometria[e+1]),
+    // na orientação origem -> destino da aresta
+    size_t *inicio_geometria;
+    size_t *geometria;
+
+    // Para cada ponto original: cadeia que o contém (-1 se for junção),
+    // posição na geometria e distância a partir da origem da cadeia
+    ssize_t *cadeia_do_ponto;
+    size_t *posicao_na_cadeia;
+    double *deslocamento;
+} GrafoComprimido;
+
+// Colapsa as cadeias de grau 2 do grafo (NULL em caso de erro)
+GrafoComprimido* comprimir_grafo(Grafo *grafo);
+
+// Libera o grafo comprimido (o grafo original não é liberado)
+void liberar_grafo_comprimido(GrafoComprimido *comprimido);
+
+// Dijkstra sobre o núcleo comprimido. Origem e destino podem ser quaisquer
+// pontos do grafo original; o caminho é desempacotado com todos os pontos.
+ResultadoDijkstra* dijkstra_comprimido(GrafoComprimido *comprimido, long origem_id, long destino_id);
+
+#endif // COMPRESSION_H
@@ -0,0 +1,45 @@
+#ifndef CONTRACTION_H
+#define CONTRACTION_H
+
+#include "osm_reader.h"
+#include "arena.h"
+#include "distance_matrix.h"
+#include <stddef.h>
+
+// Arco da hierarquia: original ou atalho que substitui um ponto contraído
+typedef struct {
+    size_t destino;   // Índice do ponto vizinho em grafo->pontos
+    double peso;
+    size_t anterior;  // Último ponto antes da ponta do arco, com o atalho desempacotado
+} ArcoHierarquia;
+
+// Hierarquia de contração: os pontos são contraídos um a um em ordem de
+// importância, e atalhos preservam as distâncias entre os que restam. Uma
+// busca só precisa subir na hierarquia, tanto a partir da origem quanto
+// (no grafo reverso) a partir do destino. Tudo mora em uma arena.
+typedef struct {
+    Arena *arena;
+    size_t num_pontos;
+    size_t *nivel;               // Ordem de contração de cada ponto
+    size_t *inicio_subida;       // num_pontos + 1 posições (CSR)
+    ArcoHierarquia *subida;      // Arcos u -> destino com nível maior que o de u
+    size_t *inicio_descida;      // num_pontos + 1 posições (CSR)
+    ArcoHierarquia *descida;     // Arcos destino -> u com nível maior que o de u
+    size_t num_atalhos;
+} HierarquiaContracao;
+
+// Pré-processa o grafo (usa a adjacência de obter_indices). A hierarquia vale
+// até o grafo ser alterado. Retorna NULL em caso de erro.
+HierarquiaContracao* construir_hierarquia(Grafo *grafo);
+void liberar_hierarquia(HierarquiaContracao *hierarquia);
+
+// Mesma interface de matriz_distancias(), pelo algoritmo de baldes: buscas
+// reversas para cima a partir de cada destino deixam (destino, distância)
+// nos pontos alcançados, e buscas para cima a partir de cada origem combinam
+// as próprias distâncias com esses baldes.
+MatrizDistancias* matriz_distancias_hierarquia(const HierarquiaContracao *hierarquia, Grafo *grafo,
+                                               const long *origens, size_t num_origens,
+                                               const long *destinos, size_t num_destinos,
+                                               int com_predecessores, int num_threads);
+
+#endif // CONTRACTION_H
@@ -0,0 +1,15 @@
+#ifndef DELTA_STEPPING_H
+#define DELTA_STEPPING_H
+
+#include "osm_reader.h"
+
+// Caminhos mínimos de uma origem para todos os pontos pelo delta-stepping
+// paralelo: os pontos são agrupados em baldes de largura delta (km), e cada
+// balde é esvaziado relaxando em paralelo primeiro os arcos leves (<= delta)
+// e depois os pesados. Resultado igual ao de dijkstra_distancias(): vetor
+// por índice de grafo->pontos, DBL_MAX para inalcançáveis, liberado com free().
+// delta <= 0 escolhe um valor a partir do peso médio dos arcos;
+// num_threads <= 0 usa o número de processadores disponíveis.
+double* delta_stepping(Grafo *grafo, long origem_id, double delta, int num_threads);
+
+#endif // DELTA_STEPPING_H
@@ -2,6 +2,7 @@
 #define DIJKSTRA_H
 
 #include "osm_reader.h"
+#include "graph.h"
 
 // Estrutura para armazenar resultado do algoritmo de Dijkstra
 typedef struct {
@@ -9,6 +10,7 @@ typedef struct {
     int tamanho_caminho;    // Número de pontos no caminho
     double distancia_total; // Distância total do caminho
     int sucesso;           // 1 se caminho foi encontrado, 0 caso contrário
+    int nos_visitados;     // Pontos estabelecidos (retirados da fila) durante a busca
 } ResultadoDijkstra;
 
 // Estrutura para nó na fila de prioridade
@@ -35,6 +37,14 @@ void diminuir_chave(FilaPrioridade *fila, long ponto_id, double nova_distancia);
 // Função principal do algoritmo de Dijkstra
 ResultadoDijkstra* dijkstra(Grafo *grafo, long origem_id, long destino_id);
 
+// Dijkstra com a função de custo escolhida (a topologia é a mesma; só muda o
+// vetor de pesos lido). distancia_total fica na unidade da métrica.
+ResultadoDijkstra* dijkstra_metrica(Grafo *grafo, long origem_id, long destino_id, Metrica metrica);
+
+// Distâncias da origem até todos os pontos (índices de grafo->pontos; DBL_MAX
+// se inalcançável). O vetor deve ser liberado com free().
+double* dijkstra_distancias(Grafo *grafo, long origem_id);
+
 // Função para liberar resultado
 void liberar_resultado_dijkstra(ResultadoDijkstra *resultado);
 
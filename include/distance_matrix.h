@@ -0,0 +1,72 @@
+#ifndef DISTANCE_MATRIX_H
+#define DISTANCE_MATRIX_H
+
+#include "osm_reader.h"
+#include "dijkstra.h"
+#include "graph.h"
+#include <stddef.h>
+#include <stdint.h>
+
+// Área de trabalho de uma busca, reaproveitada entre consultas: os vetores
+// por ponto são alocados uma vez e "limpos" apenas trocando a época, sem
+// percorrer o grafo inteiro a cada origem. Não é compartilhável entre threads.
+typedef struct {
+    size_t num_pontos;
+    double *distancias;
+    size_t *predecessores;
+    uint32_t *marca;         // marca[v] == epoca: distancias/predecessores de v valem
+    uint32_t *estabelecido;  // estabelecido[v] == epoca: v já saiu da fila
+    uint32_t *alvo;          // alvo[v] == epoca: v é destino ainda pendente
+    uint32_t epoca;
+    FilaPrioridade *fila;
+    Metrica metrica;         // Custo usado nas buscas (METRICA_DISTANCIA ao criar);
+                             // com várias threads, chame obter_pesos_metrica antes
+} EspacoBusca;
+
+// Tabela densa de distâncias, uma linha por origem
+typedef struct {
+    size_t num_origens;
+    size_t num_destinos;
+    double *distancias;   // [i * num_destinos + j] em km; -1 se inalcançável
+    long *predecessores;  // Ponto anterior ao destino j no caminho vindo da
+                          // origem i (-1 se não há); NULL se não foi pedido
+} MatrizDistancias;
+
+EspacoBusca* criar_espaco_busca(size_t num_pontos);
+void liberar_espaco_busca(EspacoBusca *espaco);
+
+// Começa uma nova busca: invalida a anterior em O(1) trocando a época (as
+// marcas só são zeradas quando a época dá a volta, a cada 2^32 buscas)
+void reiniciar_espaco_busca(EspacoBusca *espaco);
+
+// Uma busca a partir da origem que termina assim que todos os destinos são
+// estabelecidos. Preenche distancias[j] (-1 se inalcançável ou id desconhecido)
+// e, se não for NULL, predecessores[j]. Retorna 0 ou -1 em caso de erro.
+int distancias_um_para_muitos(Grafo *grafo, EspacoBusca *espaco, long origem_id,
+                              const long *destinos, size_t num_destinos,
+                              double *distancias, long *predecessores);
+
+// Mesmo contrato de dijkstra_metrica() na métrica do espaço, mas usando (e
+// reaproveitando) o espaço de busca em vez de alocar vetores do tamanho do
+// grafo a cada consulta
+ResultadoDijkstra* dijkstra_com_espaco(Grafo *grafo, EspacoBusca *espaco, long origem_id, long destino_id);
+
+// Matriz origens x destinos, com as origens distribuídas entre num_threads
+// threads (<= 0 usa o número de processadores). Retorna NULL em caso de erro.
+MatrizDistancias* matriz_distancias(Grafo *grafo, const long *origens, size_t num_origens,
+                                    const long *destinos, size_t num_destinos,
+                                    int com_predecessores, int num_threads);
+
+// Mesmo que matriz_distancias(), com os custos na métrica dada (distancias
+// passa a guardar esse custo, por exemplo minutos em METRICA_TEMPO)
+MatrizDistancias* matriz_distancias_metrica(Grafo *grafo, const long *origens, size_t num_origens,
+                                            const long *destinos, size_t num_destinos, Metrica metrica,
+                                            int com_predecessores, int num_threads);
+
+void liberar_matriz_distancias(MatrizDistancias *matriz);
+
+static inline double distancia_na_matriz(const MatrizDistancias *matriz, size_t origem, size_t destino) {
+    return matriz->distancias[origem * matriz->num_destinos + destino];
+}
+
+#endif // DISTANCE_MATRIX_H
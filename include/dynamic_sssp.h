@@ -0,0 +1,49 @@
+#ifndef DYNAMIC_SSSP_H
+#define DYNAMIC_SSSP_H
+
+#include "osm_reader.h"
+#include "graph.h"
+#include "dijkstra.h"
+#include <stddef.h>
+
+// Árvore de caminhos mínimos de uma origem mantida sob mudanças de peso
+// (reparo no estilo Ramalingam–Reps): depois de atualizar_pesos(), só os
+// pontos cujo caminho passava por um arco alterado, ou que ganham um atalho
+// por um arco que ficou mais leve, são reavaliados. O resto da árvore fica
+// intacto.
+typedef struct {
+    Grafo *grafo;
+    const IndicesGrafo *indices;  // Índices sobre os quais a árvore foi montada
+    unsigned long versao_indices; // grafo->versao_indices na montagem
+    size_t num_arcos;
+    long origem_id;
+    size_t origem;
+    size_t num_pontos;
+    double *distancias;       // DBL_MAX se inalcançável
+    size_t *arco_pai;         // Arco da árvore que chega ao ponto (índice em indices->arcos)
+    size_t *inicio_entrada;   // num_pontos + 1 posições (CSR reverso)
+    size_t *entrada;          // Arcos que chegam a cada ponto
+    size_t *origem_arco;      // Ponto de partida de cada arco
+    unsigned char *afetado;   // Área de trabalho do reparo
+    size_t *afetados;
+    FilaPrioridade *fila;
+} ArvoreDinamica;
+
+// Monta a árvore a partir da origem (NULL se o id não existir ou faltar memória)
+ArvoreDinamica* criar_arvore_dinamica(Grafo *grafo, long origem_id);
+
+// Repara a árvore depois de atualizar_pesos() com o mesmo lote. Se os índices
+// tiverem sido reconstruídos (grafo editado), a árvore é montada de novo.
+// Retorna quantos pontos foram reestabelecidos, ou -1 em caso de erro.
+int reparar_arvore_dinamica(ArvoreDinamica *arvore, const AtualizacaoPeso *atualizacoes, size_t quantidade);
+
+// Recalcula a árvore inteira do zero; mesmo retorno de reparar_arvore_dinamica
+int recalcular_arvore_dinamica(ArvoreDinamica *arvore);
+
+// Caminho da origem até o destino pela árvore atual, no contrato de
+// dijkstra() (nos_visitados é sempre 0: nenhuma busca é feita)
+ResultadoDijkstra* caminho_arvore_dinamica(const ArvoreDinamica *arvore, long destino_id);
+
+void liberar_arvore_dinamica(ArvoreDinamica *arvore);
+
+#endif // DYNAMIC_SSSP_H
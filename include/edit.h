@@ -2,6 +2,7 @@
 #define EDIT_H
 
 #include "osm_reader.h"
+#include "spatial_index.h"
 #include <gtk/gtk.h>
 
 // Enumeração para modos de edição
@@ -23,6 +24,12 @@ typedef struct {
     // Contador para IDs de novos nós
     long long next_node_id;
     long long next_way_id;
+    
+    // Índice espacial do grafo, mantido em dia por create_node_at_position,
+    // delete_node, connect_nodes, disconnect_nodes e set_connection_direction
+    // (NULL se não houver). Pertence ao estado; se uma atualização falhar, é
+    // descartado e volta a NULL.
+    IndiceEspacial *indice_espacial;
 } EditState;
 
 // Funções para gerenciamento do modo de edição
@@ -34,7 +41,7 @@ EditMode get_edit_mode(EditState *state);
 gboolean create_node_at_position(Grafo *grafo, EditState *state, double lat, double lon);
 gboolean delete_node(Grafo *grafo, EditState *state, long long node_id);
 gboolean connect_nodes(Grafo *grafo, EditState *state, long long from_id, long long to_id);
-gboolean disconnect_nodes(Grafo *grafo, long long from_id, long long to_id);
+gboolean disconnect_nodes(Grafo *grafo, EditState *state, long long from_id, long long to_id);
 
 // Funções auxiliares
 long long find_highest_node_id(Grafo *grafo);
@@ -60,6 +67,7 @@ int count_oneway_edges(Grafo *grafo);
 int count_bidirectional_edges(Grafo *grafo);
 
 // Função para controlar direção de conexão entre dois nós
-gboolean set_connection_direction(Grafo *grafo, long long node1, long long node2, int direction_type);
+gboolean set_connection_direction(Grafo *grafo, EditState *state, long long node1, long long node2,
+                                  int direction_type);
 
 #endif // EDIT_H
\ No newline at end of file
@@ -2,21 +2,153 @@
 #define GRAPH_H
 
 #include "osm_reader.h"
+#include "arena.h"
 #include <stddef.h>
+#include <stdint.h>
 #include <sys/types.h> // Para ssize_t
 
+// Arco da lista de adjacência: um sentido percorrível de uma aresta
+typedef struct {
+    size_t destino;   // Índice do ponto de destino em grafo->pontos
+    size_t aresta;    // Índice da aresta de origem em grafo->arestas
+    double peso;
+} Arco;
+
+// Par (id, índice) usado para localizar pontos por busca binária
+typedef struct {
+    long long id;
+    size_t indice;
+} EntradaIndiceId;
+
+// Função de custo de uma consulta
+typedef enum {
+    METRICA_DISTANCIA,      // km (Aresta.peso)
+    METRICA_TEMPO,          // Segundos, pela velocidade da via
+    METRICA_PERSONALIZADA,  // Segundos: tempo mais a penalidade da aresta
+    NUM_METRICAS
+} Metrica;
+
+// Índices derivados do grafo, construídos sob demanda. Todos os vetores vêm
+// da mesma arena e são liberados juntos.
+typedef struct IndicesGrafo {
+    Arena *arena;
+    size_t num_pontos;
+    size_t num_arcos;
+    size_t *inicio_arcos;   // num_pontos + 1 posições (formato CSR)
+    Arco *arcos;            // Arcos de saída agrupados por ponto de origem
+
+    // Componentes conexas por ponto (NULL até obter_componentes ser chamada).
+    // As fortes seguem a ordem de término de Tarjan: todo arco vai de uma
+    // componente para outra de número menor ou igual.
+    size_t *componente_forte;
+    size_t num_componentes_fortes;
+    size_t maior_componente_forte;  // Componente forte com mais pontos
+    size_t *componente_fraca;       // Conectividade ignorando o sentido das vias
+    size_t num_componentes_fracas;
+
+    // Pesos inteiros dos arcos em milímetros, paralelos a arcos
+    // (NULL até obter_pesos_inteiros ser chamada)
+    uint32_t *peso_mm;
+
+    // Pesos dos arcos por métrica, cada um um vetor paralelo a arcos (a
+    // topologia é compartilhada); NULL até obter_pesos_metrica ser chamada
+    double *peso_metrica[NUM_METRICAS];
+} IndicesGrafo;
+
+// Novo peso de uma aresta, para atualizar_pesos
+typedef struct {
+    size_t aresta;  // Índice em grafo->arestas
+    double peso;
+} AtualizacaoPeso;
+
+// Milímetros por km (unidade dos pesos inteiros)
+#define MM_POR_KM 1000000.0
+
+// Armazenamento: pontos, arestas e os três vetores de atributos são vetores
+// próprios com crescimento geométrico (realloc), não blocos de arena. Eles
+// precisam crescer e encolher no lugar (reserva, remover_aresta, remover_ponto,
+// reordenação), e a arena só devolve memória de uma vez. Só os índices
+// derivados, que são reconstruídos inteiros, vêm de uma arena; por isso
+// liberar_grafo() faz uma liberação por vetor em vez de uma única.
+
 // Cria um grafo vazio
 Grafo* criar_grafo(void);
 
-// Adiciona um ponto ao grafo
+// Cria um grafo vazio já com espaço para a quantidade esperada de elementos
+Grafo* criar_grafo_com_capacidade(size_t pontos, size_t arestas);
+
+// Garante espaço para pelo menos 'capacidade' pontos/arestas sem realocar.
+// Quando precisa crescer, ao menos dobra a capacidade atual. Retorna 0 ou -1.
+int reservar_pontos(Grafo* grafo, size_t capacidade);
+int reservar_arestas(Grafo* grafo, size_t capacidade);
+
+// Adiciona um ponto ao grafo (custo amortizado constante)
 int adicionar_ponto(Grafo* grafo, long long id, double lat, double lon);
 
-// Adiciona uma aresta ao grafo
+// Adiciona uma aresta ao grafo (custo amortizado constante)
 int adicionar_aresta(Grafo* grafo, long long origem, long long destino, double peso);
 
-// Busca o índice de um ponto pelo id
+// Adicionam vários pontos/arestas de uma vez, com uma única reserva
+int adicionar_pontos(Grafo* grafo, const Ponto* pontos, size_t quantidade);
+int adicionar_arestas(Grafo* grafo, const Aresta* arestas, size_t quantidade);
+
+// Aloca os atributos por aresta (com valores padrão) se ainda não existirem.
+// Retorna 0 ou -1.
+int garantir_atributos_arestas(Grafo* grafo);
+
+// Remove a aresta trazendo a última para o lugar dela (com os atributos)
+void remover_aresta(Grafo* grafo, size_t aresta);
+
+// Remove o ponto trazendo o último para o lugar dela; o mapa de IDs é
+// corrigido no lugar e só a adjacência é descartada. As arestas do ponto
+// devem ter sido removidas antes.
+void remover_ponto(Grafo* grafo, size_t ponto);
+
+// Busca o índice de um ponto pelo id pelo mapa de IDs (O(1) esperado), ou
+// percorrendo os pontos se o mapa não existir. Só lê o grafo, sem montar
+// nada, e pode ser chamada de várias threads enquanto ninguém o altera.
 ssize_t buscar_indice_ponto(const Grafo* grafo, long long id);
 
+// Retorna os índices do grafo, construindo-os se necessário (NULL em caso de erro)
+const IndicesGrafo* obter_indices(Grafo* grafo);
+
+// Retorna os índices com peso_mm preenchido (arredondado; NULL em caso de erro)
+const IndicesGrafo* obter_pesos_inteiros(Grafo* grafo);
+
+// Índices (em indices->arcos) dos arcos gerados pela aresta: um para mão
+// única, dois para mão dupla. Retorna quantos foram escritos em arcos[2].
+size_t arcos_da_aresta(Grafo* grafo, size_t aresta, size_t arcos[2]);
+
+// Altera o peso de várias arestas de uma vez. Se os índices existirem, os
+// arcos (com peso_mm e os pesos por métrica) são corrigidos no lugar em vez
+// de descartados, pois adjacência e componentes não dependem dos pesos;
+// estruturas derivadas dos pesos (hierarquias, núcleos de roteamento) ficam
+// desatualizadas. Valida o lote inteiro antes de aplicar. Retorna quantas
+// arestas mudaram ou -1.
+int atualizar_pesos(Grafo* grafo, const AtualizacaoPeso* atualizacoes, size_t quantidade);
+
+// Descarta a adjacência (CSR, componentes, pesos por arco); deve ser chamada
+// após alterar arestas ou acrescentar/remover pontos pelas funções acima, que
+// já mantêm o mapa de IDs. Incrementa grafo->versao_indices: quem guarda
+// posições de arcos compara a versão, pois os índices novos podem ocupar o
+// mesmo endereço dos antigos.
+void invalidar_adjacencia(Grafo* grafo);
+
+// Como invalidar_adjacencia, e também refaz o mapa de IDs em O(V). Para quem
+// escreve diretamente em grafo->pontos (reordenação, cópias em lote).
+void invalidar_indices(Grafo* grafo);
+
+// Libera adjacência e mapa de IDs sem refazer nada (usada por liberar_grafo)
+void liberar_indices_grafo(Grafo* grafo);
+
+// Funde registros espelhados de uma mesma via (mãos únicas opostas com o
+// mesmo peso e os mesmos atributos) em um único registro de mão dupla, e
+// descarta registros entre os mesmos pontos que outro domina: permite os
+// mesmos sentidos e não custa mais em nenhuma métrica. Registros com
+// atributos diferentes que valem mais em alguma métrica são mantidos.
+// Retorna o número de registros removidos.
+size_t canonicalizar_arestas(Grafo* grafo);
+
 // Imprime o grafo (para debug)
 void imprimir_grafo(const Grafo* grafo);
 
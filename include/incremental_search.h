@@ -0,0 +1,32 @@
+#ifndef INCREMENTAL_SEARCH_H
+#define INCREMENTAL_SEARCH_H
+
+#include "osm_reader.h"
+#include "dijkstra.h"
+#include <stddef.h>
+
+// Busca de Dijkstra que pode ser retomada: o estado (distâncias, pontos já
+// estabelecidos e a fila) de uma origem é mantido entre consultas, e um novo
+// destino só avança a busca a partir de onde ela parou. Um destino que já foi
+// estabelecido é respondido sem nenhuma busca. Vale até o grafo ser alterado.
+typedef struct {
+    Grafo *grafo;
+    long origem_id;
+    size_t origem;
+    double *distancias;
+    size_t *predecessores;
+    unsigned char *estabelecido;
+    FilaPrioridade *fila;
+    size_t num_estabelecidos;
+} BuscaIncremental;
+
+// Cria a busca a partir da origem (NULL se o id não existir ou faltar memória)
+BuscaIncremental* criar_busca_incremental(Grafo *grafo, long origem_id);
+
+// Mesmo contrato de dijkstra() para a origem da busca; nos_visitados conta
+// apenas os pontos estabelecidos nesta chamada
+ResultadoDijkstra* continuar_busca_incremental(BuscaIncremental *busca, long destino_id);
+
+void liberar_busca_incremental(BuscaIncremental *busca);
+
+#endif // INCREMENTAL_SEARCH_H
@@ -9,6 +9,12 @@ gboolean on_graph_scroll(GtkWidget *widget, GdkEventScroll *event, gpointer user
 // Função para encontrar o ponto mais próximo do clique
 Ponto* find_closest_point(AppData *app, double click_x, double click_y);
 
+// Função para projetar o clique na via mais próxima (até 20 px). Preenche o
+// ponto da via mais próximo da projeção e mid_edge = TRUE se a projeção cai
+// longe dele (clique no meio da rua). Retorna FALSE se não há via perto.
+gboolean find_closest_edge(AppData *app, double click_x, double click_y, ProjecaoAresta *projecao,
+                           long long *nearest_id, gboolean *mid_edge);
+
 // Função para converter coordenadas de tela para lat/lon
 void screen_to_latlon(AppData *app, double screen_x, double screen_y, double *lat, double *lon);
 
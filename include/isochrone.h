@@ -0,0 +1,41 @@
+#ifndef ISOCHRONE_H
+#define ISOCHRONE_H
+
+#include "osm_reader.h"
+#include "graph.h"
+#include "distance_matrix.h"
+#include <stddef.h>
+
+// Pontos alcançáveis a partir de uma origem dentro de um limite de custo (na
+// métrica do espaço de busca: km para distância, segundos para tempo). Os
+// vetores crescem conforme a necessidade e são reaproveitados entre buscas.
+typedef struct {
+    size_t *pontos;       // Índices em grafo->pontos, em ordem crescente de custo
+    double *custos;       // Custo de cada ponto a partir da origem (paralelo a pontos)
+    size_t num_pontos;
+    size_t capacidade;
+    size_t num_tocados;   // Pontos rotulados pela busca (região mais a fronteira)
+    double limite;
+} RegiaoAlcancavel;
+
+RegiaoAlcancavel* criar_regiao_alcancavel(void);
+void liberar_regiao_alcancavel(RegiaoAlcancavel *regiao);
+
+// Dijkstra que para ao passar do limite e guarda os pontos estabelecidos na
+// região. Usa o espaço de busca (limpo por época), de modo que o trabalho é
+// proporcional à região e não ao grafo. Retorna 0 ou -1 em caso de erro (id
+// desconhecido, limite negativo, espaço de outro tamanho ou falta de memória).
+int busca_limitada(Grafo *grafo, EspacoBusca *espaco, long origem_id, double limite,
+                   RegiaoAlcancavel *regiao);
+
+// Custo do ponto na última busca_limitada() feita com o espaço (-1 se ficou fora)
+static inline double custo_alcancado(const EspacoBusca *espaco, size_t ponto) {
+    return ponto < espaco->num_pontos && espaco->estabelecido[ponto] == espaco->epoca
+        ? espaco->distancias[ponto] : -1.0;
+}
+
+// Faixa (0 .. num_faixas - 1) do custo ao dividir o limite em partes iguais;
+// -1 se o custo estiver fora do limite
+int faixa_alcance(double custo, double limite, int num_faixas);
+
+#endif // ISOCHRONE_H
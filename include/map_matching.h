@@ -0,0 +1,92 @@
+#ifndef MAP_MATCHING_H
+#define MAP_MATCHING_H
+
+#include "osm_reader.h"
+#include "graph.h"
+#include <stddef.h>
+
+// Posição registrada pelo GPS
+typedef struct {
+    double lat;
+    double lon;
+} PontoGPS;
+
+// Trajeto de um veículo, na ordem das leituras
+typedef struct {
+    PontoGPS *pontos;
+    size_t num_pontos;
+} TrajetoGPS;
+
+typedef struct {
+    TrajetoGPS *trajetos;
+    size_t num_trajetos;
+} ConjuntoTrajetos;
+
+// Lê os trajetos de um arquivo GPX: cada <trk> vira um trajeto com os
+// <trkpt> de todos os seus segmentos. Retorna NULL se o arquivo não abrir.
+ConjuntoTrajetos* ler_trajetos_gpx(const char *caminho_arquivo_gpx);
+void liberar_conjunto_trajetos(ConjuntoTrajetos *conjunto);
+
+typedef struct {
+    double sigma_gps_m;     // Desvio padrão do erro do GPS (emissão gaussiana)
+    double beta_m;          // Escala da diferença entre rota e linha reta (transição exponencial)
+    double raio_busca_m;    // Vias candidatas a até esta distância de cada leitura
+    size_t max_candidatos;  // Candidatas mais próximas mantidas por leitura
+    double fator_rota;      // Rotas entre leituras com mais que fator x linha reta
+                            // + 2 x raio são descartadas (limite das buscas)
+    size_t tamanho_cache;   // Buscas limitadas guardadas por trabalhador (0: só a última)
+} ParametrosCombinacao;
+
+// Valores padrão (sigma 10 m, beta 5 m, raio 50 m, 8 candidatas, fator 2, cache de 32)
+ParametrosCombinacao parametros_combinacao_padrao(void);
+
+// Leitura casada com uma via
+typedef struct {
+    size_t aresta;       // Índice em grafo->arestas ((size_t)-1 se a leitura ficou de fora)
+    double fracao;       // Posição na aresta, de origem (0) a destino (1)
+    double lat;          // Ponto projetado na via
+    double lon;
+    double distancia_m;  // Da leitura até a via
+} PontoCasado;
+
+typedef struct {
+    PontoCasado *pontos;        // Uma por leitura do trajeto
+    size_t num_pontos;
+    size_t num_nao_casados;     // Leituras sem via candidata no raio
+    long *caminho;              // Pontos percorridos, em ordem: pares consecutivos do
+    size_t tamanho_caminho;     // mesmo trecho são arestas do grafo
+    size_t *inicio_trechos;     // Posição em caminho de cada trecho contínuo (o
+    size_t num_trechos;         // modelo recomeça quando não há rota entre leituras)
+    size_t buscas;              // Buscas limitadas executadas
+    size_t acertos_cache;       // Consultas de rota respondidas pelo cache
+    double tempo_ms;
+} ResultadoCombinacao;
+
+// Estrutura para casar trajetos com um grafo: índice espacial (spatial_index.h,
+// com células do tamanho do raio de busca) e os parâmetros do modelo. O grafo
+// não pode ser alterado enquanto o combinador existir.
+typedef struct CombinadorMapa CombinadorMapa;
+
+// Retorna NULL em caso de erro (parâmetros inválidos ou falta de memória)
+CombinadorMapa* criar_combinador_mapa(Grafo *grafo, const ParametrosCombinacao *parametros);
+void liberar_combinador_mapa(CombinadorMapa *combinador);
+
+// Casa um trajeto por Viterbi sobre um modelo oculto de Markov: os estados
+// de cada leitura são as projeções nas vias candidatas, a emissão pesa a
+// distância até a via e a transição compara a distância pela rede (busca
+// limitada a partir das pontas da via) com a distância em linha reta. As
+// buscas ficam num cache por origem, reaproveitado entre leituras seguidas
+// na mesma via. Retorna NULL em caso de erro.
+ResultadoCombinacao* combinar_trajeto(CombinadorMapa *combinador, const TrajetoGPS *trajeto);
+
+// Casa vários trajetos em paralelo, cada trabalhador com o próprio espaço
+// de busca e cache; num_threads <= 0 usa o número de processadores. Retorna
+// um vetor na ordem dos trajetos (liberar com liberar_resultados_combinacao)
+// ou NULL em caso de erro.
+ResultadoCombinacao** combinar_trajetos(CombinadorMapa *combinador, const ConjuntoTrajetos *conjunto,
+                                        int num_threads);
+
+void liberar_resultado_combinacao(ResultadoCombinacao *resultado);
+void liberar_resultados_combinacao(ResultadoCombinacao **resultados, size_t quantidade);
+
+#endif // MAP_MATCHING_H
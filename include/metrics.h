@@ -0,0 +1,42 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include "osm_reader.h"
+#include "graph.h"
+#include <stddef.h>
+
+// Classe correspondente ao valor da tag highway (VIA_DESCONHECIDA se não reconhecido)
+ClasseVia classe_via_da_tag(const char* valor);
+
+// Valor da tag highway que representa a classe ("unclassified" para
+// VIA_DESCONHECIDA), usado ao salvar o grafo
+const char* tag_da_classe_via(ClasseVia classe);
+
+// Velocidade em km/h do valor da tag maxspeed ("50", "30 mph"); 0 se não
+// for numérico (por exemplo "none" ou "signals")
+double velocidade_da_tag(const char* valor);
+
+// Velocidade em km/h usada quando a via não tem maxspeed
+double velocidade_padrao(ClasseVia classe);
+
+// Velocidade efetiva da aresta: maxspeed se conhecida, senão a da classe
+double velocidade_aresta(const Grafo* grafo, size_t aresta);
+
+// Custo de percorrer a aresta na métrica dada
+double custo_aresta(const Grafo* grafo, size_t aresta, Metrica metrica);
+
+// Pesos dos arcos (paralelos a indices->arcos) na métrica dada, construídos
+// uma vez por versão dos índices. NULL em caso de erro.
+const double* obter_pesos_metrica(Grafo* grafo, Metrica metrica);
+
+// Define a penalidade personalizada da aresta, corrigindo os pesos já
+// construídos da métrica personalizada. Retorna 0 ou -1.
+int definir_penalidade(Grafo* grafo, size_t aresta, double segundos);
+
+// Soma todas as métricas ao longo de um caminho (IDs de pontos). Entre dois
+// pontos consecutivos usa o arco mais barato na métrica em que o caminho foi
+// calculado. Retorna 0 ou -1 se algum trecho não existir no grafo.
+int metricas_caminho(Grafo* grafo, const long* caminho, int tamanho, Metrica metrica,
+                     double custos[NUM_METRICAS]);
+
+#endif // METRICS_H
@@ -11,6 +11,8 @@ typedef struct {
 } Ponto;
 
 // Estrutura para armazenar uma aresta
+// Vias de mão dupla são armazenadas uma única vez (is_bidirectional = 1);
+// a camada de adjacência expande os dois sentidos logicamente.
 typedef struct {
     long long origem;
     long long destino;
@@ -18,12 +20,47 @@ typedef struct {
     int is_bidirectional;  // 1 para bidirectional (mão dupla), 0 para direcional (mão única)
 } Aresta;
 
+// Classe da via (tag highway), que define a velocidade padrão da aresta
+typedef enum {
+    VIA_DESCONHECIDA = 0,
+    VIA_MOTORWAY,
+    VIA_TRUNK,
+    VIA_PRIMARY,
+    VIA_SECONDARY,
+    VIA_TERTIARY,
+    VIA_UNCLASSIFIED,
+    VIA_RESIDENTIAL,
+    VIA_LIVING_STREET,
+    VIA_SERVICE,
+    VIA_TRACK,
+    VIA_PEDESTRE,      // footway, path, pedestrian, cycleway, steps
+    NUM_CLASSES_VIA
+} ClasseVia;
+
+// Índices derivados do grafo: adjacência definida em graph.h, mapa de IDs
+// privado de graph.c
+struct IndicesGrafo;
+typedef struct MapaIds MapaIds;
+
 // Estrutura para armazenar o grafo
 typedef struct {
     Ponto* pontos;
     size_t num_pontos;
+    size_t capacidade_pontos;   // Posições alocadas em pontos (>= num_pontos)
     Aresta* arestas;
     size_t num_arestas;
+    size_t capacidade_arestas;  // Posições alocadas em arestas (>= num_arestas)
+
+    // Atributos por aresta em estrutura de vetores, paralelos a arestas e com
+    // a mesma capacidade. NULL enquanto nenhuma aresta tiver atributos
+    // próprios (classe desconhecida, velocidade padrão, sem penalidade).
+    unsigned char* classe_via;  // ClasseVia
+    float* velocidade_kmh;      // maxspeed; 0 usa a velocidade padrão da classe
+    float* penalidade_s;        // Custo extra da métrica personalizada, em segundos
+
+    struct IndicesGrafo* indices; // Construídos sob demanda, NULL quando inválidos
+    unsigned long versao_indices; // Incrementada a cada invalidar_adjacencia()
+    MapaIds* mapa_ids;            // id -> posição em pontos, mantido a cada edição
 } Grafo;
 
 // Protótipo da função que lê o arquivo OSM e armazena os pontos e as arestas
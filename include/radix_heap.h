@@ -0,0 +1,51 @@
+#ifndef RADIX_HEAP_H
+#define RADIX_HEAP_H
+
+#include "osm_reader.h"
+#include "dijkstra.h"
+#include <stddef.h>
+#include <stdint.h>
+
+// Número de baldes: um para chaves iguais à última extraída e um por bit
+#define NUM_BALDES_RADIX 65
+
+typedef struct {
+    uint64_t chave;
+    size_t valor;
+} ItemRadix;
+
+typedef struct {
+    ItemRadix *itens;
+    size_t tamanho;
+    size_t capacidade;
+} BaldeRadix;
+
+// Fila de prioridade monótona (radix heap): as chaves inseridas nunca são
+// menores que a última extraída, como acontece no Dijkstra. O item fica no
+// balde do bit mais alto em que difere da última chave extraída, e cada item
+// só desce de balde, o que dá custo amortizado O(log C) sem comparações.
+typedef struct {
+    BaldeRadix baldes[NUM_BALDES_RADIX];
+    uint64_t ultima;    // Última chave extraída
+    size_t tamanho;
+} FilaRadix;
+
+// Inicializa/libera a fila (a estrutura em si pode estar na pilha)
+void iniciar_fila_radix(FilaRadix *fila);
+void liberar_fila_radix(FilaRadix *fila);
+
+// Insere um item; a chave deve ser >= à última extraída. Retorna 0 ou -1.
+int inserir_fila_radix(FilaRadix *fila, uint64_t chave, size_t valor);
+
+// Remove o item de menor chave (a fila não pode estar vazia)
+ItemRadix extrair_minimo_radix(FilaRadix *fila);
+
+static inline int fila_radix_vazia(const FilaRadix *fila) {
+    return fila->tamanho == 0;
+}
+
+// Dijkstra com pesos inteiros (milímetros) e fila radix. Mesmo contrato de
+// dijkstra(); a distância é somada em inteiros e devolvida em km.
+ResultadoDijkstra* dijkstra_radix(Grafo *grafo, long origem_id, long destino_id);
+
+#endif // RADIX_HEAP_H
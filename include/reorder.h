@@ -0,0 +1,12 @@
+#ifndef REORDER_H
+#define REORDER_H
+
+#include "osm_reader.h"
+
+// Renumera os pontos na ordem da curva de Hilbert sobre (lat, lon), para que
+// pontos vizinhos na rede fiquem próximos na memória. As arestas são ordenadas
+// pelo novo índice da origem e os índices derivados do grafo são invalidados.
+// Passo opcional, a ser chamado após o carregamento. Retorna 0 em caso de sucesso.
+int reordenar_hilbert(Grafo *grafo);
+
+#endif // REORDER_H
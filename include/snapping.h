@@ -0,0 +1,53 @@
+#ifndef SNAPPING_H
+#define SNAPPING_H
+
+#include "osm_reader.h"
+#include "dijkstra.h"
+#include "graph.h"
+#include "distance_matrix.h"
+#include "spatial_index.h"
+#include <stddef.h>
+
+// Ponto de uma aresta mais próximo de uma coordenada
+typedef struct {
+    size_t aresta;       // Índice em grafo->arestas
+    double fracao;       // Posição na aresta, de origem (0) a destino (1)
+    double lat;          // Ponto projetado na via
+    double lon;
+    double distancia_m;  // Da coordenada até a via
+} ProjecaoAresta;
+
+// As consultas usam o índice espacial do grafo (spatial_index.h), que as
+// edições mantêm atualizado, e medem em metros numa projeção equirretangular
+// em torno da coordenada consultada. Só leem o índice: podem rodar em várias
+// threads ao mesmo tempo.
+
+// Aresta mais próxima da coordenada: o segmento mais próximo no plano lon/lat
+// dá um raio em metros, e as arestas na caixa desse raio são comparadas em
+// metros. raio_max_m <= 0 não limita a distância. Empates ficam com a aresta
+// de menor índice. Retorna 0, ou -1 se não há aresta no raio.
+int aresta_mais_proxima(const IndiceEspacial *indice, double lat, double lon, double raio_max_m,
+                        ProjecaoAresta *projecao);
+
+// As até max_saida arestas a até raio_m da coordenada, em ordem de distância
+// (empates pelo índice da aresta). Retorna quantas foram escritas em saida.
+size_t arestas_proximas(const IndiceEspacial *indice, double lat, double lon, double raio_m,
+                        ProjecaoAresta *saida, size_t max_saida);
+
+// Projeção exatamente sobre o ponto do grafo, numa aresta que o toca (fração
+// 0 ou 1), para rotear de um ponto até uma projeção com dijkstra_projecoes().
+// Retorna -1 se o id não existe ou nenhuma aresta toca o ponto.
+int projecao_no_ponto(const IndiceEspacial *indice, long long id, ProjecaoAresta *projecao);
+
+// Menor caminho entre dois pontos projetados em vias, dividindo as arestas
+// virtualmente nas projeções: a busca parte das pontas da aresta de origem
+// (com o custo do pedaço até cada uma) e termina ao entrar na aresta de
+// destino, respeitando as vias de mão única; na mesma aresta, o trecho direto
+// também vale. Usa a métrica do espaço de busca. caminho tem só os pontos do
+// grafo entre as duas projeções, incluindo as pontas sobre as quais uma
+// projeção cai (vazio se o trecho direto no meio da aresta for o melhor), e
+// distancia_total inclui os pedaços de aresta. Retorna NULL em caso de erro.
+ResultadoDijkstra* dijkstra_projecoes(Grafo *grafo, EspacoBusca *espaco, const ProjecaoAresta *origem,
+                                      const ProjecaoAresta *destino);
+
+#endif // SNAPPING_H
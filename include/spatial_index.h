@@ -0,0 +1,79 @@
+#ifndef SPATIAL_INDEX_H
+#define SPATIAL_INDEX_H
+
+#include "osm_reader.h"
+#include <stddef.h>
+
+// Índice espacial dos pontos e dos segmentos (arestas) do grafo numa grade
+// uniforme sobre lon/lat em graus: o mesmo plano em que a interface desenha
+// o grafo (escala igual nos dois eixos), então distâncias aqui são distâncias
+// na tela divididas pela escala. Cada célula tem listas encadeadas dos seus
+// pontos e segmentos, de modo que inserir e remover custa o tamanho de uma
+// célula, e o índice acompanha as edições sem ser reconstruído.
+//
+// Um segmento fica numa só célula, a do centro do seu retângulo envolvente,
+// no nível mais fino da hierarquia de grades (lado dobrando a cada nível) em
+// que cabe; assim vias longas não espalham cópias nem forçam células grandes.
+typedef struct IndiceEspacial IndiceEspacial;
+
+// Índices de pontos ou arestas devolvidos pelas consultas por retângulo. O
+// vetor cresce conforme a necessidade e é reaproveitado entre consultas.
+typedef struct {
+    size_t *itens;
+    size_t quantidade;
+    size_t capacidade;
+} ListaIndices;
+
+ListaIndices* criar_lista_indices(void);
+void liberar_lista_indices(ListaIndices *lista);
+
+// Constrói o índice sobre os pontos e arestas atuais. celula_graus <= 0
+// escolhe o lado pela densidade (cerca de dois pontos por célula). Arestas
+// com pontas inexistentes ficam de fora. Retorna NULL em caso de erro.
+IndiceEspacial* criar_indice_espacial(const Grafo *grafo, double celula_graus);
+void liberar_indice_espacial(IndiceEspacial *indice);
+
+// Atualizações, chamadas logo depois da mesma alteração no grafo (as
+// remoções seguem a convenção do grafo: o último elemento vai para a posição
+// removida). Um ponto novo fora da área da grade faz o índice ser refeito com
+// os limites novos. Retornam 0, ou -1 em caso de erro; após um erro o índice
+// não corresponde mais ao grafo e deve ser descartado.
+int inserir_ponto_indice(IndiceEspacial *indice, size_t ponto);
+int remover_ponto_indice(IndiceEspacial *indice, size_t ponto);  // Sem arestas tocando o ponto
+int inserir_aresta_indice(IndiceEspacial *indice, size_t aresta, size_t origem, size_t destino);
+int remover_aresta_indice(IndiceEspacial *indice, size_t aresta);
+
+// Limites dos pontos indexados, mantidos a cada inserção; remover um ponto da
+// borda faz com que sejam recalculados pelas colunas e linhas extremas da
+// grade. Retorna -1 se não há pontos.
+int limites_indice(IndiceEspacial *indice, double *min_lat, double *max_lat, double *min_lon, double *max_lon);
+
+// Grafo indexado, e as pontas da aresta em grafo->pontos na orientação atual
+// dela (uma edição pode inverter a aresta no lugar). pontas_segmento retorna
+// -1 se a aresta não está no índice ou tem pontas inexistentes.
+const Grafo* grafo_indice(const IndiceEspacial *indice);
+int pontas_segmento(const IndiceEspacial *indice, size_t aresta, size_t *origem, size_t *destino);
+
+// Ponto/segmento mais próximo da coordenada (distância em graus no plano
+// lon/lat). raio_max <= 0 não limita a distância. Empates ficam com o menor
+// índice. Retornam 0, ou -1 se não há nada no raio.
+int ponto_mais_proximo(const IndiceEspacial *indice, double lat, double lon, double raio_max, size_t *ponto);
+int segmento_mais_proximo(const IndiceEspacial *indice, double lat, double lon, double raio_max, size_t *aresta);
+
+// Os até k pontos/segmentos mais próximos, em ordem de distância (empates pelo
+// índice), com as distâncias em distancias (pode ser NULL). A busca começa
+// por um quadrado de uma célula e dobra o lado até que o k-ésimo esteja
+// dentro dele. Retornam quantos foram escritos em saida.
+size_t pontos_mais_proximos(const IndiceEspacial *indice, double lat, double lon, double raio_max, size_t k,
+                            size_t *saida, double *distancias);
+size_t segmentos_mais_proximos(const IndiceEspacial *indice, double lat, double lon, double raio_max, size_t k,
+                               size_t *saida, double *distancias);
+
+// Pontos dentro do retângulo / arestas cujo retângulo envolvente o toca, na
+// ordem das células. Substituem o conteúdo de saida. Retornam 0 ou -1.
+int pontos_na_caixa(const IndiceEspacial *indice, double min_lat, double min_lon, double max_lat, double max_lon,
+                    ListaIndices *saida);
+int segmentos_na_caixa(const IndiceEspacial *indice, double min_lat, double min_lon, double max_lat,
+                       double max_lon, ListaIndices *saida);
+
+#endif // SPATIAL_INDEX_H
@@ -0,0 +1,77 @@
+#ifndef TIME_DEPENDENT_H
+#define TIME_DEPENDENT_H
+
+#include "osm_reader.h"
+#include "dijkstra.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define SEGUNDOS_POR_DIA 86400u
+
+// Aresta sem perfil: tempo de travessia constante (fator 1)
+#define PERFIL_CONSTANTE UINT32_MAX
+
+// Ponto de quebra de um perfil: fator aplicado ao tempo em via livre a
+// partir de 'instante' (segundos desde a meia-noite), interpolado
+// linearmente até o próximo ponto e, depois do último, de volta ao primeiro
+typedef struct {
+    uint32_t instante;
+    float fator;
+} PontoPerfil;
+
+// Perfis de tempo de viagem por hora do dia. Um perfil é um multiplicador
+// do tempo em via livre (peso / velocidade_kmh), então vias com o mesmo
+// padrão de trânsito compartilham um único perfil, guardado uma só vez; cada
+// aresta custa apenas o id de 4 bytes. Vale para as arestas existentes na
+// criação da tabela; arestas adicionadas depois são constantes.
+typedef struct {
+    size_t num_arestas;
+    uint32_t *perfil_aresta;   // Id do perfil de cada aresta ou PERFIL_CONSTANTE
+    double velocidade_kmh;     // Velocidade em via livre
+
+    size_t num_perfis;
+    size_t capacidade_perfis;
+    size_t *inicio_perfil;     // num_perfis + 1 posições em pontos
+    PontoPerfil *pontos;
+    size_t num_pontos;
+    size_t capacidade_pontos;
+
+    uint32_t *tabela_hash;     // Ids + 1 por hash do conteúdo (0 = vazio)
+    size_t capacidade_hash;
+} TabelaPerfis;
+
+// Cria a tabela com todas as arestas constantes (NULL em caso de erro)
+TabelaPerfis* criar_tabela_perfis(const Grafo *grafo, double velocidade_kmh);
+void liberar_tabela_perfis(TabelaPerfis *tabela);
+
+// Registra um perfil (pontos em ordem crescente de instante, todos menores
+// que um dia, fatores positivos) e retorna o id; um perfil idêntico a um já
+// registrado devolve o mesmo id. Retorna -1 se o perfil for inválido.
+long registrar_perfil(TabelaPerfis *tabela, const PontoPerfil *pontos, size_t quantidade);
+
+// Associa um perfil (ou PERFIL_CONSTANTE) a uma aresta. Para garantir a
+// propriedade FIFO (sair mais tarde nunca faz chegar mais cedo), o fator do
+// perfil não pode cair mais rápido que 1 / t0 por segundo, sendo t0 o tempo
+// da aresta em via livre com o peso atual: uma queda que serve a uma via
+// curta é recusada numa longa. Retorna 0, ou -1 se a aresta ou o perfil não
+// existir ou o perfil violar FIFO nela.
+int associar_perfil(TabelaPerfis *tabela, const Grafo *grafo, size_t aresta, uint32_t perfil);
+
+// Fator do perfil no instante (segundos; qualquer valor, tomado módulo um dia)
+double fator_perfil(const TabelaPerfis *tabela, uint32_t perfil, double instante);
+
+// Tempo em segundos para percorrer a aresta saindo no instante dado
+double tempo_travessia(const TabelaPerfis *tabela, const Grafo *grafo, size_t aresta, double instante);
+
+// Bytes ocupados pela tabela (para comparar com perfis por aresta)
+size_t memoria_tabela_perfis(const TabelaPerfis *tabela);
+
+// Caminho mais rápido saindo da origem no instante 'partida' (segundos desde
+// a meia-noite). Mesmo contrato de dijkstra(), com distancia_total em km ao
+// longo do caminho escolhido; se duracao não for NULL, recebe o tempo de
+// viagem em segundos (-1 se inalcançável).
+ResultadoDijkstra* dijkstra_dependente_tempo(Grafo *grafo, const TabelaPerfis *tabela,
+                                             long origem_id, long destino_id,
+                                             double partida, double *duracao);
+
+#endif // TIME_DEPENDENT_H
@@ -0,0 +1,8 @@
+#ifndef TIMING_H
+#define TIMING_H
+
+// Relógio monotônico em milissegundos, para prazos (orçamentos de tempo das
+// otimizações) e medições. Só diferenças entre duas leituras têm sentido.
+double agora_ms(void);
+
+#endif // TIMING_H
@@ -0,0 +1,35 @@
+#ifndef TOUR_H
+#define TOUR_H
+
+#include "osm_reader.h"
+#include "graph.h"
+#include "waypoints.h"
+#include <stddef.h>
+
+// Ordem de visita otimizada para um conjunto de paradas. A primeira parada
+// (depósito) é sempre a primeira da ordem; num circuito a rota volta a ela.
+typedef struct {
+    size_t num_paradas;
+    size_t *ordem;             // Posições em paradas[], na ordem de visita
+    int circuito;
+    double custo_vizinho;      // Custo da ordem do vizinho mais próximo
+    double custo;              // Custo final (na métrica pedida)
+    int completo;              // 0 se algum trecho da ordem não tem caminho
+    size_t melhorias;          // Movimentos 2-opt / Or-opt aplicados
+    int tempo_esgotado;        // 1 se a melhoria parou pelo orçamento de tempo
+    double tempo_matriz_ms;    // Montagem da matriz de custos entre paradas
+    double tempo_otimizacao_ms;
+    RotaParadas *rota;         // Caminho completo na ordem final (NULL se incompleto)
+} Tour;
+
+// Monta a matriz de custos com uma busca um-para-muitos por parada, gera
+// uma ordem pelo vizinho mais próximo e a melhora com 2-opt e Or-opt
+// (segmentos de 1 a 3 paradas) até não haver ganho ou o orçamento acabar
+// (orcamento_ms <= 0: sem limite). Funciona com custos assimétricos (mão
+// única). Retorna NULL com id desconhecido ou em caso de erro.
+Tour* otimizar_tour(Grafo *grafo, const long *paradas, size_t num_paradas, Metrica metrica,
+                    int circuito, double orcamento_ms);
+
+void liberar_tour(Tour *tour);
+
+#endif // TOUR_H
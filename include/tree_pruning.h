@@ -0,0 +1,48 @@
+#ifndef TREE_PRUNING_H
+#define TREE_PRUNING_H
+
+#include "osm_reader.h"
+#include "dijkstra.h"
+#include "compression.h"
+#include "incremental_search.h"
+#include <stddef.h>
+#include <sys/types.h>
+
+// Grafo de roteamento sem as árvores de becos sem saída (2-core).
+// Pontos de uma árvore pendurada só podem ser alcançados pela raiz onde ela
+// se prende ao núcleo, então a busca roda apenas no núcleo e os trechos de
+// árvore são resolvidos seguindo os ponteiros para o pai.
+typedef struct {
+    Grafo *original;            // Grafo de origem (não pertence a esta estrutura)
+    Grafo *nucleo;              // Pontos restantes após a poda e as arestas entre eles
+    GrafoComprimido *nucleo_comprimido; // Opcional: cadeias de grau 2 do núcleo colapsadas
+
+    // Por ponto original (índices em original->pontos)
+    ssize_t *pai;               // Próximo ponto em direção à raiz (-1 no núcleo)
+    size_t *raiz;               // Ponto do núcleo onde a árvore se prende (o próprio ponto no núcleo)
+    double *distancia_raiz;     // Distância até a raiz ao longo da árvore
+    size_t *profundidade;       // Número de arestas até a raiz
+    size_t num_podados;
+} NucleoRoteamento;
+
+// Remove iterativamente pontos de grau 1 ligados por vias de mão dupla
+NucleoRoteamento* construir_nucleo_roteamento(Grafo *grafo);
+
+// Colapsa as cadeias de grau 2 do núcleo (0 em caso de sucesso)
+int comprimir_nucleo_roteamento(NucleoRoteamento *nucleo);
+
+// Libera a estrutura (o grafo original não é liberado)
+void liberar_nucleo_roteamento(NucleoRoteamento *nucleo);
+
+// Caminho mais curto entre quaisquer pontos do grafo original, buscando só no núcleo
+ResultadoDijkstra* dijkstra_nucleo(NucleoRoteamento *nucleo, long origem_id, long destino_id);
+
+// Como dijkstra_nucleo(), mas a busca no núcleo (sem compressão de cadeias)
+// é retomada de uma consulta para outra enquanto a raiz da origem for a
+// mesma; *busca é criada/substituída aqui e liberada pelo chamador com
+// liberar_busca_incremental(). Trocar só o destino custa apenas o avanço
+// que faltar, ou nada se ele já foi estabelecido.
+ResultadoDijkstra* dijkstra_nucleo_incremental(NucleoRoteamento *nucleo, BuscaIncremental **busca,
+                                               long origem_id, long destino_id);
+
+#endif // TREE_PRUNING_H
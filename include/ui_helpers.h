@@ -9,12 +9,45 @@ void update_status(AppData *app, const char *message);
 // Função para verificar se uma aresta faz parte do caminho mais curto
 gboolean is_edge_in_shortest_path(AppData *app, long node1_id, long node2_id);
 
+// Função para obter a rota alternativa (1, 2, ...) que usa uma aresta, ou 0
+size_t alternative_of_edge(AppData *app, long node1_id, long node2_id);
+
 // Função para atualizar as informações do arquivo
 void update_file_info(AppData *app);
 
 // Função para limpar dados da aplicação
 void cleanup_app_data(AppData *app);
 
+// Função para descartar estruturas de roteamento derivadas do grafo (após edições)
+void invalidate_routing_data(AppData *app);
+
+// Função para obter o núcleo de roteamento, reconstruindo-o se necessário
+NucleoRoteamento* get_routing_core(AppData *app);
+
+// Função para obter o índice espacial do grafo, construindo-o se necessário
+// (depois disso as edições o mantêm em dia)
+IndiceEspacial* get_spatial_index(AppData *app);
+
+// Função para descartar o índice espacial (antes de trocar ou liberar o grafo)
+void discard_spatial_index(AppData *app);
+
+// Função para obter os limites dos pontos do grafo (FALSE se não houver pontos)
+gboolean get_graph_bounds(AppData *app, double *min_lat, double *max_lat, double *min_lon, double *max_lon);
+
+// Função para obter a métrica escolhida no combo (distância se não houver)
+Metrica get_selected_metric(AppData *app);
+
+// Função para obter a isócrona do ponto inicial, recalculando-a se necessário
+// (NULL se desativada ou sem ponto inicial)
+RegiaoAlcancavel* get_isochrone(AppData *app);
+
+// Função para obter a partição de Voronoi das instalações, recalculando-a se
+// necessário (NULL se desativada)
+ParticaoVoronoi* get_voronoi(AppData *app);
+
+// Função para marcar ou desmarcar um ponto como instalação
+void toggle_facility(AppData *app, long long id);
+
 // Função auxiliar para buscar um ponto pelo ID
 Ponto* buscar_ponto_por_id(Grafo *grafo, long long id);
 
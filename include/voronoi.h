@@ -0,0 +1,35 @@
+#ifndef VORONOI_H
+#define VORONOI_H
+
+#include "osm_reader.h"
+#include "graph.h"
+#include <stddef.h>
+#include <stdint.h>
+
+// Ponto que nenhuma fonte alcança
+#define SEM_DONO UINT32_MAX
+
+// Partição de Voronoi pela rede: cada ponto recebe a fonte (instalação,
+// depósito) mais próxima pela via e o custo até ela, no sentido da fonte
+// para o ponto. Empates ficam com a fonte de menor posição na lista.
+typedef struct {
+    size_t num_pontos;
+    size_t num_fontes;
+    Metrica metrica;
+    size_t *pontos_fonte;     // Índice em grafo->pontos de cada fonte
+    uint32_t *dono;           // Posição da fonte dona de cada ponto (SEM_DONO se inalcançável)
+    double *custos;           // Custo da fonte dona até o ponto (-1 se inalcançável)
+    size_t *tamanho_celula;   // Pontos atribuídos a cada fonte
+    size_t num_inalcancaveis;
+} ParticaoVoronoi;
+
+// Um único Dijkstra com todas as fontes na fila a custo 0. Retorna NULL se
+// algum id de fonte for desconhecido ou em caso de erro.
+ParticaoVoronoi* particao_voronoi(Grafo *grafo, const long *fontes, size_t num_fontes, Metrica metrica);
+
+void liberar_particao_voronoi(ParticaoVoronoi *particao);
+
+// ID da fonte mais próxima do ponto (-1 se inalcançável ou id desconhecido)
+long fonte_mais_proxima(const Grafo *grafo, const ParticaoVoronoi *particao, long ponto_id);
+
+#endif // VORONOI_H
@@ -0,0 +1,30 @@
+#ifndef WAYPOINTS_H
+#define WAYPOINTS_H
+
+#include "osm_reader.h"
+#include "dijkstra.h"
+#include "graph.h"
+#include <stddef.h>
+
+// Rota que passa pelas paradas na ordem dada, trecho a trecho
+typedef struct {
+    ResultadoDijkstra *rota;  // Caminho completo (junções não repetidas); custo
+                              // total em distancia_total e pontos estabelecidos
+                              // somados em nos_visitados. sucesso = 0 se algum
+                              // trecho não tiver caminho.
+    size_t num_trechos;
+    double *custos_trechos;   // Custo de cada trecho na métrica (-1 se sem caminho)
+    int *inicio_trechos;      // Posição em rota->caminho onde cada trecho começa
+    size_t trecho_falho;      // Primeiro trecho sem caminho (num_trechos se nenhum)
+} RotaParadas;
+
+// Cada trecho (parada i -> i + 1) é uma consulta do motor de lotes: os
+// trechos rodam em paralelo e cada trabalhador reaproveita o próprio espaço
+// de busca entre trechos. num_threads <= 0 usa o número de processadores.
+// Retorna NULL com menos de duas paradas, id desconhecido ou erro.
+RotaParadas* rota_por_paradas(Grafo *grafo, const long *paradas, size_t num_paradas,
+                              Metrica metrica, int num_threads);
+
+void liberar_rota_paradas(RotaParadas *rota);
+
+#endif // WAYPOINTS_H
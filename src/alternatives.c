@@ -0,0 +1,443 @@
+#include "alternatives.h"
+#include "distance_matrix.h"
+#include "metrics.h"
+#include "timing.h"
+#include <float.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NENHUM ((size_t)-1)
+
+// Caminhos gerados por Yen (aceitos ou descartados pela sobreposição) por
+// rota pedida, antes de desistir de encontrar alternativas diferentes
+#define MAX_EXAMINADOS_POR_ROTA 10
+
+// Alternativas por penalidade quando Yen não basta: fator aplicado aos arcos
+// de cada caminho encontrado e número de buscas por rota pedida
+#define FATOR_PENALIDADE 1.4
+#define MAX_PENALIDADES_POR_ROTA 5
+
+// Caminho como sequência de arcos (índices em indices->arcos)
+typedef struct {
+    size_t *arcos;
+    size_t num_arcos;
+    double custo;
+    size_t desvio;  // Posição do ponto de desvio que o gerou: os desvios dele
+                    // só precisam partir daí em diante (Lawler)
+} Caminho;
+
+typedef struct {
+    Caminho *itens;
+    size_t num;
+    size_t capacidade;
+} ListaCaminhos;
+
+static int acrescentar_caminho(ListaCaminhos *lista, Caminho caminho) {
+    if (lista->num == lista->capacidade) {
+        size_t capacidade = lista->capacidade ? 2 * lista->capacidade : 16;
+        Caminho *itens = realloc(lista->itens, capacidade * sizeof(Caminho));
+        if (!itens) return -1;
+        lista->itens = itens;
+        lista->capacidade = capacidade;
+    }
+    lista->itens[lista->num++] = caminho;
+    return 0;
+}
+
+static void liberar_lista(ListaCaminhos *lista) {
+    for (size_t i = 0; i < lista->num; i++) free(lista->itens[i].arcos);
+    free(lista->itens);
+}
+
+// Estado compartilhado pelas buscas de uma consulta
+typedef struct {
+    const Grafo *grafo;
+    const IndicesGrafo *indices;
+    const double *pesos;     // NULL: distância guardada nos arcos
+    size_t *origem_arco;     // Ponto de partida de cada arco
+    double *ate_destino;     // Distância exata de cada ponto ao destino (DBL_MAX se não chega)
+    EspacoBusca *espaco;     // predecessores guarda o arco de chegada
+    size_t destino;
+    size_t estabelecidos;
+} Busca;
+
+static inline double peso_arco(const Busca *b, size_t k) {
+    return b->pesos ? b->pesos[k] : b->indices->arcos[k].peso;
+}
+
+// Dijkstra a partir do destino pelos arcos de entrada (CSR reverso montado
+// aqui), preenchendo ate_destino. Retorna 0 ou -1.
+static int buscar_reverso(Busca *b) {
+    const IndicesGrafo *indices = b->indices;
+    size_t n = indices->num_pontos;
+    size_t *inicio_entrada = calloc(n + 1, sizeof(size_t));
+    size_t *entrada = malloc((indices->num_arcos ? indices->num_arcos : 1) * sizeof(size_t));
+    if (!inicio_entrada || !entrada) {
+        free(inicio_entrada);
+        free(entrada);
+        return -1;
+    }
+    for (size_t v = 0; v < n; v++) {
+        for (size_t k = indices->inicio_arcos[v]; k < indices->inicio_arcos[v + 1]; k++) {
+            b->origem_arco[k] = v;
+            inicio_entrada[indices->arcos[k].destino + 1]++;
+        }
+    }
+    for (size_t v = 0; v < n; v++) inicio_entrada[v + 1] += inicio_entrada[v];
+    for (size_t k = 0; k < indices->num_arcos; k++) {
+        // inicio_entrada[d] avança enquanto preenche; é restaurado abaixo
+        entrada[inicio_entrada[indices->arcos[k].destino]++] = k;
+    }
+    for (size_t v = n; v > 0; v--) inicio_entrada[v] = inicio_entrada[v - 1];
+    inicio_entrada[0] = 0;
+
+    EspacoBusca *e = b->espaco;
+    reiniciar_espaco_busca(e);
+    uint32_t epoca = e->epoca;
+    e->marca[b->destino] = epoca;
+    e->distancias[b->destino] = 0.0;
+    inserir_fila_prioridade(e->fila, (long)b->destino, 0.0);
+    while (!fila_vazia(e->fila)) {
+        size_t atual = (size_t)extrair_minimo(e->fila).ponto_id;
+        if (e->estabelecido[atual] == epoca) continue;
+        e->estabelecido[atual] = epoca;
+        b->estabelecidos++;
+        for (size_t j = inicio_entrada[atual]; j < inicio_entrada[atual + 1]; j++) {
+            size_t k = entrada[j];
+            size_t vizinho = b->origem_arco[k];
+            if (e->estabelecido[vizinho] == epoca) continue;
+            double nova = e->distancias[atual] + peso_arco(b, k);
+            if (e->marca[vizinho] != epoca || nova < e->distancias[vizinho]) {
+                e->marca[vizinho] = epoca;
+                e->distancias[vizinho] = nova;
+                inserir_fila_prioridade(e->fila, (long)vizinho, nova);
+            }
+        }
+    }
+    for (size_t v = 0; v < n; v++) {
+        b->ate_destino[v] = e->estabelecido[v] == epoca ? e->distancias[v] : DBL_MAX;
+    }
+    free(inicio_entrada);
+    free(entrada);
+    return 0;
+}
+
+// A* do ponto de desvio até o destino, com ate_destino como heurística. Os
+// pontos bloqueados (a raiz do caminho) entram já estabelecidos, e os arcos
+// proibidos só são testados na saída do ponto de desvio, de onde todos
+// partem. Retorna 1 se o destino foi alcançado.
+static int buscar_desvio(Busca *b, size_t desvio, const size_t *bloqueados, size_t num_bloqueados,
+                         const size_t *proibidos, size_t num_proibidos) {
+    EspacoBusca *e = b->espaco;
+    const IndicesGrafo *indices = b->indices;
+    reiniciar_espaco_busca(e);
+    uint32_t epoca = e->epoca;
+    for (size_t i = 0; i < num_bloqueados; i++) e->estabelecido[bloqueados[i]] = epoca;
+    if (b->ate_destino[desvio] == DBL_MAX) return 0;
+
+    e->marca[desvio] = epoca;
+    e->distancias[desvio] = 0.0;
+    e->predecessores[desvio] = NENHUM;
+    inserir_fila_prioridade(e->fila, (long)desvio, b->ate_destino[desvio]);
+    while (!fila_vazia(e->fila)) {
+        size_t atual = (size_t)extrair_minimo(e->fila).ponto_id;
+        if (e->estabelecido[atual] == epoca) continue;
+        e->estabelecido[atual] = epoca;
+        b->estabelecidos++;
+        if (atual == b->destino) return 1;
+
+        for (size_t k = indices->inicio_arcos[atual]; k < indices->inicio_arcos[atual + 1]; k++) {
+            size_t vizinho = indices->arcos[k].destino;
+            if (e->estabelecido[vizinho] == epoca || b->ate_destino[vizinho] == DBL_MAX) continue;
+            if (atual == desvio) {
+                size_t p = 0;
+                while (p < num_proibidos && proibidos[p] != k) p++;
+                if (p < num_proibidos) continue;
+            }
+            double nova = e->distancias[atual] + peso_arco(b, k);
+            if (e->marca[vizinho] != epoca || nova < e->distancias[vizinho]) {
+                e->marca[vizinho] = epoca;
+                e->distancias[vizinho] = nova;
+                e->predecessores[vizinho] = k;
+                inserir_fila_prioridade(e->fila, (long)vizinho, nova + b->ate_destino[vizinho]);
+            }
+        }
+    }
+    return 0;
+}
+
+// Raiz (primeiros tamanho_raiz arcos de base) seguida do desvio encontrado
+// pela última busca. Retorna 0 ou -1.
+static int montar_candidato(const Busca *b, const Caminho *base, size_t tamanho_raiz, double custo_raiz,
+                            size_t desvio, Caminho *candidato) {
+    const EspacoBusca *e = b->espaco;
+    size_t num_desvio = 0;
+    for (size_t v = b->destino; v != desvio; v = b->origem_arco[e->predecessores[v]]) num_desvio++;
+
+    candidato->num_arcos = tamanho_raiz + num_desvio;
+    candidato->arcos = malloc((candidato->num_arcos ? candidato->num_arcos : 1) * sizeof(size_t));
+    if (!candidato->arcos) return -1;
+    if (tamanho_raiz) memcpy(candidato->arcos, base->arcos, tamanho_raiz * sizeof(size_t));
+    size_t posicao = candidato->num_arcos;
+    for (size_t v = b->destino; v != desvio; v = b->origem_arco[e->predecessores[v]]) {
+        candidato->arcos[--posicao] = e->predecessores[v];
+    }
+    candidato->custo = custo_raiz + e->distancias[b->destino];
+    candidato->desvio = tamanho_raiz;
+    return 0;
+}
+
+static int mesmo_caminho(const Caminho *a, const Caminho *b) {
+    return a->num_arcos == b->num_arcos && memcmp(a->arcos, b->arcos, a->num_arcos * sizeof(size_t)) == 0;
+}
+
+static int comparar_arcos(const void *a, const void *b) {
+    size_t x = *(const size_t *)a, y = *(const size_t *)b;
+    return (x > y) - (x < y);
+}
+
+// Fração do custo do caminho em arcos do conjunto (vetor ordenado)
+static double fracao_compartilhada(const Busca *b, const Caminho *caminho, const size_t *ordenados, size_t num) {
+    if (caminho->custo <= 0.0) return 1.0;
+    double compartilhado = 0.0;
+    for (size_t i = 0; i < caminho->num_arcos; i++) {
+        if (bsearch(&caminho->arcos[i], ordenados, num, sizeof(size_t), comparar_arcos)) {
+            compartilhado += peso_arco(b, caminho->arcos[i]);
+        }
+    }
+    return compartilhado / caminho->custo;
+}
+
+void liberar_alternativas(Alternativas *alternativas) {
+    if (alternativas) {
+        for (size_t i = 0; i < alternativas->num_rotas; i++) {
+            liberar_resultado_dijkstra(alternativas->rotas[i].caminho);
+        }
+        free(alternativas->rotas);
+        free(alternativas);
+    }
+}
+
+// Rotas aceitas até aqui e a contabilidade de tempo e pontos por rota
+typedef struct {
+    Alternativas *alt;
+    size_t origem;
+    double max_sobreposicao;
+    size_t **ordenados;          // Arcos de cada rota aceita, ordenados
+    double tempo_anterior;
+    size_t estabelecidos_anterior;
+} Aceite;
+
+// Aceita o caminho se ele não compartilhar mais que o limite com nenhuma
+// rota já aceita (nem for uma delas). Retorna 1 se aceitou, 0 se não, -1 em erro.
+static int avaliar_caminho(Aceite *a, const Busca *b, const Caminho *caminho) {
+    Alternativas *alt = a->alt;
+    for (size_t r = 0; r < alt->num_rotas; r++) {
+        size_t num = (size_t)alt->rotas[r].caminho->tamanho_caminho - 1;
+        if (a->max_sobreposicao < 1.0 &&
+            fracao_compartilhada(b, caminho, a->ordenados[r], num) > a->max_sobreposicao) {
+            return 0;
+        }
+        if (num == caminho->num_arcos) {
+            const ResultadoDijkstra *c = alt->rotas[r].caminho;
+            int igual = 1;
+            for (size_t i = 0; igual && i < num; i++) {
+                igual = c->caminho[i + 1] == b->grafo->pontos[b->indices->arcos[caminho->arcos[i]].destino].id;
+            }
+            if (igual) return 0;
+        }
+    }
+
+    size_t r = alt->num_rotas;
+    a->ordenados[r] = malloc((caminho->num_arcos ? caminho->num_arcos : 1) * sizeof(size_t));
+    ResultadoDijkstra *resultado = a->ordenados[r] ? calloc(1, sizeof(ResultadoDijkstra)) : NULL;
+    if (resultado) {
+        resultado->tamanho_caminho = (int)caminho->num_arcos + 1;
+        resultado->caminho = malloc((size_t)resultado->tamanho_caminho * sizeof(long));
+    }
+    if (!resultado || !resultado->caminho) {
+        free(resultado);
+        return -1;
+    }
+    resultado->caminho[0] = b->grafo->pontos[a->origem].id;
+    for (size_t i = 0; i < caminho->num_arcos; i++) {
+        resultado->caminho[i + 1] = b->grafo->pontos[b->indices->arcos[caminho->arcos[i]].destino].id;
+    }
+    resultado->distancia_total = caminho->custo;
+    resultado->sucesso = 1;
+    resultado->nos_visitados = (int)(b->estabelecidos - a->estabelecidos_anterior);
+
+    if (caminho->num_arcos) memcpy(a->ordenados[r], caminho->arcos, caminho->num_arcos * sizeof(size_t));
+    qsort(a->ordenados[r], caminho->num_arcos, sizeof(size_t), comparar_arcos);
+    double agora = agora_ms();
+    alt->rotas[r].caminho = resultado;
+    alt->rotas[r].sobreposicao = r == 0 ? 0.0 : fracao_compartilhada(b, caminho, a->ordenados[0],
+                                                                      (size_t)alt->rotas[0].caminho->tamanho_caminho - 1);
+    alt->rotas[r].tempo_ms = agora - a->tempo_anterior;
+    alt->num_rotas++;
+    a->tempo_anterior = agora;
+    a->estabelecidos_anterior = b->estabelecidos;
+    return 1;
+}
+
+static int comparar_rotas(const void *a, const void *b) {
+    double x = ((const RotaAlternativa *)a)->caminho->distancia_total;
+    double y = ((const RotaAlternativa *)b)->caminho->distancia_total;
+    return (x > y) - (x < y);
+}
+
+Alternativas* rotas_alternativas(Grafo *grafo, long origem_id, long destino_id, size_t k,
+                                 Metrica metrica, double max_sobreposicao) {
+    if (!grafo || (int)metrica < 0 || metrica >= NUM_METRICAS) return NULL;
+    const IndicesGrafo *indices = obter_indices(grafo);
+    ssize_t origem = buscar_indice_ponto(grafo, origem_id);
+    ssize_t destino = buscar_indice_ponto(grafo, destino_id);
+    if (!indices || origem < 0 || destino < 0) return NULL;
+
+    Busca b = {grafo, indices, NULL, NULL, NULL, NULL, (size_t)destino, 0};
+    if (metrica != METRICA_DISTANCIA && !(b.pesos = obter_pesos_metrica(grafo, metrica))) return NULL;
+    const double *pesos = b.pesos;
+
+    Aceite aceite = {NULL, (size_t)origem, max_sobreposicao, NULL, agora_ms(), 0};
+    Alternativas *alt = aceite.alt = calloc(1, sizeof(Alternativas));
+    b.origem_arco = malloc((indices->num_arcos ? indices->num_arcos : 1) * sizeof(size_t));
+    b.ate_destino = malloc((grafo->num_pontos ? grafo->num_pontos : 1) * sizeof(double));
+    b.espaco = criar_espaco_busca(grafo->num_pontos);
+    if (alt) alt->rotas = calloc(k ? k : 1, sizeof(RotaAlternativa));
+    aceite.ordenados = calloc(k ? k : 1, sizeof(size_t *));
+    ListaCaminhos examinados = {NULL, 0, 0};   // Lista A de Yen
+    ListaCaminhos candidatos = {NULL, 0, 0};   // Lista B de Yen
+    size_t *nos = NULL, *proibidos = NULL;
+    double *penalizados = NULL;
+    int ok = alt && alt->rotas && b.origem_arco && b.ate_destino && b.espaco && aceite.ordenados;
+    if (b.espaco) b.espaco->metrica = metrica;
+    if (ok) ok = buscar_reverso(&b) == 0;
+
+    // Caminho mais curto: o próprio A* desde a origem, sem bloqueios
+    Caminho vazio = {NULL, 0, 0.0, 0}, primeiro;
+    if (ok && k > 0 && buscar_desvio(&b, (size_t)origem, NULL, 0, NULL, 0)) {
+        ok = montar_candidato(&b, &vazio, 0, 0.0, (size_t)origem, &primeiro) == 0;
+        if (ok && acrescentar_caminho(&examinados, primeiro) != 0) {
+            free(primeiro.arcos);
+            ok = 0;
+        }
+    }
+
+    size_t max_examinados = k * MAX_EXAMINADOS_POR_ROTA;
+    while (ok && examinados.num > 0) {
+        // Aceitar (ou descartar) o caminho que acabou de ser examinado
+        alt->caminhos_examinados++;
+        if (avaliar_caminho(&aceite, &b, &examinados.itens[examinados.num - 1]) < 0) {
+            ok = 0;
+            break;
+        }
+        if (alt->num_rotas >= k || examinados.num >= max_examinados) break;
+
+        // Desvios do último caminho, a partir do ponto onde ele se desviou
+        const Caminho *base = &examinados.itens[examinados.num - 1];
+        size_t *mais_nos = realloc(nos, (base->num_arcos + 1) * sizeof(size_t));
+        size_t *mais_proibidos = realloc(proibidos, examinados.num * sizeof(size_t));
+        if (mais_nos) nos = mais_nos;
+        if (mais_proibidos) proibidos = mais_proibidos;
+        if (!mais_nos || !mais_proibidos) {
+            ok = 0;
+            break;
+        }
+        nos[0] = (size_t)origem;
+        double custo_raiz = 0.0;
+        for (size_t i = 0; i < base->num_arcos; i++) {
+            nos[i + 1] = indices->arcos[base->arcos[i]].destino;
+            if (i < base->desvio) custo_raiz += peso_arco(&b, base->arcos[i]);
+        }
+        for (size_t i = base->desvio; ok && i < base->num_arcos; i++) {
+            // Caminhos já examinados com a mesma raiz não podem repetir o próximo arco
+            size_t num_proibidos = 0;
+            for (size_t q = 0; q < examinados.num; q++) {
+                const Caminho *outro = &examinados.itens[q];
+                if (outro->num_arcos > i && memcmp(outro->arcos, base->arcos, i * sizeof(size_t)) == 0) {
+                    proibidos[num_proibidos++] = outro->arcos[i];
+                }
+            }
+            alt->buscas_desvio++;
+            if (buscar_desvio(&b, nos[i], nos, i, proibidos, num_proibidos)) {
+                Caminho candidato;
+                ok = montar_candidato(&b, base, i, custo_raiz, nos[i], &candidato) == 0;
+                if (!ok) break;
+                int repetido = 0;
+                for (size_t c = 0; c < candidatos.num && !repetido; c++) {
+                    repetido = mesmo_caminho(&candidatos.itens[c], &candidato);
+                }
+                if (repetido || acrescentar_caminho(&candidatos, candidato) != 0) free(candidato.arcos);
+            }
+            custo_raiz += peso_arco(&b, base->arcos[i]);
+        }
+        if (!ok || candidatos.num == 0) break;
+
+        // O candidato mais barato (com menos arcos no empate) é o próximo examinado
+        size_t melhor = 0;
+        for (size_t c = 1; c < candidatos.num; c++) {
+            const Caminho *x = &candidatos.itens[c], *y = &candidatos.itens[melhor];
+            if (x->custo < y->custo || (x->custo == y->custo && x->num_arcos < y->num_arcos)) melhor = c;
+        }
+        Caminho escolhido = candidatos.itens[melhor];
+        candidatos.itens[melhor] = candidatos.itens[--candidatos.num];
+        if (acrescentar_caminho(&examinados, escolhido) != 0) {
+            free(escolhido.arcos);
+            ok = 0;
+        }
+    }
+
+    // Os caminhos seguintes de Yen só diferem da melhor rota em trechos
+    // curtos (comum em malhas densas): penalizar os arcos dos caminhos já
+    // encontrados e repetir o A* desde a origem. A heurística continua
+    // admissível, pois os pesos só aumentam; o custo da rota é o real.
+    if (ok && alt->num_rotas > 0 && alt->num_rotas < k) {
+        penalizados = malloc((indices->num_arcos ? indices->num_arcos : 1) * sizeof(double));
+        ok = penalizados != NULL;
+        for (size_t c = 0; ok && c < indices->num_arcos; c++) penalizados[c] = peso_arco(&b, c);
+        for (size_t r = 0; ok && r < alt->num_rotas; r++) {
+            size_t num = (size_t)alt->rotas[r].caminho->tamanho_caminho - 1;
+            for (size_t i = 0; i < num; i++) penalizados[aceite.ordenados[r][i]] *= FATOR_PENALIDADE;
+        }
+        size_t aceitas_yen = alt->num_rotas;
+        for (size_t t = 0; ok && alt->num_rotas < k && t < k * MAX_PENALIDADES_POR_ROTA; t++) {
+            b.pesos = penalizados;
+            alt->buscas_penalidade++;
+            int achou = buscar_desvio(&b, (size_t)origem, NULL, 0, NULL, 0);
+            b.pesos = pesos;
+            if (!achou) break;
+            Caminho caminho;
+            ok = montar_candidato(&b, &vazio, 0, 0.0, (size_t)origem, &caminho) == 0;
+            if (!ok) break;
+            caminho.custo = 0.0;
+            for (size_t i = 0; i < caminho.num_arcos; i++) caminho.custo += peso_arco(&b, caminho.arcos[i]);
+            ok = avaliar_caminho(&aceite, &b, &caminho) >= 0;
+            for (size_t i = 0; i < caminho.num_arcos; i++) penalizados[caminho.arcos[i]] *= FATOR_PENALIDADE;
+            free(caminho.arcos);
+        }
+        // Nenhuma rota por penalidade é mais barata que as de Yen (que
+        // enumerou tudo até o custo do último caminho examinado)
+        if (ok && alt->num_rotas > aceitas_yen) {
+            qsort(alt->rotas + aceitas_yen, alt->num_rotas - aceitas_yen, sizeof(RotaAlternativa), comparar_rotas);
+        }
+    }
+    if (alt) alt->pontos_estabelecidos = b.estabelecidos;
+
+    if (aceite.ordenados) {
+        for (size_t r = 0; r < k; r++) free(aceite.ordenados[r]);
+        free(aceite.ordenados);
+    }
+    free(penalizados);
+    liberar_lista(&examinados);
+    liberar_lista(&candidatos);
+    free(nos);
+    free(proibidos);
+    free(b.origem_arco);
+    free(b.ate_destino);
+    liberar_espaco_busca(b.espaco);
+    if (!ok) {
+        liberar_alternativas(alt);
+        return NULL;
+    }
+    return alt;
+}
@@ -0,0 +1,65 @@
+#include "arena.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdalign.h>
+
+#define TAMANHO_BLOCO_PADRAO (64 * 1024)
+
+struct BlocoArena {
+    BlocoArena *anterior;
+    size_t capacidade;
+    size_t usado;
+    alignas(max_align_t) unsigned char dados[];
+};
+
+Arena* arena_criar(size_t tamanho_bloco) {
+    Arena *arena = malloc(sizeof(Arena));
+    if (!arena) return NULL;
+    arena->blocos = NULL;
+    arena->tamanho_bloco = tamanho_bloco ? tamanho_bloco : TAMANHO_BLOCO_PADRAO;
+    arena->total_alocado = 0;
+    return arena;
+}
+
+void* arena_alocar(Arena *arena, size_t bytes) {
+    if (!arena) return NULL;
+    if (bytes == 0) bytes = 1;
+
+    // Arredondar para manter o alinhamento da próxima alocação
+    size_t alinhamento = alignof(max_align_t);
+    bytes = (bytes + alinhamento - 1) & ~(alinhamento - 1);
+
+    BlocoArena *bloco = arena->blocos;
+    if (!bloco || bloco->capacidade - bloco->usado < bytes) {
+        // Pedidos maiores que o bloco padrão ganham um bloco do tamanho exato
+        size_t capacidade = bytes > arena->tamanho_bloco ? bytes : arena->tamanho_bloco;
+        bloco = malloc(sizeof(BlocoArena) + capacidade);
+        if (!bloco) return NULL;
+        bloco->anterior = arena->blocos;
+        bloco->capacidade = capacidade;
+        bloco->usado = 0;
+        arena->blocos = bloco;
+    }
+
+    void *memoria = bloco->dados + bloco->usado;
+    bloco->usado += bytes;
+    arena->total_alocado += bytes;
+    return memoria;
+}
+
+void* arena_alocar_zerado(Arena *arena, size_t bytes) {
+    void *memoria = arena_alocar(arena, bytes);
+    if (memoria) memset(memoria, 0, bytes);
+    return memoria;
+}
+
+void arena_liberar(Arena *arena) {
+    if (!arena) return;
+    BlocoArena *bloco = arena->blocos;
+    while (bloco) {
+        BlocoArena *anterior = bloco->anterior;
+        free(bloco);
+        bloco = anterior;
+    }
+    free(arena);
+}
@@ -0,0 +1,197 @@
+#include "batch_query.h"
+#include "graph.h"
+#include "components.h"
+#include "distance_matrix.h"
+#include "metrics.h"
+#include "timing.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <unistd.h>
+
+// Fatia [inicio, fim) de um trabalhador, empacotada em 64 bits para que
+// dono e ladrões a alterem com uma única troca atômica. Uma linha de cache
+// por fatia evita falso compartilhamento entre os trabalhadores.
+typedef struct {
+    _Atomic uint64_t intervalo;
+    char preenchimento[64 - sizeof(uint64_t)];
+} FatiaTrabalho;
+
+static inline uint64_t empacotar(uint32_t inicio, uint32_t fim) {
+    return ((uint64_t)inicio << 32) | fim;
+}
+
+// O dono consome pela frente
+static int pegar_proxima(FatiaTrabalho *fatia, size_t *indice) {
+    uint64_t atual = atomic_load(&fatia->intervalo);
+    for (;;) {
+        uint32_t inicio = (uint32_t)(atual >> 32), fim = (uint32_t)atual;
+        if (inicio >= fim) return 0;
+        if (atomic_compare_exchange_weak(&fatia->intervalo, &atual, empacotar(inicio + 1, fim))) {
+            *indice = inicio;
+            return 1;
+        }
+    }
+}
+
+// O ladrão leva a metade de trás (arredondada para cima)
+static int roubar_metade(FatiaTrabalho *vitima, uint32_t *inicio_roubado, uint32_t *fim_roubado) {
+    uint64_t atual = atomic_load(&vitima->intervalo);
+    for (;;) {
+        uint32_t inicio = (uint32_t)(atual >> 32), fim = (uint32_t)atual;
+        if (inicio >= fim) return 0;
+        uint32_t corte = fim - (fim - inicio + 1) / 2;
+        if (atomic_compare_exchange_weak(&vitima->intervalo, &atual, empacotar(inicio, corte))) {
+            *inicio_roubado = corte;
+            *fim_roubado = fim;
+            return 1;
+        }
+    }
+}
+
+typedef struct {
+    Grafo *grafo;
+    const ParConsulta *pares;
+    Metrica metrica;
+    ResultadoLote *lote;
+    FatiaTrabalho *fatias;
+    int num_trabalhadores;
+    atomic_size_t roubos;
+    atomic_int erro;
+} EstadoLote;
+
+typedef struct {
+    EstadoLote *estado;
+    int id;
+} ArgumentoLote;
+
+static void* trabalhar_lote(void *arg) {
+    ArgumentoLote *a = arg;
+    EstadoLote *e = a->estado;
+    FatiaTrabalho *propria = &e->fatias[a->id];
+    EspacoBusca *espaco = criar_espaco_busca(e->grafo->num_pontos);
+    if (!espaco) {
+        // Sem espaço próprio, a fatia fica para os ladrões
+        atomic_store(&e->erro, 1);
+        return NULL;
+    }
+    espaco->metrica = e->metrica;
+
+    for (;;) {
+        size_t indice;
+        while (pegar_proxima(propria, &indice)) {
+            ResultadoConsulta *c = &e->lote->consultas[indice];
+            double inicio = agora_ms();
+            c->resultado = dijkstra_com_espaco(e->grafo, espaco, e->pares[indice].origem, e->pares[indice].destino);
+            c->tempo_ms = agora_ms() - inicio;
+            c->trabalhador = a->id;
+        }
+
+        // Fatia vazia: procurar trabalho nos outros, a partir do vizinho
+        int roubou = 0;
+        for (int passo = 1; passo < e->num_trabalhadores && !roubou; passo++) {
+            FatiaTrabalho *vitima = &e->fatias[(a->id + passo) % e->num_trabalhadores];
+            uint32_t inicio, fim;
+            if (roubar_metade(vitima, &inicio, &fim)) {
+                // Ninguém mais insere na própria fatia, que está vazia
+                atomic_store(&propria->intervalo, empacotar(inicio, fim));
+                atomic_fetch_add(&e->roubos, 1);
+                roubou = 1;
+            }
+        }
+        // Trabalho nunca é criado, só movido: sem nada para roubar, acabou
+        if (!roubou) break;
+    }
+    liberar_espaco_busca(espaco);
+    return NULL;
+}
+
+void liberar_resultado_lote(ResultadoLote *lote) {
+    if (lote) {
+        for (size_t i = 0; lote->consultas && i < lote->num_consultas; i++) {
+            liberar_resultado_dijkstra(lote->consultas[i].resultado);
+        }
+        free(lote->consultas);
+        free(lote);
+    }
+}
+
+ResultadoLote* executar_lote(Grafo *grafo, const ParConsulta *pares, size_t num_pares, int num_threads) {
+    return executar_lote_metrica(grafo, pares, num_pares, METRICA_DISTANCIA, num_threads);
+}
+
+ResultadoLote* executar_lote_metrica(Grafo *grafo, const ParConsulta *pares, size_t num_pares,
+                                     Metrica metrica, int num_threads) {
+    if (!grafo || (num_pares && !pares) || num_pares >= UINT32_MAX) return NULL;
+
+    // Tudo o que as consultas leem é construído antes das threads
+    if (!obter_componentes(grafo) && !obter_indices(grafo)) return NULL;
+    if (metrica != METRICA_DISTANCIA && !obter_pesos_metrica(grafo, metrica)) return NULL;
+
+    if (num_threads <= 0) {
+        long processadores = sysconf(_SC_NPROCESSORS_ONLN);
+        num_threads = processadores > 0 ? (int)processadores : 1;
+    }
+    if ((size_t)num_threads > num_pares) num_threads = num_pares ? (int)num_pares : 1;
+
+    ResultadoLote *lote = calloc(1, sizeof(ResultadoLote));
+    FatiaTrabalho *fatias = aligned_alloc(64, (size_t)num_threads * sizeof(FatiaTrabalho));
+    pthread_t *threads = calloc((size_t)num_threads, sizeof(pthread_t));
+    ArgumentoLote *argumentos = calloc((size_t)num_threads, sizeof(ArgumentoLote));
+    if (lote) lote->consultas = calloc(num_pares ? num_pares : 1, sizeof(ResultadoConsulta));
+    if (!lote || !lote->consultas || !fatias || !threads || !argumentos) {
+        liberar_resultado_lote(lote);
+        lote = NULL;
+        goto fim;
+    }
+    lote->num_consultas = num_pares;
+
+    EstadoLote estado = {
+        .grafo = grafo, .pares = pares, .metrica = metrica, .lote = lote,
+        .fatias = fatias, .num_trabalhadores = num_threads
+    };
+    atomic_init(&estado.roubos, 0);
+    atomic_init(&estado.erro, 0);
+    for (int t = 0; t < num_threads; t++) {
+        uint32_t inicio = (uint32_t)(num_pares * t / num_threads);
+        uint32_t fim = (uint32_t)(num_pares * (t + 1) / num_threads);
+        atomic_init(&fatias[t].intervalo, empacotar(inicio, fim));
+    }
+
+    double inicio = agora_ms();
+    int criadas = 1;
+    for (int t = 1; t < num_threads; t++) {
+        argumentos[t] = (ArgumentoLote){&estado, t};
+        // Se a thread não existir, a fatia dela é roubada pelas outras
+        if (pthread_create(&threads[t], NULL, trabalhar_lote, &argumentos[t]) != 0) break;
+        criadas++;
+    }
+    argumentos[0] = (ArgumentoLote){&estado, 0};
+    trabalhar_lote(&argumentos[0]);
+    for (int t = 1; t < criadas; t++) pthread_join(threads[t], NULL);
+    lote->tempo_total_ms = agora_ms() - inicio;
+    lote->num_threads = criadas;
+    lote->roubos = atomic_load(&estado.roubos);
+
+    // Um trabalhador sem espaço de busca pode ter deixado consultas sem
+    // ninguém para roubá-las (se todos falharam)
+    if (atomic_load(&estado.erro)) {
+        for (int t = 0; t < num_threads; t++) {
+            uint64_t resto = atomic_load(&fatias[t].intervalo);
+            if ((uint32_t)(resto >> 32) < (uint32_t)resto) {
+                liberar_resultado_lote(lote);
+                lote = NULL;
+                break;
+            }
+        }
+    }
+
+fim:
+    free(fatias);
+    free(threads);
+    free(argumentos);
+    return lote;
+}
@@ -2,8 +2,24 @@
 #include "ui_helpers.h"
 #include "drawing.h"
 #include "dijkstra.h"
+#include "metrics.h"
+#include "waypoints.h"
+#include "tour.h"
+#include "alternatives.h"
+#include "map_matching.h"
+#include "snapping.h"
+#include "reorder.h"
 #include <string.h>
 #include <stdlib.h>
+#include <math.h>
+
+// Orçamento de tempo da melhoria da ordem das paradas (sem contar a matriz)
+#define TOUR_TIME_BUDGET_MS 200.0
+
+// Rotas alternativas: quantas pedir e quanto do custo da mais curta cada uma
+// pode repetir
+#define ALTERNATIVE_ROUTES 3
+#define ALTERNATIVE_MAX_OVERLAP 0.8
 
 // Callback para abrir arquivo OSM
 void on_open_osm_clicked(GtkMenuItem *menuitem, gpointer user_data) {
@@ -30,6 +46,8 @@ void on_open_osm_clicked(GtkMenuItem *menuitem, gpointer user_data) {
         update_status(app, "Loading OSM file...");
         
         // Liberar grafo anterior se existir
+        invalidate_routing_data(app);
+        discard_spatial_index(app);
         if (app->grafo) {
             liberar_grafo(app->grafo);
         }
@@ -38,6 +56,11 @@ void on_open_osm_clicked(GtkMenuItem *menuitem, gpointer user_data) {
         app->grafo = ler_osm(filename);
         
         if (app->grafo) {
+            // Renumerar pontos pela curva de Hilbert para melhorar a localidade de cache
+            if (app->reorder_on_load) {
+                reordenar_hilbert(app->grafo);
+            }
+            
             g_free(app->current_file);
             app->current_file = g_strdup(filename);
             
@@ -46,6 +69,9 @@ void on_open_osm_clicked(GtkMenuItem *menuitem, gpointer user_data) {
             app->has_end_point = FALSE;
             app->selected_start_id = 0;
             app->selected_end_id = 0;
+            app->num_waypoints = 0;
+            liberar_alternativas(app->alternatives);
+            app->alternatives = NULL;
             
             // Clear shortest path when loading new file
             if (app->shortest_path) {
@@ -63,6 +89,16 @@ void on_open_osm_clicked(GtkMenuItem *menuitem, gpointer user_data) {
             // Update edit state with proper node IDs
             update_node_ids(&app->edit_state, app->grafo);
             
+            // Componentes conexas: consultas entre componentes diferentes são
+            // rejeitadas sem busca
+            obter_componentes(app->grafo);
+            
+            // Pré-processar o grafo de roteamento (só a poda de becos sem saída)
+            get_routing_core(app);
+            
+            // Índice espacial para cliques e desenho (mantido pelas edições)
+            get_spatial_index(app);
+            
             update_file_info(app);
             update_status(app, "OSM file loaded successfully. Hold Ctrl and click points to select them.");
             
@@ -92,6 +128,146 @@ void on_load_osm_clicked(GtkToolButton *toolbutton, gpointer user_data) {
     on_open_osm_clicked(NULL, user_data);
 }
 
+// Callback para casar trajetos GPS com as vias: os trajetos do arquivo são
+// casados em paralelo e os caminhos resultantes, concatenados, tomam o lugar
+// do caminho mais curto no desenho
+void on_match_traces_clicked(GtkMenuItem *menuitem, gpointer user_data) {
+    (void)menuitem; // Suppress unused parameter warning
+    AppData *app = (AppData *)user_data;
+    
+    if (!app->grafo) {
+        update_status(app, "No graph loaded");
+        return;
+    }
+    
+    GtkWidget *dialog = gtk_file_chooser_dialog_new("Open GPX File",
+                                                   GTK_WINDOW(app->window),
+                                                   GTK_FILE_CHOOSER_ACTION_OPEN,
+                                                   "_Cancel", GTK_RESPONSE_CANCEL,
+                                                   "_Open", GTK_RESPONSE_ACCEPT,
+                                                   NULL);
+    GtkFileFilter *filter = gtk_file_filter_new();
+    gtk_file_filter_set_name(filter, "GPX files");
+    gtk_file_filter_add_pattern(filter, "*.gpx");
+    gtk_file_chooser_add_filter(GTK_FILE_CHOOSER(dialog), filter);
+    
+    char *filename = NULL;
+    if (gtk_dialog_run(GTK_DIALOG(dialog)) == GTK_RESPONSE_ACCEPT) {
+        filename = gtk_file_chooser_get_filename(GTK_FILE_CHOOSER(dialog));
+    }
+    gtk_widget_destroy(dialog);
+    if (!filename) return;
+    
+    update_status(app, "Matching GPS traces...");
+    ConjuntoTrajetos *conjunto = ler_trajetos_gpx(filename);
+    CombinadorMapa *combinador = conjunto ? criar_combinador_mapa(app->grafo, NULL) : NULL;
+    ResultadoCombinacao **resultados = combinador ? combinar_trajetos(combinador, conjunto, 0) : NULL;
+    g_free(filename);
+    if (!resultados) {
+        update_status(app, conjunto ? "Error matching GPS traces" : "Error reading GPX file");
+        liberar_combinador_mapa(combinador);
+        liberar_conjunto_trajetos(conjunto);
+        return;
+    }
+    
+    // Caminhos de todos os trajetos em sequência: entre o fim de um trecho e
+    // o início do seguinte não há aresta, então nada é desenhado ali
+    size_t total = 0, leituras = 0, nao_casadas = 0, trechos = 0, buscas = 0, acertos = 0;
+    double tempo_ms = 0.0;
+    for (size_t t = 0; t < conjunto->num_trajetos; t++) {
+        total += resultados[t]->tamanho_caminho;
+        leituras += resultados[t]->num_pontos;
+        nao_casadas += resultados[t]->num_nao_casados;
+        trechos += resultados[t]->num_trechos;
+        buscas += resultados[t]->buscas;
+        acertos += resultados[t]->acertos_cache;
+        tempo_ms += resultados[t]->tempo_ms;
+    }
+    free(app->shortest_path);
+    app->shortest_path = total ? malloc(total * sizeof(long)) : NULL;
+    app->shortest_path_length = 0;
+    for (size_t t = 0; app->shortest_path && t < conjunto->num_trajetos; t++) {
+        for (size_t i = 0; i < resultados[t]->tamanho_caminho; i++) {
+            app->shortest_path[app->shortest_path_length++] = resultados[t]->caminho[i];
+        }
+    }
+    app->has_shortest_path = app->shortest_path_length > 1;
+    app->snapped_route = FALSE;
+    liberar_alternativas(app->alternatives);
+    app->alternatives = NULL;
+    
+    GString *text = g_string_new("GPS Traces Matched!\n\n");
+    g_string_append_printf(text, "Traces: %zu\n  Fixes: %zu (%zu unmatched)\n  Matched pieces: %zu\n",
+                           conjunto->num_trajetos, leituras, nao_casadas, trechos);
+    g_string_append_printf(text, "  Matching time: %.1f ms (%.0f fixes/s per thread)\n",
+                           tempo_ms, tempo_ms > 0.0 ? leituras / (tempo_ms / 1000.0) : 0.0);
+    g_string_append_printf(text, "  Bounded searches: %zu (%zu answered from cache)\n", buscas, acertos);
+    for (size_t t = 0; t < conjunto->num_trajetos; t++) {
+        g_string_append_printf(text, "  Trace %zu: %zu fixes, %zu points, %zu pieces\n", t + 1,
+                               resultados[t]->num_pontos, resultados[t]->tamanho_caminho,
+                               resultados[t]->num_trechos);
+    }
+    GtkTextBuffer *buffer = gtk_text_view_get_buffer(GTK_TEXT_VIEW(app->results_text));
+    gtk_text_buffer_set_text(buffer, text->str, -1);
+    g_string_free(text, TRUE);
+    update_status(app, "GPS traces matched");
+    gtk_widget_queue_draw(app->graph_area);
+    
+    liberar_resultados_combinacao(resultados, conjunto->num_trajetos);
+    liberar_combinador_mapa(combinador);
+    liberar_conjunto_trajetos(conjunto);
+}
+
+// Rota com início e/ou fim projetados no meio de uma via: a ponta que é um
+// ponto do grafo é projetada sobre ele mesmo e as arestas são divididas nas
+// projeções. Preenche as projeções usadas; NULL se alguma não existir.
+static ResultadoDijkstra* find_snapped_path(AppData *app, long start_id, long end_id, Metrica metrica,
+                                            ProjecaoAresta *from, ProjecaoAresta *to) {
+    IndiceEspacial *indice = get_spatial_index(app);
+    if (!indice) return NULL;
+    
+    if (app->start_snapped && start_id == app->selected_start_id) {
+        *from = app->start_snap;
+    } else if (projecao_no_ponto(indice, start_id, from) != 0) {
+        return NULL;
+    }
+    if (app->end_snapped && end_id == app->selected_end_id) {
+        *to = app->end_snap;
+    } else if (projecao_no_ponto(indice, end_id, to) != 0) {
+        return NULL;
+    }
+    
+    EspacoBusca *espaco = criar_espaco_busca(app->grafo->num_pontos);
+    if (!espaco) return NULL;
+    espaco->metrica = metrica;
+    ResultadoDijkstra *resultado = dijkstra_projecoes(app->grafo, espaco, from, to);
+    liberar_espaco_busca(espaco);
+    return resultado;
+}
+
+// Custos em todas as métricas de uma rota entre projeções: as arestas entre
+// os pontos do caminho mais os pedaços de aresta das duas pontas
+static int snapped_path_costs(Grafo *grafo, const ResultadoDijkstra *resultado, const ProjecaoAresta *from,
+                              const ProjecaoAresta *to, Metrica metrica, double custos[NUM_METRICAS]) {
+    double from_part, to_part;
+    if (resultado->tamanho_caminho == 0) {
+        // Trecho direto dentro de uma aresta
+        for (int m = 0; m < NUM_METRICAS; ++m) custos[m] = 0.0;
+        from_part = fabs(to->fracao - from->fracao);
+        to_part = 0.0;
+    } else {
+        if (metricas_caminho(grafo, resultado->caminho, resultado->tamanho_caminho, metrica, custos) != 0) return -1;
+        long first = resultado->caminho[0], last = resultado->caminho[resultado->tamanho_caminho - 1];
+        from_part = first == grafo->arestas[from->aresta].destino ? 1.0 - from->fracao : from->fracao;
+        to_part = last == grafo->arestas[to->aresta].origem ? to->fracao : 1.0 - to->fracao;
+    }
+    for (int m = 0; m < NUM_METRICAS; ++m) {
+        custos[m] += from_part * custo_aresta(grafo, from->aresta, (Metrica)m) +
+                     to_part * custo_aresta(grafo, to->aresta, (Metrica)m);
+    }
+    return 0;
+}
+
 // Callback para encontrar caminho mais curto
 void on_find_path_clicked(GtkButton *button, gpointer user_data) {
     (void)button; // Suppress unused parameter warning
@@ -131,8 +307,50 @@ void on_find_path_clicked(GtkButton *button, gpointer user_data) {
     
     update_status(app, "Calculating shortest path...");
     
-    // Executar algoritmo de Dijkstra
-    ResultadoDijkstra *resultado = dijkstra(app->grafo, start_id, end_id);
+    // Métrica escolhida no painel (a ordem dos itens segue o enum Metrica)
+    Metrica metrica = get_selected_metric(app);
+    
+    // Por distância, executar o Dijkstra sobre o núcleo de roteamento (o
+    // caminho retornado já vem desempacotado com todos os pontos originais);
+    // com a mesma origem da consulta anterior, a busca é retomada de onde
+    // parou. O núcleo só guarda distâncias: as outras métricas usam o grafo.
+    // Com paradas intermediárias, os trechos rodam em paralelo no grafo e o
+    // resultado concatenado toma o lugar do caminho único. Sem paradas e com
+    // alternativas ativadas, elas são calculadas à parte no grafo completo.
+    // Início ou fim clicados no meio de uma via (sem paradas) dividem as
+    // arestas nas projeções.
+    liberar_alternativas(app->alternatives);
+    app->alternatives = NULL;
+    RotaParadas *rota = NULL;
+    ResultadoDijkstra *resultado = NULL;
+    ProjecaoAresta snap_from, snap_to;
+    gboolean snapped = app->num_waypoints == 0 &&
+                       ((app->start_snapped && start_id == app->selected_start_id) ||
+                        (app->end_snapped && end_id == app->selected_end_id));
+    if (snapped) {
+        resultado = find_snapped_path(app, start_id, end_id, metrica, &snap_from, &snap_to);
+    } else if (app->num_waypoints > 0) {
+        long *paradas = malloc((app->num_waypoints + 2) * sizeof(long));
+        if (paradas) {
+            paradas[0] = start_id;
+            for (size_t i = 0; i < app->num_waypoints; i++) paradas[i + 1] = app->waypoint_ids[i];
+            paradas[app->num_waypoints + 1] = end_id;
+            rota = rota_por_paradas(app->grafo, paradas, app->num_waypoints + 2, metrica, 0);
+            free(paradas);
+        }
+        if (rota) {
+            resultado = rota->rota;
+            rota->rota = NULL;
+        }
+    } else {
+        NucleoRoteamento *nucleo = metrica == METRICA_DISTANCIA ? get_routing_core(app) : NULL;
+        resultado = nucleo ? dijkstra_nucleo_incremental(nucleo, &app->busca_incremental, start_id, end_id)
+                           : dijkstra_metrica(app->grafo, start_id, end_id, metrica);
+        if (app->show_alternatives && resultado && resultado->sucesso) {
+            app->alternatives = rotas_alternativas(app->grafo, start_id, end_id, ALTERNATIVE_ROUTES, metrica,
+                                                   ALTERNATIVE_MAX_OVERLAP);
+        }
+    }
     
     GtkTextBuffer *buffer = gtk_text_view_get_buffer(GTK_TEXT_VIEW(app->results_text));
     
@@ -143,9 +361,9 @@ void on_find_path_clicked(GtkButton *button, gpointer user_data) {
             app->shortest_path = NULL;
         }
         
-        // Armazenar o novo caminho mais curto
+        // Armazenar o novo caminho mais curto (entre projeções, pode não ter pontos)
         app->shortest_path_length = resultado->tamanho_caminho;
-        app->shortest_path = malloc(app->shortest_path_length * sizeof(long));
+        app->shortest_path = malloc((app->shortest_path_length ? app->shortest_path_length : 1) * sizeof(long));
         if (app->shortest_path) {
             for (int i = 0; i < resultado->tamanho_caminho; i++) {
                 app->shortest_path[i] = resultado->caminho[i];
@@ -155,14 +373,75 @@ void on_find_path_clicked(GtkButton *button, gpointer user_data) {
             app->has_shortest_path = FALSE;
             app->shortest_path_length = 0;
         }
+        app->snapped_route = snapped && app->has_shortest_path;
         
-        gchar *result_text = g_strdup_printf("Shortest Path Found!\n\nStart Point:\n  ID: %lld\n  Lat: %.6f\n  Lon: %.6f\n\nEnd Point:\n  ID: %lld\n  Lat: %.6f\n  Lon: %.6f\n\nPath Details:\n  Distance: %.2f km\n  Points in path: %d\n\nPath: ",
+        // Todas as métricas da rota escolhida, não só a minimizada
+        static const char *nomes_metricas[NUM_METRICAS] = {"shortest", "fastest", "custom"};
+        double custos[NUM_METRICAS];
+        int custos_erro = snapped ? snapped_path_costs(app->grafo, resultado, &snap_from, &snap_to, metrica, custos)
+                                  : metricas_caminho(app->grafo, resultado->caminho, resultado->tamanho_caminho,
+                                                     metrica, custos);
+        if (custos_erro != 0) {
+            custos[METRICA_DISTANCIA] = metrica == METRICA_DISTANCIA ? resultado->distancia_total : -1.0;
+            custos[METRICA_TEMPO] = custos[METRICA_PERSONALIZADA] = -1.0;
+        }
+        
+        gchar *result_text = g_strdup_printf("Shortest Path Found!\n\nStart Point:\n  ID: %lld\n  Lat: %.6f\n  Lon: %.6f\n\nEnd Point:\n  ID: %lld\n  Lat: %.6f\n  Lon: %.6f\n\nPath Details (%s route):\n  Distance: %.2f km\n  Travel time: %.1f min\n  Custom cost: %.1f min\n  Points in path: %d\n  Nodes settled: %d\n",
                                             start_point->id, start_point->lat, start_point->lon,
                                             end_point->id, end_point->lat, end_point->lon,
-                                            resultado->distancia_total, resultado->tamanho_caminho);
+                                            nomes_metricas[metrica], custos[METRICA_DISTANCIA],
+                                            custos[METRICA_TEMPO] / 60.0, custos[METRICA_PERSONALIZADA] / 60.0,
+                                            resultado->tamanho_caminho, resultado->nos_visitados);
         
-        // Adicionar pontos do caminho
         GString *path_str = g_string_new(result_text);
+        if (snapped) {
+            // Pontas no meio de uma via: posição na aresta dividida
+            const ProjecaoAresta *ends[2] = {&snap_from, &snap_to};
+            const char *names[2] = {"Start", "End"};
+            g_string_append(path_str, "  Edges split at the clicked road positions:\n");
+            for (int e = 0; e < 2; e++) {
+                const Aresta *aresta = &app->grafo->arestas[ends[e]->aresta];
+                g_string_append_printf(path_str, "  %s on road: %.6f, %.6f (%.0f%% of %lld -> %lld)\n", names[e],
+                                       ends[e]->lat, ends[e]->lon, ends[e]->fracao * 100.0,
+                                       aresta->origem, aresta->destino);
+            }
+        }
+        if (rota) {
+            // Custo de cada trecho na métrica minimizada (km ou min)
+            g_string_append_printf(path_str, "  Stops: %zu\n", rota->num_trechos + 1);
+            for (size_t t = 0; t < rota->num_trechos; t++) {
+                double custo = rota->custos_trechos[t];
+                g_string_append_printf(path_str, "  Leg %zu: %ld -> %ld (%.2f %s)\n", t + 1,
+                                       resultado->caminho[rota->inicio_trechos[t]],
+                                       t + 1 < rota->num_trechos ? resultado->caminho[rota->inicio_trechos[t + 1]]
+                                                                 : resultado->caminho[resultado->tamanho_caminho - 1],
+                                       metrica == METRICA_DISTANCIA ? custo : custo / 60.0,
+                                       metrica == METRICA_DISTANCIA ? "km" : "min");
+            }
+        }
+        
+        if (app->alternatives && app->alternatives->num_rotas > 1) {
+            // Custo na métrica minimizada, acréscimo sobre a mais curta e
+            // fração do custo em trechos compartilhados com ela
+            const Alternativas *alt = app->alternatives;
+            double melhor = alt->rotas[0].caminho->distancia_total;
+            double total_ms = 0.0;
+            for (size_t r = 0; r < alt->num_rotas; r++) total_ms += alt->rotas[r].tempo_ms;
+            g_string_append_printf(path_str, "\nAlternatives (%zu routes in %.1f ms):\n", alt->num_rotas, total_ms);
+            for (size_t r = 1; r < alt->num_rotas; r++) {
+                double custo = alt->rotas[r].caminho->distancia_total;
+                g_string_append_printf(path_str, "  Route %zu: %.2f %s (+%.0f%%), %.0f%% shared, %.1f ms\n", r + 1,
+                                       metrica == METRICA_DISTANCIA ? custo : custo / 60.0,
+                                       metrica == METRICA_DISTANCIA ? "km" : "min",
+                                       melhor > 0.0 ? (custo / melhor - 1.0) * 100.0 : 0.0,
+                                       alt->rotas[r].sobreposicao * 100.0, alt->rotas[r].tempo_ms);
+            }
+        } else if (app->show_alternatives && app->num_waypoints == 0) {
+            g_string_append(path_str, "\nAlternatives: none found\n");
+        }
+        
+        // Adicionar pontos do caminho
+        g_string_append(path_str, "\nPath: ");
         for (int i = 0; i < resultado->tamanho_caminho; i++) {
             if (i > 0) g_string_append(path_str, " -> ");
             g_string_append_printf(path_str, "%ld", resultado->caminho[i]);
@@ -179,6 +458,7 @@ void on_find_path_clicked(GtkButton *button, gpointer user_data) {
         gtk_widget_queue_draw(app->graph_area);
         
         liberar_resultado_dijkstra(resultado);
+        liberar_rota_paradas(rota);
     } else {
         // Limpar caminho anterior se não há caminho válido
         if (app->shortest_path) {
@@ -187,10 +467,17 @@ void on_find_path_clicked(GtkButton *button, gpointer user_data) {
         }
         app->has_shortest_path = FALSE;
         app->shortest_path_length = 0;
+        app->snapped_route = FALSE;
         
         gchar *error_msg = g_strdup_printf("No path found between points!\n\nStart Point:\n  ID: %lld\n  Lat: %.6f\n  Lon: %.6f\n\nEnd Point:\n  ID: %lld\n  Lat: %.6f\n  Lon: %.6f\n\nThe points may be in disconnected components of the graph.\n",
                                           start_point->id, start_point->lat, start_point->lon,
                                           end_point->id, end_point->lat, end_point->lon);
+        if (rota && rota->trecho_falho < rota->num_trechos) {
+            gchar *leg_msg = g_strdup_printf("%sNo path for leg %zu of %zu.\n", error_msg,
+                                             rota->trecho_falho + 1, rota->num_trechos);
+            g_free(error_msg);
+            error_msg = leg_msg;
+        }
         gtk_text_buffer_set_text(buffer, error_msg, -1);
         g_free(error_msg);
         update_status(app, "No path found");
@@ -201,9 +488,84 @@ void on_find_path_clicked(GtkButton *button, gpointer user_data) {
         if (resultado) {
             liberar_resultado_dijkstra(resultado);
         }
+        liberar_rota_paradas(rota);
     }
 }
 
+// Callback para otimizar a ordem das paradas: circuito a partir do início
+// passando por todas as paradas e pelo fim. As paradas são reordenadas, o
+// fim passa a ser o próprio início e a rota é traçada por on_find_path_clicked().
+void on_optimize_tour_clicked(GtkButton *button, gpointer user_data) {
+    (void)button; // Suppress unused parameter warning
+    AppData *app = (AppData *)user_data;
+    
+    if (!app->grafo) {
+        update_status(app, "No graph loaded");
+        return;
+    }
+    if (!app->has_start_point || !app->has_end_point || app->num_waypoints == 0) {
+        update_status(app, "Select start, end and at least one more stop (Ctrl+click) to optimize the visiting order");
+        return;
+    }
+    
+    // Início, paradas e fim, sem repetir o início (o circuito já volta a ele)
+    long start_id = (long)app->selected_start_id;
+    long *paradas = malloc((app->num_waypoints + 2) * sizeof(long));
+    if (!paradas) return;
+    size_t num_paradas = 0;
+    paradas[num_paradas++] = start_id;
+    for (size_t i = 0; i < app->num_waypoints; i++) {
+        if (app->waypoint_ids[i] != start_id) paradas[num_paradas++] = app->waypoint_ids[i];
+    }
+    if ((long)app->selected_end_id != start_id) paradas[num_paradas++] = (long)app->selected_end_id;
+    if (num_paradas < 2) {
+        update_status(app, "All stops are the start point; nothing to optimize");
+        free(paradas);
+        return;
+    }
+    
+    update_status(app, "Optimizing stop order...");
+    Metrica metrica = get_selected_metric(app);
+    Tour *tour = otimizar_tour(app->grafo, paradas, num_paradas, metrica, TRUE, TOUR_TIME_BUDGET_MS);
+    if (!tour || !tour->completo) {
+        update_status(app, tour ? "Some stops cannot reach each other; order not changed" : "Failed to optimize stop order");
+        liberar_tour(tour);
+        free(paradas);
+        return;
+    }
+    
+    // Nova ordem: as paradas seguem o circuito e o fim volta ao início
+    long *ids = realloc(app->waypoint_ids, (num_paradas - 1) * sizeof(long));
+    if (ids) {
+        app->waypoint_ids = ids;
+        for (size_t k = 1; k < num_paradas; k++) app->waypoint_ids[k - 1] = paradas[tour->ordem[k]];
+        app->num_waypoints = num_paradas - 1;
+        app->selected_end_id = start_id;
+        gtk_entry_set_text(GTK_ENTRY(app->end_entry), gtk_entry_get_text(GTK_ENTRY(app->start_entry)));
+        
+        on_find_path_clicked(NULL, app);
+        
+        // Resumo da otimização ao fim do texto do caminho
+        double escala = metrica == METRICA_DISTANCIA ? 1.0 : 1.0 / 60.0;
+        const char *unidade = metrica == METRICA_DISTANCIA ? "km" : "min";
+        gchar *resumo = g_strdup_printf("\nTour Optimization:\n  Stops: %zu (closed tour from start)\n  Nearest neighbour: %.2f %s\n  After 2-opt/Or-opt: %.2f %s (%.1f%% shorter, %zu moves)\n  Matrix: %.1f ms, improvement: %.1f ms%s\n",
+                                        num_paradas, tour->custo_vizinho * escala, unidade,
+                                        tour->custo * escala, unidade,
+                                        tour->custo_vizinho > 0.0 ? 100.0 * (tour->custo_vizinho - tour->custo) / tour->custo_vizinho : 0.0,
+                                        tour->melhorias, tour->tempo_matriz_ms, tour->tempo_otimizacao_ms,
+                                        tour->tempo_esgotado ? " (time budget reached)" : "");
+        GtkTextBuffer *buffer = gtk_text_view_get_buffer(GTK_TEXT_VIEW(app->results_text));
+        GtkTextIter fim;
+        gtk_text_buffer_get_end_iter(buffer, &fim);
+        gtk_text_buffer_insert(buffer, &fim, resumo, -1);
+        g_free(resumo);
+        update_status(app, "Stop order optimized; numbers show the visiting order");
+    }
+    
+    liberar_tour(tour);
+    free(paradas);
+}
+
 // Callback para limpar
 void on_clear_clicked(GtkToolButton *toolbutton, gpointer user_data) {
     (void)toolbutton; // Suppress unused parameter warning
@@ -217,6 +579,12 @@ void on_clear_clicked(GtkToolButton *toolbutton, gpointer user_data) {
     app->has_end_point = FALSE;
     app->selected_start_id = 0;
     app->selected_end_id = 0;
+    app->num_waypoints = 0;
+    app->start_snapped = FALSE;
+    app->end_snapped = FALSE;
+    app->snapped_route = FALSE;
+    liberar_alternativas(app->alternatives);
+    app->alternatives = NULL;
     
     // Clear shortest path
     if (app->shortest_path) {
@@ -229,7 +597,7 @@ void on_clear_clicked(GtkToolButton *toolbutton, gpointer user_data) {
     GtkTextBuffer *buffer = gtk_text_view_get_buffer(GTK_TEXT_VIEW(app->results_text));
     gtk_text_buffer_set_text(buffer, "", -1);
     
-    update_status(app, "Cleared. Hold Ctrl and click points to select them.");
+    update_status(app, "Cleared. Hold Ctrl and click points to select start, end and further stops.");
     
     // Redraw to remove highlighting
     if (app->grafo) {
@@ -315,6 +683,133 @@ void on_edit_normal_clicked(GtkToolButton *toolbutton, gpointer user_data) {
     }
 }
 
+// Callback para ligar ou desligar a reordenação de Hilbert no carregamento
+void on_reorder_on_load_toggled(GtkCheckMenuItem *menu_item, gpointer user_data) {
+    AppData *app = (AppData *)user_data;
+    
+    app->reorder_on_load = gtk_check_menu_item_get_active(menu_item);
+    update_status(app, app->reorder_on_load ? "Maps will be reordered along a Hilbert curve when loaded"
+                                            : "Maps will be loaded without reordering");
+}
+
+// Callback para colorir pontos por componente
+void on_components_toggled(GtkToggleToolButton *toggle_button, gpointer user_data) {
+    AppData *app = (AppData *)user_data;
+    
+    app->color_by_component = gtk_toggle_tool_button_get_active(toggle_button);
+    
+    if (app->color_by_component && app->grafo) {
+        const IndicesGrafo *indices = obter_componentes(app->grafo);
+        if (indices) {
+            gchar *msg = g_strdup_printf("Coloring by component: %zu strongly connected, %zu weakly connected (largest in gray)",
+                                         indices->num_componentes_fortes, indices->num_componentes_fracas);
+            update_status(app, msg);
+            g_free(msg);
+        }
+    } else {
+        update_status(app, "Component coloring off");
+    }
+    
+    if (app->grafo) {
+        gtk_widget_queue_draw(app->graph_area);
+    }
+}
+
+// Status com o tamanho da isócrona atual
+static void update_isochrone_status(AppData *app) {
+    RegiaoAlcancavel *regiao = get_isochrone(app);
+    if (!regiao) {
+        update_status(app, app->has_start_point ? "Isochrone unavailable for the start point"
+                                                : "Isochrone on: hold Ctrl and click a start point");
+        return;
+    }
+    
+    gboolean distancia = get_selected_metric(app) == METRICA_DISTANCIA;
+    gchar *msg = g_strdup_printf("Isochrone: %zu points within %.1f %s of the start point (%zu labeled)",
+                                 regiao->num_pontos, distancia ? regiao->limite : regiao->limite / 60.0,
+                                 distancia ? "km" : "min", regiao->num_tocados);
+    update_status(app, msg);
+    g_free(msg);
+}
+
+// Callback para colorir arestas pela isócrona do ponto inicial
+void on_isochrone_toggled(GtkToggleToolButton *toggle_button, gpointer user_data) {
+    AppData *app = (AppData *)user_data;
+    
+    app->show_isochrone = gtk_toggle_tool_button_get_active(toggle_button);
+    app->isochrone_valid = FALSE;
+    
+    if (app->show_isochrone) {
+        update_isochrone_status(app);
+    } else {
+        update_status(app, "Isochrone off");
+    }
+    
+    if (app->grafo) {
+        gtk_widget_queue_draw(app->graph_area);
+    }
+}
+
+// Callback para mudança de alcance ou métrica da isócrona
+void on_isochrone_settings_changed(GtkWidget *widget, gpointer user_data) {
+    (void)widget; // Suppress unused parameter warning
+    AppData *app = (AppData *)user_data;
+    
+    app->isochrone_valid = FALSE;
+    
+    if (app->show_isochrone && app->grafo) {
+        update_isochrone_status(app);
+        gtk_widget_queue_draw(app->graph_area);
+    }
+}
+
+// Status com o resumo da partição de Voronoi atual
+static void update_voronoi_status(AppData *app) {
+    ParticaoVoronoi *particao = get_voronoi(app);
+    if (!particao || particao->num_fontes == 0) {
+        update_status(app, "Voronoi on: hold Shift and click points to add or remove facilities");
+        return;
+    }
+    
+    gchar *msg = g_strdup_printf("Voronoi: %zu facilities, %zu points assigned, %zu unreachable",
+                                 particao->num_fontes, particao->num_pontos - particao->num_inalcancaveis,
+                                 particao->num_inalcancaveis);
+    update_status(app, msg);
+    g_free(msg);
+}
+
+// Callback para colorir pontos pela instalação mais próxima
+void on_voronoi_toggled(GtkToggleToolButton *toggle_button, gpointer user_data) {
+    AppData *app = (AppData *)user_data;
+    
+    app->show_voronoi = gtk_toggle_tool_button_get_active(toggle_button);
+    
+    if (app->show_voronoi) {
+        update_voronoi_status(app);
+    } else {
+        update_status(app, "Voronoi coloring off");
+    }
+    
+    if (app->grafo) {
+        gtk_widget_queue_draw(app->graph_area);
+    }
+}
+
+// Callback para mostrar rotas alternativas no cálculo do caminho
+void on_alternatives_toggled(GtkToggleToolButton *toggle_button, gpointer user_data) {
+    AppData *app = (AppData *)user_data;
+    
+    app->show_alternatives = gtk_toggle_tool_button_get_active(toggle_button);
+    if (app->show_alternatives) {
+        update_status(app, "Alternatives on: Find Path also shows clearly different routes (without extra stops)");
+    } else {
+        liberar_alternativas(app->alternatives);
+        app->alternatives = NULL;
+        update_status(app, "Alternative routes off");
+        if (app->grafo) gtk_widget_queue_draw(app->graph_area);
+    }
+}
+
 // Callback para exportar PNG
 void on_export_png_clicked(GtkToolButton *toolbutton, gpointer user_data) {
     (void)toolbutton; // Suppress unused parameter warning
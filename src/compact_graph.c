@@ -0,0 +1,277 @@
+#include "compact_graph.h"
+#include "graph.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// Entrada ainda não codificada (uma por extremidade de via)
+typedef struct {
+    size_t destino;
+    uint32_t peso_dm;
+    unsigned sentidos;
+} EntradaTemporaria;
+
+static int comparar_ids(const void *a, const void *b) {
+    long long ia = ((const EntradaIndiceId *)a)->id;
+    long long ib = ((const EntradaIndiceId *)b)->id;
+    return (ia > ib) - (ia < ib);
+}
+
+static int comparar_entradas(const void *a, const void *b) {
+    const EntradaTemporaria *ea = a;
+    const EntradaTemporaria *eb = b;
+    if (ea->destino != eb->destino) return (ea->destino > eb->destino) - (ea->destino < eb->destino);
+    return (ea->peso_dm > eb->peso_dm) - (ea->peso_dm < eb->peso_dm);
+}
+
+static ssize_t buscar_id(const EntradaIndiceId *ids, size_t n, long long id) {
+    size_t inicio = 0, fim = n;
+    while (inicio < fim) {
+        size_t meio = inicio + (fim - inicio) / 2;
+        if (ids[meio].id < id) inicio = meio + 1;
+        else fim = meio;
+    }
+    return (inicio < n && ids[inicio].id == id) ? (ssize_t)ids[inicio].indice : -1;
+}
+
+static size_t tamanho_varint(uint64_t valor) {
+    size_t bytes = 1;
+    while (valor >= 0x80) {
+        valor >>= 7;
+        bytes++;
+    }
+    return bytes;
+}
+
+static uint8_t* escrever_varint(uint8_t *p, uint64_t valor) {
+    while (valor >= 0x80) {
+        *p++ = (uint8_t)(valor | 0x80);
+        valor >>= 7;
+    }
+    *p++ = (uint8_t)valor;
+    return p;
+}
+
+// Chave codificada de uma entrada, dada a posição na lista
+static uint64_t chave_entrada(size_t ponto, size_t anterior, int primeiro, const EntradaTemporaria *e) {
+    uint64_t delta;
+    if (primeiro) {
+        int64_t relativo = (int64_t)e->destino - (int64_t)ponto;
+        delta = ((uint64_t)relativo << 1) ^ (uint64_t)(relativo >> 63);
+    } else {
+        delta = (uint64_t)(e->destino - anterior);
+    }
+    return (delta << 2) | e->sentidos;
+}
+
+static uint32_t quantizar_peso(double peso_km) {
+    double dm = round(peso_km * 10000.0);
+    if (dm < 0.0) return 0;
+    if (dm > (double)UINT32_MAX) return UINT32_MAX;
+    return (uint32_t)dm;
+}
+
+void liberar_adjacencia_compacta(AdjacenciaCompacta *adjacencia) {
+    if (adjacencia) {
+        free(adjacencia->dados);
+        free(adjacencia->inicio_bloco);
+        free(adjacencia->deslocamento);
+        free(adjacencia);
+    }
+}
+
+AdjacenciaCompacta* compactar_adjacencia(const Grafo *grafo) {
+    if (!grafo) return NULL;
+
+    size_t n = grafo->num_pontos;
+    size_t m = grafo->num_arestas;
+    size_t num_blocos = (n >> BITS_BLOCO_COMPACTO) + 1;
+    AdjacenciaCompacta *adj = calloc(1, sizeof(AdjacenciaCompacta));
+    EntradaIndiceId *ids = malloc((n ? n : 1) * sizeof(EntradaIndiceId));
+    size_t *inicio = calloc(n + 1, sizeof(size_t));
+    EntradaTemporaria *entradas = malloc((m ? 2 * m : 1) * sizeof(EntradaTemporaria));
+    size_t *bytes_ponto = calloc(n ? n : 1, sizeof(size_t));
+    if (adj) {
+        adj->num_pontos = n;
+        adj->inicio_bloco = calloc(num_blocos, sizeof(uint64_t));
+        adj->deslocamento = calloc(n + 1, sizeof(uint32_t));
+    }
+    if (!adj || !ids || !inicio || !entradas || !bytes_ponto || !adj->inicio_bloco || !adj->deslocamento) {
+        liberar_adjacencia_compacta(adj);
+        adj = NULL;
+        goto fim;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        ids[i].id = grafo->pontos[i].id;
+        ids[i].indice = i;
+    }
+    qsort(ids, n, sizeof(EntradaIndiceId), comparar_ids);
+
+    // Contar entradas por ponto (laços e extremidades desconhecidas são ignorados)
+    for (size_t i = 0; i < m; i++) {
+        ssize_t o = buscar_id(ids, n, grafo->arestas[i].origem);
+        ssize_t d = buscar_id(ids, n, grafo->arestas[i].destino);
+        if (o < 0 || d < 0 || o == d) continue;
+        inicio[o + 1]++;
+        inicio[d + 1]++;
+    }
+    for (size_t v = 0; v < n; v++) inicio[v + 1] += inicio[v];
+    adj->num_entradas = inicio[n];
+
+    // Preencher usando bytes_ponto como cursor temporário
+    for (size_t i = 0; i < m; i++) {
+        const Aresta *a = &grafo->arestas[i];
+        ssize_t o = buscar_id(ids, n, a->origem);
+        ssize_t d = buscar_id(ids, n, a->destino);
+        if (o < 0 || d < 0 || o == d) continue;
+        uint32_t peso = quantizar_peso(a->peso);
+        unsigned volta = a->is_bidirectional ? SENTIDO_ENTRADA : 0u;
+        unsigned ida = a->is_bidirectional ? SENTIDO_SAIDA : 0u;
+        entradas[inicio[o] + bytes_ponto[o]++] = (EntradaTemporaria){(size_t)d, peso, SENTIDO_SAIDA | volta};
+        entradas[inicio[d] + bytes_ponto[d]++] = (EntradaTemporaria){(size_t)o, peso, SENTIDO_ENTRADA | ida};
+    }
+
+    // Ordenar cada lista e medir o tamanho codificado
+    size_t total = 0;
+    for (size_t v = 0; v < n; v++) {
+        size_t k0 = inicio[v], k1 = inicio[v + 1];
+        qsort(entradas + k0, k1 - k0, sizeof(EntradaTemporaria), comparar_entradas);
+        size_t bytes = 0, anterior = 0;
+        for (size_t k = k0; k < k1; k++) {
+            bytes += tamanho_varint(chave_entrada(v, anterior, k == k0, &entradas[k]));
+            bytes += tamanho_varint(entradas[k].peso_dm);
+            anterior = entradas[k].destino;
+        }
+        bytes_ponto[v] = bytes;
+        total += bytes;
+    }
+
+    // Deslocamentos em dois níveis: 64 bits por bloco, 32 bits por ponto
+    size_t posicao = 0;
+    for (size_t v = 0; v <= n; v++) {
+        size_t bloco = v >> BITS_BLOCO_COMPACTO;
+        if ((v & ((1u << BITS_BLOCO_COMPACTO) - 1)) == 0) adj->inicio_bloco[bloco] = posicao;
+        size_t relativo = posicao - adj->inicio_bloco[bloco];
+        if (relativo > UINT32_MAX) {
+            liberar_adjacencia_compacta(adj);
+            adj = NULL;
+            goto fim;
+        }
+        adj->deslocamento[v] = (uint32_t)relativo;
+        if (v < n) posicao += bytes_ponto[v];
+    }
+
+    adj->tamanho_dados = total;
+    adj->dados = malloc(total ? total : 1);
+    if (!adj->dados) {
+        liberar_adjacencia_compacta(adj);
+        adj = NULL;
+        goto fim;
+    }
+    uint8_t *p = adj->dados;
+    for (size_t v = 0; v < n; v++) {
+        size_t anterior = 0;
+        for (size_t k = inicio[v]; k < inicio[v + 1]; k++) {
+            p = escrever_varint(p, chave_entrada(v, anterior, k == inicio[v], &entradas[k]));
+            p = escrever_varint(p, entradas[k].peso_dm);
+            anterior = entradas[k].destino;
+        }
+    }
+
+fim:
+    free(ids);
+    free(inicio);
+    free(entradas);
+    free(bytes_ponto);
+    return adj;
+}
+
+size_t bytes_adjacencia_compacta(const AdjacenciaCompacta *adjacencia) {
+    if (!adjacencia) return 0;
+    size_t num_blocos = (adjacencia->num_pontos >> BITS_BLOCO_COMPACTO) + 1;
+    return adjacencia->tamanho_dados + num_blocos * sizeof(uint64_t) +
+           (adjacencia->num_pontos + 1) * sizeof(uint32_t);
+}
+
+static size_t inicio_lista(const AdjacenciaCompacta *adj, size_t ponto) {
+    return adj->inicio_bloco[ponto >> BITS_BLOCO_COMPACTO] + adj->deslocamento[ponto];
+}
+
+void iniciar_iterador_compacto(const AdjacenciaCompacta *adjacencia, size_t ponto, IteradorCompacto *it) {
+    it->atual = adjacencia->dados + inicio_lista(adjacencia, ponto);
+    it->fim = adjacencia->dados + inicio_lista(adjacencia, ponto + 1);
+    it->ponto = ponto;
+    it->anterior = ponto;
+    it->primeiro = 1;
+}
+
+ResultadoDijkstra* dijkstra_compacto(const AdjacenciaCompacta *adj, const Grafo *grafo,
+                                     size_t origem, size_t destino) {
+    if (!adj || !grafo || origem >= adj->num_pontos || destino >= adj->num_pontos) return NULL;
+
+    size_t n = adj->num_pontos;
+    uint64_t *distancias = malloc(n * sizeof(uint64_t));
+    size_t *predecessores = malloc(n * sizeof(size_t));
+    unsigned char *visitados = calloc(n, 1);
+    FilaPrioridade *fila = criar_fila_prioridade(64);
+    ResultadoDijkstra *resultado = calloc(1, sizeof(ResultadoDijkstra));
+    if (!distancias || !predecessores || !visitados || !fila || !resultado) {
+        free(distancias);
+        free(predecessores);
+        free(visitados);
+        liberar_fila_prioridade(fila);
+        free(resultado);
+        return NULL;
+    }
+    for (size_t i = 0; i < n; i++) {
+        distancias[i] = UINT64_MAX;
+        predecessores[i] = (size_t)-1;
+    }
+
+    distancias[origem] = 0;
+    inserir_fila_prioridade(fila, (long)origem, 0.0);
+    while (!fila_vazia(fila)) {
+        size_t atual = (size_t)extrair_minimo(fila).ponto_id;
+        if (visitados[atual]) continue;
+        visitados[atual] = 1;
+        resultado->nos_visitados++;
+        if (atual == destino) break;
+
+        IteradorCompacto it;
+        VizinhoCompacto vizinho;
+        iniciar_iterador_compacto(adj, atual, &it);
+        while (proximo_vizinho_compacto(&it, &vizinho)) {
+            if (!(vizinho.sentidos & SENTIDO_SAIDA) || visitados[vizinho.destino]) continue;
+            uint64_t nova = distancias[atual] + vizinho.peso_dm;
+            if (nova < distancias[vizinho.destino]) {
+                distancias[vizinho.destino] = nova;
+                predecessores[vizinho.destino] = atual;
+                inserir_fila_prioridade(fila, (long)vizinho.destino, (double)nova);
+            }
+        }
+    }
+
+    resultado->distancia_total = -1.0;
+    if (distancias[destino] != UINT64_MAX) {
+        int contador = 0;
+        for (size_t v = destino; v != (size_t)-1; v = predecessores[v]) contador++;
+        resultado->caminho = malloc(sizeof(long) * contador);
+        if (resultado->caminho) {
+            int posicao = contador - 1;
+            for (size_t v = destino; v != (size_t)-1; v = predecessores[v]) {
+                resultado->caminho[posicao--] = grafo->pontos[v].id;
+            }
+            resultado->tamanho_caminho = contador;
+        }
+        resultado->distancia_total = distancias[destino] / 10000.0;
+        resultado->sucesso = 1;
+    }
+
+    free(distancias);
+    free(predecessores);
+    free(visitados);
+    liberar_fila_prioridade(fila);
+    return resultado;
+}
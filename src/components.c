@@ -0,0 +1,166 @@
+#include "components.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SEM_COMPONENTE ((size_t)-1)
+
+// Tarjan iterativo: a recursão é substituída por uma pilha explícita de
+// chamadas e pelo próximo arco a examinar de cada ponto, para aguentar
+// grafos com milhões de pontos sem estourar a pilha do processo.
+static int calcular_componentes_fortes(IndicesGrafo* indices) {
+    size_t n = indices->num_pontos;
+    size_t tam = n ? n : 1;
+    size_t* ordem = calloc(tam, sizeof(size_t));      // Ordem de descoberta (0 = não visitado)
+    size_t* baixo = malloc(tam * sizeof(size_t));     // Menor ordem alcançável (lowlink)
+    size_t* pilha = malloc(tam * sizeof(size_t));     // Pontos ainda sem componente
+    size_t* chamadas = malloc(tam * sizeof(size_t));  // Pilha da busca em profundidade
+    size_t* proximo_arco = malloc(tam * sizeof(size_t));
+    // O resultado fica na arena dos índices; os vetores de trabalho são temporários
+    size_t* componente = arena_alocar(indices->arena, tam * sizeof(size_t));
+    size_t* tamanho = NULL;
+    if (!ordem || !baixo || !pilha || !chamadas || !proximo_arco || !componente) {
+        free(ordem);
+        free(baixo);
+        free(pilha);
+        free(chamadas);
+        free(proximo_arco);
+        return -1;
+    }
+
+    for (size_t v = 0; v < n; ++v) componente[v] = SEM_COMPONENTE;
+
+    size_t contador = 1, topo_pilha = 0, num_componentes = 0;
+    for (size_t raiz = 0; raiz < n; ++raiz) {
+        if (ordem[raiz]) continue;
+
+        size_t topo_chamadas = 0;
+        chamadas[topo_chamadas++] = raiz;
+        ordem[raiz] = baixo[raiz] = contador++;
+        proximo_arco[raiz] = indices->inicio_arcos[raiz];
+        pilha[topo_pilha++] = raiz;
+
+        while (topo_chamadas > 0) {
+            size_t v = chamadas[topo_chamadas - 1];
+            if (proximo_arco[v] < indices->inicio_arcos[v + 1]) {
+                size_t w = indices->arcos[proximo_arco[v]++].destino;
+                if (!ordem[w]) {
+                    // "Chamada recursiva" para w
+                    ordem[w] = baixo[w] = contador++;
+                    proximo_arco[w] = indices->inicio_arcos[w];
+                    pilha[topo_pilha++] = w;
+                    chamadas[topo_chamadas++] = w;
+                } else if (componente[w] == SEM_COMPONENTE && ordem[w] < baixo[v]) {
+                    // w ainda está na pilha de Tarjan: pertence à busca atual
+                    baixo[v] = ordem[w];
+                }
+                continue;
+            }
+
+            // Todos os arcos de v examinados: "retorno" da chamada
+            topo_chamadas--;
+            if (baixo[v] == ordem[v]) {
+                size_t w;
+                do {
+                    w = pilha[--topo_pilha];
+                    componente[w] = num_componentes;
+                } while (w != v);
+                num_componentes++;
+            }
+            if (topo_chamadas > 0) {
+                size_t u = chamadas[topo_chamadas - 1];
+                if (baixo[v] < baixo[u]) baixo[u] = baixo[v];
+            }
+        }
+    }
+
+    free(ordem);
+    free(baixo);
+    free(pilha);
+    free(chamadas);
+    free(proximo_arco);
+
+    // Componente com mais pontos (em geral a malha principal da cidade)
+    size_t maior = 0;
+    tamanho = calloc(num_componentes ? num_componentes : 1, sizeof(size_t));
+    if (tamanho) {
+        for (size_t v = 0; v < n; ++v) tamanho[componente[v]]++;
+        for (size_t c = 1; c < num_componentes; ++c) {
+            if (tamanho[c] > tamanho[maior]) maior = c;
+        }
+        free(tamanho);
+    }
+
+    indices->componente_forte = componente;
+    indices->num_componentes_fortes = num_componentes;
+    indices->maior_componente_forte = maior;
+    return 0;
+}
+
+// Raiz do conjunto de v, com compressão de caminho por divisão
+static size_t encontrar_raiz(size_t* pai, size_t v) {
+    while (pai[v] != v) {
+        pai[v] = pai[pai[v]];
+        v = pai[v];
+    }
+    return v;
+}
+
+// Componentes fracas por união e busca sobre os arcos da adjacência
+static int calcular_componentes_fracas(IndicesGrafo* indices) {
+    size_t n = indices->num_pontos;
+    size_t* pai = malloc((n ? n : 1) * sizeof(size_t));
+    size_t* componente = arena_alocar(indices->arena, (n ? n : 1) * sizeof(size_t));
+    if (!pai || !componente) {
+        free(pai);
+        return -1;
+    }
+
+    for (size_t v = 0; v < n; ++v) pai[v] = v;
+    for (size_t v = 0; v < n; ++v) {
+        for (size_t k = indices->inicio_arcos[v]; k < indices->inicio_arcos[v + 1]; ++k) {
+            size_t a = encontrar_raiz(pai, v);
+            size_t b = encontrar_raiz(pai, indices->arcos[k].destino);
+            if (a != b) pai[a] = b;
+        }
+    }
+
+    // Numerar as raízes de forma densa, na ordem em que aparecem
+    size_t num_componentes = 0;
+    for (size_t v = 0; v < n; ++v) componente[v] = SEM_COMPONENTE;
+    for (size_t v = 0; v < n; ++v) {
+        size_t r = encontrar_raiz(pai, v);
+        if (componente[r] == SEM_COMPONENTE) componente[r] = num_componentes++;
+        componente[v] = componente[r];
+    }
+    free(pai);
+
+    indices->componente_fraca = componente;
+    indices->num_componentes_fracas = num_componentes;
+    return 0;
+}
+
+const IndicesGrafo* obter_componentes(Grafo* grafo) {
+    const IndicesGrafo* constantes = obter_indices(grafo);
+    if (!constantes) return NULL;
+    // Os componentes ficam no mesmo cache dos índices e são descartados com eles
+    IndicesGrafo* indices = grafo->indices;
+
+    if (!indices->componente_forte && calcular_componentes_fortes(indices) != 0) {
+        return NULL;
+    }
+    if (!indices->componente_fraca && calcular_componentes_fracas(indices) != 0) {
+        return NULL;
+    }
+    return indices;
+}
+
+int alcance_possivel(Grafo* grafo, size_t origem, size_t destino) {
+    if (origem == destino) return 1;
+    const IndicesGrafo* indices = obter_componentes(grafo);
+    if (!indices || origem >= indices->num_pontos || destino >= indices->num_pontos) return 1;
+
+    if (indices->componente_fraca[origem] != indices->componente_fraca[destino]) return 0;
+    // Arcos nunca sobem na numeração de Tarjan
+    return indices->componente_forte[origem] >= indices->componente_forte[destino];
+}
@@ -0,0 +1,543 @@
+#include "compression.h"
+#include "graph.h"
+#include "components.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+
+// Vetor dinâmico simples de IDs para montar o caminho desempacotado
+typedef struct {
+    long *ids;
+    int tamanho;
+    int capacidade;
+} VetorIds;
+
+static int vetor_ids_adicionar(VetorIds *v, long id) {
+    if (v->tamanho == v->capacidade) {
+        int nova = v->capacidade ? v->capacidade * 2 : 64;
+        long *novos = realloc(v->ids, sizeof(long) * nova);
+        if (!novos) return -1;
+        v->ids = novos;
+        v->capacidade = nova;
+    }
+    v->ids[v->tamanho++] = id;
+    return 0;
+}
+
+void liberar_grafo_comprimido(GrafoComprimido *comprimido) {
+    if (comprimido) {
+        liberar_grafo(comprimido->nucleo);
+        free(comprimido->inicio_geometria);
+        free(comprimido->geometria);
+        free(comprimido->cadeia_do_ponto);
+        free(comprimido->posicao_na_cadeia);
+        free(comprimido->deslocamento);
+        free(comprimido);
+    }
+}
+
+// Estado temporário da compressão
+typedef struct {
+    const Grafo *grafo;
+    ssize_t *origem;          // Índice do ponto de origem de cada registro (-1 se inválido)
+    ssize_t *destino;
+    size_t *inicio_incidencia; // Registros incidentes em cada ponto (formato CSR)
+    size_t *incidencia;
+    unsigned char *interior;   // 1 se o ponto é interno a uma cadeia
+    unsigned char *percorrida; // 1 se o registro já pertence a uma cadeia
+
+    // Arestas do núcleo em construção (índices de pontos originais)
+    size_t *cadeia_origem;
+    size_t *cadeia_destino;
+    double *cadeia_peso;
+    int *cadeia_bidirecional;
+    size_t *cadeia_inicio_geo;
+    size_t num_cadeias, cap_cadeias;
+
+    size_t *geometria;
+    double *acumulado;         // Distância a partir do início do percurso, por ponto da geometria
+    size_t tam_geometria, cap_geometria;
+} EstadoCompressao;
+
+static size_t outro_extremo(const EstadoCompressao *e, size_t registro, size_t ponto) {
+    return (size_t)e->origem[registro] == ponto ? (size_t)e->destino[registro] : (size_t)e->origem[registro];
+}
+
+// Um ponto é interno se tiver exatamente duas vias distintas e o sentido
+// de circulação for o mesmo nas duas (ambas mão dupla ou uma entra e outra sai)
+static int eh_interior(const EstadoCompressao *e, size_t ponto) {
+    size_t inicio = e->inicio_incidencia[ponto];
+    if (e->inicio_incidencia[ponto + 1] - inicio != 2) return 0;
+
+    size_t r1 = e->incidencia[inicio], r2 = e->incidencia[inicio + 1];
+    if (e->origem[r1] == e->destino[r1] || e->origem[r2] == e->destino[r2]) return 0;
+    if (outro_extremo(e, r1, ponto) == outro_extremo(e, r2, ponto)) return 0;
+
+    const Aresta *a1 = &e->grafo->arestas[r1];
+    const Aresta *a2 = &e->grafo->arestas[r2];
+    if (a1->is_bidirectional && a2->is_bidirectional) return 1;
+    if (a1->is_bidirectional || a2->is_bidirectional) return 0;
+    int entra1 = (size_t)e->destino[r1] == ponto;
+    int entra2 = (size_t)e->destino[r2] == ponto;
+    return entra1 != entra2;
+}
+
+static int garantir_capacidade_geometria(EstadoCompressao *e) {
+    if (e->tam_geometria < e->cap_geometria) return 0;
+    size_t nova = e->cap_geometria ? e->cap_geometria * 2 : 256;
+    size_t *geo = realloc(e->geometria, nova * sizeof(size_t));
+    if (!geo) return -1;
+    e->geometria = geo;
+    double *acc = realloc(e->acumulado, nova * sizeof(double));
+    if (!acc) return -1;
+    e->acumulado = acc;
+    e->cap_geometria = nova;
+    return 0;
+}
+
+static int garantir_capacidade_cadeias(EstadoCompressao *e) {
+    if (e->num_cadeias < e->cap_cadeias) return 0;
+    size_t nova = e->cap_cadeias ? e->cap_cadeias * 2 : 256;
+    size_t *o = realloc(e->cadeia_origem, nova * sizeof(size_t));
+    if (!o) return -1;
+    e->cadeia_origem = o;
+    size_t *d = realloc(e->cadeia_destino, nova * sizeof(size_t));
+    if (!d) return -1;
+    e->cadeia_destino = d;
+    double *p = realloc(e->cadeia_peso, nova * sizeof(double));
+    if (!p) return -1;
+    e->cadeia_peso = p;
+    int *b = realloc(e->cadeia_bidirecional, nova * sizeof(int));
+    if (!b) return -1;
+    e->cadeia_bidirecional = b;
+    size_t *g = realloc(e->cadeia_inicio_geo, (nova + 1) * sizeof(size_t));
+    if (!g) return -1;
+    e->cadeia_inicio_geo = g;
+    e->cap_cadeias = nova;
+    return 0;
+}
+
+// Percorre uma cadeia a partir da junção 'inicio' pelo registro 'registro'
+// até a próxima junção, registrando-a como uma aresta do núcleo
+static int percorrer_cadeia(EstadoCompressao *e, size_t inicio, size_t registro) {
+    if (garantir_capacidade_cadeias(e) != 0) return -1;
+
+    size_t inicio_geo = e->tam_geometria;
+    const Aresta *primeira = &e->grafo->arestas[registro];
+    int bidirecional = primeira->is_bidirectional;
+    int no_sentido = bidirecional || (size_t)e->origem[registro] == inicio;
+
+    size_t atual = inicio;
+    double peso = 0.0;
+    for (;;) {
+        e->percorrida[registro] = 1;
+        peso += e->grafo->arestas[registro].peso;
+        size_t proximo = outro_extremo(e, registro, atual);
+        if (!e->interior[proximo] || proximo == inicio) {
+            atual = proximo;
+            break;
+        }
+
+        if (garantir_capacidade_geometria(e) != 0) return -1;
+        e->geometria[e->tam_geometria] = proximo;
+        e->acumulado[e->tam_geometria] = peso;
+        e->tam_geometria++;
+
+        // Seguir pelo outro registro do ponto interno
+        size_t k = e->inicio_incidencia[proximo];
+        atual = proximo;
+        registro = e->incidencia[k] == registro ? e->incidencia[k + 1] : e->incidencia[k];
+    }
+
+    size_t c = e->num_cadeias++;
+    e->cadeia_peso[c] = peso;
+    e->cadeia_bidirecional[c] = bidirecional;
+    e->cadeia_inicio_geo[c] = inicio_geo;
+    if (no_sentido) {
+        e->cadeia_origem[c] = inicio;
+        e->cadeia_destino[c] = atual;
+    } else {
+        // Mão única percorrida contra o sentido: inverter a cadeia
+        e->cadeia_origem[c] = atual;
+        e->cadeia_destino[c] = inicio;
+        size_t fim_geo = e->tam_geometria;
+        for (size_t i = inicio_geo, j = fim_geo; i < j--; ++i) {
+            size_t tmp = e->geometria[i];
+            e->geometria[i] = e->geometria[j];
+            e->geometria[j] = tmp;
+            double acc = e->acumulado[i];
+            e->acumulado[i] = e->acumulado[j];
+            e->acumulado[j] = acc;
+        }
+        for (size_t i = inicio_geo; i < fim_geo; ++i) {
+            e->acumulado[i] = peso - e->acumulado[i];
+        }
+    }
+    return 0;
+}
+
+static void liberar_estado(EstadoCompressao *e) {
+    free(e->origem);
+    free(e->destino);
+    free(e->inicio_incidencia);
+    free(e->incidencia);
+    free(e->interior);
+    free(e->percorrida);
+    free(e->cadeia_origem);
+    free(e->cadeia_destino);
+    free(e->cadeia_peso);
+    free(e->cadeia_bidirecional);
+    free(e->cadeia_inicio_geo);
+    free(e->geometria);
+    free(e->acumulado);
+}
+
+// Colapsa as cadeias de grau 2 do grafo
+GrafoComprimido* comprimir_grafo(Grafo *grafo) {
+    if (!grafo) return NULL;
+
+    size_t n = grafo->num_pontos;
+    size_t m = grafo->num_arestas;
+    EstadoCompressao e = {0};
+    e.grafo = grafo;
+    e.origem = malloc((m ? m : 1) * sizeof(ssize_t));
+    e.destino = malloc((m ? m : 1) * sizeof(ssize_t));
+    e.inicio_incidencia = calloc(n + 1, sizeof(size_t));
+    e.incidencia = malloc((2 * m + 1) * sizeof(size_t));
+    e.interior = calloc(n ? n : 1, 1);
+    e.percorrida = calloc(m ? m : 1, 1);
+    GrafoComprimido *gc = calloc(1, sizeof(GrafoComprimido));
+    if (!e.origem || !e.destino || !e.inicio_incidencia || !e.incidencia ||
+        !e.interior || !e.percorrida || !gc) {
+        free(gc);
+        liberar_estado(&e);
+        return NULL;
+    }
+    gc->original = grafo;
+
+    // Incidência não direcionada de cada ponto
+    for (size_t i = 0; i < m; ++i) {
+        e.origem[i] = buscar_indice_ponto(grafo, grafo->arestas[i].origem);
+        e.destino[i] = buscar_indice_ponto(grafo, grafo->arestas[i].destino);
+        if (e.origem[i] < 0 || e.destino[i] < 0) {
+            e.origem[i] = e.destino[i] = -1;
+            e.percorrida[i] = 1; // Registro inválido: nunca entra em cadeia
+            continue;
+        }
+        e.inicio_incidencia[e.origem[i] + 1]++;
+        if (e.destino[i] != e.origem[i]) e.inicio_incidencia[e.destino[i] + 1]++;
+    }
+    for (size_t v = 0; v < n; ++v) e.inicio_incidencia[v + 1] += e.inicio_incidencia[v];
+    size_t *proximo = malloc((n ? n : 1) * sizeof(size_t));
+    if (!proximo) {
+        free(gc);
+        liberar_estado(&e);
+        return NULL;
+    }
+    memcpy(proximo, e.inicio_incidencia, n * sizeof(size_t));
+    for (size_t i = 0; i < m; ++i) {
+        if (e.origem[i] < 0) continue;
+        e.incidencia[proximo[e.origem[i]]++] = i;
+        if (e.destino[i] != e.origem[i]) e.incidencia[proximo[e.destino[i]]++] = i;
+    }
+    free(proximo);
+
+    for (size_t v = 0; v < n; ++v) e.interior[v] = (unsigned char)eh_interior(&e, v);
+
+    // Percorrer cadeias a partir das junções; ciclos isolados formados só por
+    // pontos internos recebem uma junção artificial na segunda passada
+    int erro = 0;
+    for (int passada = 0; passada < 2 && !erro; ++passada) {
+        for (size_t v = 0; v < n && !erro; ++v) {
+            if (e.interior[v]) {
+                if (passada == 0) continue;
+                size_t k = e.inicio_incidencia[v];
+                if (e.percorrida[e.incidencia[k]]) continue;
+                e.interior[v] = 0;
+            }
+            for (size_t k = e.inicio_incidencia[v]; k < e.inicio_incidencia[v + 1] && !erro; ++k) {
+                size_t r = e.incidencia[k];
+                if (!e.percorrida[r]) erro = percorrer_cadeia(&e, v, r);
+            }
+        }
+    }
+    if (erro) {
+        free(gc);
+        liberar_estado(&e);
+        return NULL;
+    }
+
+    // Montar o núcleo: pontos de junção e uma aresta por cadeia
+    size_t num_juncoes = 0;
+    for (size_t v = 0; v < n; ++v) if (!e.interior[v]) num_juncoes++;
+    gc->nucleo = criar_grafo_com_capacidade(num_juncoes, e.num_cadeias);
+    gc->cadeia_do_ponto = malloc((n ? n : 1) * sizeof(ssize_t));
+    gc->posicao_na_cadeia = malloc((n ? n : 1) * sizeof(size_t));
+    gc->deslocamento = malloc((n ? n : 1) * sizeof(double));
+    gc->inicio_geometria = malloc((e.num_cadeias + 1) * sizeof(size_t));
+    if (!gc->nucleo || !gc->cadeia_do_ponto ||
+        !gc->posicao_na_cadeia || !gc->deslocamento || !gc->inicio_geometria) {
+        liberar_grafo_comprimido(gc);
+        liberar_estado(&e);
+        return NULL;
+    }
+
+    for (size_t v = 0; v < n; ++v) {
+        gc->cadeia_do_ponto[v] = -1;
+        gc->posicao_na_cadeia[v] = 0;
+        gc->deslocamento[v] = 0.0;
+        if (!e.interior[v]) gc->nucleo->pontos[gc->nucleo->num_pontos++] = grafo->pontos[v];
+    }
+    invalidar_indices(gc->nucleo);  // Mapa de IDs dos pontos copiados
+    for (size_t c = 0; c < e.num_cadeias; ++c) {
+        Aresta *a = &gc->nucleo->arestas[c];
+        a->origem = grafo->pontos[e.cadeia_origem[c]].id;
+        a->destino = grafo->pontos[e.cadeia_destino[c]].id;
+        a->peso = e.cadeia_peso[c];
+        a->is_bidirectional = e.cadeia_bidirecional[c];
+
+        size_t fim_geo = c + 1 < e.num_cadeias ? e.cadeia_inicio_geo[c + 1] : e.tam_geometria;
+        gc->inicio_geometria[c] = e.cadeia_inicio_geo[c];
+        for (size_t g = e.cadeia_inicio_geo[c]; g < fim_geo; ++g) {
+            size_t p = e.geometria[g];
+            gc->cadeia_do_ponto[p] = (ssize_t)c;
+            gc->posicao_na_cadeia[p] = g - e.cadeia_inicio_geo[c];
+            gc->deslocamento[p] = e.acumulado[g];
+        }
+    }
+    gc->nucleo->num_arestas = e.num_cadeias;
+    gc->inicio_geometria[e.num_cadeias] = e.tam_geometria;
+
+    // A geometria passa a pertencer ao grafo comprimido
+    gc->geometria = e.geometria;
+    e.geometria = NULL;
+    liberar_estado(&e);
+    return gc;
+}
+
+// Ponto de partida ou de chegada da busca no núcleo, com custo adicional
+typedef struct {
+    ssize_t no;       // Índice no núcleo
+    double custo;     // Distância entre o ponto original e a junção
+    int sentido;      // 1: pela ponta destino da cadeia; 0: pela ponta origem
+} Terminal;
+
+// Adiciona ao caminho os pontos da geometria entre as posições [de, ate], em ordem
+static int adicionar_geometria(const GrafoComprimido *gc, VetorIds *caminho, size_t cadeia,
+                               ssize_t de, ssize_t ate) {
+    const size_t *geo = gc->geometria + gc->inicio_geometria[cadeia];
+    int passo = de <= ate ? 1 : -1;
+    for (ssize_t i = de; ; i += passo) {
+        if (vetor_ids_adicionar(caminho, gc->original->pontos[geo[i]].id) != 0) return -1;
+        if (i == ate) break;
+    }
+    return 0;
+}
+
+static ssize_t tamanho_geometria(const GrafoComprimido *gc, size_t cadeia) {
+    return (ssize_t)(gc->inicio_geometria[cadeia + 1] - gc->inicio_geometria[cadeia]);
+}
+
+ResultadoDijkstra* dijkstra_comprimido(GrafoComprimido *gc, long origem_id, long destino_id) {
+    if (!gc || !gc->original || !gc->nucleo) return NULL;
+
+    ssize_t s = buscar_indice_ponto(gc->original, origem_id);
+    ssize_t t = buscar_indice_ponto(gc->original, destino_id);
+    const IndicesGrafo *indices = obter_indices(gc->nucleo);
+    if (s < 0 || t < 0 || !indices) return NULL;
+
+    ResultadoDijkstra *resultado = calloc(1, sizeof(ResultadoDijkstra));
+    if (!resultado) return NULL;
+    resultado->distancia_total = -1.0;
+
+    if (s == t) {
+        resultado->caminho = malloc(sizeof(long));
+        if (resultado->caminho) {
+            resultado->caminho[0] = origem_id;
+            resultado->tamanho_caminho = 1;
+        }
+        resultado->distancia_total = 0.0;
+        resultado->sucesso = 1;
+        return resultado;
+    }
+    if (!alcance_possivel(gc->original, (size_t)s, (size_t)t)) {
+        return resultado;
+    }
+
+    // Terminais de partida (sementes) e de chegada
+    Terminal sementes[2], alvos[2];
+    int num_sementes = 0, num_alvos = 0;
+    ssize_t cadeia_s = gc->cadeia_do_ponto[s];
+    ssize_t cadeia_t = gc->cadeia_do_ponto[t];
+    if (cadeia_s < 0) {
+        sementes[num_sementes++] = (Terminal){buscar_indice_ponto(gc->nucleo, origem_id), 0.0, 0};
+    } else {
+        const Aresta *a = &gc->nucleo->arestas[cadeia_s];
+        double d = gc->deslocamento[s];
+        sementes[num_sementes++] = (Terminal){buscar_indice_ponto(gc->nucleo, a->destino), a->peso - d, 1};
+        if (a->is_bidirectional)
+            sementes[num_sementes++] = (Terminal){buscar_indice_ponto(gc->nucleo, a->origem), d, 0};
+    }
+    if (cadeia_t < 0) {
+        alvos[num_alvos++] = (Terminal){buscar_indice_ponto(gc->nucleo, destino_id), 0.0, 0};
+    } else {
+        const Aresta *a = &gc->nucleo->arestas[cadeia_t];
+        double d = gc->deslocamento[t];
+        alvos[num_alvos++] = (Terminal){buscar_indice_ponto(gc->nucleo, a->origem), d, 0};
+        if (a->is_bidirectional)
+            alvos[num_alvos++] = (Terminal){buscar_indice_ponto(gc->nucleo, a->destino), a->peso - d, 1};
+    }
+
+    // Origem e destino na mesma cadeia: percurso direto ao longo da geometria
+    double melhor = DBL_MAX;
+    int melhor_direto = 0, melhor_alvo = -1;
+    if (cadeia_s >= 0 && cadeia_s == cadeia_t) {
+        double ds = gc->deslocamento[s], dt = gc->deslocamento[t];
+        if (dt >= ds) {
+            melhor = dt - ds;
+            melhor_direto = 1;
+        } else if (gc->nucleo->arestas[cadeia_s].is_bidirectional) {
+            melhor = ds - dt;
+            melhor_direto = 1;
+        }
+    }
+
+    size_t n = gc->nucleo->num_pontos;
+    double *distancias = malloc(sizeof(double) * (n ? n : 1));
+    long *predecessores = malloc(sizeof(long) * (n ? n : 1));
+    size_t *aresta_predecessora = malloc(sizeof(size_t) * (n ? n : 1));
+    unsigned char *visitados = calloc(n ? n : 1, 1);
+    FilaPrioridade *fila = criar_fila_prioridade((int)(n ? n : 1));
+    if (!distancias || !predecessores || !aresta_predecessora || !visitados || !fila) {
+        free(distancias);
+        free(predecessores);
+        free(aresta_predecessora);
+        free(visitados);
+        liberar_fila_prioridade(fila);
+        free(resultado);
+        return NULL;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        distancias[i] = DBL_MAX;
+        predecessores[i] = -1;
+    }
+    for (int i = 0; i < num_sementes; ++i) {
+        ssize_t no = sementes[i].no;
+        if (no >= 0 && sementes[i].custo < distancias[no]) {
+            distancias[no] = sementes[i].custo;
+            inserir_fila_prioridade(fila, no, sementes[i].custo);
+        }
+    }
+
+    int nos_visitados = 0;
+    while (!fila_vazia(fila)) {
+        NoFilaPrioridade atual = extrair_minimo(fila);
+        long u = atual.ponto_id;
+        if (visitados[u]) continue;
+        if (atual.distancia >= melhor) break;
+        visitados[u] = 1;
+        nos_visitados++;
+
+        for (int i = 0; i < num_alvos; ++i) {
+            if (alvos[i].no == u && distancias[u] + alvos[i].custo < melhor) {
+                melhor = distancias[u] + alvos[i].custo;
+                melhor_alvo = i;
+                melhor_direto = 0;
+            }
+        }
+
+        for (size_t k = indices->inicio_arcos[u]; k < indices->inicio_arcos[u + 1]; ++k) {
+            const Arco *arco = &indices->arcos[k];
+            if (visitados[arco->destino]) continue;
+            double nova = distancias[u] + arco->peso;
+            if (nova < distancias[arco->destino]) {
+                distancias[arco->destino] = nova;
+                predecessores[arco->destino] = u;
+                aresta_predecessora[arco->destino] = arco->aresta;
+                inserir_fila_prioridade(fila, arco->destino, nova);
+            }
+        }
+    }
+    resultado->nos_visitados = nos_visitados;
+
+    VetorIds caminho = {0};
+    int erro = 0;
+    if (melhor == DBL_MAX) {
+        // Sem caminho
+    } else if (melhor_direto) {
+        erro = adicionar_geometria(gc, &caminho, cadeia_s,
+                                   (ssize_t)gc->posicao_na_cadeia[s], (ssize_t)gc->posicao_na_cadeia[t]);
+    } else {
+        // Sequência de junções, do alvo até a semente que a originou
+        size_t num_juncoes = 0;
+        for (long v = alvos[melhor_alvo].no; v != -1; v = predecessores[v]) num_juncoes++;
+        long *juncoes = malloc(sizeof(long) * num_juncoes);
+        if (!juncoes) {
+            erro = -1;
+        } else {
+            size_t pos = num_juncoes;
+            for (long v = alvos[melhor_alvo].no; v != -1; v = predecessores[v]) juncoes[--pos] = v;
+
+            // Trecho inicial: da origem (interna a uma cadeia) até a primeira junção
+            long raiz = juncoes[0];
+            if (cadeia_s >= 0) {
+                int sentido = -1;
+                for (int i = 0; i < num_sementes; ++i) {
+                    if (sementes[i].no == raiz && sementes[i].custo == distancias[raiz] &&
+                        (sentido < 0 || sementes[i].custo < sementes[sentido].custo)) {
+                        sentido = i;
+                    }
+                }
+                ssize_t p = (ssize_t)gc->posicao_na_cadeia[s];
+                if (sementes[sentido].sentido == 1) {
+                    erro = adicionar_geometria(gc, &caminho, cadeia_s, p, tamanho_geometria(gc, cadeia_s) - 1);
+                } else {
+                    erro = adicionar_geometria(gc, &caminho, cadeia_s, p, 0);
+                }
+            }
+
+            // Junções intercaladas com a geometria de cada cadeia percorrida
+            if (!erro) erro = vetor_ids_adicionar(&caminho, gc->nucleo->pontos[raiz].id);
+            for (size_t i = 1; i < num_juncoes && !erro; ++i) {
+                long v = juncoes[i];
+                size_t cadeia = aresta_predecessora[v];
+                ssize_t tam = tamanho_geometria(gc, cadeia);
+                if (tam > 0) {
+                    const Aresta *a = &gc->nucleo->arestas[cadeia];
+                    int no_sentido = a->origem == gc->nucleo->pontos[juncoes[i - 1]].id;
+                    erro = no_sentido ? adicionar_geometria(gc, &caminho, cadeia, 0, tam - 1)
+                                      : adicionar_geometria(gc, &caminho, cadeia, tam - 1, 0);
+                }
+                if (!erro) erro = vetor_ids_adicionar(&caminho, gc->nucleo->pontos[v].id);
+            }
+
+            // Trecho final: da última junção até o destino interno à cadeia
+            if (!erro && cadeia_t >= 0) {
+                ssize_t p = (ssize_t)gc->posicao_na_cadeia[t];
+                if (alvos[melhor_alvo].sentido == 0) {
+                    erro = adicionar_geometria(gc, &caminho, cadeia_t, 0, p);
+                } else {
+                    erro = adicionar_geometria(gc, &caminho, cadeia_t, tamanho_geometria(gc, cadeia_t) - 1, p);
+                }
+            }
+            free(juncoes);
+        }
+    }
+
+    if (melhor != DBL_MAX && !erro) {
+        resultado->caminho = caminho.ids;
+        resultado->tamanho_caminho = caminho.tamanho;
+        resultado->distancia_total = melhor;
+        resultado->sucesso = 1;
+    } else {
+        free(caminho.ids);
+    }
+
+    free(distancias);
+    free(predecessores);
+    free(aresta_predecessora);
+    free(visitados);
+    liberar_fila_prioridade(fila);
+    return resultado;
+}
@@ -0,0 +1,603 @@
+#include "contraction.h"
+#include "graph.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#define NENHUM ((size_t)-1)
+
+// Limites da busca de testemunhas: ao estimar a prioridade basta uma busca
+// curta; na contração real uma busca maior evita atalhos desnecessários.
+// Parar cedo nunca quebra a correção, apenas cria atalhos a mais.
+#define TESTEMUNHA_SIMULACAO 50
+#define TESTEMUNHA_CONTRACAO 500
+
+// Arco do grafo que ainda está sendo contraído; nas listas de entrada,
+// vizinho é a origem do arco
+typedef struct {
+    size_t vizinho;
+    double peso;
+    size_t anterior;
+} ArcoDinamico;
+
+typedef struct {
+    ArcoDinamico *itens;
+    size_t tamanho;
+    size_t capacidade;
+} ListaArcos;
+
+typedef struct {
+    size_t n;
+    ListaArcos *saida;
+    ListaArcos *entrada;
+    unsigned char *contraido;
+    size_t *vizinhos_contraidos;
+    size_t num_atalhos;
+} GrafoContracao;
+
+static int empilhar_arco(ListaArcos *lista, ArcoDinamico arco) {
+    if (lista->tamanho == lista->capacidade) {
+        size_t nova = lista->capacidade ? lista->capacidade * 2 : 4;
+        ArcoDinamico *novos = realloc(lista->itens, nova * sizeof(ArcoDinamico));
+        if (!novos) return -1;
+        lista->itens = novos;
+        lista->capacidade = nova;
+    }
+    lista->itens[lista->tamanho++] = arco;
+    return 0;
+}
+
+static ArcoDinamico* procurar_arco(ListaArcos *lista, size_t vizinho) {
+    for (size_t k = 0; k < lista->tamanho; k++) {
+        if (lista->itens[k].vizinho == vizinho) return &lista->itens[k];
+    }
+    return NULL;
+}
+
+static void remover_arco(ListaArcos *lista, size_t vizinho) {
+    for (size_t k = 0; k < lista->tamanho; k++) {
+        if (lista->itens[k].vizinho == vizinho) {
+            lista->itens[k] = lista->itens[--lista->tamanho];
+            return;
+        }
+    }
+}
+
+// Insere o arco u -> w, ou reduz o peso de um já existente (arcos paralelos
+// e atalhos repetidos ficam só com o menor). Retorna 1 se inseriu, 0 se
+// reduziu/ignorou, -1 em caso de erro.
+static int inserir_arco(GrafoContracao *g, size_t u, size_t w, double peso, size_t anterior) {
+    ArcoDinamico *existente = procurar_arco(&g->saida[u], w);
+    if (existente) {
+        if (peso < existente->peso) {
+            existente->peso = peso;
+            existente->anterior = anterior;
+            ArcoDinamico *reverso = procurar_arco(&g->entrada[w], u);
+            reverso->peso = peso;
+            reverso->anterior = anterior;
+        }
+        return 0;
+    }
+    if (empilhar_arco(&g->saida[u], (ArcoDinamico){w, peso, anterior}) != 0) return -1;
+    if (empilhar_arco(&g->entrada[w], (ArcoDinamico){u, peso, anterior}) != 0) return -1;
+    return 1;
+}
+
+static void liberar_grafo_contracao(GrafoContracao *g) {
+    for (size_t v = 0; g->saida && v < g->n; v++) free(g->saida[v].itens);
+    for (size_t v = 0; g->entrada && v < g->n; v++) free(g->entrada[v].itens);
+    free(g->saida);
+    free(g->entrada);
+    free(g->contraido);
+    free(g->vizinhos_contraidos);
+}
+
+// Dijkstra limitado a partir de origem no grafo restante, sem passar por
+// ignorado. As distâncias provisórias também servem de testemunha: cada uma
+// corresponde a um caminho real.
+static void buscar_testemunhas(const GrafoContracao *g, EspacoBusca *espaco, size_t origem,
+                               size_t ignorado, double limite, int max_estabelecidos) {
+    reiniciar_espaco_busca(espaco);
+    uint32_t epoca = espaco->epoca;
+    espaco->marca[origem] = epoca;
+    espaco->distancias[origem] = 0.0;
+    inserir_fila_prioridade(espaco->fila, (long)origem, 0.0);
+
+    int estabelecidos = 0;
+    while (!fila_vazia(espaco->fila)) {
+        NoFilaPrioridade no = extrair_minimo(espaco->fila);
+        size_t atual = (size_t)no.ponto_id;
+        if (no.distancia > espaco->distancias[atual]) continue;
+        if (no.distancia > limite || ++estabelecidos > max_estabelecidos) break;
+        const ListaArcos *saida = &g->saida[atual];
+        for (size_t k = 0; k < saida->tamanho; k++) {
+            size_t w = saida->itens[k].vizinho;
+            if (w == ignorado) continue;
+            double nova = no.distancia + saida->itens[k].peso;
+            if (espaco->marca[w] != epoca || nova < espaco->distancias[w]) {
+                espaco->marca[w] = epoca;
+                espaco->distancias[w] = nova;
+                inserir_fila_prioridade(espaco->fila, (long)w, nova);
+            }
+        }
+    }
+}
+
+// Conta (simular) ou cria os atalhos necessários para retirar v do grafo.
+// Retorna o número de atalhos, ou -1 em caso de erro.
+static long contrair(GrafoContracao *g, EspacoBusca *espaco, size_t v, int simular) {
+    long atalhos = 0;
+    ListaArcos *entrada = &g->entrada[v];
+    ListaArcos *saida = &g->saida[v];
+    for (size_t a = 0; a < entrada->tamanho; a++) {
+        size_t u = entrada->itens[a].vizinho;
+        double peso_uv = entrada->itens[a].peso;
+        double limite = -1.0;
+        for (size_t b = 0; b < saida->tamanho; b++) {
+            if (saida->itens[b].vizinho != u && peso_uv + saida->itens[b].peso > limite)
+                limite = peso_uv + saida->itens[b].peso;
+        }
+        if (limite < 0.0) continue;
+        buscar_testemunhas(g, espaco, u, v, limite,
+                           simular ? TESTEMUNHA_SIMULACAO : TESTEMUNHA_CONTRACAO);
+        for (size_t b = 0; b < saida->tamanho; b++) {
+            size_t w = saida->itens[b].vizinho;
+            if (w == u) continue;
+            double custo = peso_uv + saida->itens[b].peso;
+            if (espaco->marca[w] == espaco->epoca && espaco->distancias[w] <= custo) continue;
+            atalhos++;
+            if (!simular) {
+                int r = inserir_arco(g, u, w, custo, saida->itens[b].anterior);
+                if (r < 0) return -1;
+                g->num_atalhos += (size_t)r;
+            }
+        }
+    }
+    return atalhos;
+}
+
+// Diferença de arestas mais vizinhos já contraídos (espalha a contração)
+static double prioridade(GrafoContracao *g, EspacoBusca *espaco, size_t v) {
+    long atalhos = contrair(g, espaco, v, 1);
+    return (double)atalhos - (double)(g->entrada[v].tamanho + g->saida[v].tamanho) +
+           (double)g->vizinhos_contraidos[v];
+}
+
+// Copia as listas finais (vizinhos de nível maior) para o formato CSR
+static int copiar_para_csr(Arena *arena, const ListaArcos *listas, size_t n,
+                           size_t **inicio, ArcoHierarquia **arcos) {
+    *inicio = arena_alocar(arena, (n + 1) * sizeof(size_t));
+    if (!*inicio) return -1;
+    (*inicio)[0] = 0;
+    for (size_t v = 0; v < n; v++) (*inicio)[v + 1] = (*inicio)[v] + listas[v].tamanho;
+    *arcos = arena_alocar(arena, ((*inicio)[n] ? (*inicio)[n] : 1) * sizeof(ArcoHierarquia));
+    if (!*arcos) return -1;
+    for (size_t v = 0; v < n; v++) {
+        for (size_t k = 0; k < listas[v].tamanho; k++) {
+            const ArcoDinamico *a = &listas[v].itens[k];
+            (*arcos)[(*inicio)[v] + k] = (ArcoHierarquia){a->vizinho, a->peso, a->anterior};
+        }
+    }
+    return 0;
+}
+
+void liberar_hierarquia(HierarquiaContracao *hierarquia) {
+    // A própria estrutura mora na arena
+    if (hierarquia) arena_liberar(hierarquia->arena);
+}
+
+HierarquiaContracao* construir_hierarquia(Grafo *grafo) {
+    const IndicesGrafo *indices = obter_indices(grafo);
+    if (!indices) return NULL;
+
+    size_t n = indices->num_pontos;
+    GrafoContracao g = {0};
+    g.n = n;
+    g.saida = calloc(n ? n : 1, sizeof(ListaArcos));
+    g.entrada = calloc(n ? n : 1, sizeof(ListaArcos));
+    g.contraido = calloc(n ? n : 1, 1);
+    g.vizinhos_contraidos = calloc(n ? n : 1, sizeof(size_t));
+    double *prioridades = malloc((n ? n : 1) * sizeof(double));
+    EspacoBusca *espaco = criar_espaco_busca(n);
+    FilaPrioridade *fila = criar_fila_prioridade(n ? (int)n : 1);
+    Arena *arena = NULL;
+    HierarquiaContracao *hierarquia = NULL;
+    if (!g.saida || !g.entrada || !g.contraido || !g.vizinhos_contraidos || !prioridades || !espaco || !fila) {
+        goto fim;
+    }
+
+    for (size_t u = 0; u < n; u++) {
+        for (size_t k = indices->inicio_arcos[u]; k < indices->inicio_arcos[u + 1]; k++) {
+            size_t v = indices->arcos[k].destino;
+            if (v != u && inserir_arco(&g, u, v, indices->arcos[k].peso, u) < 0) goto fim;
+        }
+    }
+
+    for (size_t v = 0; v < n; v++) {
+        prioridades[v] = prioridade(&g, espaco, v);
+        inserir_fila_prioridade(fila, (long)v, prioridades[v]);
+    }
+
+    arena = arena_criar(0);
+    if (!arena) goto fim;
+    hierarquia = arena_alocar_zerado(arena, sizeof(HierarquiaContracao));
+    if (!hierarquia) goto fim;
+    hierarquia->arena = arena;
+    hierarquia->num_pontos = n;
+    hierarquia->nivel = arena_alocar(arena, (n ? n : 1) * sizeof(size_t));
+    if (!hierarquia->nivel) goto fim;
+
+    size_t proximo_nivel = 0;
+    while (!fila_vazia(fila)) {
+        NoFilaPrioridade no = extrair_minimo(fila);
+        size_t v = (size_t)no.ponto_id;
+        // Entradas obsoletas: ponto já contraído ou prioridade já recalculada
+        if (g.contraido[v] || no.distancia != prioridades[v]) continue;
+
+        // Atualização preguiçosa: se piorou, volta para a fila
+        double atual = prioridade(&g, espaco, v);
+        if (atual > no.distancia && !fila_vazia(fila) && atual > fila->nos[0].distancia) {
+            prioridades[v] = atual;
+            inserir_fila_prioridade(fila, (long)v, atual);
+            continue;
+        }
+
+        if (contrair(&g, espaco, v, 0) < 0) goto fim;
+        g.contraido[v] = 1;
+        hierarquia->nivel[v] = proximo_nivel++;
+
+        // As listas de v ficam como estão (só têm vizinhos de nível maior) e
+        // os vizinhos deixam de enxergar v. A prioridade deles não é refeita
+        // aqui: a atualização preguiçosa acima corrige quando forem retirados,
+        // com a mesma qualidade e bem menos buscas de testemunha.
+        for (size_t k = 0; k < g.saida[v].tamanho; k++) {
+            size_t w = g.saida[v].itens[k].vizinho;
+            remover_arco(&g.entrada[w], v);
+            g.vizinhos_contraidos[w]++;
+        }
+        for (size_t k = 0; k < g.entrada[v].tamanho; k++) {
+            size_t u = g.entrada[v].itens[k].vizinho;
+            remover_arco(&g.saida[u], v);
+            g.vizinhos_contraidos[u]++;
+        }
+    }
+
+    if (proximo_nivel != n ||
+        copiar_para_csr(arena, g.saida, n, &hierarquia->inicio_subida, &hierarquia->subida) != 0 ||
+        copiar_para_csr(arena, g.entrada, n, &hierarquia->inicio_descida, &hierarquia->descida) != 0) {
+        goto fim;
+    }
+    hierarquia->num_atalhos = g.num_atalhos;
+    arena = NULL; // Agora pertence à hierarquia
+
+fim:
+    if (arena) {
+        arena_liberar(arena);
+        hierarquia = NULL;
+    }
+    liberar_grafo_contracao(&g);
+    free(prioridades);
+    liberar_espaco_busca(espaco);
+    liberar_fila_prioridade(fila);
+    return hierarquia;
+}
+
+// ---------------------------------------------------------------------------
+// Muitos-para-muitos por baldes
+
+typedef struct {
+    size_t *itens;
+    size_t tamanho;
+    size_t capacidade;
+} VetorIndices;
+
+// Entrada deixada num ponto v pela busca reversa de um destino
+typedef struct {
+    size_t destino;     // Coluna na matriz
+    double distancia;   // Distância de v até o destino
+    size_t anterior;    // Ponto antes do destino no caminho (NENHUM se v é o destino)
+} EntradaBalde;
+
+typedef struct {
+    size_t ponto;
+    EntradaBalde entrada;
+} EntradaPendente;
+
+typedef struct {
+    EntradaPendente *itens;
+    size_t tamanho;
+    size_t capacidade;
+} VetorPendentes;
+
+typedef struct {
+    const HierarquiaContracao *hierarquia;
+    const Grafo *grafo;
+    const size_t *origens;
+    const size_t *destinos;
+    MatrizDistancias *matriz;
+    VetorPendentes *pendentes;      // Um por thread (fase reversa)
+    const size_t *inicio_balde;     // Baldes em CSR (fase direta)
+    const EntradaBalde *baldes;
+    atomic_size_t proximo;
+    atomic_int erro;
+} TrabalhoBaldes;
+
+typedef struct {
+    TrabalhoBaldes *trabalho;
+    int id;
+} ArgumentoBaldes;
+
+static int empilhar_indice(VetorIndices *v, size_t indice) {
+    if (v->tamanho == v->capacidade) {
+        size_t nova = v->capacidade ? v->capacidade * 2 : 64;
+        size_t *novos = realloc(v->itens, nova * sizeof(size_t));
+        if (!novos) return -1;
+        v->itens = novos;
+        v->capacidade = nova;
+    }
+    v->itens[v->tamanho++] = indice;
+    return 0;
+}
+
+static int empilhar_pendente(VetorPendentes *v, EntradaPendente item) {
+    if (v->tamanho == v->capacidade) {
+        size_t nova = v->capacidade ? v->capacidade * 2 : 256;
+        EntradaPendente *novos = realloc(v->itens, nova * sizeof(EntradaPendente));
+        if (!novos) return -1;
+        v->itens = novos;
+        v->capacidade = nova;
+    }
+    v->itens[v->tamanho++] = item;
+    return 0;
+}
+
+// Busca para cima: pela subida ou, com reversa = 1, pela descida a partir
+// de um destino. Os pontos estabelecidos vão para alcancados, e
+// predecessores guarda o ponto anterior à ponta do caminho desempacotado
+// (o destino, na reversa), que é o que a matriz precisa. Um ponto que um
+// vizinho de nível maior alcança por menos é "estacionado": não está em
+// nenhum caminho mínimo, então não expande nem entra em alcancados.
+static int buscar_para_cima(const HierarquiaContracao *h, EspacoBusca *espaco, size_t origem,
+                            int reversa, VetorIndices *alcancados) {
+    const size_t *inicio = reversa ? h->inicio_descida : h->inicio_subida;
+    const ArcoHierarquia *arcos = reversa ? h->descida : h->subida;
+    const size_t *inicio_oposto = reversa ? h->inicio_subida : h->inicio_descida;
+    const ArcoHierarquia *opostos = reversa ? h->subida : h->descida;
+
+    reiniciar_espaco_busca(espaco);
+    alcancados->tamanho = 0;
+    uint32_t epoca = espaco->epoca;
+    espaco->marca[origem] = epoca;
+    espaco->distancias[origem] = 0.0;
+    espaco->predecessores[origem] = NENHUM;
+    inserir_fila_prioridade(espaco->fila, (long)origem, 0.0);
+
+    while (!fila_vazia(espaco->fila)) {
+        NoFilaPrioridade no = extrair_minimo(espaco->fila);
+        size_t atual = (size_t)no.ponto_id;
+        if (espaco->estabelecido[atual] == epoca) continue;
+        espaco->estabelecido[atual] = epoca;
+
+        int estacionado = 0;
+        for (size_t k = inicio_oposto[atual]; k < inicio_oposto[atual + 1] && !estacionado; k++) {
+            size_t x = opostos[k].destino;
+            if (espaco->marca[x] == epoca && espaco->distancias[x] + opostos[k].peso < no.distancia)
+                estacionado = 1;
+        }
+        if (estacionado) continue;
+        if (empilhar_indice(alcancados, atual) != 0) return -1;
+
+        for (size_t k = inicio[atual]; k < inicio[atual + 1]; k++) {
+            size_t x = arcos[k].destino;
+            double nova = no.distancia + arcos[k].peso;
+            if (espaco->marca[x] != epoca || nova < espaco->distancias[x]) {
+                espaco->marca[x] = epoca;
+                espaco->distancias[x] = nova;
+                if (reversa && atual != origem) {
+                    espaco->predecessores[x] = espaco->predecessores[atual];
+                } else {
+                    espaco->predecessores[x] = arcos[k].anterior;
+                }
+                inserir_fila_prioridade(espaco->fila, (long)x, nova);
+            }
+        }
+    }
+    return 0;
+}
+
+// Fase 1: cada destino deixa entradas nos pontos da sua busca reversa
+static void* trabalhar_reversa(void *arg) {
+    ArgumentoBaldes *a = arg;
+    TrabalhoBaldes *t = a->trabalho;
+    VetorPendentes *pendentes = &t->pendentes[a->id];
+    VetorIndices alcancados = {0};
+    EspacoBusca *espaco = criar_espaco_busca(t->hierarquia->num_pontos);
+    if (!espaco) {
+        atomic_store(&t->erro, 1);
+        return NULL;
+    }
+    for (;;) {
+        size_t j = atomic_fetch_add(&t->proximo, 1);
+        if (j >= t->matriz->num_destinos || atomic_load(&t->erro)) break;
+        if (t->destinos[j] == NENHUM) continue;
+        if (buscar_para_cima(t->hierarquia, espaco, t->destinos[j], 1, &alcancados) != 0) {
+            atomic_store(&t->erro, 1);
+            break;
+        }
+        for (size_t k = 0; k < alcancados.tamanho; k++) {
+            size_t v = alcancados.itens[k];
+            EntradaPendente item = {v, {j, espaco->distancias[v], espaco->predecessores[v]}};
+            if (empilhar_pendente(pendentes, item) != 0) atomic_store(&t->erro, 1);
+        }
+    }
+    free(alcancados.itens);
+    liberar_espaco_busca(espaco);
+    return NULL;
+}
+
+// Fase 2: cada origem sobe e combina suas distâncias com os baldes
+static void* trabalhar_direta(void *arg) {
+    ArgumentoBaldes *a = arg;
+    TrabalhoBaldes *t = a->trabalho;
+    MatrizDistancias *m = t->matriz;
+    VetorIndices alcancados = {0};
+    EspacoBusca *espaco = criar_espaco_busca(t->hierarquia->num_pontos);
+    if (!espaco) {
+        atomic_store(&t->erro, 1);
+        return NULL;
+    }
+    for (;;) {
+        size_t i = atomic_fetch_add(&t->proximo, 1);
+        if (i >= m->num_origens || atomic_load(&t->erro)) break;
+        double *linha = m->distancias + i * m->num_destinos;
+        long *anteriores = m->predecessores ? m->predecessores + i * m->num_destinos : NULL;
+        for (size_t j = 0; j < m->num_destinos; j++) {
+            linha[j] = DBL_MAX;
+            if (anteriores) anteriores[j] = -1;
+        }
+
+        size_t origem = t->origens[i];
+        if (origem != NENHUM) {
+            if (buscar_para_cima(t->hierarquia, espaco, origem, 0, &alcancados) != 0) {
+                atomic_store(&t->erro, 1);
+                break;
+            }
+            for (size_t k = 0; k < alcancados.tamanho; k++) {
+                size_t v = alcancados.itens[k];
+                double d = espaco->distancias[v];
+                for (size_t e = t->inicio_balde[v]; e < t->inicio_balde[v + 1]; e++) {
+                    const EntradaBalde *entrada = &t->baldes[e];
+                    double candidata = d + entrada->distancia;
+                    if (candidata >= linha[entrada->destino]) continue;
+                    linha[entrada->destino] = candidata;
+                    if (anteriores) {
+                        size_t anterior = entrada->anterior != NENHUM ? entrada->anterior
+                                                                      : espaco->predecessores[v];
+                        anteriores[entrada->destino] = anterior != NENHUM ? t->grafo->pontos[anterior].id : -1;
+                    }
+                }
+            }
+        }
+        for (size_t j = 0; j < m->num_destinos; j++) {
+            if (linha[j] == DBL_MAX) linha[j] = -1.0;
+        }
+    }
+    free(alcancados.itens);
+    liberar_espaco_busca(espaco);
+    return NULL;
+}
+
+// Roda funcao em num_threads threads (a principal é a de id 0). Se alguma
+// não puder ser criada, as demais pegam o trabalho dela.
+static void executar_em_threads(TrabalhoBaldes *t, int num_threads, void *(*funcao)(void *)) {
+    pthread_t *threads = calloc((size_t)num_threads, sizeof(pthread_t));
+    ArgumentoBaldes *argumentos = calloc((size_t)num_threads, sizeof(ArgumentoBaldes));
+    atomic_store(&t->proximo, 0);
+    int criadas = 1;
+    for (int id = 1; threads && argumentos && id < num_threads; id++) {
+        argumentos[id] = (ArgumentoBaldes){t, id};
+        if (pthread_create(&threads[id], NULL, funcao, &argumentos[id]) != 0) break;
+        criadas++;
+    }
+    ArgumentoBaldes principal = {t, 0};
+    funcao(&principal);
+    for (int id = 1; id < criadas; id++) pthread_join(threads[id], NULL);
+    free(threads);
+    free(argumentos);
+}
+
+MatrizDistancias* matriz_distancias_hierarquia(const HierarquiaContracao *hierarquia, Grafo *grafo,
+                                               const long *origens, size_t num_origens,
+                                               const long *destinos, size_t num_destinos,
+                                               int com_predecessores, int num_threads) {
+    if (!hierarquia || !grafo || hierarquia->num_pontos != grafo->num_pontos ||
+        (num_origens && !origens) || (num_destinos && !destinos)) {
+        return NULL;
+    }
+    size_t n = hierarquia->num_pontos;
+
+    if (num_threads <= 0) {
+        long processadores = sysconf(_SC_NPROCESSORS_ONLN);
+        num_threads = processadores > 0 ? (int)processadores : 1;
+    }
+    size_t maior_lado = num_origens > num_destinos ? num_origens : num_destinos;
+    if ((size_t)num_threads > maior_lado) num_threads = maior_lado ? (int)maior_lado : 1;
+
+    size_t celulas = num_origens * num_destinos;
+    MatrizDistancias *matriz = calloc(1, sizeof(MatrizDistancias));
+    size_t *indices_origem = malloc((num_origens ? num_origens : 1) * sizeof(size_t));
+    size_t *indices_destino = malloc((num_destinos ? num_destinos : 1) * sizeof(size_t));
+    VetorPendentes *pendentes = calloc((size_t)num_threads, sizeof(VetorPendentes));
+    size_t *inicio_balde = calloc(n + 1, sizeof(size_t));
+    EntradaBalde *baldes = NULL;
+    if (matriz) {
+        matriz->num_origens = num_origens;
+        matriz->num_destinos = num_destinos;
+        matriz->distancias = malloc((celulas ? celulas : 1) * sizeof(double));
+        if (com_predecessores) matriz->predecessores = malloc((celulas ? celulas : 1) * sizeof(long));
+    }
+    if (!matriz || !indices_origem || !indices_destino || !pendentes || !inicio_balde ||
+        !matriz->distancias || (com_predecessores && !matriz->predecessores)) {
+        goto erro;
+    }
+
+    for (size_t i = 0; i < num_origens; i++) {
+        ssize_t o = buscar_indice_ponto(grafo, origens[i]);
+        indices_origem[i] = o >= 0 ? (size_t)o : NENHUM;
+    }
+    for (size_t j = 0; j < num_destinos; j++) {
+        ssize_t d = buscar_indice_ponto(grafo, destinos[j]);
+        indices_destino[j] = d >= 0 ? (size_t)d : NENHUM;
+    }
+
+    TrabalhoBaldes trabalho = {
+        .hierarquia = hierarquia, .grafo = grafo, .origens = indices_origem,
+        .destinos = indices_destino, .matriz = matriz, .pendentes = pendentes
+    };
+    atomic_init(&trabalho.proximo, 0);
+    atomic_init(&trabalho.erro, 0);
+
+    executar_em_threads(&trabalho, num_threads, trabalhar_reversa);
+    if (atomic_load(&trabalho.erro)) goto erro;
+
+    // Juntar as entradas de todas as threads em baldes por ponto (CSR)
+    for (int id = 0; id < num_threads; id++) {
+        for (size_t k = 0; k < pendentes[id].tamanho; k++) inicio_balde[pendentes[id].itens[k].ponto + 1]++;
+    }
+    for (size_t v = 0; v < n; v++) inicio_balde[v + 1] += inicio_balde[v];
+    baldes = malloc((inicio_balde[n] ? inicio_balde[n] : 1) * sizeof(EntradaBalde));
+    if (!baldes) goto erro;
+    for (int id = 0; id < num_threads; id++) {
+        for (size_t k = 0; k < pendentes[id].tamanho; k++) {
+            const EntradaPendente *p = &pendentes[id].itens[k];
+            baldes[inicio_balde[p->ponto]++] = p->entrada;
+        }
+        free(pendentes[id].itens);
+        pendentes[id].itens = NULL;
+    }
+    // O preenchimento avançou cada início até o fim do balde: recuar um balde
+    for (size_t v = n; v > 0; v--) inicio_balde[v] = inicio_balde[v - 1];
+    inicio_balde[0] = 0;
+
+    trabalho.inicio_balde = inicio_balde;
+    trabalho.baldes = baldes;
+    executar_em_threads(&trabalho, num_threads, trabalhar_direta);
+    if (atomic_load(&trabalho.erro)) goto erro;
+    goto fim;
+
+erro:
+    liberar_matriz_distancias(matriz);
+    matriz = NULL;
+fim:
+    for (int id = 0; pendentes && id < num_threads; id++) free(pendentes[id].itens);
+    free(pendentes);
+    free(indices_origem);
+    free(indices_destino);
+    free(inicio_balde);
+    free(baldes);
+    return matriz;
+}
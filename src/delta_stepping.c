@@ -0,0 +1,330 @@
+#include "delta_stepping.h"
+#include "graph.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <unistd.h>
+
+// Fronteiras menores que isto são relaxadas pela thread principal sozinha:
+// acordar as demais custaria mais que o trabalho
+#define LIMIAR_PARALELO 512
+
+typedef struct {
+    size_t *itens;
+    size_t tamanho;
+    size_t capacidade;
+} VetorIndices;
+
+static int empilhar_indice(VetorIndices *v, size_t indice) {
+    if (v->tamanho == v->capacidade) {
+        size_t nova = v->capacidade ? v->capacidade * 2 : 64;
+        size_t *novos = realloc(v->itens, nova * sizeof(size_t));
+        if (!novos) return -1;
+        v->itens = novos;
+        v->capacidade = nova;
+    }
+    v->itens[v->tamanho++] = indice;
+    return 0;
+}
+
+// Barreira simples (pthread_barrier_t não existe em todas as plataformas)
+typedef struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    int total;
+    int esperando;
+    unsigned geracao;
+} Barreira;
+
+static void iniciar_barreira(Barreira *b, int total) {
+    pthread_mutex_init(&b->mutex, NULL);
+    pthread_cond_init(&b->cond, NULL);
+    b->total = total;
+    b->esperando = 0;
+    b->geracao = 0;
+}
+
+static void destruir_barreira(Barreira *b) {
+    pthread_mutex_destroy(&b->mutex);
+    pthread_cond_destroy(&b->cond);
+}
+
+// Ajusta o número de participantes (usado se alguma thread não pôde ser criada)
+static void redimensionar_barreira(Barreira *b, int total) {
+    pthread_mutex_lock(&b->mutex);
+    b->total = total;
+    pthread_mutex_unlock(&b->mutex);
+}
+
+static void esperar_barreira(Barreira *b) {
+    pthread_mutex_lock(&b->mutex);
+    unsigned geracao = b->geracao;
+    if (++b->esperando == b->total) {
+        b->esperando = 0;
+        b->geracao++;
+        pthread_cond_broadcast(&b->cond);
+    } else {
+        while (geracao == b->geracao) pthread_cond_wait(&b->cond, &b->mutex);
+    }
+    pthread_mutex_unlock(&b->mutex);
+}
+
+// Distâncias não negativas guardadas como bits de double: para valores >= 0
+// a ordem dos inteiros coincide com a dos doubles, então um CAS de inteiros
+// implementa o "mínimo atômico"
+static inline uint64_t bits_de(double valor) {
+    uint64_t bits;
+    memcpy(&bits, &valor, sizeof(bits));
+    return bits;
+}
+
+static inline double valor_de(uint64_t bits) {
+    double valor;
+    memcpy(&valor, &bits, sizeof(valor));
+    return valor;
+}
+
+static inline int relaxar_minimo(_Atomic uint64_t *alvo, double valor) {
+    uint64_t novo = bits_de(valor);
+    uint64_t atual = atomic_load_explicit(alvo, memory_order_relaxed);
+    while (novo < atual) {
+        if (atomic_compare_exchange_weak_explicit(alvo, &atual, novo,
+                                                  memory_order_relaxed, memory_order_relaxed)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+typedef struct {
+    const IndicesGrafo *indices;
+    _Atomic uint64_t *distancias;
+    double delta;
+    int num_threads;
+
+    // Fase corrente, preenchida pela thread principal antes da barreira de início
+    const size_t *fronteira;
+    size_t tamanho_fronteira;
+    int pesados;            // 0: arcos leves (<= delta); 1: arcos pesados
+    int terminar;
+    atomic_int erro;        // Falta de memória em alguma thread
+
+    VetorIndices *melhorados; // Pontos cuja distância caiu, por thread
+    Barreira inicio;
+    Barreira fim;
+} EstadoDelta;
+
+typedef struct {
+    EstadoDelta *estado;
+    int id;
+} ArgumentoThread;
+
+static void relaxar_intervalo(EstadoDelta *e, int id, size_t de, size_t ate) {
+    const IndicesGrafo *indices = e->indices;
+    VetorIndices *saida = &e->melhorados[id];
+    for (size_t f = de; f < ate; f++) {
+        size_t u = e->fronteira[f];
+        double du = valor_de(atomic_load_explicit(&e->distancias[u], memory_order_relaxed));
+        for (size_t k = indices->inicio_arcos[u]; k < indices->inicio_arcos[u + 1]; k++) {
+            const Arco *arco = &indices->arcos[k];
+            if (e->pesados ? arco->peso <= e->delta : arco->peso > e->delta) continue;
+            if (relaxar_minimo(&e->distancias[arco->destino], du + arco->peso) &&
+                empilhar_indice(saida, arco->destino) != 0) {
+                atomic_store(&e->erro, 1);
+            }
+        }
+    }
+}
+
+static void relaxar_fatia(EstadoDelta *e, int id) {
+    size_t n = e->tamanho_fronteira;
+    size_t de = n * (size_t)id / (size_t)e->num_threads;
+    size_t ate = n * (size_t)(id + 1) / (size_t)e->num_threads;
+    relaxar_intervalo(e, id, de, ate);
+}
+
+static void* executar_trabalhador(void *arg) {
+    ArgumentoThread *a = arg;
+    EstadoDelta *e = a->estado;
+    for (;;) {
+        esperar_barreira(&e->inicio);
+        if (e->terminar) break;
+        relaxar_fatia(e, a->id);
+        esperar_barreira(&e->fim);
+    }
+    return NULL;
+}
+
+// Relaxa os arcos (leves ou pesados) de toda a fronteira
+static void executar_fase(EstadoDelta *e, const VetorIndices *fronteira, int pesados) {
+    e->fronteira = fronteira->itens;
+    e->tamanho_fronteira = fronteira->tamanho;
+    e->pesados = pesados;
+    if (e->num_threads == 1 || fronteira->tamanho < LIMIAR_PARALELO) {
+        relaxar_intervalo(e, 0, 0, fronteira->tamanho);
+        return;
+    }
+    esperar_barreira(&e->inicio);
+    relaxar_fatia(e, 0);
+    esperar_barreira(&e->fim);
+}
+
+// Coloca cada ponto melhorado no balde da sua nova distância
+static int distribuir_melhorados(EstadoDelta *e, VetorIndices **baldes, size_t *num_baldes) {
+    for (int t = 0; t < e->num_threads; t++) {
+        VetorIndices *lista = &e->melhorados[t];
+        for (size_t i = 0; i < lista->tamanho; i++) {
+            size_t v = lista->itens[i];
+            double d = valor_de(atomic_load_explicit(&e->distancias[v], memory_order_relaxed));
+            size_t b = (size_t)(d / e->delta);
+            if (b >= *num_baldes) {
+                size_t novo = *num_baldes * 2 > b + 1 ? *num_baldes * 2 : b + 1;
+                VetorIndices *novos = realloc(*baldes, novo * sizeof(VetorIndices));
+                if (!novos) return -1;
+                memset(novos + *num_baldes, 0, (novo - *num_baldes) * sizeof(VetorIndices));
+                *baldes = novos;
+                *num_baldes = novo;
+            }
+            if (empilhar_indice(&(*baldes)[b], v) != 0) return -1;
+        }
+        lista->tamanho = 0;
+    }
+    return 0;
+}
+
+// Largura padrão dos baldes: alguns arcos médios
+static double escolher_delta(const IndicesGrafo *indices) {
+    double soma = 0.0;
+    for (size_t k = 0; k < indices->num_arcos; k++) soma += indices->arcos[k].peso;
+    double media = indices->num_arcos ? soma / indices->num_arcos : 0.0;
+    return media > 0.0 ? 4.0 * media : 1.0;
+}
+
+double* delta_stepping(Grafo *grafo, long origem_id, double delta, int num_threads) {
+    const IndicesGrafo *indices = obter_indices(grafo);
+    if (!indices) return NULL;
+    ssize_t origem = buscar_indice_ponto(grafo, origem_id);
+    if (origem < 0) return NULL;
+
+    if (num_threads <= 0) {
+        long processadores = sysconf(_SC_NPROCESSORS_ONLN);
+        num_threads = processadores > 0 ? (int)processadores : 1;
+    }
+    if (delta <= 0.0) delta = escolher_delta(indices);
+
+    size_t n = grafo->num_pontos;
+    EstadoDelta e;
+    memset(&e, 0, sizeof(e));
+    e.indices = indices;
+    e.delta = delta;
+    e.num_threads = num_threads;
+    e.distancias = malloc(n * sizeof(_Atomic uint64_t));
+    e.melhorados = calloc((size_t)num_threads, sizeof(VetorIndices));
+    size_t num_baldes = 64;
+    VetorIndices *baldes = calloc(num_baldes, sizeof(VetorIndices));
+    uint32_t *marca_fronteira = calloc(n, sizeof(uint32_t));
+    uint32_t *marca_balde = calloc(n, sizeof(uint32_t));
+    pthread_t *threads = calloc((size_t)num_threads, sizeof(pthread_t));
+    ArgumentoThread *argumentos = calloc((size_t)num_threads, sizeof(ArgumentoThread));
+    VetorIndices fronteira = {0}, estabelecidos = {0};
+    double *resultado = NULL;
+    int threads_criadas = 1;
+
+    if (!e.distancias || !e.melhorados || !baldes || !marca_fronteira || !marca_balde ||
+        !threads || !argumentos) {
+        goto fim;
+    }
+
+    for (size_t v = 0; v < n; v++) atomic_init(&e.distancias[v], bits_de(DBL_MAX));
+    atomic_store(&e.distancias[origem], bits_de(0.0));
+    if (empilhar_indice(&baldes[0], (size_t)origem) != 0) goto fim;
+
+    iniciar_barreira(&e.inicio, num_threads);
+    iniciar_barreira(&e.fim, num_threads);
+    for (int t = 1; t < num_threads; t++) {
+        argumentos[t] = (ArgumentoThread){&e, t};
+        if (pthread_create(&threads[t], NULL, executar_trabalhador, &argumentos[t]) != 0) {
+            // Sem a thread, a barreira nunca completaria: seguir só com as já criadas
+            break;
+        }
+        threads_criadas++;
+    }
+    if (threads_criadas < num_threads) {
+        // As threads criadas ainda não chegaram ao fim da barreira de início,
+        // pois a principal não a alcançou: basta reduzir o total esperado
+        redimensionar_barreira(&e.inicio, threads_criadas);
+        redimensionar_barreira(&e.fim, threads_criadas);
+        e.num_threads = threads_criadas;
+    }
+
+    uint32_t epoca_fronteira = 0, epoca_balde = 0;
+    for (size_t i = 0; i < num_baldes && !e.erro; i++) {
+        if (baldes[i].tamanho == 0) continue;
+
+        // Esvaziar o balde i relaxando arcos leves até ele não receber mais pontos
+        epoca_balde++;
+        estabelecidos.tamanho = 0;
+        while (baldes[i].tamanho > 0 && !e.erro) {
+            epoca_fronteira++;
+            fronteira.tamanho = 0;
+            for (size_t j = 0; j < baldes[i].tamanho; j++) {
+                size_t v = baldes[i].itens[j];
+                double d = valor_de(atomic_load_explicit(&e.distancias[v], memory_order_relaxed));
+                // Entradas obsoletas: o ponto desceu para um balde anterior
+                if ((size_t)(d / delta) != i || marca_fronteira[v] == epoca_fronteira) continue;
+                marca_fronteira[v] = epoca_fronteira;
+                if (empilhar_indice(&fronteira, v) != 0) e.erro = 1;
+                if (marca_balde[v] != epoca_balde) {
+                    marca_balde[v] = epoca_balde;
+                    if (empilhar_indice(&estabelecidos, v) != 0) e.erro = 1;
+                }
+            }
+            baldes[i].tamanho = 0;
+            if (fronteira.tamanho == 0) break;
+            executar_fase(&e, &fronteira, 0);
+            if (distribuir_melhorados(&e, &baldes, &num_baldes) != 0) e.erro = 1;
+        }
+
+        // Arcos pesados só alcançam baldes posteriores: uma passada basta
+        executar_fase(&e, &estabelecidos, 1);
+        if (distribuir_melhorados(&e, &baldes, &num_baldes) != 0) e.erro = 1;
+    }
+
+    // Liberar os trabalhadores
+    e.terminar = 1;
+    if (e.num_threads > 1) esperar_barreira(&e.inicio);
+    for (int t = 1; t < e.num_threads; t++) pthread_join(threads[t], NULL);
+    destruir_barreira(&e.inicio);
+    destruir_barreira(&e.fim);
+
+    if (!e.erro) {
+        resultado = malloc(n * sizeof(double));
+        if (resultado) {
+            for (size_t v = 0; v < n; v++) {
+                resultado[v] = valor_de(atomic_load_explicit(&e.distancias[v], memory_order_relaxed));
+            }
+        }
+    }
+
+fim:
+    if (e.melhorados) {
+        for (int t = 0; t < num_threads; t++) free(e.melhorados[t].itens);
+    }
+    if (baldes) {
+        for (size_t b = 0; b < num_baldes; b++) free(baldes[b].itens);
+    }
+    free(baldes);
+    free(e.melhorados);
+    free((void *)e.distancias);
+    free(marca_fronteira);
+    free(marca_balde);
+    free(threads);
+    free(argumentos);
+    free(fronteira.itens);
+    free(estabelecidos.itens);
+    return resultado;
+}
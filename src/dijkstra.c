@@ -1,4 +1,7 @@
 #include "dijkstra.h"
+#include "graph.h"
+#include "components.h"
+#include "metrics.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -69,7 +72,14 @@ void heapify_down(FilaPrioridade *fila, int indice) {
 }
 
 void inserir_fila_prioridade(FilaPrioridade *fila, long ponto_id, double distancia) {
-    if (fila->tamanho >= fila->capacidade) return;
+    if (fila->tamanho >= fila->capacidade) {
+        // Inserções preguiçosas podem repetir pontos: crescer em vez de descartar
+        int nova_capacidade = fila->capacidade > 0 ? fila->capacidade * 2 : 16;
+        NoFilaPrioridade *novos = realloc(fila->nos, sizeof(NoFilaPrioridade) * nova_capacidade);
+        if (!novos) return;
+        fila->nos = novos;
+        fila->capacidade = nova_capacidade;
+    }
     
     fila->nos[fila->tamanho].ponto_id = ponto_id;
     fila->nos[fila->tamanho].distancia = distancia;
@@ -104,12 +114,7 @@ void diminuir_chave(FilaPrioridade *fila, long ponto_id, double nova_distancia)
 
 // Função auxiliar para encontrar índice de um ponto
 int encontrar_indice_ponto(Grafo *grafo, long ponto_id) {
-    for (size_t i = 0; i < grafo->num_pontos; i++) {
-        if (grafo->pontos[i].id == ponto_id) {
-            return i;
-        }
-    }
-    return -1;
+    return (int)buscar_indice_ponto(grafo, ponto_id);
 }
 
 // Função para reconstruir caminho
@@ -153,11 +158,28 @@ long* reconstruir_caminho(long *predecessores, int num_pontos, long origem_id, l
 }
 
 // Implementação principal do algoritmo de Dijkstra
+// A fila de prioridade armazena índices de pontos (não IDs) e os vizinhos
+// vêm da adjacência CSR, que já expande as arestas bidirecionais.
 ResultadoDijkstra* dijkstra(Grafo *grafo, long origem_id, long destino_id) {
+    return dijkstra_metrica(grafo, origem_id, destino_id, METRICA_DISTANCIA);
+}
+
+ResultadoDijkstra* dijkstra_metrica(Grafo *grafo, long origem_id, long destino_id, Metrica metrica) {
     if (!grafo || grafo->num_pontos == 0) {
         return NULL;
     }
     
+    const IndicesGrafo *indices = obter_indices(grafo);
+    if (!indices) {
+        return NULL;
+    }
+    
+    // A distância já está nos arcos; as outras métricas vêm de vetores à parte
+    const double *pesos = NULL;
+    if (metrica != METRICA_DISTANCIA && !(pesos = obter_pesos_metrica(grafo, metrica))) {
+        return NULL;
+    }
+    
     // Encontrar índices dos pontos de origem e destino
     int indice_origem = encontrar_indice_ponto(grafo, origem_id);
     int indice_destino = encontrar_indice_ponto(grafo, destino_id);
@@ -166,6 +188,18 @@ ResultadoDijkstra* dijkstra(Grafo *grafo, long origem_id, long destino_id) {
         return NULL;
     }
     
+    // Componentes diferentes: o destino é inalcançável, não é preciso buscar
+    if (!alcance_possivel(grafo, indice_origem, indice_destino)) {
+        ResultadoDijkstra *resultado = calloc(1, sizeof(ResultadoDijkstra));
+        if (resultado) resultado->distancia_total = -1.0;
+        return resultado;
+    }
+    
+    // Um ponto numa componente forte de número menor que a do destino não
+    // pode levar até ele, então esses pontos nem entram na fila
+    const size_t *componente = indices->componente_forte;
+    size_t componente_destino = componente ? componente[indice_destino] : 0;
+    
     int num_pontos = grafo->num_pontos;
     
     // Inicializar arrays
@@ -199,51 +233,43 @@ ResultadoDijkstra* dijkstra(Grafo *grafo, long origem_id, long destino_id) {
     }
     
     // Inserir ponto de origem na fila
-    inserir_fila_prioridade(fila, origem_id, 0.0);
+    inserir_fila_prioridade(fila, indice_origem, 0.0);
     
     // Executar algoritmo de Dijkstra
+    int nos_visitados = 0;
     while (!fila_vazia(fila)) {
         NoFilaPrioridade atual = extrair_minimo(fila);
-        int indice_atual = encontrar_indice_ponto(grafo, atual.ponto_id);
+        long indice_atual = atual.ponto_id;
         
-        if (indice_atual == -1 || visitados[indice_atual]) {
+        if (visitados[indice_atual]) {
             continue;
         }
         
         visitados[indice_atual] = 1;
+        nos_visitados++;
         
         // Se chegamos ao destino, podemos parar
-        if (atual.ponto_id == destino_id) {
+        if (indice_atual == indice_destino) {
             break;
         }
         
-        // Examinar todos os vizinhos
-        for (size_t i = 0; i < grafo->num_arestas; i++) {
-            Aresta *aresta = &grafo->arestas[i];
-            long vizinho_id = -1;
-            
-            // Determinar se esta aresta sai do ponto atual, respeitando direção
-            if (aresta->origem == atual.ponto_id) {
-                // Esta aresta sai do ponto atual
-                vizinho_id = aresta->destino;
-            } else if (aresta->destino == atual.ponto_id && aresta->is_bidirectional) {
-                // Esta aresta chega ao ponto atual, mas só podemos usar na direção reversa se for bidirecional
-                vizinho_id = aresta->origem;
-            } else {
-                continue; // Esta aresta não pode ser usada do ponto atual
+        // Examinar os arcos de saída (a direção já foi respeitada na adjacência)
+        for (size_t k = indices->inicio_arcos[indice_atual]; k < indices->inicio_arcos[indice_atual + 1]; k++) {
+            const Arco *arco = &indices->arcos[k];
+            size_t indice_vizinho = arco->destino;
+            if (visitados[indice_vizinho]) {
+                continue;
             }
-            
-            int indice_vizinho = encontrar_indice_ponto(grafo, vizinho_id);
-            if (indice_vizinho == -1 || visitados[indice_vizinho]) {
+            if (componente && componente[indice_vizinho] < componente_destino) {
                 continue;
             }
             
-            double nova_distancia = distancias[indice_atual] + aresta->peso;
+            double nova_distancia = distancias[indice_atual] + (pesos ? pesos[k] : arco->peso);
             
             if (nova_distancia < distancias[indice_vizinho]) {
                 distancias[indice_vizinho] = nova_distancia;
-                predecessores[indice_vizinho] = atual.ponto_id;
-                inserir_fila_prioridade(fila, vizinho_id, nova_distancia);
+                predecessores[indice_vizinho] = indice_atual;
+                inserir_fila_prioridade(fila, indice_vizinho, nova_distancia);
             }
         }
     }
@@ -257,6 +283,7 @@ ResultadoDijkstra* dijkstra(Grafo *grafo, long origem_id, long destino_id) {
         free(visitados);
         return NULL;
     }
+    resultado->nos_visitados = nos_visitados;
     
     // Verificar se caminho foi encontrado
     if (distancias[indice_destino] == DBL_MAX) {
@@ -266,44 +293,19 @@ ResultadoDijkstra* dijkstra(Grafo *grafo, long origem_id, long destino_id) {
         resultado->distancia_total = -1.0;
         resultado->sucesso = 0;
     } else {
-        // Reconstruir caminho completo usando predecessores
-        // Primeiro, contar o tamanho do caminho
+        // Contar o tamanho do caminho seguindo os predecessores
         int contador = 0;
-        long atual_id = destino_id;
-        int indice_atual = indice_destino;
-        
-        while (indice_atual != -1) {
+        for (long i = indice_destino; i != -1; i = predecessores[i]) {
             contador++;
-            if (atual_id == origem_id) break;
-            
-            // Encontrar o predecessor
-            long predecessor_id = predecessores[indice_atual];
-            if (predecessor_id == -1) break;
-            
-            // Encontrar índice do predecessor
-            indice_atual = encontrar_indice_ponto(grafo, predecessor_id);
-            atual_id = predecessor_id;
         }
         
-        // Alocar array para o caminho
+        // Preencher caminho de trás para frente, convertendo índices em IDs
         resultado->caminho = malloc(sizeof(long) * contador);
         if (resultado->caminho) {
-            // Preencher caminho de trás para frente
-            atual_id = destino_id;
-            indice_atual = indice_destino;
-            
-            for (int i = contador - 1; i >= 0; i--) {
-                resultado->caminho[i] = atual_id;
-                if (atual_id == origem_id) break;
-                
-                // Próximo predecessor
-                long predecessor_id = predecessores[indice_atual];
-                if (predecessor_id == -1) break;
-                
-                indice_atual = encontrar_indice_ponto(grafo, predecessor_id);
-                atual_id = predecessor_id;
+            int posicao = contador - 1;
+            for (long i = indice_destino; i != -1; i = predecessores[i]) {
+                resultado->caminho[posicao--] = grafo->pontos[i].id;
             }
-            
             resultado->tamanho_caminho = contador;
         } else {
             resultado->tamanho_caminho = 0;
@@ -321,6 +323,51 @@ ResultadoDijkstra* dijkstra(Grafo *grafo, long origem_id, long destino_id) {
     return resultado;
 }
 
+// Dijkstra completo a partir da origem: distância até cada ponto (por índice)
+double* dijkstra_distancias(Grafo *grafo, long origem_id) {
+    const IndicesGrafo *indices = obter_indices(grafo);
+    if (!indices) return NULL;
+    int indice_origem = encontrar_indice_ponto(grafo, origem_id);
+    if (indice_origem == -1) return NULL;
+    
+    size_t num_pontos = grafo->num_pontos;
+    double *distancias = malloc(sizeof(double) * num_pontos);
+    char *visitados = calloc(num_pontos, 1);
+    FilaPrioridade *fila = criar_fila_prioridade(1024);
+    if (!distancias || !visitados || !fila) {
+        free(distancias);
+        free(visitados);
+        liberar_fila_prioridade(fila);
+        return NULL;
+    }
+    for (size_t i = 0; i < num_pontos; i++) {
+        distancias[i] = DBL_MAX;
+    }
+    
+    distancias[indice_origem] = 0.0;
+    inserir_fila_prioridade(fila, indice_origem, 0.0);
+    while (!fila_vazia(fila)) {
+        long indice_atual = extrair_minimo(fila).ponto_id;
+        if (visitados[indice_atual]) {
+            continue;
+        }
+        visitados[indice_atual] = 1;
+        
+        for (size_t k = indices->inicio_arcos[indice_atual]; k < indices->inicio_arcos[indice_atual + 1]; k++) {
+            const Arco *arco = &indices->arcos[k];
+            double nova_distancia = distancias[indice_atual] + arco->peso;
+            if (nova_distancia < distancias[arco->destino]) {
+                distancias[arco->destino] = nova_distancia;
+                inserir_fila_prioridade(fila, arco->destino, nova_distancia);
+            }
+        }
+    }
+    
+    liberar_fila_prioridade(fila);
+    free(visitados);
+    return distancias;
+}
+
 void liberar_resultado_dijkstra(ResultadoDijkstra *resultado) {
     if (resultado) {
         free(resultado->caminho);
@@ -0,0 +1,311 @@
+#include "distance_matrix.h"
+#include "graph.h"
+#include "components.h"
+#include "metrics.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <unistd.h>
+
+// Marca de id desconhecido / ponto sem predecessor
+#define NENHUM ((size_t)-1)
+
+EspacoBusca* criar_espaco_busca(size_t num_pontos) {
+    EspacoBusca *espaco = calloc(1, sizeof(EspacoBusca));
+    if (!espaco) return NULL;
+    size_t n = num_pontos ? num_pontos : 1;
+    espaco->num_pontos = num_pontos;
+    espaco->distancias = malloc(n * sizeof(double));
+    espaco->predecessores = malloc(n * sizeof(size_t));
+    espaco->marca = calloc(n, sizeof(uint32_t));
+    espaco->estabelecido = calloc(n, sizeof(uint32_t));
+    espaco->alvo = calloc(n, sizeof(uint32_t));
+    espaco->fila = criar_fila_prioridade(64);
+    if (!espaco->distancias || !espaco->predecessores || !espaco->marca ||
+        !espaco->estabelecido || !espaco->alvo || !espaco->fila) {
+        liberar_espaco_busca(espaco);
+        return NULL;
+    }
+    return espaco;
+}
+
+void liberar_espaco_busca(EspacoBusca *espaco) {
+    if (espaco) {
+        free(espaco->distancias);
+        free(espaco->predecessores);
+        free(espaco->marca);
+        free(espaco->estabelecido);
+        free(espaco->alvo);
+        liberar_fila_prioridade(espaco->fila);
+        free(espaco);
+    }
+}
+
+void reiniciar_espaco_busca(EspacoBusca *espaco) {
+    if (++espaco->epoca == 0) {
+        memset(espaco->marca, 0, espaco->num_pontos * sizeof(uint32_t));
+        memset(espaco->estabelecido, 0, espaco->num_pontos * sizeof(uint32_t));
+        memset(espaco->alvo, 0, espaco->num_pontos * sizeof(uint32_t));
+        espaco->epoca = 1;
+    }
+    espaco->fila->tamanho = 0;
+}
+
+// Dijkstra a partir de origem até estabelecer todos os destinos alcançáveis.
+// Os destinos são índices em grafo->pontos (NENHUM para ids desconhecidos).
+// Pesos NULL usa a distância guardada nos arcos. Retorna o número de pontos
+// estabelecidos.
+static size_t buscar_destinos(const IndicesGrafo *indices, const double *pesos, EspacoBusca *espaco,
+                              size_t origem, const size_t *destinos, size_t num_destinos) {
+    reiniciar_espaco_busca(espaco);
+    uint32_t epoca = espaco->epoca;
+    const size_t *forte = indices->componente_forte;
+    const size_t *fraca = indices->componente_fraca;
+
+    // Só contam os destinos que as componentes não descartam; a menor
+    // componente forte entre eles limita a poda, como em dijkstra()
+    size_t pendentes = 0;
+    size_t menor_componente = (size_t)-1;
+    for (size_t j = 0; j < num_destinos; j++) {
+        size_t d = destinos[j];
+        if (d == NENHUM || espaco->alvo[d] == epoca) continue;
+        if (forte && (fraca[d] != fraca[origem] || forte[d] > forte[origem])) continue;
+        espaco->alvo[d] = epoca;
+        pendentes++;
+        if (forte && forte[d] < menor_componente) menor_componente = forte[d];
+    }
+    if (pendentes == 0) return 0;
+
+    espaco->marca[origem] = epoca;
+    espaco->distancias[origem] = 0.0;
+    espaco->predecessores[origem] = NENHUM;
+    inserir_fila_prioridade(espaco->fila, (long)origem, 0.0);
+
+    size_t estabelecidos = 0;
+    while (pendentes > 0 && !fila_vazia(espaco->fila)) {
+        size_t atual = (size_t)extrair_minimo(espaco->fila).ponto_id;
+        if (espaco->estabelecido[atual] == epoca) continue;
+        espaco->estabelecido[atual] = epoca;
+        estabelecidos++;
+        if (espaco->alvo[atual] == epoca) pendentes--;
+
+        double base = espaco->distancias[atual];
+        for (size_t k = indices->inicio_arcos[atual]; k < indices->inicio_arcos[atual + 1]; k++) {
+            size_t vizinho = indices->arcos[k].destino;
+            if (espaco->estabelecido[vizinho] == epoca) continue;
+            if (forte && forte[vizinho] < menor_componente) continue;
+            double nova = base + (pesos ? pesos[k] : indices->arcos[k].peso);
+            if (espaco->marca[vizinho] != epoca || nova < espaco->distancias[vizinho]) {
+                espaco->marca[vizinho] = epoca;
+                espaco->distancias[vizinho] = nova;
+                espaco->predecessores[vizinho] = atual;
+                inserir_fila_prioridade(espaco->fila, (long)vizinho, nova);
+            }
+        }
+    }
+    return estabelecidos;
+}
+
+// Copia o resultado da última busca para uma linha da tabela
+static void preencher_linha(const Grafo *grafo, const EspacoBusca *espaco, size_t origem,
+                            const size_t *destinos, size_t num_destinos,
+                            double *distancias, long *predecessores) {
+    for (size_t j = 0; j < num_destinos; j++) {
+        size_t d = destinos[j];
+        int alcancado = origem != NENHUM && d != NENHUM && espaco->estabelecido[d] == espaco->epoca;
+        distancias[j] = alcancado ? espaco->distancias[d] : -1.0;
+        if (predecessores) {
+            size_t anterior = alcancado ? espaco->predecessores[d] : NENHUM;
+            predecessores[j] = anterior != NENHUM ? grafo->pontos[anterior].id : -1;
+        }
+    }
+}
+
+int distancias_um_para_muitos(Grafo *grafo, EspacoBusca *espaco, long origem_id,
+                              const long *destinos, size_t num_destinos,
+                              double *distancias, long *predecessores) {
+    if (!grafo || !espaco || (num_destinos && (!destinos || !distancias))) return -1;
+    if (espaco->num_pontos != grafo->num_pontos) return -1;
+
+    const IndicesGrafo *indices = obter_componentes(grafo);
+    if (!indices) indices = obter_indices(grafo);
+    if (!indices) return -1;
+    const double *pesos = NULL;
+    if (espaco->metrica != METRICA_DISTANCIA && !(pesos = obter_pesos_metrica(grafo, espaco->metrica))) return -1;
+
+    size_t *indices_destino = malloc((num_destinos ? num_destinos : 1) * sizeof(size_t));
+    if (!indices_destino) return -1;
+    for (size_t j = 0; j < num_destinos; j++) {
+        ssize_t d = buscar_indice_ponto(grafo, destinos[j]);
+        indices_destino[j] = d >= 0 ? (size_t)d : NENHUM;
+    }
+
+    ssize_t origem = buscar_indice_ponto(grafo, origem_id);
+    if (origem >= 0) buscar_destinos(indices, pesos, espaco, (size_t)origem, indices_destino, num_destinos);
+    preencher_linha(grafo, espaco, origem >= 0 ? (size_t)origem : NENHUM,
+                    indices_destino, num_destinos, distancias, predecessores);
+    free(indices_destino);
+    return 0;
+}
+
+ResultadoDijkstra* dijkstra_com_espaco(Grafo *grafo, EspacoBusca *espaco, long origem_id, long destino_id) {
+    if (!grafo || !espaco || espaco->num_pontos != grafo->num_pontos || grafo->num_pontos == 0) return NULL;
+
+    const IndicesGrafo *indices = obter_componentes(grafo);
+    if (!indices) indices = obter_indices(grafo);
+    if (!indices) return NULL;
+    const double *pesos = NULL;
+    if (espaco->metrica != METRICA_DISTANCIA && !(pesos = obter_pesos_metrica(grafo, espaco->metrica))) return NULL;
+
+    ssize_t origem = buscar_indice_ponto(grafo, origem_id);
+    ssize_t destino = buscar_indice_ponto(grafo, destino_id);
+    if (origem < 0 || destino < 0) return NULL;
+
+    ResultadoDijkstra *resultado = calloc(1, sizeof(ResultadoDijkstra));
+    if (!resultado) return NULL;
+    resultado->distancia_total = -1.0;
+
+    size_t alvo = (size_t)destino;
+    resultado->nos_visitados = (int)buscar_destinos(indices, pesos, espaco, (size_t)origem, &alvo, 1);
+    if (espaco->estabelecido[alvo] != espaco->epoca) return resultado;
+
+    int contador = 0;
+    for (size_t v = alvo; v != NENHUM; v = espaco->predecessores[v]) contador++;
+    resultado->caminho = malloc(sizeof(long) * contador);
+    if (resultado->caminho) {
+        int posicao = contador - 1;
+        for (size_t v = alvo; v != NENHUM; v = espaco->predecessores[v]) {
+            resultado->caminho[posicao--] = grafo->pontos[v].id;
+        }
+        resultado->tamanho_caminho = contador;
+    }
+    resultado->distancia_total = espaco->distancias[alvo];
+    resultado->sucesso = 1;
+    return resultado;
+}
+
+// Estado compartilhado pelas threads: cada uma pega a próxima origem livre
+typedef struct {
+    const Grafo *grafo;
+    const IndicesGrafo *indices;
+    const double *pesos;  // NULL: distância
+    const size_t *origens;
+    const size_t *destinos;
+    MatrizDistancias *matriz;
+    atomic_size_t proxima;
+    atomic_int erro;
+} TrabalhoMatriz;
+
+static void* trabalhar_matriz(void *arg) {
+    TrabalhoMatriz *t = arg;
+    MatrizDistancias *m = t->matriz;
+    EspacoBusca *espaco = criar_espaco_busca(t->grafo->num_pontos);
+    if (!espaco) {
+        atomic_store(&t->erro, 1);
+        return NULL;
+    }
+    for (;;) {
+        size_t i = atomic_fetch_add(&t->proxima, 1);
+        if (i >= m->num_origens || atomic_load(&t->erro)) break;
+        size_t origem = t->origens[i];
+        if (origem != NENHUM) buscar_destinos(t->indices, t->pesos, espaco, origem, t->destinos, m->num_destinos);
+        preencher_linha(t->grafo, espaco, origem, t->destinos, m->num_destinos,
+                        m->distancias + i * m->num_destinos,
+                        m->predecessores ? m->predecessores + i * m->num_destinos : NULL);
+    }
+    liberar_espaco_busca(espaco);
+    return NULL;
+}
+
+void liberar_matriz_distancias(MatrizDistancias *matriz) {
+    if (matriz) {
+        free(matriz->distancias);
+        free(matriz->predecessores);
+        free(matriz);
+    }
+}
+
+MatrizDistancias* matriz_distancias(Grafo *grafo, const long *origens, size_t num_origens,
+                                    const long *destinos, size_t num_destinos,
+                                    int com_predecessores, int num_threads) {
+    return matriz_distancias_metrica(grafo, origens, num_origens, destinos, num_destinos,
+                                     METRICA_DISTANCIA, com_predecessores, num_threads);
+}
+
+MatrizDistancias* matriz_distancias_metrica(Grafo *grafo, const long *origens, size_t num_origens,
+                                            const long *destinos, size_t num_destinos, Metrica metrica,
+                                            int com_predecessores, int num_threads) {
+    if (!grafo || (num_origens && !origens) || (num_destinos && !destinos)) return NULL;
+
+    // Índices, componentes e pesos são construídos aqui, antes das threads,
+    // que só os leem
+    const IndicesGrafo *indices = obter_componentes(grafo);
+    if (!indices) indices = obter_indices(grafo);
+    if (!indices) return NULL;
+    const double *pesos = NULL;
+    if (metrica != METRICA_DISTANCIA && !(pesos = obter_pesos_metrica(grafo, metrica))) return NULL;
+
+    size_t celulas = num_origens * num_destinos;
+    MatrizDistancias *matriz = calloc(1, sizeof(MatrizDistancias));
+    size_t *indices_origem = malloc((num_origens ? num_origens : 1) * sizeof(size_t));
+    size_t *indices_destino = malloc((num_destinos ? num_destinos : 1) * sizeof(size_t));
+    pthread_t *threads = NULL;
+    if (matriz) {
+        matriz->num_origens = num_origens;
+        matriz->num_destinos = num_destinos;
+        matriz->distancias = malloc((celulas ? celulas : 1) * sizeof(double));
+        if (com_predecessores) matriz->predecessores = malloc((celulas ? celulas : 1) * sizeof(long));
+    }
+    if (!matriz || !indices_origem || !indices_destino || !matriz->distancias ||
+        (com_predecessores && !matriz->predecessores)) {
+        liberar_matriz_distancias(matriz);
+        matriz = NULL;
+        goto fim;
+    }
+
+    for (size_t i = 0; i < num_origens; i++) {
+        ssize_t o = buscar_indice_ponto(grafo, origens[i]);
+        indices_origem[i] = o >= 0 ? (size_t)o : NENHUM;
+    }
+    for (size_t j = 0; j < num_destinos; j++) {
+        ssize_t d = buscar_indice_ponto(grafo, destinos[j]);
+        indices_destino[j] = d >= 0 ? (size_t)d : NENHUM;
+    }
+
+    if (num_threads <= 0) {
+        long processadores = sysconf(_SC_NPROCESSORS_ONLN);
+        num_threads = processadores > 0 ? (int)processadores : 1;
+    }
+    if ((size_t)num_threads > num_origens) num_threads = num_origens ? (int)num_origens : 1;
+
+    TrabalhoMatriz trabalho = {
+        .grafo = grafo, .indices = indices, .pesos = pesos, .origens = indices_origem,
+        .destinos = indices_destino, .matriz = matriz
+    };
+    atomic_init(&trabalho.proxima, 0);
+    atomic_init(&trabalho.erro, 0);
+
+    // A thread principal também trabalha; se alguma não puder ser criada,
+    // as origens dela ficam para as demais
+    threads = calloc((size_t)num_threads, sizeof(pthread_t));
+    int threads_criadas = 1;
+    for (int t = 1; threads && t < num_threads; t++) {
+        if (pthread_create(&threads[t], NULL, trabalhar_matriz, &trabalho) != 0) break;
+        threads_criadas++;
+    }
+    trabalhar_matriz(&trabalho);
+    for (int t = 1; t < threads_criadas; t++) pthread_join(threads[t], NULL);
+
+    if (atomic_load(&trabalho.erro)) {
+        liberar_matriz_distancias(matriz);
+        matriz = NULL;
+    }
+
+fim:
+    free(indices_origem);
+    free(indices_destino);
+    free(threads);
+    return matriz;
+}
@@ -1,10 +1,101 @@
 #include "drawing.h"
 #include "ui_helpers.h"
 #include <math.h>
+#include <stdio.h>
+
+// Cor distinta por índice: matizes espalhados pela razão áurea
+static void set_index_color(cairo_t *cr, size_t index) {
+    double h = fmod(index * 0.618033988749895, 1.0) * 6.0;
+    double x = 1.0 - fabs(fmod(h, 2.0) - 1.0);
+    double r = 0.0, g = 0.0, b = 0.0;
+    switch ((int)h) {
+        case 0: r = 1.0; g = x; break;
+        case 1: r = x; g = 1.0; break;
+        case 2: g = 1.0; b = x; break;
+        case 3: g = x; b = 1.0; break;
+        case 4: r = x; b = 1.0; break;
+        default: r = 1.0; b = x; break;
+    }
+    cairo_set_source_rgb(cr, 0.1 + 0.8 * r, 0.1 + 0.8 * g, 0.1 + 0.8 * b);
+}
+
+// Cor de um ponto por componente forte: a maior componente fica em cinza e as
+// demais recebem cores distintas, para destacar ilhas
+static void set_component_color(cairo_t *cr, size_t component, size_t largest) {
+    if (component == largest) {
+        cairo_set_source_rgb(cr, 0.55, 0.55, 0.55);
+        return;
+    }
+    set_index_color(cr, component);
+}
+
+// Faixas de custo da isócrona, da mais próxima (verde) à mais distante (vermelho)
+#define ISOCHRONE_BANDS 4
+
+static void set_band_color(cairo_t *cr, int band) {
+    static const double colors[ISOCHRONE_BANDS][3] = {
+        {0.10, 0.65, 0.25}, {0.55, 0.75, 0.10}, {0.95, 0.60, 0.10}, {0.85, 0.15, 0.10},
+    };
+    cairo_set_source_rgba(cr, colors[band][0], colors[band][1], colors[band][2], 0.9);
+}
+
+// Início e fim clicados no meio de uma via: pedaços de aresta da rota até as
+// projeções (em vermelho, como o caminho) e marcadores sobre as projeções
+static void draw_snapped_ends(cairo_t *cr, AppData *app, double center_x, double center_y,
+                              double map_center_x, double map_center_y, double scale) {
+    double point_radius = 4.0 / app->zoom_factor;
+    if (point_radius < 2.0) point_radius = 2.0;
+    if (point_radius > 6.0) point_radius = 6.0;
+    
+    // Pontas da rota: a projeção, ou o próprio ponto se não foi projetado
+    Ponto *start = buscar_ponto_por_id(app->grafo, app->selected_start_id);
+    Ponto *end = buscar_ponto_por_id(app->grafo, app->selected_end_id);
+    if (app->snapped_route && start && end) {
+        double lat[2] = {app->start_snapped ? app->start_snap.lat : start->lat,
+                         app->end_snapped ? app->end_snap.lat : end->lat};
+        double lon[2] = {app->start_snapped ? app->start_snap.lon : start->lon,
+                         app->end_snapped ? app->end_snap.lon : end->lon};
+        Ponto *first = app->shortest_path_length > 0 ? buscar_ponto_por_id(app->grafo, app->shortest_path[0]) : NULL;
+        Ponto *last = app->shortest_path_length > 0
+                      ? buscar_ponto_por_id(app->grafo, app->shortest_path[app->shortest_path_length - 1]) : NULL;
+        
+        cairo_set_source_rgba(cr, 1.0, 0.0, 0.0, 0.9);
+        cairo_set_line_width(cr, 3.0 / app->zoom_factor);
+        cairo_move_to(cr, center_x + (lon[0] - map_center_x) * scale + app->pan_x,
+                      center_y - (lat[0] - map_center_y) * scale + app->pan_y);
+        if (first && last) {
+            cairo_line_to(cr, center_x + (first->lon - map_center_x) * scale + app->pan_x,
+                          center_y - (first->lat - map_center_y) * scale + app->pan_y);
+            cairo_move_to(cr, center_x + (last->lon - map_center_x) * scale + app->pan_x,
+                          center_y - (last->lat - map_center_y) * scale + app->pan_y);
+        }
+        cairo_line_to(cr, center_x + (lon[1] - map_center_x) * scale + app->pan_x,
+                      center_y - (lat[1] - map_center_y) * scale + app->pan_y);
+        cairo_stroke(cr);
+    }
+    
+    if (app->has_start_point && app->start_snapped) {
+        // Start on the road - green
+        cairo_set_source_rgb(cr, 0.2, 0.8, 0.2);
+        cairo_arc(cr, center_x + (app->start_snap.lon - map_center_x) * scale + app->pan_x,
+                  center_y - (app->start_snap.lat - map_center_y) * scale + app->pan_y,
+                  point_radius + 2, 0, 2 * M_PI);
+        cairo_fill(cr);
+    }
+    if (app->has_end_point && app->end_snapped) {
+        // End on the road - red
+        cairo_set_source_rgb(cr, 0.8, 0.2, 0.2);
+        cairo_arc(cr, center_x + (app->end_snap.lon - map_center_x) * scale + app->pan_x,
+                  center_y - (app->end_snap.lat - map_center_y) * scale + app->pan_y,
+                  point_radius + 2, 0, 2 * M_PI);
+        cairo_fill(cr);
+    }
+}
 
 // Função para desenhar o grafo
 gboolean on_graph_draw(GtkWidget *widget, cairo_t *cr, gpointer user_data) {
     AppData *app = (AppData *)user_data;
+    gint64 frame_start = g_get_monotonic_time();
     
     GtkAllocation allocation;
     gtk_widget_get_allocation(widget, &allocation);
@@ -23,17 +114,10 @@ gboolean on_graph_draw(GtkWidget *widget, cairo_t *cr, gpointer user_data) {
         return TRUE;
     }
     
-    // Find bounds
-    double min_lat = 90.0, max_lat = -90.0;
-    double min_lon = 180.0, max_lon = -180.0;
-    
-    for (size_t i = 0; i < app->grafo->num_pontos; i++) {
-        Ponto *p = &app->grafo->pontos[i];
-        if (p->lat < min_lat) min_lat = p->lat;
-        if (p->lat > max_lat) max_lat = p->lat;
-        if (p->lon < min_lon) min_lon = p->lon;
-        if (p->lon > max_lon) max_lon = p->lon;
-    }
+    // Find bounds (kept by the spatial index)
+    double min_lat = 0.0, max_lat = 0.0;
+    double min_lon = 0.0, max_lon = 0.0;
+    get_graph_bounds(app, &min_lat, &max_lat, &min_lon, &max_lon);
     
     double lat_range = max_lat - min_lat;
     double lon_range = max_lon - min_lon;
@@ -54,24 +138,36 @@ gboolean on_graph_draw(GtkWidget *widget, cairo_t *cr, gpointer user_data) {
         double map_center_x = (min_lon + max_lon) / 2.0;
         double map_center_y = (min_lat + max_lat) / 2.0;
         
+        // Visible rectangle in lon/lat (10 px margin): edges and points come
+        // from the spatial index, so a zoomed-in frame only touches what is on
+        // screen; without the index, everything is tested below
+        double view_min_lon = map_center_x + (-10 - center_x - app->pan_x) / scale;
+        double view_max_lon = map_center_x + (allocation.width + 10 - center_x - app->pan_x) / scale;
+        double view_min_lat = map_center_y - (allocation.height + 10 - center_y - app->pan_y) / scale;
+        double view_max_lat = map_center_y - (-10 - center_y - app->pan_y) / scale;
+        if (!app->visible_items) app->visible_items = criar_lista_indices();
+        IndiceEspacial *spatial_index = app->visible_items ? get_spatial_index(app) : NULL;
+        size_t edges_drawn = 0, points_drawn = 0;
+        
         // Draw edges first (behind points)
         cairo_set_line_width(cr, 1.2 / app->zoom_factor); // Era 0.8, agora 1.2
         
-        for (size_t i = 0; i < app->grafo->num_arestas; i++) {
+        // Região alcançável a partir do ponto inicial (NULL se desativada)
+        const RegiaoAlcancavel *isochrone = get_isochrone(app);
+        
+        gboolean culled = spatial_index &&
+            segmentos_na_caixa(spatial_index, view_min_lat, view_min_lon, view_max_lat, view_max_lon,
+                               app->visible_items) == 0;
+        size_t num_candidates = culled ? app->visible_items->quantidade : app->grafo->num_arestas;
+        
+        for (size_t j = 0; j < num_candidates; j++) {
+            size_t i = culled ? app->visible_items->itens[j] : j;
             Aresta *a = &app->grafo->arestas[i];
             
-            // Find source and destination points
-            Ponto *origem = NULL, *destino = NULL;
-            
-            for (size_t j = 0; j < app->grafo->num_pontos; j++) {
-                if (app->grafo->pontos[j].id == a->origem) {
-                    origem = &app->grafo->pontos[j];
-                }
-                if (app->grafo->pontos[j].id == a->destino) {
-                    destino = &app->grafo->pontos[j];
-                }
-                if (origem && destino) break;
-            }
+            // Find source and destination points (one stroke per road segment,
+            // two-way roads are stored once)
+            Ponto *origem = buscar_ponto_por_id(app->grafo, a->origem);
+            Ponto *destino = buscar_ponto_por_id(app->grafo, a->destino);
             
             if (origem && destino) {
                 double x1 = center_x + (origem->lon - map_center_x) * scale + app->pan_x;
@@ -82,14 +178,34 @@ gboolean on_graph_draw(GtkWidget *widget, cairo_t *cr, gpointer user_data) {
                 // Only draw if at least part of the line is visible
                 if ((x1 >= -10 || x2 >= -10) && (x1 <= allocation.width + 10 || x2 <= allocation.width + 10) &&
                     (y1 >= -10 || y2 >= -10) && (y1 <= allocation.height + 10 || y2 <= allocation.height + 10)) {
+                    edges_drawn++;
                     
                     // Check if this edge is part of the shortest path
                     gboolean is_shortest_path_edge = is_edge_in_shortest_path(app, a->origem, a->destino);
+                    size_t alternative = is_shortest_path_edge ? 0 : alternative_of_edge(app, a->origem, a->destino);
+                    
+                    // Faixa da aresta: a do extremo mais caro, se ambos forem alcançados
+                    int band = -1;
+                    if (isochrone) {
+                        double c1 = custo_alcancado(app->isochrone_space, (size_t)(origem - app->grafo->pontos));
+                        double c2 = custo_alcancado(app->isochrone_space, (size_t)(destino - app->grafo->pontos));
+                        if (c1 >= 0.0 && c2 >= 0.0) {
+                            band = faixa_alcance(c1 > c2 ? c1 : c2, isochrone->limite, ISOCHRONE_BANDS);
+                        }
+                    }
                     
                     if (is_shortest_path_edge) {
                         // Draw shortest path edges in red with thicker line
                         cairo_set_source_rgba(cr, 1.0, 0.0, 0.0, 0.9); // Red
                         cairo_set_line_width(cr, 3.0 / app->zoom_factor);
+                    } else if (alternative > 0) {
+                        // Alternative routes in distinct colors, under the shortest path
+                        set_index_color(cr, alternative);
+                        cairo_set_line_width(cr, 2.5 / app->zoom_factor);
+                    } else if (band >= 0) {
+                        // Reachable edges colored by cost band
+                        set_band_color(cr, band);
+                        cairo_set_line_width(cr, 2.5 / app->zoom_factor);
                     } else {
                         // Different colors for directional vs bidirectional edges
                         if (a->is_bidirectional) {
@@ -112,7 +228,7 @@ gboolean on_graph_draw(GtkWidget *widget, cairo_t *cr, gpointer user_data) {
                     cairo_stroke(cr);
                     
                     // Draw arrow for directional edges (not bidirectional)
-                    if (!a->is_bidirectional && !is_shortest_path_edge) {
+                    if (!a->is_bidirectional && !is_shortest_path_edge && alternative == 0) {
                         // Calculate arrow position and direction
                         double dx = x2 - x1;
                         double dy = y2 - y1;
@@ -150,21 +266,40 @@ gboolean on_graph_draw(GtkWidget *widget, cairo_t *cr, gpointer user_data) {
             }
         }
         
+        // Componentes para colorir os pontos (NULL se desativado)
+        const IndicesGrafo *components = app->color_by_component ? obter_componentes(app->grafo) : NULL;
+        
+        // Partição pela instalação mais próxima (NULL se desativada)
+        const ParticaoVoronoi *voronoi = get_voronoi(app);
+        
+        culled = spatial_index &&
+            pontos_na_caixa(spatial_index, view_min_lat, view_min_lon, view_max_lat, view_max_lon,
+                            app->visible_items) == 0;
+        num_candidates = culled ? app->visible_items->quantidade : app->grafo->num_pontos;
+        
         // Draw graph points (on top of edges)
-        for (size_t i = 0; i < app->grafo->num_pontos; i++) {
+        for (size_t j = 0; j < num_candidates; j++) {
+            size_t i = culled ? app->visible_items->itens[j] : j;
             Ponto *p = &app->grafo->pontos[i];
             double x = center_x + (p->lon - map_center_x) * scale + app->pan_x;
             double y = center_y - (p->lat - map_center_y) * scale + app->pan_y;
             
             // Only draw if point is visible
             if (x >= -10 && x <= allocation.width + 10 && y >= -10 && y <= allocation.height + 10) {
+                points_drawn++;
                 double point_radius = 4.0 / app->zoom_factor;
                 if (point_radius < 2.0) point_radius = 2.0;
                 if (point_radius > 6.0) point_radius = 6.0;
                 
-                // Check if this point is selected
-                gboolean is_start = (app->has_start_point && p->id == app->selected_start_id);
-                gboolean is_end = (app->has_end_point && p->id == app->selected_end_id);
+                // Check if this point is selected (snapped ends are drawn on the road)
+                gboolean is_start = (app->has_start_point && !app->start_snapped && p->id == app->selected_start_id);
+                gboolean is_end = (app->has_end_point && !app->end_snapped && p->id == app->selected_end_id);
+                gboolean is_waypoint = FALSE;
+                size_t waypoint_index = 0;
+                for (size_t w = 0; w < app->num_waypoints && !is_waypoint; w++) {
+                    is_waypoint = p->id == app->waypoint_ids[w];
+                    waypoint_index = w;
+                }
                 gboolean is_edit_selected = (app->edit_state.has_selected_node && p->id == app->edit_state.selected_node_id);
                 gboolean is_connecting_from = (app->edit_state.is_connecting && p->id == app->edit_state.connecting_from_id);
                 
@@ -179,6 +314,17 @@ gboolean on_graph_draw(GtkWidget *widget, cairo_t *cr, gpointer user_data) {
                     cairo_set_source_rgb(cr, 0.8, 0.2, 0.2);
                     cairo_arc(cr, x, y, point_radius + 2, 0, 2 * M_PI);
                     cairo_fill(cr);
+                } else if (is_waypoint) {
+                    // Via point - amber, labelled with its visiting order
+                    cairo_set_source_rgb(cr, 0.95, 0.7, 0.1);
+                    cairo_arc(cr, x, y, point_radius + 2, 0, 2 * M_PI);
+                    cairo_fill(cr);
+                    
+                    char order[24];
+                    snprintf(order, sizeof(order), "%zu", waypoint_index + 1);
+                    cairo_set_source_rgb(cr, 0.3, 0.2, 0.0);
+                    cairo_move_to(cr, x + point_radius + 3, y - point_radius - 3);
+                    cairo_show_text(cr, order);
                 } else if (is_connecting_from) {
                     // Connection source - blue
                     cairo_set_source_rgb(cr, 0.2, 0.2, 0.8);
@@ -189,6 +335,28 @@ gboolean on_graph_draw(GtkWidget *widget, cairo_t *cr, gpointer user_data) {
                     cairo_set_source_rgb(cr, 1.0, 0.5, 0.0);
                     cairo_arc(cr, x, y, point_radius + 2, 0, 2 * M_PI);
                     cairo_fill(cr);
+                } else if (voronoi && voronoi->num_fontes > 0) {
+                    uint32_t dono = voronoi->dono[i];
+                    if (dono == SEM_DONO) {
+                        cairo_set_source_rgb(cr, 0.85, 0.85, 0.85); // Unreachable - light gray
+                    } else {
+                        set_index_color(cr, dono);
+                    }
+                    // Facilities are larger and outlined
+                    gboolean is_facility = dono != SEM_DONO && voronoi->pontos_fonte[dono] == i;
+                    cairo_arc(cr, x, y, is_facility ? point_radius + 3 : point_radius, 0, 2 * M_PI);
+                    cairo_fill_preserve(cr);
+                    if (is_facility) {
+                        cairo_set_source_rgb(cr, 0.0, 0.0, 0.0);
+                        cairo_set_line_width(cr, 1.5);
+                        cairo_stroke(cr);
+                    } else {
+                        cairo_new_path(cr);
+                    }
+                } else if (components) {
+                    set_component_color(cr, components->componente_forte[i], components->maior_componente_forte);
+                    cairo_arc(cr, x, y, point_radius, 0, 2 * M_PI);
+                    cairo_fill(cr);
                 } else {
                     // Normal point - color depends on edit mode
                     switch (app->edit_state.current_mode) {
@@ -210,6 +378,19 @@ gboolean on_graph_draw(GtkWidget *widget, cairo_t *cr, gpointer user_data) {
                 }
             }
         }
+        
+        draw_snapped_ends(cr, app, center_x, center_y, map_center_x, map_center_y, scale);
+        
+        // Frame time readout (bottom left), to compare zoom levels
+        gchar *readout = g_strdup_printf("Frame: %.1f ms, %zu of %zu edges and %zu of %zu points drawn%s",
+                                         (g_get_monotonic_time() - frame_start) / 1000.0,
+                                         edges_drawn, app->grafo->num_arestas,
+                                         points_drawn, app->grafo->num_pontos,
+                                         spatial_index ? "" : " (no spatial index)");
+        cairo_set_source_rgba(cr, 0.3, 0.3, 0.3, 0.9);
+        cairo_move_to(cr, 10, allocation.height - 10);
+        cairo_show_text(cr, readout);
+        g_free(readout);
     }
     
     return TRUE;
@@ -230,17 +411,10 @@ void render_graph_to_png(AppData *app, const char *filename, int width, int heig
     cairo_set_source_rgb(cr, 1.0, 1.0, 1.0);
     cairo_paint(cr);
     
-    // Calcular bounds do grafo
-    double min_lat = 90.0, max_lat = -90.0;
-    double min_lon = 180.0, max_lon = -180.0;
-    
-    for (size_t i = 0; i < app->grafo->num_pontos; i++) {
-        Ponto *p = &app->grafo->pontos[i];
-        if (p->lat < min_lat) min_lat = p->lat;
-        if (p->lat > max_lat) max_lat = p->lat;
-        if (p->lon < min_lon) min_lon = p->lon;
-        if (p->lon > max_lon) max_lon = p->lon;
-    }
+    // Calcular bounds do grafo (mantidos pelo índice espacial)
+    double min_lat = 0.0, max_lat = 0.0;
+    double min_lon = 0.0, max_lon = 0.0;
+    get_graph_bounds(app, &min_lat, &max_lat, &min_lon, &max_lon);
     
     double lat_range = max_lat - min_lat;
     double lon_range = max_lon - min_lon;
@@ -266,17 +440,8 @@ void render_graph_to_png(AppData *app, const char *filename, int width, int heig
             Aresta *a = &app->grafo->arestas[i];
             
             // Encontrar pontos origem e destino
-            Ponto *origem = NULL, *destino = NULL;
-            
-            for (size_t j = 0; j < app->grafo->num_pontos; j++) {
-                if (app->grafo->pontos[j].id == a->origem) {
-                    origem = &app->grafo->pontos[j];
-                }
-                if (app->grafo->pontos[j].id == a->destino) {
-                    destino = &app->grafo->pontos[j];
-                }
-                if (origem && destino) break;
-            }
+            Ponto *origem = buscar_ponto_por_id(app->grafo, a->origem);
+            Ponto *destino = buscar_ponto_por_id(app->grafo, a->destino);
             
             if (origem && destino) {
                 double x1 = center_x + (origem->lon - map_center_x) * scale + app->pan_x;
@@ -286,11 +451,16 @@ void render_graph_to_png(AppData *app, const char *filename, int width, int heig
                 
                 // Verificar se esta aresta faz parte do caminho mais curto
                 gboolean is_shortest_path_edge = is_edge_in_shortest_path(app, a->origem, a->destino);
+                size_t alternative = is_shortest_path_edge ? 0 : alternative_of_edge(app, a->origem, a->destino);
                 
                 if (is_shortest_path_edge) {
                     // Caminho mais curto em vermelho e mais grosso
                     cairo_set_source_rgba(cr, 1.0, 0.0, 0.0, 0.9);
                     cairo_set_line_width(cr, 3.0 / app->zoom_factor);
+                } else if (alternative > 0) {
+                    // Rotas alternativas em cores distintas
+                    set_index_color(cr, alternative);
+                    cairo_set_line_width(cr, 2.5 / app->zoom_factor);
                 } else {
                     // Cores diferentes para bidirecionais vs direcionais
                     if (a->is_bidirectional) {
@@ -307,7 +477,7 @@ void render_graph_to_png(AppData *app, const char *filename, int width, int heig
                 cairo_stroke(cr);
                 
                 // Desenhar seta para arestas direcionais
-                if (!a->is_bidirectional && !is_shortest_path_edge) {
+                if (!a->is_bidirectional && !is_shortest_path_edge && alternative == 0) {
                     double dx = x2 - x1;
                     double dy = y2 - y1;
                     double length = sqrt(dx*dx + dy*dy);
@@ -0,0 +1,255 @@
+#include "dynamic_sssp.h"
+#include <float.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NENHUM ((size_t)-1)
+
+static void liberar_vetores(ArvoreDinamica *arvore) {
+    free(arvore->distancias);
+    free(arvore->arco_pai);
+    free(arvore->inicio_entrada);
+    free(arvore->entrada);
+    free(arvore->origem_arco);
+    free(arvore->afetado);
+    free(arvore->afetados);
+    arvore->distancias = NULL;
+    arvore->arco_pai = NULL;
+    arvore->inicio_entrada = NULL;
+    arvore->entrada = NULL;
+    arvore->origem_arco = NULL;
+    arvore->afetado = NULL;
+    arvore->afetados = NULL;
+}
+
+void liberar_arvore_dinamica(ArvoreDinamica *arvore) {
+    if (arvore) {
+        liberar_vetores(arvore);
+        liberar_fila_prioridade(arvore->fila);
+        free(arvore);
+    }
+}
+
+// Dijkstra a partir do que já está na fila. Entradas obsoletas (distância
+// maior que a atual do ponto) são descartadas ao sair.
+static int propagar(ArvoreDinamica *arvore) {
+    const IndicesGrafo *indices = arvore->indices;
+    int estabelecidos = 0;
+    while (!fila_vazia(arvore->fila)) {
+        NoFilaPrioridade no = extrair_minimo(arvore->fila);
+        size_t atual = (size_t)no.ponto_id;
+        if (no.distancia > arvore->distancias[atual]) continue;
+        estabelecidos++;
+
+        for (size_t k = indices->inicio_arcos[atual]; k < indices->inicio_arcos[atual + 1]; k++) {
+            size_t vizinho = indices->arcos[k].destino;
+            double nova = no.distancia + indices->arcos[k].peso;
+            if (nova < arvore->distancias[vizinho]) {
+                arvore->distancias[vizinho] = nova;
+                arvore->arco_pai[vizinho] = k;
+                inserir_fila_prioridade(arvore->fila, (long)vizinho, nova);
+            }
+        }
+    }
+    return estabelecidos;
+}
+
+int recalcular_arvore_dinamica(ArvoreDinamica *arvore) {
+    if (!arvore || !arvore->distancias) return -1;
+    for (size_t i = 0; i < arvore->num_pontos; i++) {
+        arvore->distancias[i] = DBL_MAX;
+        arvore->arco_pai[i] = NENHUM;
+    }
+    arvore->fila->tamanho = 0;
+    arvore->distancias[arvore->origem] = 0.0;
+    inserir_fila_prioridade(arvore->fila, (long)arvore->origem, 0.0);
+    return propagar(arvore);
+}
+
+// (Re)aloca os vetores para os índices atuais, monta o CSR reverso e
+// calcula a árvore do zero
+static int montar_arvore(ArvoreDinamica *arvore) {
+    Grafo *grafo = arvore->grafo;
+    const IndicesGrafo *indices = obter_indices(grafo);
+    if (!indices) return -1;
+    ssize_t origem = buscar_indice_ponto(grafo, arvore->origem_id);
+    if (origem < 0) return -1;
+
+    liberar_vetores(arvore);
+    size_t n = indices->num_pontos;
+    size_t m = indices->num_arcos;
+    arvore->indices = indices;
+    arvore->versao_indices = grafo->versao_indices;
+    arvore->num_arcos = m;
+    arvore->num_pontos = n;
+    arvore->origem = (size_t)origem;
+    arvore->distancias = malloc(n * sizeof(double));
+    arvore->arco_pai = malloc(n * sizeof(size_t));
+    arvore->inicio_entrada = calloc(n + 1, sizeof(size_t));
+    arvore->entrada = malloc((m > 0 ? m : 1) * sizeof(size_t));
+    arvore->origem_arco = malloc((m > 0 ? m : 1) * sizeof(size_t));
+    arvore->afetado = calloc(n > 0 ? n : 1, 1);
+    arvore->afetados = malloc((n > 0 ? n : 1) * sizeof(size_t));
+    if (!arvore->distancias || !arvore->arco_pai || !arvore->inicio_entrada || !arvore->entrada ||
+        !arvore->origem_arco || !arvore->afetado || !arvore->afetados) {
+        liberar_vetores(arvore);
+        return -1;
+    }
+
+    // Contagem por destino e depois preenchimento, como no CSR de saída
+    for (size_t u = 0; u < n; u++) {
+        for (size_t k = indices->inicio_arcos[u]; k < indices->inicio_arcos[u + 1]; k++) {
+            arvore->origem_arco[k] = u;
+            arvore->inicio_entrada[indices->arcos[k].destino + 1]++;
+        }
+    }
+    for (size_t v = 0; v < n; v++) arvore->inicio_entrada[v + 1] += arvore->inicio_entrada[v];
+    size_t *proxima = malloc((n > 0 ? n : 1) * sizeof(size_t));
+    if (!proxima) {
+        liberar_vetores(arvore);
+        return -1;
+    }
+    memcpy(proxima, arvore->inicio_entrada, n * sizeof(size_t));
+    for (size_t k = 0; k < m; k++) arvore->entrada[proxima[indices->arcos[k].destino]++] = k;
+    free(proxima);
+
+    return recalcular_arvore_dinamica(arvore);
+}
+
+ArvoreDinamica* criar_arvore_dinamica(Grafo *grafo, long origem_id) {
+    if (!grafo) return NULL;
+    ArvoreDinamica *arvore = calloc(1, sizeof(ArvoreDinamica));
+    if (!arvore) return NULL;
+    arvore->grafo = grafo;
+    arvore->origem_id = origem_id;
+    arvore->fila = criar_fila_prioridade(64);
+    if (!arvore->fila || montar_arvore(arvore) < 0) {
+        liberar_arvore_dinamica(arvore);
+        return NULL;
+    }
+    return arvore;
+}
+
+// Marca a subárvore abaixo de raiz (inclusive), seguindo os arcos de saída
+// que são arcos da árvore. Retorna a nova quantidade de pontos em afetados.
+static size_t marcar_subarvore(ArvoreDinamica *arvore, size_t raiz, size_t num_afetados) {
+    const IndicesGrafo *indices = arvore->indices;
+    size_t lido = num_afetados;
+    arvore->afetado[raiz] = 1;
+    arvore->afetados[num_afetados++] = raiz;
+    // A própria lista serve de fila da travessia
+    while (lido < num_afetados) {
+        size_t atual = arvore->afetados[lido++];
+        for (size_t k = indices->inicio_arcos[atual]; k < indices->inicio_arcos[atual + 1]; k++) {
+            size_t filho = indices->arcos[k].destino;
+            if (arvore->arco_pai[filho] == k && !arvore->afetado[filho]) {
+                arvore->afetado[filho] = 1;
+                arvore->afetados[num_afetados++] = filho;
+            }
+        }
+    }
+    return num_afetados;
+}
+
+int reparar_arvore_dinamica(ArvoreDinamica *arvore, const AtualizacaoPeso *atualizacoes, size_t quantidade) {
+    if (!arvore || (quantidade > 0 && !atualizacoes)) return -1;
+    const IndicesGrafo *indices = obter_indices(arvore->grafo);
+    if (!indices) return -1;
+    // O endereço e o número de arcos podem coincidir com os dos índices
+    // antigos (inverter uma mão única): só a versão distingue a reconstrução
+    if (arvore->grafo->versao_indices != arvore->versao_indices || !arvore->distancias) {
+        return montar_arvore(arvore);
+    }
+    arvore->fila->tamanho = 0;
+
+    // 1. Arcos da árvore alterados: a subárvore inteira abaixo deles perde a
+    //    distância (para mais ou para menos) e é desligada da árvore
+    size_t num_afetados = 0;
+    for (size_t i = 0; i < quantidade; i++) {
+        size_t arcos[2];
+        size_t n = arcos_da_aresta(arvore->grafo, atualizacoes[i].aresta, arcos);
+        for (size_t j = 0; j < n; j++) {
+            size_t v = indices->arcos[arcos[j]].destino;
+            if (arvore->arco_pai[v] == arcos[j] && !arvore->afetado[v]) {
+                num_afetados = marcar_subarvore(arvore, v, num_afetados);
+            }
+        }
+    }
+    for (size_t i = 0; i < num_afetados; i++) {
+        size_t v = arvore->afetados[i];
+        arvore->distancias[v] = DBL_MAX;
+        arvore->arco_pai[v] = NENHUM;
+    }
+
+    // 2. Cada ponto afetado recebe a melhor estimativa vinda de fora da região
+    //    afetada, cujas distâncias continuam exatas
+    for (size_t i = 0; i < num_afetados; i++) {
+        size_t v = arvore->afetados[i];
+        for (size_t e = arvore->inicio_entrada[v]; e < arvore->inicio_entrada[v + 1]; e++) {
+            size_t k = arvore->entrada[e];
+            size_t u = arvore->origem_arco[k];
+            if (arvore->afetado[u] || arvore->distancias[u] == DBL_MAX) continue;
+            double nova = arvore->distancias[u] + indices->arcos[k].peso;
+            if (nova < arvore->distancias[v]) {
+                arvore->distancias[v] = nova;
+                arvore->arco_pai[v] = k;
+            }
+        }
+        if (arvore->distancias[v] < DBL_MAX) {
+            inserir_fila_prioridade(arvore->fila, (long)v, arvore->distancias[v]);
+        }
+    }
+
+    // 3. Arcos fora da árvore que ficaram mais leves podem encurtar caminhos
+    for (size_t i = 0; i < quantidade; i++) {
+        size_t arcos[2];
+        size_t n = arcos_da_aresta(arvore->grafo, atualizacoes[i].aresta, arcos);
+        for (size_t j = 0; j < n; j++) {
+            size_t u = arvore->origem_arco[arcos[j]];
+            size_t v = indices->arcos[arcos[j]].destino;
+            if (arvore->afetado[u] || arvore->distancias[u] == DBL_MAX) continue;
+            double nova = arvore->distancias[u] + indices->arcos[arcos[j]].peso;
+            if (nova < arvore->distancias[v]) {
+                arvore->distancias[v] = nova;
+                arvore->arco_pai[v] = arcos[j];
+                inserir_fila_prioridade(arvore->fila, (long)v, nova);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < num_afetados; i++) arvore->afetado[arvore->afetados[i]] = 0;
+
+    // 4. Dijkstra só a partir dos pontos que mudaram
+    return propagar(arvore);
+}
+
+ResultadoDijkstra* caminho_arvore_dinamica(const ArvoreDinamica *arvore, long destino_id) {
+    if (!arvore || !arvore->distancias) return NULL;
+    ssize_t destino = buscar_indice_ponto(arvore->grafo, destino_id);
+    if (destino < 0 || (size_t)destino >= arvore->num_pontos) return NULL;
+
+    ResultadoDijkstra *resultado = calloc(1, sizeof(ResultadoDijkstra));
+    if (!resultado) return NULL;
+    resultado->distancia_total = -1.0;
+    if (arvore->distancias[destino] == DBL_MAX) return resultado;
+
+    int contador = 1;
+    for (size_t v = (size_t)destino; arvore->arco_pai[v] != NENHUM; v = arvore->origem_arco[arvore->arco_pai[v]]) {
+        contador++;
+    }
+    resultado->caminho = malloc(sizeof(long) * contador);
+    if (resultado->caminho) {
+        int posicao = contador - 1;
+        size_t v = (size_t)destino;
+        resultado->caminho[posicao--] = arvore->grafo->pontos[v].id;
+        while (arvore->arco_pai[v] != NENHUM) {
+            v = arvore->origem_arco[arvore->arco_pai[v]];
+            resultado->caminho[posicao--] = arvore->grafo->pontos[v].id;
+        }
+        resultado->tamanho_caminho = contador;
+    }
+    resultado->distancia_total = arvore->distancias[destino];
+    resultado->sucesso = 1;
+    return resultado;
+}
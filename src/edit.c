@@ -1,4 +1,6 @@
 #include "edit.h"
+#include "graph.h"
+#include "metrics.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -19,6 +21,15 @@ void init_edit_state(EditState *state) {
     state->is_connecting = FALSE;
     state->next_node_id = 1;
     state->next_way_id = 1;
+    state->indice_espacial = NULL;
+}
+
+// Função auxiliar para descartar o índice espacial que deixou de corresponder ao grafo
+static void check_index_update(EditState *state, int status) {
+    if (status != 0) {
+        liberar_indice_espacial(state->indice_espacial);
+        state->indice_espacial = NULL;
+    }
 }
 
 // Função para definir o modo de edição
@@ -73,45 +84,32 @@ void update_node_ids(EditState *state, Grafo *grafo) {
     state->next_way_id = find_highest_way_id(grafo) + 1;
 }
 
-// Função para redimensionar array de pontos
+// Função para redimensionar array de pontos (cresce geometricamente, nunca encolhe)
 gboolean resize_points_array(Grafo *grafo, size_t new_size) {
     if (!grafo) return FALSE;
-    
-    Ponto *new_points = realloc(grafo->pontos, sizeof(Ponto) * new_size);
-    if (!new_points) return FALSE;
-    
-    grafo->pontos = new_points;
-    return TRUE;
+    return reservar_pontos(grafo, new_size) == 0;
 }
 
-// Função para redimensionar array de arestas
+// Função para redimensionar array de arestas (cresce geometricamente, nunca encolhe)
 gboolean resize_edges_array(Grafo *grafo, size_t new_size) {
     if (!grafo) return FALSE;
-    
-    Aresta *new_edges = realloc(grafo->arestas, sizeof(Aresta) * new_size);
-    if (!new_edges) return FALSE;
-    
-    grafo->arestas = new_edges;
-    return TRUE;
+    return reservar_arestas(grafo, new_size) == 0;
 }
 
 // Função para criar um novo nó na posição especificada
 gboolean create_node_at_position(Grafo *grafo, EditState *state, double lat, double lon) {
     if (!grafo || !state) return FALSE;
     
-    // Redimensionar array se necessário
-    if (!resize_points_array(grafo, grafo->num_pontos + 1)) {
+    // Criar novo ponto (o vetor cresce geometricamente e o mapa de IDs
+    // recebe só o ponto novo)
+    if (adicionar_ponto(grafo, state->next_node_id, lat, lon) != 0) {
         return FALSE;
     }
-    
-    // Criar novo ponto
-    Ponto *new_point = &grafo->pontos[grafo->num_pontos];
-    new_point->id = state->next_node_id;
-    new_point->lat = lat;
-    new_point->lon = lon;
-    
-    grafo->num_pontos++;
+    Ponto *new_point = &grafo->pontos[grafo->num_pontos - 1];
     state->next_node_id++;
+    if (state->indice_espacial) {
+        check_index_update(state, inserir_ponto_indice(state->indice_espacial, grafo->num_pontos - 1));
+    }
     
     printf("Created new node with ID %lld at (%.6f, %.6f)\n", 
            new_point->id, lat, lon);
@@ -142,31 +140,28 @@ gboolean delete_node(Grafo *grafo, EditState *state, long long node_id) {
     if (!grafo || !state) return FALSE;
     
     // Encontrar o índice do nó
-    int node_index = -1;
-    for (size_t i = 0; i < grafo->num_pontos; i++) {
-        if (grafo->pontos[i].id == node_id) {
-            node_index = i;
-            break;
-        }
-    }
-    
-    if (node_index == -1) return FALSE;
+    ssize_t node_index = buscar_indice_ponto(grafo, node_id);
+    if (node_index < 0) return FALSE;
     
     // Remover todas as arestas conectadas a este nó
     for (size_t i = 0; i < grafo->num_arestas; ) {
         if (grafo->arestas[i].origem == node_id || 
             grafo->arestas[i].destino == node_id) {
-            // Mover última aresta para posição atual
-            grafo->arestas[i] = grafo->arestas[grafo->num_arestas - 1];
-            grafo->num_arestas--;
+            // Mover última aresta (e seus atributos) para posição atual
+            remover_aresta(grafo, i);
+            if (state->indice_espacial) {
+                check_index_update(state, remover_aresta_indice(state->indice_espacial, i));
+            }
         } else {
             i++;
         }
     }
     
     // Remover o nó movendo o último para a posição atual
-    grafo->pontos[node_index] = grafo->pontos[grafo->num_pontos - 1];
-    grafo->num_pontos--;
+    remover_ponto(grafo, (size_t)node_index);
+    if (state->indice_espacial) {
+        check_index_update(state, remover_ponto_indice(state->indice_espacial, (size_t)node_index));
+    }
     
     printf("Deleted node with ID %lld\n", node_id);
     return TRUE;
@@ -210,13 +205,11 @@ gboolean connect_nodes(Grafo *grafo, EditState *state, long long from_id, long l
     if (!grafo || !state || from_id == to_id) return FALSE;
     
     // Verificar se os nós existem
-    Ponto *from_point = NULL, *to_point = NULL;
-    for (size_t i = 0; i < grafo->num_pontos; i++) {
-        if (grafo->pontos[i].id == from_id) from_point = &grafo->pontos[i];
-        if (grafo->pontos[i].id == to_id) to_point = &grafo->pontos[i];
-    }
-    
-    if (!from_point || !to_point) return FALSE;
+    ssize_t from_index = buscar_indice_ponto(grafo, from_id);
+    ssize_t to_index = buscar_indice_ponto(grafo, to_id);
+    if (from_index < 0 || to_index < 0) return FALSE;
+    Ponto *from_point = &grafo->pontos[from_index];
+    Ponto *to_point = &grafo->pontos[to_index];
     
     // Verificar se já estão conectados
     if (nodes_are_connected(grafo, from_id, to_id)) {
@@ -224,22 +217,19 @@ gboolean connect_nodes(Grafo *grafo, EditState *state, long long from_id, long l
         return FALSE;
     }
     
-    // Redimensionar array de arestas se necessário
-    if (!resize_edges_array(grafo, grafo->num_arestas + 1)) {
+    // Criar nova aresta (bidirecional por padrão, com atributos padrão),
+    // pesando a distância entre os nós
+    double peso = calculate_distance(from_point->lat, from_point->lon,
+                                     to_point->lat, to_point->lon);
+    if (adicionar_aresta(grafo, from_id, to_id, peso) != 0) {
         return FALSE;
     }
-    
-    // Criar nova aresta
-    Aresta *new_edge = &grafo->arestas[grafo->num_arestas];
-    new_edge->origem = from_id;
-    new_edge->destino = to_id;
-    new_edge->is_bidirectional = 1;  // Por padrão, conexões criadas manualmente são bidirecionais
-    
-    // Calcular peso (distância)
-    new_edge->peso = calculate_distance(from_point->lat, from_point->lon,
-                                       to_point->lat, to_point->lon);
-    
-    grafo->num_arestas++;
+    Aresta *new_edge = &grafo->arestas[grafo->num_arestas - 1];
+    if (state->indice_espacial) {
+        check_index_update(state, inserir_aresta_indice(state->indice_espacial, grafo->num_arestas - 1,
+                                                        (size_t)(from_point - grafo->pontos),
+                                                        (size_t)(to_point - grafo->pontos)));
+    }
     
     printf("Connected nodes %lld and %lld (distance: %.3f km)\n", 
            from_id, to_id, new_edge->peso);
@@ -248,8 +238,8 @@ gboolean connect_nodes(Grafo *grafo, EditState *state, long long from_id, long l
 }
 
 // Função para desconectar dois nós
-gboolean disconnect_nodes(Grafo *grafo, long long from_id, long long to_id) {
-    if (!grafo) return FALSE;
+gboolean disconnect_nodes(Grafo *grafo, EditState *state, long long from_id, long long to_id) {
+    if (!grafo || !state) return FALSE;
     
     for (size_t i = 0; i < grafo->num_arestas; i++) {
         Aresta *edge = &grafo->arestas[i];
@@ -257,9 +247,11 @@ gboolean disconnect_nodes(Grafo *grafo, long long from_id, long long to_id) {
         if ((edge->origem == from_id && edge->destino == to_id) ||
             (edge->origem == to_id && edge->destino == from_id && edge->is_bidirectional)) {
             
-            // Mover última aresta para posição atual
-            grafo->arestas[i] = grafo->arestas[grafo->num_arestas - 1];
-            grafo->num_arestas--;
+            // Mover última aresta (e seus atributos) para posição atual
+            remover_aresta(grafo, i);
+            if (state->indice_espacial) {
+                check_index_update(state, remover_aresta_indice(state->indice_espacial, i));
+            }
             
             printf("Disconnected nodes %lld and %lld\n", from_id, to_id);
             return TRUE;
@@ -269,43 +261,57 @@ gboolean disconnect_nodes(Grafo *grafo, long long from_id, long long to_id) {
     return FALSE;
 }
 
-// Função para alterar a direção de uma conexão entre dois nós
-gboolean set_connection_direction(Grafo *grafo, long long node1, long long node2, int direction_type) {
-    // direction_type: 0 = oneway (node1 -> node2), 1 = bidirectional, -1 = oneway (node2 -> node1)
-    if (!grafo) return FALSE;
-    
-    gboolean found_forward = FALSE, found_reverse = FALSE;
-    size_t forward_index = 0, reverse_index = 0;
-    
-    // Encontrar arestas existentes
+// Função auxiliar para localizar o registro de uma via entre dois nós,
+// em qualquer orientação. Retorna -1 se não houver conexão.
+static ssize_t find_segment_index(Grafo *grafo, long long node1, long long node2) {
     for (size_t i = 0; i < grafo->num_arestas; i++) {
         Aresta *edge = &grafo->arestas[i];
-        if (edge->origem == node1 && edge->destino == node2) {
-            found_forward = TRUE;
-            forward_index = i;
+        if ((edge->origem == node1 && edge->destino == node2) ||
+            (edge->origem == node2 && edge->destino == node1)) {
+            return (ssize_t)i;
         }
-        if (edge->origem == node2 && edge->destino == node1) {
-            found_reverse = TRUE;
-            reverse_index = i;
+    }
+    return -1;
+}
+
+// Função para alterar a direção de uma conexão entre dois nós
+gboolean set_connection_direction(Grafo *grafo, EditState *state, long long node1, long long node2,
+                                  int direction_type) {
+    // direction_type: 0 = oneway (node1 -> node2), 1 = bidirectional, -1 = oneway (node2 -> node1)
+    if (!grafo || !state) return FALSE;
+    
+    ssize_t index = find_segment_index(grafo, node1, node2);
+    if (index < 0) return FALSE;
+    
+    // Cada via tem um único registro; descartar espelhos remanescentes
+    for (size_t i = grafo->num_arestas; i-- > (size_t)index + 1; ) {
+        Aresta *other = &grafo->arestas[i];
+        if ((other->origem == node1 && other->destino == node2) ||
+            (other->origem == node2 && other->destino == node1)) {
+            remover_aresta(grafo, i);
+            if (state->indice_espacial) {
+                check_index_update(state, remover_aresta_indice(state->indice_espacial, i));
+            }
         }
     }
     
-    // Aplicar mudanças baseadas no tipo de direção
+    // Inverter a orientação não move o segmento: o índice espacial não muda
+    Aresta *edge = &grafo->arestas[index];
     if (direction_type == 1) { // Bidirectional
-        if (found_forward) grafo->arestas[forward_index].is_bidirectional = 1;
-        if (found_reverse) grafo->arestas[reverse_index].is_bidirectional = 1;
+        edge->is_bidirectional = 1;
         printf("Connection %lld ↔ %lld set to bidirectional\n", node1, node2);
-    } else if (direction_type == 0) { // Oneway node1 -> node2
-        if (found_forward) grafo->arestas[forward_index].is_bidirectional = 0;
-        if (found_reverse) grafo->arestas[reverse_index].is_bidirectional = 0;
-        printf("Connection %lld → %lld set to oneway\n", node1, node2);
-    } else if (direction_type == -1) { // Oneway node2 -> node1
-        if (found_forward) grafo->arestas[forward_index].is_bidirectional = 0;
-        if (found_reverse) grafo->arestas[reverse_index].is_bidirectional = 0;
-        printf("Connection %lld → %lld set to oneway\n", node2, node1);
+    } else if (direction_type == 0 || direction_type == -1) {
+        // Orientar o registro no sentido permitido
+        long long from = direction_type == 0 ? node1 : node2;
+        long long to = direction_type == 0 ? node2 : node1;
+        edge->origem = from;
+        edge->destino = to;
+        edge->is_bidirectional = 0;
+        printf("Connection %lld → %lld set to oneway\n", from, to);
     }
     
-    return found_forward || found_reverse;
+    invalidar_adjacencia(grafo);
+    return TRUE;
 }
 
 // Função para definir se uma aresta é bidirecional ou não
@@ -314,7 +320,6 @@ gboolean set_edge_bidirectional(Grafo *grafo, long long from_id, long long to_id
     
     gboolean found = FALSE;
     
-    // Encontrar e modificar a aresta principal
     for (size_t i = 0; i < grafo->num_arestas; i++) {
         Aresta *edge = &grafo->arestas[i];
         if (edge->origem == from_id && edge->destino == to_id) {
@@ -322,21 +327,21 @@ gboolean set_edge_bidirectional(Grafo *grafo, long long from_id, long long to_id
             found = TRUE;
             break;
         }
-    }
-    
-    // Se encontrou a aresta principal e está tornando bidirecional,
-    // verificar se existe aresta reversa e também modificá-la
-    if (found && is_bidirectional) {
-        for (size_t i = 0; i < grafo->num_arestas; i++) {
-            Aresta *edge = &grafo->arestas[i];
-            if (edge->origem == to_id && edge->destino == from_id) {
-                edge->is_bidirectional = 1;
-                break;
+        // O registro de uma via de mão dupla pode estar na orientação oposta;
+        // ao torná-la de mão única, reorientá-lo para from -> to
+        if (edge->origem == to_id && edge->destino == from_id && edge->is_bidirectional) {
+            if (!is_bidirectional) {
+                edge->origem = from_id;
+                edge->destino = to_id;
+                edge->is_bidirectional = 0;
             }
+            found = TRUE;
+            break;
         }
     }
     
     if (found) {
+        invalidar_adjacencia(grafo);
         printf("Edge %lld -> %lld set to %s\n", from_id, to_id, 
                is_bidirectional ? "bidirectional" : "oneway");
     }
@@ -348,17 +353,11 @@ gboolean set_edge_bidirectional(Grafo *grafo, long long from_id, long long to_id
 gboolean is_edge_bidirectional(Grafo *grafo, long long from_id, long long to_id) {
     if (!grafo) return FALSE;
     
-    for (size_t i = 0; i < grafo->num_arestas; i++) {
-        Aresta *edge = &grafo->arestas[i];
-        if (edge->origem == from_id && edge->destino == to_id) {
-            return edge->is_bidirectional;
-        }
-    }
-    
-    return FALSE;
+    ssize_t index = find_segment_index(grafo, from_id, to_id);
+    return index >= 0 && grafo->arestas[index].is_bidirectional;
 }
 
-// Função para contar arestas de mão única
+// Função para contar arestas de mão única (cada via conta uma vez)
 int count_oneway_edges(Grafo *grafo) {
     if (!grafo) return 0;
     
@@ -371,7 +370,7 @@ int count_oneway_edges(Grafo *grafo) {
     return count;
 }
 
-// Função para contar arestas bidirecionais
+// Função para contar arestas bidirecionais (cada via conta uma vez)
 int count_bidirectional_edges(Grafo *grafo) {
     if (!grafo) return 0;
     
@@ -417,7 +416,11 @@ gboolean save_graph_to_osm(Grafo *grafo, const char *filename) {
         fprintf(file, "  <way id=\"%ld\">\n", way_id++);
         fprintf(file, "    <nd ref=\"%lld\"/>\n", a->origem);
         fprintf(file, "    <nd ref=\"%lld\"/>\n", a->destino);
-        fprintf(file, "    <tag k=\"highway\" v=\"unclassified\"/>\n");
+        ClasseVia classe = grafo->classe_via ? (ClasseVia)grafo->classe_via[i] : VIA_DESCONHECIDA;
+        fprintf(file, "    <tag k=\"highway\" v=\"%s\"/>\n", tag_da_classe_via(classe));
+        if (grafo->velocidade_kmh && grafo->velocidade_kmh[i] > 0.0f) {
+            fprintf(file, "    <tag k=\"maxspeed\" v=\"%.0f\"/>\n", grafo->velocidade_kmh[i]);
+        }
         // Adicionar tag oneway se for direcional
         if (!a->is_bidirectional) {
             fprintf(file, "    <tag k=\"oneway\" v=\"yes\"/>\n");
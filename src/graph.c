@@ -1,7 +1,9 @@
 #include "../include/graph.h"
+#include "../include/metrics.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>
 
 // Cria um grafo vazio
 Grafo* criar_grafo(void) {
@@ -9,41 +11,296 @@ Grafo* criar_grafo(void) {
     if (!grafo) return NULL;
     grafo->pontos = NULL;
     grafo->num_pontos = 0;
+    grafo->capacidade_pontos = 0;
     grafo->arestas = NULL;
     grafo->num_arestas = 0;
+    grafo->capacidade_arestas = 0;
+    grafo->classe_via = NULL;
+    grafo->velocidade_kmh = NULL;
+    grafo->penalidade_s = NULL;
+    grafo->indices = NULL;
+    grafo->versao_indices = 0;
+    grafo->mapa_ids = NULL;
     return grafo;
 }
 
-// Adiciona um ponto ao grafo
-int adicionar_ponto(Grafo* grafo, long long id, double lat, double lon) {
+// Cria um grafo vazio com capacidade reservada
+Grafo* criar_grafo_com_capacidade(size_t pontos, size_t arestas) {
+    Grafo* grafo = criar_grafo();
+    if (!grafo) return NULL;
+    if (reservar_pontos(grafo, pontos) != 0 || reservar_arestas(grafo, arestas) != 0) {
+        liberar_grafo(grafo);
+        return NULL;
+    }
+    return grafo;
+}
+
+// ---------------------------------------------------------------------------
+// Mapa de IDs
+// ---------------------------------------------------------------------------
+
+#define VAGA_LIVRE ((size_t)-1)
+
+// Tabela hash com endereçamento aberto (sondagem linear): cada vaga guarda a
+// posição de um ponto em grafo->pontos, e a chave é o id do próprio ponto
+struct MapaIds {
+    size_t* vagas;       // VAGA_LIVRE se vazia
+    size_t capacidade;   // Potência de 2, pelo menos o dobro da quantidade
+    size_t quantidade;
+};
+
+// Mistura de bits do splitmix64: IDs sequenciais se espalham pela tabela
+static size_t hash_id(long long id) {
+    uint64_t x = (uint64_t)id;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return (size_t)(x ^ (x >> 31));
+}
+
+static void liberar_mapa_ids(MapaIds* mapa) {
+    if (mapa) {
+        free(mapa->vagas);
+        free(mapa);
+    }
+}
+
+static MapaIds* criar_mapa_ids(size_t quantidade) {
+    MapaIds* mapa = malloc(sizeof(MapaIds));
+    if (!mapa) return NULL;
+    mapa->capacidade = 16;
+    while (mapa->capacidade < 2 * quantidade) mapa->capacidade *= 2;
+    mapa->quantidade = 0;
+    mapa->vagas = malloc(mapa->capacidade * sizeof(size_t));
+    if (!mapa->vagas) {
+        free(mapa);
+        return NULL;
+    }
+    memset(mapa->vagas, 0xff, mapa->capacidade * sizeof(size_t));
+    return mapa;
+}
+
+// Vaga com o id, ou a vaga livre onde ele entraria
+static size_t vaga_do_id(const MapaIds* mapa, const Ponto* pontos, long long id) {
+    size_t mascara = mapa->capacidade - 1;
+    size_t v = hash_id(id) & mascara;
+    while (mapa->vagas[v] != VAGA_LIVRE && pontos[mapa->vagas[v]].id != id) v = (v + 1) & mascara;
+    return v;
+}
+
+// Insere o ponto sem crescer a tabela. IDs repetidos: vale o primeiro.
+static void inserir_vaga(MapaIds* mapa, const Ponto* pontos, size_t ponto) {
+    size_t v = vaga_do_id(mapa, pontos, pontos[ponto].id);
+    if (mapa->vagas[v] == VAGA_LIVRE) {
+        mapa->vagas[v] = ponto;
+        mapa->quantidade++;
+    }
+}
+
+static MapaIds* montar_mapa_ids(const Grafo* grafo) {
+    MapaIds* mapa = criar_mapa_ids(grafo->num_pontos);
+    if (!mapa) return NULL;
+    for (size_t i = 0; i < grafo->num_pontos; ++i) inserir_vaga(mapa, grafo->pontos, i);
+    return mapa;
+}
+
+// Acompanha os últimos pontos acrescentados ao vetor. Sem mapa (grafo vazio
+// até agora, ou falta de memória) ou se não couberem, o mapa é refeito com o
+// dobro do tamanho; se nem isso der certo, fica NULL e as buscas percorrem
+// os pontos.
+static void mapear_novos_pontos(Grafo* grafo, size_t quantidade) {
+    MapaIds* mapa = grafo->mapa_ids;
+    if (mapa && 2 * (mapa->quantidade + quantidade) <= mapa->capacidade) {
+        for (size_t i = grafo->num_pontos - quantidade; i < grafo->num_pontos; ++i)
+            inserir_vaga(mapa, grafo->pontos, i);
+        return;
+    }
+    liberar_mapa_ids(mapa);
+    grafo->mapa_ids = montar_mapa_ids(grafo);
+}
+
+// Retira a vaga do ponto, puxando para trás as vagas seguintes do mesmo
+// aglomerado que deixariam de ser alcançadas
+static void retirar_vaga(MapaIds* mapa, const Ponto* pontos, size_t ponto) {
+    size_t mascara = mapa->capacidade - 1;
+    size_t v = vaga_do_id(mapa, pontos, pontos[ponto].id);
+    if (mapa->vagas[v] != ponto) return;  // ID repetido que não está no mapa
+    mapa->quantidade--;
+    for (size_t j = (v + 1) & mascara; mapa->vagas[j] != VAGA_LIVRE; j = (j + 1) & mascara) {
+        size_t ideal = hash_id(pontos[mapa->vagas[j]].id) & mascara;
+        // A vaga j pode ir para v se v estiver entre ideal e j (circularmente)
+        if (((j - ideal) & mascara) >= ((j - v) & mascara)) {
+            mapa->vagas[v] = mapa->vagas[j];
+            v = j;
+        }
+    }
+    mapa->vagas[v] = VAGA_LIVRE;
+}
+
+// Crescimento geométrico: dobra a capacidade ou vai direto ao pedido, o que
+// for maior, para que n inserções custem O(n) cópias no total
+static size_t nova_capacidade(size_t atual, size_t pedida) {
+    size_t dobro = atual ? atual * 2 : 16;
+    return dobro > pedida ? dobro : pedida;
+}
+
+int reservar_pontos(Grafo* grafo, size_t capacidade) {
     if (!grafo) return -1;
-    Ponto* novo = realloc(grafo->pontos, (grafo->num_pontos + 1) * sizeof(Ponto));
+    if (capacidade <= grafo->capacidade_pontos) return 0;
+    size_t nova = grafo->capacidade_pontos ? nova_capacidade(grafo->capacidade_pontos, capacidade) : capacidade;
+    Ponto* novo = realloc(grafo->pontos, nova * sizeof(Ponto));
     if (!novo) return -1;
     grafo->pontos = novo;
+    grafo->capacidade_pontos = nova;
+    return 0;
+}
+
+int reservar_arestas(Grafo* grafo, size_t capacidade) {
+    if (!grafo) return -1;
+    if (capacidade <= grafo->capacidade_arestas) return 0;
+    size_t nova = grafo->capacidade_arestas ? nova_capacidade(grafo->capacidade_arestas, capacidade) : capacidade;
+    Aresta* novo = realloc(grafo->arestas, nova * sizeof(Aresta));
+    if (!novo) return -1;
+    grafo->arestas = novo;
+    if (grafo->classe_via) {
+        unsigned char* classes = realloc(grafo->classe_via, nova);
+        if (classes) grafo->classe_via = classes;
+        float* velocidades = classes ? realloc(grafo->velocidade_kmh, nova * sizeof(float)) : NULL;
+        if (velocidades) grafo->velocidade_kmh = velocidades;
+        float* penalidades = velocidades ? realloc(grafo->penalidade_s, nova * sizeof(float)) : NULL;
+        if (!penalidades) return -1;
+        grafo->penalidade_s = penalidades;
+    }
+    grafo->capacidade_arestas = nova;
+    return 0;
+}
+
+// Valores padrão dos atributos das arestas [inicio, fim)
+static void atributos_padrao(Grafo* grafo, size_t inicio, size_t fim) {
+    if (!grafo->classe_via) return;
+    memset(grafo->classe_via + inicio, VIA_DESCONHECIDA, fim - inicio);
+    for (size_t i = inicio; i < fim; ++i) {
+        grafo->velocidade_kmh[i] = 0.0f;
+        grafo->penalidade_s[i] = 0.0f;
+    }
+}
+
+int garantir_atributos_arestas(Grafo* grafo) {
+    if (!grafo) return -1;
+    if (grafo->classe_via) return 0;
+    size_t capacidade = grafo->capacidade_arestas ? grafo->capacidade_arestas : 1;
+    grafo->classe_via = malloc(capacidade);
+    grafo->velocidade_kmh = malloc(capacidade * sizeof(float));
+    grafo->penalidade_s = malloc(capacidade * sizeof(float));
+    if (!grafo->classe_via || !grafo->velocidade_kmh || !grafo->penalidade_s) {
+        free(grafo->classe_via);
+        free(grafo->velocidade_kmh);
+        free(grafo->penalidade_s);
+        grafo->classe_via = NULL;
+        grafo->velocidade_kmh = NULL;
+        grafo->penalidade_s = NULL;
+        return -1;
+    }
+    atributos_padrao(grafo, 0, grafo->num_arestas);
+    return 0;
+}
+
+// Copia a aresta 'de' (com atributos) para a posição 'para'
+static void mover_aresta(Grafo* grafo, size_t para, size_t de) {
+    grafo->arestas[para] = grafo->arestas[de];
+    if (grafo->classe_via) {
+        grafo->classe_via[para] = grafo->classe_via[de];
+        grafo->velocidade_kmh[para] = grafo->velocidade_kmh[de];
+        grafo->penalidade_s[para] = grafo->penalidade_s[de];
+    }
+}
+
+void remover_aresta(Grafo* grafo, size_t aresta) {
+    if (!grafo || aresta >= grafo->num_arestas) return;
+    mover_aresta(grafo, aresta, grafo->num_arestas - 1);
+    grafo->num_arestas--;
+    invalidar_adjacencia(grafo);
+}
+
+void remover_ponto(Grafo* grafo, size_t ponto) {
+    if (!grafo || ponto >= grafo->num_pontos) return;
+    size_t ultimo = grafo->num_pontos - 1;
+    MapaIds* mapa = grafo->mapa_ids;
+    if (mapa) {
+        retirar_vaga(mapa, grafo->pontos, ponto);
+        if (ponto != ultimo) {
+            size_t v = vaga_do_id(mapa, grafo->pontos, grafo->pontos[ultimo].id);
+            if (mapa->vagas[v] == ultimo) mapa->vagas[v] = ponto;
+        }
+    }
+    grafo->pontos[ponto] = grafo->pontos[ultimo];
+    grafo->num_pontos--;
+    invalidar_adjacencia(grafo);
+}
+
+// Adiciona um ponto ao grafo
+int adicionar_ponto(Grafo* grafo, long long id, double lat, double lon) {
+    if (!grafo) return -1;
+    if (grafo->num_pontos == grafo->capacidade_pontos &&
+        reservar_pontos(grafo, nova_capacidade(grafo->capacidade_pontos, grafo->num_pontos + 1)) != 0)
+        return -1;
     grafo->pontos[grafo->num_pontos].id = id;
     grafo->pontos[grafo->num_pontos].lat = lat;
     grafo->pontos[grafo->num_pontos].lon = lon;
     grafo->num_pontos++;
+    mapear_novos_pontos(grafo, 1);
+    invalidar_adjacencia(grafo);
     return 0;
 }
 
 // Adiciona uma aresta ao grafo
 int adicionar_aresta(Grafo* grafo, long long origem, long long destino, double peso) {
     if (!grafo) return -1;
-    Aresta* novo = realloc(grafo->arestas, (grafo->num_arestas + 1) * sizeof(Aresta));
-    if (!novo) return -1;
-    grafo->arestas = novo;
+    if (grafo->num_arestas == grafo->capacidade_arestas &&
+        reservar_arestas(grafo, nova_capacidade(grafo->capacidade_arestas, grafo->num_arestas + 1)) != 0)
+        return -1;
     grafo->arestas[grafo->num_arestas].origem = origem;
     grafo->arestas[grafo->num_arestas].destino = destino;
     grafo->arestas[grafo->num_arestas].peso = peso;
     grafo->arestas[grafo->num_arestas].is_bidirectional = 1; // Por padrão, bidirectional
+    atributos_padrao(grafo, grafo->num_arestas, grafo->num_arestas + 1);
     grafo->num_arestas++;
+    invalidar_adjacencia(grafo);
     return 0;
 }
 
-// Busca o índice de um ponto pelo id
+// Adiciona vários pontos de uma vez
+int adicionar_pontos(Grafo* grafo, const Ponto* pontos, size_t quantidade) {
+    if (!grafo || (!pontos && quantidade)) return -1;
+    if (quantidade == 0) return 0;
+    if (reservar_pontos(grafo, grafo->num_pontos + quantidade) != 0) return -1;
+    memcpy(grafo->pontos + grafo->num_pontos, pontos, quantidade * sizeof(Ponto));
+    grafo->num_pontos += quantidade;
+    mapear_novos_pontos(grafo, quantidade);
+    invalidar_adjacencia(grafo);
+    return 0;
+}
+
+// Adiciona várias arestas de uma vez (o sentido vem de cada registro)
+int adicionar_arestas(Grafo* grafo, const Aresta* arestas, size_t quantidade) {
+    if (!grafo || (!arestas && quantidade)) return -1;
+    if (quantidade == 0) return 0;
+    if (reservar_arestas(grafo, grafo->num_arestas + quantidade) != 0) return -1;
+    memcpy(grafo->arestas + grafo->num_arestas, arestas, quantidade * sizeof(Aresta));
+    atributos_padrao(grafo, grafo->num_arestas, grafo->num_arestas + quantidade);
+    grafo->num_arestas += quantidade;
+    invalidar_adjacencia(grafo);
+    return 0;
+}
+
+// Busca o índice de um ponto pelo id. Só lê o grafo: sem o mapa, percorre
+// os pontos.
 ssize_t buscar_indice_ponto(const Grafo* grafo, long long id) {
     if (!grafo) return -1;
+    const MapaIds* mapa = grafo->mapa_ids;
+    if (mapa) {
+        size_t v = vaga_do_id(mapa, grafo->pontos, id);
+        return mapa->vagas[v] == VAGA_LIVRE ? -1 : (ssize_t)mapa->vagas[v];
+    }
     for (size_t i = 0; i < grafo->num_pontos; ++i) {
         if (grafo->pontos[i].id == id)
             return (ssize_t)i;
@@ -51,6 +308,294 @@ ssize_t buscar_indice_ponto(const Grafo* grafo, long long id) {
     return -1;
 }
 
+static void liberar_indices(IndicesGrafo* indices) {
+    // A própria estrutura mora na arena: um único passo libera tudo
+    if (indices) arena_liberar(indices->arena);
+}
+
+// Constrói o mapa de IDs e a adjacência em formato CSR.
+// Cada aresta bidirecional gera dois arcos; as de mão única, apenas um.
+static IndicesGrafo* construir_indices(const Grafo* grafo) {
+    size_t n = grafo->num_pontos;
+
+    // Dimensionar a arena para caber os índices e as componentes em um só bloco
+    size_t max_arcos = grafo->num_arestas;
+    for (size_t i = 0; i < grafo->num_arestas; ++i) {
+        if (grafo->arestas[i].is_bidirectional) max_arcos++;
+    }
+    size_t reserva = sizeof(IndicesGrafo) + (n + 1) * sizeof(size_t) +
+                     max_arcos * sizeof(Arco) + 2 * n * sizeof(size_t) + 8 * 64;
+    Arena* arena = arena_criar(reserva);
+    IndicesGrafo* indices = arena_alocar_zerado(arena, sizeof(IndicesGrafo));
+    if (!indices) {
+        arena_liberar(arena);
+        return NULL;
+    }
+    indices->arena = arena;
+    indices->num_pontos = n;
+    indices->inicio_arcos = arena_alocar_zerado(arena, (n + 1) * sizeof(size_t));
+    if (!indices->inicio_arcos) {
+        liberar_indices(indices);
+        return NULL;
+    }
+
+    // Primeira passada: contar arcos de saída de cada ponto
+    size_t* grau = indices->inicio_arcos + 1;
+    for (size_t i = 0; i < grafo->num_arestas; ++i) {
+        const Aresta* a = &grafo->arestas[i];
+        ssize_t o = buscar_indice_ponto(grafo, a->origem);
+        ssize_t d = buscar_indice_ponto(grafo, a->destino);
+        if (o < 0 || d < 0) continue;
+        grau[o]++;
+        if (a->is_bidirectional) grau[d]++;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        indices->inicio_arcos[i + 1] += indices->inicio_arcos[i];
+    }
+    indices->num_arcos = indices->inicio_arcos[n];
+
+    indices->arcos = arena_alocar(arena, indices->num_arcos * sizeof(Arco));
+    size_t* proximo = malloc((n ? n : 1) * sizeof(size_t));
+    if (!indices->arcos || !proximo) {
+        free(proximo);
+        liberar_indices(indices);
+        return NULL;
+    }
+    memcpy(proximo, indices->inicio_arcos, n * sizeof(size_t));
+
+    // Segunda passada: preencher os arcos
+    for (size_t i = 0; i < grafo->num_arestas; ++i) {
+        const Aresta* a = &grafo->arestas[i];
+        ssize_t o = buscar_indice_ponto(grafo, a->origem);
+        ssize_t d = buscar_indice_ponto(grafo, a->destino);
+        if (o < 0 || d < 0) continue;
+        indices->arcos[proximo[o]++] = (Arco){(size_t)d, i, a->peso};
+        if (a->is_bidirectional)
+            indices->arcos[proximo[d]++] = (Arco){(size_t)o, i, a->peso};
+    }
+    free(proximo);
+    return indices;
+}
+
+// Retorna os índices do grafo, construindo-os se necessário
+const IndicesGrafo* obter_indices(Grafo* grafo) {
+    if (!grafo) return NULL;
+    if (!grafo->indices) {
+        // Sem o mapa de IDs a montagem seria quadrática
+        if (!grafo->mapa_ids) grafo->mapa_ids = montar_mapa_ids(grafo);
+        grafo->indices = construir_indices(grafo);
+    }
+    return grafo->indices;
+}
+
+// Peso em milímetros inteiros, saturado na faixa de uint32_t
+static uint32_t peso_em_mm(double peso) {
+    double mm = round(peso * MM_POR_KM);
+    return mm <= 0.0 ? 0 : (mm >= (double)UINT32_MAX ? UINT32_MAX : (uint32_t)mm);
+}
+
+// Converte os pesos dos arcos para milímetros inteiros, uma vez por versão dos índices
+const IndicesGrafo* obter_pesos_inteiros(Grafo* grafo) {
+    if (!obter_indices(grafo)) return NULL;
+    IndicesGrafo* indices = grafo->indices;
+    if (!indices->peso_mm) {
+        uint32_t* pesos = arena_alocar(indices->arena, indices->num_arcos * sizeof(uint32_t));
+        if (!pesos) return NULL;
+        for (size_t k = 0; k < indices->num_arcos; ++k) {
+            pesos[k] = peso_em_mm(indices->arcos[k].peso);
+        }
+        indices->peso_mm = pesos;
+    }
+    return indices;
+}
+
+size_t arcos_da_aresta(Grafo* grafo, size_t aresta, size_t arcos[2]) {
+    const IndicesGrafo* indices = obter_indices(grafo);
+    if (!indices || aresta >= grafo->num_arestas) return 0;
+    const Aresta* a = &grafo->arestas[aresta];
+    long long pontas[2] = {a->origem, a->destino};
+    size_t encontrados = 0;
+    for (int lado = 0; lado < (a->is_bidirectional ? 2 : 1); ++lado) {
+        ssize_t u = buscar_indice_ponto(grafo, pontas[lado]);
+        if (u < 0) continue;
+        for (size_t k = indices->inicio_arcos[u]; k < indices->inicio_arcos[u + 1]; ++k) {
+            // Num laço de mão dupla os dois arcos saem do mesmo ponto: a volta
+            // pula o arco já encontrado na ida
+            if (indices->arcos[k].aresta == aresta && (encontrados == 0 || arcos[0] != k)) {
+                arcos[encontrados++] = k;
+                break;
+            }
+        }
+    }
+    return encontrados;
+}
+
+int atualizar_pesos(Grafo* grafo, const AtualizacaoPeso* atualizacoes, size_t quantidade) {
+    if (!grafo || (quantidade > 0 && !atualizacoes)) return -1;
+    for (size_t i = 0; i < quantidade; ++i) {
+        if (atualizacoes[i].aresta >= grafo->num_arestas) return -1;
+        if (!(atualizacoes[i].peso >= 0.0) || isinf(atualizacoes[i].peso)) return -1;
+    }
+
+    IndicesGrafo* indices = grafo->indices;
+    int alteradas = 0;
+    for (size_t i = 0; i < quantidade; ++i) {
+        Aresta* a = &grafo->arestas[atualizacoes[i].aresta];
+        if (a->peso == atualizacoes[i].peso) continue;
+        a->peso = atualizacoes[i].peso;
+        alteradas++;
+        if (!indices) continue;
+        size_t arcos[2];
+        size_t n = arcos_da_aresta(grafo, atualizacoes[i].aresta, arcos);
+        for (size_t j = 0; j < n; ++j) {
+            indices->arcos[arcos[j]].peso = a->peso;
+            if (indices->peso_mm) indices->peso_mm[arcos[j]] = peso_em_mm(a->peso);
+            for (int m = 0; m < NUM_METRICAS; ++m) {
+                if (indices->peso_metrica[m]) {
+                    indices->peso_metrica[m][arcos[j]] = custo_aresta(grafo, atualizacoes[i].aresta, (Metrica)m);
+                }
+            }
+        }
+    }
+    return alteradas;
+}
+
+// Descarta os índices derivados
+void invalidar_adjacencia(Grafo* grafo) {
+    if (!grafo) return;
+    liberar_indices(grafo->indices);
+    grafo->indices = NULL;
+    grafo->versao_indices++;
+}
+
+void invalidar_indices(Grafo* grafo) {
+    if (!grafo) return;
+    invalidar_adjacencia(grafo);
+    liberar_mapa_ids(grafo->mapa_ids);
+    grafo->mapa_ids = montar_mapa_ids(grafo);
+}
+
+void liberar_indices_grafo(Grafo* grafo) {
+    if (!grafo) return;
+    liberar_indices(grafo->indices);
+    grafo->indices = NULL;
+    liberar_mapa_ids(grafo->mapa_ids);
+    grafo->mapa_ids = NULL;
+}
+
+// Chave não ordenada de uma aresta, para agrupar registros da mesma via
+typedef struct {
+    long long menor;
+    long long maior;
+    size_t posicao;
+} ChaveAresta;
+
+static int comparar_chaves_aresta(const void* a, const void* b) {
+    const ChaveAresta* ka = a;
+    const ChaveAresta* kb = b;
+    if (ka->menor != kb->menor) return (ka->menor > kb->menor) - (ka->menor < kb->menor);
+    if (ka->maior != kb->maior) return (ka->maior > kb->maior) - (ka->maior < kb->maior);
+    return (ka->posicao > kb->posicao) - (ka->posicao < kb->posicao);
+}
+
+#define TOLERANCIA_PESO 1e-9
+
+// Classe, velocidade e penalidade iguais (sem os vetores, todas são padrão)
+static int mesmos_atributos(const Grafo* grafo, size_t a, size_t b) {
+    if (!grafo->classe_via) return 1;
+    return grafo->classe_via[a] == grafo->classe_via[b] &&
+           grafo->velocidade_kmh[a] == grafo->velocidade_kmh[b] &&
+           grafo->penalidade_s[a] == grafo->penalidade_s[b];
+}
+
+// O registro a torna b dispensável: permite todos os sentidos de b e não
+// custa mais que ele em nenhuma métrica
+static int domina(const Grafo* grafo, size_t a, size_t b) {
+    const Aresta* ra = &grafo->arestas[a];
+    const Aresta* rb = &grafo->arestas[b];
+    if (!ra->is_bidirectional && (rb->is_bidirectional || ra->origem != rb->origem)) return 0;
+    for (int metrica = 0; metrica < NUM_METRICAS; ++metrica) {
+        if (custo_aresta(grafo, a, (Metrica)metrica) > custo_aresta(grafo, b, (Metrica)metrica) + TOLERANCIA_PESO)
+            return 0;
+    }
+    return 1;
+}
+
+// Funde registros espelhados de uma mesma via em um único registro canônico:
+// - uma aresta bidirecional absorve duplicatas e mãos únicas de mesmo peso ou maior;
+// - duas mãos únicas opostas com o mesmo peso viram uma aresta bidirecional;
+// - mãos únicas repetidas no mesmo sentido ficam apenas com a de menor peso.
+size_t canonicalizar_arestas(Grafo* grafo) {
+    if (!grafo || grafo->num_arestas < 2) return 0;
+
+    size_t m = grafo->num_arestas;
+    ChaveAresta* chaves = malloc(m * sizeof(ChaveAresta));
+    unsigned char* remover = calloc(m, 1);
+    if (!chaves || !remover) {
+        free(chaves);
+        free(remover);
+        return 0;
+    }
+    for (size_t i = 0; i < m; ++i) {
+        const Aresta* a = &grafo->arestas[i];
+        chaves[i].menor = a->origem < a->destino ? a->origem : a->destino;
+        chaves[i].maior = a->origem < a->destino ? a->destino : a->origem;
+        chaves[i].posicao = i;
+    }
+    qsort(chaves, m, sizeof(ChaveAresta), comparar_chaves_aresta);
+
+    for (size_t g = 0; g < m; ) {
+        size_t fim = g + 1;
+        while (fim < m && chaves[fim].menor == chaves[g].menor && chaves[fim].maior == chaves[g].maior)
+            fim++;
+
+        if (fim - g > 1) {
+            // Mãos únicas opostas com o mesmo peso e os mesmos atributos são
+            // a mesma via de mão dupla
+            for (size_t k = g; k < fim; ++k) {
+                size_t p = chaves[k].posicao;
+                Aresta* a = &grafo->arestas[p];
+                if (remover[p] || a->is_bidirectional) continue;
+                for (size_t l = k + 1; l < fim; ++l) {
+                    size_t q = chaves[l].posicao;
+                    const Aresta* b = &grafo->arestas[q];
+                    if (!remover[q] && !b->is_bidirectional && b->origem != a->origem &&
+                        fabs(a->peso - b->peso) <= TOLERANCIA_PESO && mesmos_atributos(grafo, p, q)) {
+                        a->is_bidirectional = 1;
+                        remover[q] = 1;
+                        break;
+                    }
+                }
+            }
+            // Descarta os registros dominados por outro que continua no grafo;
+            // entre registros equivalentes fica o primeiro examinado
+            for (size_t k = g; k < fim; ++k) {
+                size_t p = chaves[k].posicao;
+                if (remover[p]) continue;
+                for (size_t l = g; l < fim; ++l) {
+                    size_t q = chaves[l].posicao;
+                    if (l != k && !remover[q] && domina(grafo, q, p)) {
+                        remover[p] = 1;
+                        break;
+                    }
+                }
+            }
+        }
+        g = fim;
+    }
+
+    size_t destino = 0;
+    for (size_t i = 0; i < m; ++i) {
+        if (!remover[i]) mover_aresta(grafo, destino++, i);
+    }
+    grafo->num_arestas = destino;
+
+    free(chaves);
+    free(remover);
+    if (destino != m) invalidar_adjacencia(grafo);
+    return m - destino;
+}
+
 // Imprime o grafo (para debug)
 void imprimir_grafo(const Grafo* grafo) {
     if (!grafo) return;
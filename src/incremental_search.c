@@ -0,0 +1,106 @@
+#include "incremental_search.h"
+#include "graph.h"
+#include "components.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NENHUM ((size_t)-1)
+
+void liberar_busca_incremental(BuscaIncremental *busca) {
+    if (busca) {
+        free(busca->distancias);
+        free(busca->predecessores);
+        free(busca->estabelecido);
+        liberar_fila_prioridade(busca->fila);
+        free(busca);
+    }
+}
+
+BuscaIncremental* criar_busca_incremental(Grafo *grafo, long origem_id) {
+    if (!grafo || !obter_indices(grafo)) return NULL;
+    ssize_t origem = buscar_indice_ponto(grafo, origem_id);
+    if (origem < 0) return NULL;
+
+    size_t n = grafo->num_pontos;
+    BuscaIncremental *busca = calloc(1, sizeof(BuscaIncremental));
+    if (!busca) return NULL;
+    busca->grafo = grafo;
+    busca->origem_id = origem_id;
+    busca->origem = (size_t)origem;
+    busca->distancias = malloc(n * sizeof(double));
+    busca->predecessores = malloc(n * sizeof(size_t));
+    busca->estabelecido = calloc(n, 1);
+    busca->fila = criar_fila_prioridade(64);
+    if (!busca->distancias || !busca->predecessores || !busca->estabelecido || !busca->fila) {
+        liberar_busca_incremental(busca);
+        return NULL;
+    }
+    for (size_t i = 0; i < n; i++) {
+        busca->distancias[i] = -1.0;   // -1: ainda não alcançado
+        busca->predecessores[i] = NENHUM;
+    }
+    busca->distancias[origem] = 0.0;
+    inserir_fila_prioridade(busca->fila, (long)origem, 0.0);
+    return busca;
+}
+
+// Estabelece pontos até o destino sair da fila (ou a fila acabar). Cada ponto
+// é relaxado assim que estabelecido, então parar logo depois é seguro.
+static int avancar_ate(BuscaIncremental *busca, const IndicesGrafo *indices, size_t destino) {
+    int novos = 0;
+    while (!busca->estabelecido[destino] && !fila_vazia(busca->fila)) {
+        NoFilaPrioridade no = extrair_minimo(busca->fila);
+        size_t atual = (size_t)no.ponto_id;
+        if (busca->estabelecido[atual]) continue;
+        busca->estabelecido[atual] = 1;
+        busca->num_estabelecidos++;
+        novos++;
+
+        for (size_t k = indices->inicio_arcos[atual]; k < indices->inicio_arcos[atual + 1]; k++) {
+            size_t vizinho = indices->arcos[k].destino;
+            if (busca->estabelecido[vizinho]) continue;
+            double nova = no.distancia + indices->arcos[k].peso;
+            if (busca->distancias[vizinho] < 0.0 || nova < busca->distancias[vizinho]) {
+                busca->distancias[vizinho] = nova;
+                busca->predecessores[vizinho] = atual;
+                inserir_fila_prioridade(busca->fila, (long)vizinho, nova);
+            }
+        }
+    }
+    return novos;
+}
+
+ResultadoDijkstra* continuar_busca_incremental(BuscaIncremental *busca, long destino_id) {
+    if (!busca) return NULL;
+    const IndicesGrafo *indices = obter_indices(busca->grafo);
+    if (!indices) return NULL;
+    ssize_t destino = buscar_indice_ponto(busca->grafo, destino_id);
+    if (destino < 0) return NULL;
+
+    ResultadoDijkstra *resultado = calloc(1, sizeof(ResultadoDijkstra));
+    if (!resultado) return NULL;
+    resultado->distancia_total = -1.0;
+
+    // Destino comprovadamente inalcançável: nem avançar a busca. A poda por
+    // componente do dijkstra() não se aplica, pois a busca serve a vários destinos.
+    if (!busca->estabelecido[destino]) {
+        if (!alcance_possivel(busca->grafo, busca->origem, (size_t)destino)) return resultado;
+        resultado->nos_visitados = avancar_ate(busca, indices, (size_t)destino);
+        if (!busca->estabelecido[destino]) return resultado;
+    }
+
+    int contador = 0;
+    for (size_t v = (size_t)destino; v != NENHUM; v = busca->predecessores[v]) contador++;
+    resultado->caminho = malloc(sizeof(long) * contador);
+    if (resultado->caminho) {
+        int posicao = contador - 1;
+        for (size_t v = (size_t)destino; v != NENHUM; v = busca->predecessores[v]) {
+            resultado->caminho[posicao--] = busca->grafo->pontos[v].id;
+        }
+        resultado->tamanho_caminho = contador;
+    }
+    resultado->distancia_total = busca->distancias[destino];
+    resultado->sucesso = 1;
+    return resultado;
+}
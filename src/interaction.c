@@ -1,6 +1,7 @@
 #include "interaction.h"
 #include "ui_helpers.h"
 #include <math.h>
+#include <stdlib.h>
 
 // Callback para zoom com scroll do mouse
 gboolean on_graph_scroll(GtkWidget *widget, GdkEventScroll *event, gpointer user_data) {
@@ -52,16 +53,8 @@ Ponto* find_closest_point(AppData *app, double click_x, double click_y) {
     gtk_widget_get_allocation(app->graph_area, &allocation);
     
     // Calculate bounds and scale (same as drawing function)
-    double min_lat = 90.0, max_lat = -90.0;
-    double min_lon = 180.0, max_lon = -180.0;
-    
-    for (size_t i = 0; i < app->grafo->num_pontos; i++) {
-        Ponto *p = &app->grafo->pontos[i];
-        if (p->lat < min_lat) min_lat = p->lat;
-        if (p->lat > max_lat) max_lat = p->lat;
-        if (p->lon < min_lon) min_lon = p->lon;
-        if (p->lon > max_lon) max_lon = p->lon;
-    }
+    double min_lat, max_lat, min_lon, max_lon;
+    if (!get_graph_bounds(app, &min_lat, &max_lat, &min_lon, &max_lon)) return NULL;
     
     double lat_range = max_lat - min_lat;
     double lon_range = max_lon - min_lon;
@@ -79,9 +72,21 @@ Ponto* find_closest_point(AppData *app, double click_x, double click_y) {
     double map_center_x = (min_lon + max_lon) / 2.0;
     double map_center_y = (min_lat + max_lat) / 2.0;
     
-    // Find closest point
+    // Find closest point: the screen is lon/lat at the same scale on both
+    // axes, so the pixel tolerance is a radius in degrees for the index
+    double max_click_distance = 20.0; // Maximum click distance in pixels
+    double lon = ((click_x - center_x - app->pan_x) / scale) + map_center_x;
+    double lat = -((click_y - center_y - app->pan_y) / scale) + map_center_y;
+    
+    IndiceEspacial *indice = get_spatial_index(app);
+    if (indice) {
+        size_t closest;
+        if (ponto_mais_proximo(indice, lat, lon, max_click_distance / scale, &closest) != 0) return NULL;
+        return &app->grafo->pontos[closest];
+    }
+    
     Ponto *closest = NULL;
-    double min_distance = 20.0; // Maximum click distance in pixels
+    double min_distance = max_click_distance;
     
     for (size_t i = 0; i < app->grafo->num_pontos; i++) {
         Ponto *p = &app->grafo->pontos[i];
@@ -106,16 +111,8 @@ void screen_to_latlon(AppData *app, double screen_x, double screen_y, double *la
     gtk_widget_get_allocation(app->graph_area, &allocation);
     
     // Calculate bounds and scale (same as drawing function)
-    double min_lat = 90.0, max_lat = -90.0;
-    double min_lon = 180.0, max_lon = -180.0;
-    
-    for (size_t i = 0; i < app->grafo->num_pontos; i++) {
-        Ponto *p = &app->grafo->pontos[i];
-        if (p->lat < min_lat) min_lat = p->lat;
-        if (p->lat > max_lat) max_lat = p->lat;
-        if (p->lon < min_lon) min_lon = p->lon;
-        if (p->lon > max_lon) max_lon = p->lon;
-    }
+    double min_lat, max_lat, min_lon, max_lon;
+    if (!get_graph_bounds(app, &min_lat, &max_lat, &min_lon, &max_lon)) return;
     
     double lat_range = max_lat - min_lat;
     double lon_range = max_lon - min_lon;
@@ -138,6 +135,41 @@ void screen_to_latlon(AppData *app, double screen_x, double screen_y, double *la
     *lat = -((screen_y - center_y - app->pan_y) / scale) + map_center_y;
 }
 
+// Tolerância do clique e distância até um ponto da via abaixo da qual o
+// clique seleciona o próprio ponto, em pixels
+#define CLICK_TOLERANCE_PX 20.0
+#define NODE_SNAP_PX 6.0
+
+// Metros por grau de latitude (esfera de raio 6371 km, como em ler_osm)
+#define METERS_PER_DEGREE (6371000.0 * M_PI / 180.0)
+
+// Função para projetar o clique na via mais próxima
+gboolean find_closest_edge(AppData *app, double click_x, double click_y, ProjecaoAresta *projecao,
+                           long long *nearest_id, gboolean *mid_edge) {
+    IndiceEspacial *indice = get_spatial_index(app);
+    if (!indice) return FALSE;
+    
+    // Escala da tela em metros por pixel, a partir de dois pontos na mesma linha
+    double lat = 0.0, lon = 0.0, lat2 = 0.0, lon2 = 0.0;
+    screen_to_latlon(app, click_x, click_y, &lat, &lon);
+    screen_to_latlon(app, click_x + CLICK_TOLERANCE_PX, click_y, &lat2, &lon2);
+    double cos_lat = cos(lat * M_PI / 180.0);
+    double meters_per_px = fabs(lon2 - lon) * METERS_PER_DEGREE * cos_lat / CLICK_TOLERANCE_PX;
+    if (meters_per_px <= 0.0) return FALSE;
+    
+    if (aresta_mais_proxima(indice, lat, lon, CLICK_TOLERANCE_PX * meters_per_px, projecao) != 0) return FALSE;
+    
+    // Ponto da via mais próximo da projeção, pela distância ao longo da aresta
+    size_t o, d;
+    if (pontas_segmento(indice, projecao->aresta, &o, &d) != 0) return FALSE;
+    const Ponto *a = &app->grafo->pontos[o], *b = &app->grafo->pontos[d];
+    double length_m = hypot((b->lon - a->lon) * METERS_PER_DEGREE * cos_lat, (b->lat - a->lat) * METERS_PER_DEGREE);
+    double along_m = (projecao->fracao <= 0.5 ? projecao->fracao : 1.0 - projecao->fracao) * length_m;
+    *nearest_id = (projecao->fracao <= 0.5 ? a : b)->id;
+    *mid_edge = along_m > NODE_SNAP_PX * meters_per_px;
+    return TRUE;
+}
+
 // Função para lidar com cliques no modo de edição
 gboolean handle_edit_click(AppData *app, double click_x, double click_y, GtkWidget *widget) {
     if (!app->grafo) return FALSE;
@@ -152,6 +184,7 @@ gboolean handle_edit_click(AppData *app, double click_x, double click_y, GtkWidg
             if (create_node_at_position(app->grafo, &app->edit_state, lat, lon)) {
                 update_node_ids(&app->edit_state, app->grafo);
                 mark_graph_as_modified(app->grafo);
+                invalidate_routing_data(app);
                 update_status(app, "New node created. Click to create more nodes.");
                 gtk_widget_queue_draw(widget);
                 return TRUE;
@@ -166,6 +199,7 @@ gboolean handle_edit_click(AppData *app, double click_x, double click_y, GtkWidg
                 if (can_delete_node(app->grafo, clicked_point->id)) {
                     if (delete_node(app->grafo, &app->edit_state, clicked_point->id)) {
                         mark_graph_as_modified(app->grafo);
+                        invalidate_routing_data(app);
                         update_status(app, "Node deleted. Click to delete more nodes.");
                         gtk_widget_queue_draw(widget);
                         return TRUE;
@@ -192,6 +226,7 @@ gboolean handle_edit_click(AppData *app, double click_x, double click_y, GtkWidg
                         if (connect_nodes(app->grafo, &app->edit_state, 
                                         app->edit_state.connecting_from_id, clicked_point->id)) {
                             mark_graph_as_modified(app->grafo);
+                            invalidate_routing_data(app);
                             update_status(app, "Nodes connected. Click a node to start new connection.");
                         } else {
                             update_status(app, "Failed to connect nodes. Click a node to start new connection.");
@@ -229,54 +264,88 @@ gboolean on_graph_button_press(GtkWidget *widget, GdkEventButton *event, gpointe
             }
         }
         
-        // Verificar se Ctrl está pressionado para seleção de pontos
-        if (event->state & GDK_CONTROL_MASK) {
+        // Com a partição de Voronoi ativa, Shift marca/desmarca instalações
+        if (app->show_voronoi && (event->state & GDK_SHIFT_MASK) && !(event->state & GDK_CONTROL_MASK)) {
             Ponto *clicked_point = find_closest_point(app, event->x, event->y);
             if (clicked_point) {
+                toggle_facility(app, clicked_point->id);
+                ParticaoVoronoi *particao = get_voronoi(app);
+                gchar *msg = g_strdup_printf("Facilities: %zu (%zu points unreachable from all of them)",
+                                             app->num_facilities, particao ? particao->num_inalcancaveis : 0);
+                update_status(app, msg);
+                g_free(msg);
+                gtk_widget_queue_draw(widget);
+                return TRUE;
+            }
+        }
+        
+        // Verificar se Ctrl está pressionado para seleção de pontos: o clique
+        // é projetado na via mais próxima; perto de um ponto da via (ou fora
+        // das vias), seleciona o ponto
+        if (event->state & GDK_CONTROL_MASK) {
+            ProjecaoAresta snap;
+            long long clicked_id = 0;
+            gboolean mid_edge = FALSE;
+            gboolean found = find_closest_edge(app, event->x, event->y, &snap, &clicked_id, &mid_edge);
+            if (!found) {
+                Ponto *clicked_point = find_closest_point(app, event->x, event->y);
+                found = clicked_point != NULL;
+                if (found) clicked_id = clicked_point->id;
+            }
+            if (found) {
+                // A rota exibida deixa de corresponder às projeções
+                app->snapped_route = FALSE;
+                
                 if (!app->has_start_point) {
                     // Selecionar como ponto inicial
-                    app->selected_start_id = clicked_point->id;
+                    app->selected_start_id = clicked_id;
                     app->has_start_point = TRUE;
+                    app->start_snapped = mid_edge;
+                    app->start_snap = snap;
+                    app->isochrone_valid = FALSE;
                     
                     // Atualizar entry
-                    gchar *id_str = g_strdup_printf("%lld", clicked_point->id);
+                    gchar *id_str = g_strdup_printf("%lld", clicked_id);
                     gtk_entry_set_text(GTK_ENTRY(app->start_entry), id_str);
                     g_free(id_str);
                     
-                    update_status(app, "Start point selected. Hold Ctrl and click another point to select end point.");
+                    update_status(app, mid_edge ? "Start point snapped to the road. Hold Ctrl and click another point to select end point."
+                                                : "Start point selected. Hold Ctrl and click another point to select end point.");
                 } else if (!app->has_end_point) {
                     // Selecionar como ponto final
-                    app->selected_end_id = clicked_point->id;
+                    app->selected_end_id = clicked_id;
                     app->has_end_point = TRUE;
+                    app->end_snapped = mid_edge;
+                    app->end_snap = snap;
                     
                     // Atualizar entry
-                    gchar *id_str = g_strdup_printf("%lld", clicked_point->id);
+                    gchar *id_str = g_strdup_printf("%lld", clicked_id);
                     gtk_entry_set_text(GTK_ENTRY(app->end_entry), id_str);
                     g_free(id_str);
                     
-                    update_status(app, "End point selected. Click 'Find Shortest Path' to calculate route.");
+                    update_status(app, mid_edge ? "End point snapped to the road. Click 'Find Shortest Path' to calculate route."
+                                                : "End point selected. Click 'Find Shortest Path' to calculate route.");
                 } else {
-                    // Reset e selecionar novo ponto inicial
-                    app->selected_start_id = clicked_point->id;
-                    app->selected_end_id = 0;
-                    app->has_start_point = TRUE;
-                    app->has_end_point = FALSE;
-                    
-                    // Limpar caminho mais curto
-                    if (app->shortest_path) {
-                        free(app->shortest_path);
-                        app->shortest_path = NULL;
+                    // Acrescentar parada: o fim atual vira parada intermediária
+                    // (no ponto mais próximo, se estava no meio de uma via)
+                    long *ids = realloc(app->waypoint_ids, (app->num_waypoints + 1) * sizeof(long));
+                    if (ids) {
+                        app->waypoint_ids = ids;
+                        app->waypoint_ids[app->num_waypoints++] = app->selected_end_id;
+                        app->selected_end_id = clicked_id;
+                        app->end_snapped = mid_edge;
+                        app->end_snap = snap;
+                        
+                        // Atualizar entry
+                        gchar *id_str = g_strdup_printf("%lld", clicked_id);
+                        gtk_entry_set_text(GTK_ENTRY(app->end_entry), id_str);
+                        g_free(id_str);
+                        
+                        gchar *msg = g_strdup_printf("Stop appended (%zu via points). Click 'Find Shortest Path' to route through them, or Clear to start over.",
+                                                     app->num_waypoints);
+                        update_status(app, msg);
+                        g_free(msg);
                     }
-                    app->has_shortest_path = FALSE;
-                    app->shortest_path_length = 0;
-                    
-                    // Atualizar entries
-                    gchar *id_str = g_strdup_printf("%lld", clicked_point->id);
-                    gtk_entry_set_text(GTK_ENTRY(app->start_entry), id_str);
-                    gtk_entry_set_text(GTK_ENTRY(app->end_entry), "");
-                    g_free(id_str);
-                    
-                    update_status(app, "New start point selected. Hold Ctrl and click another point to select end point.");
                 }
                 
                 gtk_widget_queue_draw(widget);
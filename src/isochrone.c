@@ -0,0 +1,89 @@
+#include "isochrone.h"
+#include "metrics.h"
+#include <stdlib.h>
+
+RegiaoAlcancavel* criar_regiao_alcancavel(void) {
+    return calloc(1, sizeof(RegiaoAlcancavel));
+}
+
+void liberar_regiao_alcancavel(RegiaoAlcancavel *regiao) {
+    if (regiao) {
+        free(regiao->pontos);
+        free(regiao->custos);
+        free(regiao);
+    }
+}
+
+// Garante espaço para mais um ponto na região (crescimento geométrico)
+static int reservar_regiao(RegiaoAlcancavel *regiao) {
+    if (regiao->num_pontos < regiao->capacidade) return 0;
+    size_t capacidade = regiao->capacidade ? regiao->capacidade * 2 : 256;
+    size_t *pontos = realloc(regiao->pontos, capacidade * sizeof(size_t));
+    if (!pontos) return -1;
+    regiao->pontos = pontos;
+    double *custos = realloc(regiao->custos, capacidade * sizeof(double));
+    if (!custos) return -1;
+    regiao->custos = custos;
+    regiao->capacidade = capacidade;
+    return 0;
+}
+
+int busca_limitada(Grafo *grafo, EspacoBusca *espaco, long origem_id, double limite,
+                   RegiaoAlcancavel *regiao) {
+    if (!grafo || !espaco || !regiao || !(limite >= 0.0)) return -1;
+    if (espaco->num_pontos != grafo->num_pontos) return -1;
+    const IndicesGrafo *indices = obter_indices(grafo);
+    if (!indices) return -1;
+    const double *pesos = NULL;
+    if (espaco->metrica != METRICA_DISTANCIA && !(pesos = obter_pesos_metrica(grafo, espaco->metrica))) return -1;
+
+    ssize_t inicio = buscar_indice_ponto(grafo, origem_id);
+    regiao->num_pontos = 0;
+    regiao->num_tocados = 0;
+    regiao->limite = limite;
+    reiniciar_espaco_busca(espaco);
+    if (inicio < 0) return -1;
+
+    uint32_t epoca = espaco->epoca;
+    size_t origem = (size_t)inicio;
+    espaco->marca[origem] = epoca;
+    espaco->distancias[origem] = 0.0;
+    espaco->predecessores[origem] = (size_t)-1;
+    inserir_fila_prioridade(espaco->fila, (long)origem, 0.0);
+    regiao->num_tocados = 1;
+
+    while (!fila_vazia(espaco->fila)) {
+        NoFilaPrioridade no = extrair_minimo(espaco->fila);
+        size_t atual = (size_t)no.ponto_id;
+        if (espaco->estabelecido[atual] == epoca) continue;
+        espaco->estabelecido[atual] = epoca;
+        if (reservar_regiao(regiao) != 0) return -1;
+        regiao->pontos[regiao->num_pontos] = atual;
+        regiao->custos[regiao->num_pontos] = no.distancia;
+        regiao->num_pontos++;
+
+        for (size_t k = indices->inicio_arcos[atual]; k < indices->inicio_arcos[atual + 1]; k++) {
+            size_t vizinho = indices->arcos[k].destino;
+            if (espaco->estabelecido[vizinho] == epoca) continue;
+            double nova = no.distancia + (pesos ? pesos[k] : indices->arcos[k].peso);
+            if (espaco->marca[vizinho] != epoca) {
+                regiao->num_tocados++;
+            } else if (nova >= espaco->distancias[vizinho]) {
+                continue;
+            }
+            espaco->marca[vizinho] = epoca;
+            espaco->distancias[vizinho] = nova;
+            espaco->predecessores[vizinho] = atual;
+            // Rótulos além do limite nunca serão estabelecidos: não vão para a fila
+            if (nova <= limite) inserir_fila_prioridade(espaco->fila, (long)vizinho, nova);
+        }
+    }
+    return 0;
+}
+
+int faixa_alcance(double custo, double limite, int num_faixas) {
+    if (custo < 0.0 || custo > limite || num_faixas < 1) return -1;
+    if (limite <= 0.0) return 0;
+    int faixa = (int)(custo / limite * num_faixas);
+    return faixa < num_faixas ? faixa : num_faixas - 1;
+}
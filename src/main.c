@@ -23,6 +23,9 @@ int main(int argc, char *argv[]) {
     // Inicializar dados básicos
     app->grafo = NULL;
     app->current_file = NULL;
+    app->nucleo_roteamento = NULL;
+    app->busca_incremental = NULL;
+    app->reorder_on_load = TRUE;
     
     // Inicializar variáveis de zoom e pan
     app->zoom_factor = 1.0;
@@ -35,6 +38,8 @@ int main(int argc, char *argv[]) {
     app->has_end_point = FALSE;
     app->selected_start_id = 0;
     app->selected_end_id = 0;
+    app->waypoint_ids = NULL;
+    app->num_waypoints = 0;
     
     // Inicializar variáveis do caminho mais curto
     app->shortest_path = NULL;
@@ -49,6 +54,22 @@ int main(int argc, char *argv[]) {
     app->edit_state.selected_node_id = 0;
     app->edit_state.next_node_id = 1;
     app->edit_state.next_way_id = 1;
+    app->edit_state.indice_espacial = NULL;
+    app->color_by_component = FALSE;
+    app->show_isochrone = FALSE;
+    app->isochrone_valid = FALSE;
+    app->isochrone_space = NULL;
+    app->isochrone_region = NULL;
+    app->show_voronoi = FALSE;
+    app->facility_ids = NULL;
+    app->num_facilities = 0;
+    app->voronoi = NULL;
+    app->show_alternatives = FALSE;
+    app->alternatives = NULL;
+    app->start_snapped = FALSE;
+    app->end_snapped = FALSE;
+    app->snapped_route = FALSE;
+    app->visible_items = NULL;
     
     // Obter widgets com verificação de erro
     app->window = GTK_WIDGET(gtk_builder_get_object(builder, "main_window"));
@@ -69,6 +90,12 @@ int main(int argc, char *argv[]) {
     app->end_entry = GTK_WIDGET(gtk_builder_get_object(builder, "end_entry"));
     if (!app->end_entry) g_warning("Failed to get end_entry from UI file");
     
+    app->metric_combo = GTK_WIDGET(gtk_builder_get_object(builder, "metric_combo"));
+    if (!app->metric_combo) g_warning("Failed to get metric_combo from UI file");
+    
+    app->isochrone_spin = GTK_WIDGET(gtk_builder_get_object(builder, "isochrone_spin"));
+    if (!app->isochrone_spin) g_warning("Failed to get isochrone_spin from UI file");
+    
     app->results_text = GTK_WIDGET(gtk_builder_get_object(builder, "results_text"));
     if (!app->results_text) g_warning("Failed to get results_text from UI file");
     
@@ -97,6 +124,15 @@ int main(int argc, char *argv[]) {
     widget = gtk_builder_get_object(builder, "open_osm_item");
     if (widget) g_signal_connect(widget, "activate", G_CALLBACK(on_open_osm_clicked), app);
     
+    widget = gtk_builder_get_object(builder, "match_traces_item");
+    if (widget) g_signal_connect(widget, "activate", G_CALLBACK(on_match_traces_clicked), app);
+    
+    widget = gtk_builder_get_object(builder, "reorder_on_load_item");
+    if (widget) {
+        app->reorder_on_load = gtk_check_menu_item_get_active(GTK_CHECK_MENU_ITEM(widget));
+        g_signal_connect(widget, "toggled", G_CALLBACK(on_reorder_on_load_toggled), app);
+    }
+    
     widget = gtk_builder_get_object(builder, "quit_item");
     if (widget) g_signal_connect(widget, "activate", G_CALLBACK(on_quit_clicked), app);
     
@@ -112,6 +148,9 @@ int main(int argc, char *argv[]) {
     widget = gtk_builder_get_object(builder, "find_path_button");
     if (widget) g_signal_connect(widget, "clicked", G_CALLBACK(on_find_path_clicked), app);
     
+    widget = gtk_builder_get_object(builder, "optimize_tour_button");
+    if (widget) g_signal_connect(widget, "clicked", G_CALLBACK(on_optimize_tour_clicked), app);
+    
     widget = gtk_builder_get_object(builder, "edit_create_button");
     if (widget) g_signal_connect(widget, "clicked", G_CALLBACK(on_edit_create_clicked), app);
     
@@ -124,6 +163,25 @@ int main(int argc, char *argv[]) {
     widget = gtk_builder_get_object(builder, "edit_normal_button");
     if (widget) g_signal_connect(widget, "clicked", G_CALLBACK(on_edit_normal_clicked), app);
     
+    widget = gtk_builder_get_object(builder, "components_toggle");
+    if (widget) g_signal_connect(widget, "toggled", G_CALLBACK(on_components_toggled), app);
+    
+    widget = gtk_builder_get_object(builder, "isochrone_toggle");
+    if (widget) g_signal_connect(widget, "toggled", G_CALLBACK(on_isochrone_toggled), app);
+    
+    widget = gtk_builder_get_object(builder, "voronoi_toggle");
+    if (widget) g_signal_connect(widget, "toggled", G_CALLBACK(on_voronoi_toggled), app);
+    
+    widget = gtk_builder_get_object(builder, "alternatives_toggle");
+    if (widget) g_signal_connect(widget, "toggled", G_CALLBACK(on_alternatives_toggled), app);
+    
+    if (app->isochrone_spin) {
+        g_signal_connect(app->isochrone_spin, "value-changed", G_CALLBACK(on_isochrone_settings_changed), app);
+    }
+    if (app->metric_combo) {
+        g_signal_connect(app->metric_combo, "changed", G_CALLBACK(on_isochrone_settings_changed), app);
+    }
+    
     if (app->graph_area) {
         g_signal_connect(app->graph_area, "draw", G_CALLBACK(on_graph_draw), app);
         g_signal_connect(app->graph_area, "button-press-event", G_CALLBACK(on_graph_button_press), app);
@@ -153,6 +211,14 @@ int main(int argc, char *argv[]) {
     if (app->shortest_path) {
         free(app->shortest_path);
     }
+    invalidate_routing_data(app);
+    liberar_espaco_busca(app->isochrone_space);
+    liberar_regiao_alcancavel(app->isochrone_region);
+    free(app->facility_ids);
+    free(app->waypoint_ids);
+    liberar_alternativas(app->alternatives);
+    discard_spatial_index(app);
+    liberar_lista_indices(app->visible_items);
     if (app->grafo) {
         liberar_grafo(app->grafo);
     }
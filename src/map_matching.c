@@ -0,0 +1,692 @@
+#include "map_matching.h"
+#include "distance_matrix.h"
+#include "isochrone.h"
+#include "snapping.h"
+#include "timing.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <locale.h>
+#include <unistd.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define NENHUM ((size_t)-1)
+#define LINHA_MAX 1024
+
+// Metros por grau de latitude (esfera de raio 6371 km, como em ler_osm)
+#define METROS_POR_GRAU (6371000.0 * M_PI / 180.0)
+
+// ---------------------------------------------------------------------------
+// Leitura de GPX
+// ---------------------------------------------------------------------------
+
+void liberar_conjunto_trajetos(ConjuntoTrajetos *conjunto) {
+    if (conjunto) {
+        for (size_t i = 0; i < conjunto->num_trajetos; i++) free(conjunto->trajetos[i].pontos);
+        free(conjunto->trajetos);
+        free(conjunto);
+    }
+}
+
+// Valor numérico do atributo nome="..." a partir de inicio (0 se ausente)
+static int valor_atributo(const char *inicio, const char *nome, double *valor) {
+    char padrao[16];
+    snprintf(padrao, sizeof(padrao), " %s=", nome);
+    const char *p = strstr(inicio, padrao);
+    const char *fim = strchr(inicio, '>');
+    if (!p || (fim && p > fim)) return 0;
+    p += strlen(padrao);
+    if (*p != '"' && *p != '\'') return 0;
+    char *depois;
+    *valor = strtod(p + 1, &depois);
+    return depois != p + 1;
+}
+
+static int novo_trajeto(ConjuntoTrajetos *conjunto, size_t *capacidade) {
+    if (conjunto->num_trajetos == *capacidade) {
+        size_t nova = *capacidade ? *capacidade * 2 : 16;
+        TrajetoGPS *trajetos = realloc(conjunto->trajetos, nova * sizeof(TrajetoGPS));
+        if (!trajetos) return -1;
+        conjunto->trajetos = trajetos;
+        *capacidade = nova;
+    }
+    conjunto->trajetos[conjunto->num_trajetos].pontos = NULL;
+    conjunto->trajetos[conjunto->num_trajetos].num_pontos = 0;
+    conjunto->num_trajetos++;
+    return 0;
+}
+
+ConjuntoTrajetos* ler_trajetos_gpx(const char *caminho_arquivo_gpx) {
+    // Set C locale to ensure decimal point parsing
+    setlocale(LC_NUMERIC, "C");
+
+    FILE *f = fopen(caminho_arquivo_gpx, "r");
+    if (!f) return NULL;
+    ConjuntoTrajetos *conjunto = calloc(1, sizeof(ConjuntoTrajetos));
+    if (!conjunto) {
+        fclose(f);
+        return NULL;
+    }
+
+    size_t capacidade_trajetos = 0, capacidade_pontos = 0;
+    int erro = 0;
+    char linha[LINHA_MAX];
+    while (!erro && fgets(linha, LINHA_MAX, f)) {
+        // Uma linha pode ter várias tags (GPX sem quebras de linha)
+        for (const char *p = strchr(linha, '<'); p && !erro; p = strchr(p + 1, '<')) {
+            if (strncmp(p, "<trk>", 5) == 0 || strncmp(p, "<trk ", 5) == 0) {
+                erro = novo_trajeto(conjunto, &capacidade_trajetos);
+                capacidade_pontos = 0;
+            } else if (strncmp(p, "<trkpt", 6) == 0) {
+                double lat, lon;
+                if (!valor_atributo(p, "lat", &lat) || !valor_atributo(p, "lon", &lon)) continue;
+                // Pontos antes de qualquer <trk> formam um trajeto próprio
+                if (conjunto->num_trajetos == 0 && (erro = novo_trajeto(conjunto, &capacidade_trajetos))) break;
+                TrajetoGPS *t = &conjunto->trajetos[conjunto->num_trajetos - 1];
+                if (t->num_pontos == capacidade_pontos) {
+                    size_t nova = capacidade_pontos ? capacidade_pontos * 2 : 64;
+                    PontoGPS *pontos = realloc(t->pontos, nova * sizeof(PontoGPS));
+                    if (!pontos) {
+                        erro = 1;
+                        break;
+                    }
+                    t->pontos = pontos;
+                    capacidade_pontos = nova;
+                }
+                t->pontos[t->num_pontos].lat = lat;
+                t->pontos[t->num_pontos].lon = lon;
+                t->num_pontos++;
+            }
+        }
+    }
+    fclose(f);
+    if (erro) {
+        liberar_conjunto_trajetos(conjunto);
+        return NULL;
+    }
+    return conjunto;
+}
+
+// ---------------------------------------------------------------------------
+// Combinador
+// ---------------------------------------------------------------------------
+
+struct CombinadorMapa {
+    Grafo *grafo;
+    ParametrosCombinacao parametros;
+    IndiceEspacial *indice;  // Células do tamanho do raio de busca
+    double lat0, lon0, cos_lat0;  // Centro do grafo, para as distâncias em linha reta
+};
+
+ParametrosCombinacao parametros_combinacao_padrao(void) {
+    ParametrosCombinacao p = {
+        .sigma_gps_m = 10.0, .beta_m = 5.0, .raio_busca_m = 50.0,
+        .max_candidatos = 8, .fator_rota = 2.0, .tamanho_cache = 32
+    };
+    return p;
+}
+
+// Projeção equirretangular em metros em torno do centro do grafo
+static inline void projetar(const CombinadorMapa *c, double lat, double lon, double *x, double *y) {
+    *x = (lon - c->lon0) * METROS_POR_GRAU * c->cos_lat0;
+    *y = (lat - c->lat0) * METROS_POR_GRAU;
+}
+
+// Pontas das arestas candidatas (todas vêm do índice)
+static inline size_t origem_de(const CombinadorMapa *c, size_t aresta) {
+    size_t o = NENHUM, d = NENHUM;
+    pontas_segmento(c->indice, aresta, &o, &d);
+    return o;
+}
+
+static inline size_t destino_de(const CombinadorMapa *c, size_t aresta) {
+    size_t o = NENHUM, d = NENHUM;
+    pontas_segmento(c->indice, aresta, &o, &d);
+    return d;
+}
+
+void liberar_combinador_mapa(CombinadorMapa *combinador) {
+    if (combinador) {
+        liberar_indice_espacial(combinador->indice);
+        free(combinador);
+    }
+}
+
+CombinadorMapa* criar_combinador_mapa(Grafo *grafo, const ParametrosCombinacao *parametros) {
+    ParametrosCombinacao p = parametros ? *parametros : parametros_combinacao_padrao();
+    if (!grafo || !(p.sigma_gps_m > 0.0) || !(p.beta_m > 0.0) || !(p.raio_busca_m > 0.0) ||
+        p.max_candidatos == 0 || !(p.fator_rota >= 1.0)) {
+        return NULL;
+    }
+    // As buscas limitadas rodam em threads que só leem os índices
+    if (!obter_indices(grafo)) return NULL;
+
+    CombinadorMapa *c = calloc(1, sizeof(CombinadorMapa));
+    if (!c) return NULL;
+    c->grafo = grafo;
+    c->parametros = p;
+    // Células com o lado do raio de busca em latitude: a caixa de uma consulta
+    // cobre poucas células
+    c->indice = criar_indice_espacial(grafo, p.raio_busca_m / METROS_POR_GRAU);
+    if (!c->indice) {
+        liberar_combinador_mapa(c);
+        return NULL;
+    }
+    double min_lat = 0.0, max_lat = 0.0, min_lon = 0.0, max_lon = 0.0;
+    limites_indice(c->indice, &min_lat, &max_lat, &min_lon, &max_lon);
+    c->lat0 = (min_lat + max_lat) / 2.0;
+    c->lon0 = (min_lon + max_lon) / 2.0;
+    c->cos_lat0 = cos(c->lat0 * M_PI / 180.0);
+    return c;
+}
+
+// ---------------------------------------------------------------------------
+// Casamento (Viterbi)
+// ---------------------------------------------------------------------------
+
+// Projeção de uma leitura numa via candidata
+typedef ProjecaoAresta Candidato;
+
+// Busca limitada guardada: custos da região ordenados por ponto
+typedef struct {
+    size_t ponto;
+    double custo;
+} CustoPonto;
+
+typedef struct {
+    size_t origem;        // NENHUM: entrada livre
+    double limite;
+    CustoPonto *custos;
+    size_t num_custos;
+    size_t capacidade;
+    uint64_t uso;         // Para descartar a menos usada recentemente
+} EntradaCache;
+
+// Estado de um trabalhador, reaproveitado entre trajetos
+typedef struct {
+    const CombinadorMapa *combinador;
+    EspacoBusca *espaco;
+    RegiaoAlcancavel *regiao;
+    EntradaCache *cache;
+    uint64_t relogio;
+    size_t ultima_origem;   // Busca ainda válida no espaço (sem cache)
+    double ultimo_limite;
+    size_t buscas;
+    size_t acertos;
+} Trabalhador;
+
+static void liberar_trabalhador(Trabalhador *w) {
+    if (!w) return;
+    liberar_espaco_busca(w->espaco);
+    liberar_regiao_alcancavel(w->regiao);
+    for (size_t i = 0; w->cache && i < w->combinador->parametros.tamanho_cache; i++) free(w->cache[i].custos);
+    free(w->cache);
+    free(w);
+}
+
+static Trabalhador* criar_trabalhador(const CombinadorMapa *c) {
+    Trabalhador *w = calloc(1, sizeof(Trabalhador));
+    if (!w) return NULL;
+    w->combinador = c;
+    w->espaco = criar_espaco_busca(c->grafo->num_pontos);
+    w->regiao = criar_regiao_alcancavel();
+    size_t n = c->parametros.tamanho_cache;
+    w->cache = n ? calloc(n, sizeof(EntradaCache)) : NULL;
+    w->ultima_origem = NENHUM;
+    if (!w->espaco || !w->regiao || (n && !w->cache)) {
+        liberar_trabalhador(w);
+        return NULL;
+    }
+    for (size_t i = 0; i < n; i++) w->cache[i].origem = NENHUM;
+    return w;
+}
+
+static int comparar_custo_ponto(const void *a, const void *b) {
+    size_t x = ((const CustoPonto *)a)->ponto, y = ((const CustoPonto *)b)->ponto;
+    return (x > y) - (x < y);
+}
+
+// Distância pela rede (km) do ponto x ao ponto y, ou DBL_MAX se passar do limite
+static double distancia_rede(Trabalhador *w, size_t x, size_t y, double limite) {
+    if (x == y) return 0.0;
+    Grafo *grafo = w->combinador->grafo;
+    size_t n = w->combinador->parametros.tamanho_cache;
+
+    if (n == 0) {
+        // Sem cache, só a última busca continua válida no espaço
+        if (w->ultima_origem != x || w->ultimo_limite < limite) {
+            if (busca_limitada(grafo, w->espaco, grafo->pontos[x].id, limite, w->regiao) != 0) return DBL_MAX;
+            w->buscas++;
+            w->ultima_origem = x;
+            w->ultimo_limite = limite;
+        } else {
+            w->acertos++;
+        }
+        double custo = custo_alcancado(w->espaco, y);
+        return custo >= 0.0 && custo <= limite ? custo : DBL_MAX;
+    }
+
+    EntradaCache *entrada = NULL;
+    EntradaCache *livre = &w->cache[0];
+    for (size_t i = 0; i < n; i++) {
+        if (w->cache[i].origem == x) {
+            entrada = &w->cache[i];
+            break;
+        }
+        if (w->cache[i].origem == NENHUM || w->cache[i].uso < livre->uso) livre = &w->cache[i];
+    }
+    if (entrada && entrada->limite >= limite) {
+        w->acertos++;
+    } else {
+        // Refaz a busca com o limite novo, no lugar da entrada da mesma origem
+        // ou da menos usada recentemente
+        if (!entrada) entrada = livre;
+        entrada->origem = NENHUM;
+        if (busca_limitada(grafo, w->espaco, grafo->pontos[x].id, limite, w->regiao) != 0) return DBL_MAX;
+        w->buscas++;
+        RegiaoAlcancavel *r = w->regiao;
+        if (r->num_pontos > entrada->capacidade) {
+            CustoPonto *custos = realloc(entrada->custos, r->num_pontos * sizeof(CustoPonto));
+            if (!custos) return DBL_MAX;
+            entrada->custos = custos;
+            entrada->capacidade = r->num_pontos;
+        }
+        for (size_t i = 0; i < r->num_pontos; i++) {
+            entrada->custos[i].ponto = r->pontos[i];
+            entrada->custos[i].custo = r->custos[i];
+        }
+        entrada->num_custos = r->num_pontos;
+        qsort(entrada->custos, entrada->num_custos, sizeof(CustoPonto), comparar_custo_ponto);
+        entrada->origem = x;
+        entrada->limite = limite;
+    }
+    entrada->uso = ++w->relogio;
+    CustoPonto chave = {y, 0.0};
+    const CustoPonto *achado = bsearch(&chave, entrada->custos, entrada->num_custos, sizeof(CustoPonto),
+                                       comparar_custo_ponto);
+    return achado && achado->custo <= limite ? achado->custo : DBL_MAX;
+}
+
+// Como a transição para um estado foi feita: na mesma aresta (saida = NENHUM)
+// ou saindo da aresta anterior por saida e entrando na nova por entrada
+typedef struct {
+    size_t anterior;    // Estado (posição em candidatos) da leitura casada anterior
+    size_t saida;
+    size_t entrada;
+    double custo_rede;  // km de saida a entrada
+} Transicao;
+
+// Menor distância pela rede (m) entre duas projeções, respeitando o sentido
+// das vias; DBL_MAX se não houver rota dentro do limite
+static double distancia_transicao(Trabalhador *w, const Candidato *a, const Candidato *b, double limite,
+                                  Transicao *t) {
+    const CombinadorMapa *c = w->combinador;
+    const Aresta *ea = &c->grafo->arestas[a->aresta];
+    const Aresta *eb = &c->grafo->arestas[b->aresta];
+    double melhor = DBL_MAX;
+
+    if (a->aresta == b->aresta && (b->fracao >= a->fracao || ea->is_bidirectional)) {
+        melhor = fabs(b->fracao - a->fracao) * ea->peso;
+        t->saida = t->entrada = NENHUM;
+        t->custo_rede = 0.0;
+    }
+
+    // Saídas de a: pelo destino, ou pela origem em vias de mão dupla;
+    // entradas em b: pela origem, ou pelo destino em vias de mão dupla
+    size_t saidas[2] = {destino_de(c, a->aresta), origem_de(c, a->aresta)};
+    double custos_saida[2] = {(1.0 - a->fracao) * ea->peso, a->fracao * ea->peso};
+    size_t entradas[2] = {origem_de(c, b->aresta), destino_de(c, b->aresta)};
+    double custos_entrada[2] = {b->fracao * eb->peso, (1.0 - b->fracao) * eb->peso};
+    int num_saidas = ea->is_bidirectional ? 2 : 1;
+    int num_entradas = eb->is_bidirectional ? 2 : 1;
+    for (int s = 0; s < num_saidas; s++) {
+        for (int e = 0; e < num_entradas; e++) {
+            double pontas = custos_saida[s] + custos_entrada[e];
+            if (pontas >= melhor) continue;
+            double rede = distancia_rede(w, saidas[s], entradas[e], limite);
+            if (rede == DBL_MAX || pontas + rede >= melhor) continue;
+            melhor = pontas + rede;
+            t->saida = saidas[s];
+            t->entrada = entradas[e];
+            t->custo_rede = rede;
+        }
+    }
+    return melhor == DBL_MAX ? DBL_MAX : melhor * 1000.0;
+}
+
+// Acrescenta um ponto ao caminho, sem repetir o último
+static int acrescentar_ponto(ResultadoCombinacao *r, size_t *capacidade, long id) {
+    if (r->tamanho_caminho > 0 && r->caminho[r->tamanho_caminho - 1] == id) return 0;
+    if (r->tamanho_caminho == *capacidade) {
+        size_t nova = *capacidade ? *capacidade * 2 : 64;
+        long *caminho = realloc(r->caminho, nova * sizeof(long));
+        if (!caminho) return -1;
+        r->caminho = caminho;
+        *capacidade = nova;
+    }
+    r->caminho[r->tamanho_caminho++] = id;
+    return 0;
+}
+
+// Refaz a busca de saida até entrada (limitada ao custo já conhecido) e
+// acrescenta os pontos do caminho
+static int acrescentar_rota(Trabalhador *w, ResultadoCombinacao *r, size_t *capacidade, const Transicao *t) {
+    Grafo *grafo = w->combinador->grafo;
+    if (t->saida == t->entrada) return acrescentar_ponto(r, capacidade, grafo->pontos[t->saida].id);
+    double limite = t->custo_rede * (1.0 + 1e-9) + 1e-12;
+    if (busca_limitada(grafo, w->espaco, grafo->pontos[t->saida].id, limite, w->regiao) != 0) return -1;
+    w->buscas++;
+    w->ultima_origem = NENHUM;  // O espaço não guarda mais a última busca do Viterbi
+    if (custo_alcancado(w->espaco, t->entrada) < 0.0) return -1;
+
+    size_t inicio = r->tamanho_caminho;
+    for (size_t v = t->entrada; v != NENHUM; v = w->espaco->predecessores[v]) {
+        if (r->tamanho_caminho == *capacidade) {
+            size_t nova = *capacidade ? *capacidade * 2 : 64;
+            long *caminho = realloc(r->caminho, nova * sizeof(long));
+            if (!caminho) return -1;
+            r->caminho = caminho;
+            *capacidade = nova;
+        }
+        r->caminho[r->tamanho_caminho++] = grafo->pontos[v].id;
+    }
+    // Inverter para ficar de saida a entrada e não repetir a junção
+    for (size_t i = inicio, j = r->tamanho_caminho - 1; i < j; i++, j--) {
+        long tmp = r->caminho[i];
+        r->caminho[i] = r->caminho[j];
+        r->caminho[j] = tmp;
+    }
+    if (inicio > 0 && r->caminho[inicio - 1] == r->caminho[inicio]) {
+        memmove(r->caminho + inicio, r->caminho + inicio + 1, (r->tamanho_caminho - inicio - 1) * sizeof(long));
+        r->tamanho_caminho--;
+    }
+    return 0;
+}
+
+static int novo_trecho(ResultadoCombinacao *r, size_t *capacidade) {
+    if (r->num_trechos == *capacidade) {
+        size_t nova = *capacidade ? *capacidade * 2 : 4;
+        size_t *inicios = realloc(r->inicio_trechos, nova * sizeof(size_t));
+        if (!inicios) return -1;
+        r->inicio_trechos = inicios;
+        *capacidade = nova;
+    }
+    r->inicio_trechos[r->num_trechos++] = r->tamanho_caminho;
+    return 0;
+}
+
+// Monta o caminho de um trecho a partir dos estados escolhidos (estados[i]
+// para as leituras casadas indicadas em leituras[0 .. num - 1])
+static int montar_trecho(Trabalhador *w, ResultadoCombinacao *r, size_t *capacidade, size_t *capacidade_trechos,
+                         const Candidato *candidatos, const Transicao *transicoes, size_t max_candidatos,
+                         const size_t *leituras, const size_t *estados, size_t num) {
+    const CombinadorMapa *c = w->combinador;
+    const Grafo *grafo = c->grafo;
+    if (novo_trecho(r, capacidade_trechos) != 0) return -1;
+
+    // entrada: ponto pelo qual se entrou na aresta atual (NENHUM enquanto o
+    // trecho não saiu da primeira aresta)
+    size_t entrada = NENHUM;
+    for (size_t i = 1; i < num; i++) {
+        const Transicao *t = &transicoes[leituras[i] * max_candidatos + estados[i]];
+        if (t->saida == NENHUM) continue;
+        size_t aresta = candidatos[leituras[i - 1] * max_candidatos + estados[i - 1]].aresta;
+        if (entrada == NENHUM) {
+            // A primeira aresta entra inteira, vinda da ponta oposta à saída
+            size_t outra = origem_de(c, aresta) == t->saida ? destino_de(c, aresta) : origem_de(c, aresta);
+            if (acrescentar_ponto(r, capacidade, grafo->pontos[outra].id) != 0) return -1;
+        }
+        if (acrescentar_ponto(r, capacidade, grafo->pontos[t->saida].id) != 0) return -1;
+        if (acrescentar_rota(w, r, capacidade, t) != 0) return -1;
+        entrada = t->entrada;
+    }
+
+    const Candidato *ultimo = &candidatos[leituras[num - 1] * max_candidatos + estados[num - 1]];
+    size_t o = origem_de(c, ultimo->aresta), d = destino_de(c, ultimo->aresta);
+    if (entrada == NENHUM) {
+        // O trecho inteiro ficou numa aresta: sentido pelo avanço da projeção
+        const Candidato *primeiro = &candidatos[leituras[0] * max_candidatos + estados[0]];
+        int para_tras = grafo->arestas[ultimo->aresta].is_bidirectional && ultimo->fracao < primeiro->fracao;
+        if (acrescentar_ponto(r, capacidade, grafo->pontos[para_tras ? d : o].id) != 0 ||
+            acrescentar_ponto(r, capacidade, grafo->pontos[para_tras ? o : d].id) != 0) {
+            return -1;
+        }
+    } else {
+        // A última aresta entra inteira até a ponta oposta à entrada
+        if (acrescentar_ponto(r, capacidade, grafo->pontos[entrada == o ? d : o].id) != 0) return -1;
+    }
+    return 0;
+}
+
+void liberar_resultado_combinacao(ResultadoCombinacao *resultado) {
+    if (resultado) {
+        free(resultado->pontos);
+        free(resultado->caminho);
+        free(resultado->inicio_trechos);
+        free(resultado);
+    }
+}
+
+void liberar_resultados_combinacao(ResultadoCombinacao **resultados, size_t quantidade) {
+    if (resultados) {
+        for (size_t i = 0; i < quantidade; i++) liberar_resultado_combinacao(resultados[i]);
+        free(resultados);
+    }
+}
+
+static ResultadoCombinacao* combinar_com_trabalhador(Trabalhador *w, const TrajetoGPS *trajeto) {
+    const CombinadorMapa *c = w->combinador;
+    const ParametrosCombinacao *p = &c->parametros;
+    size_t n = trajeto->num_pontos;
+    size_t k = p->max_candidatos;
+    double inicio = agora_ms();
+    size_t buscas_antes = w->buscas, acertos_antes = w->acertos;
+
+    ResultadoCombinacao *r = calloc(1, sizeof(ResultadoCombinacao));
+    size_t linhas = n ? n : 1;
+    Candidato *candidatos = malloc(linhas * k * sizeof(Candidato));
+    Transicao *transicoes = malloc(linhas * k * sizeof(Transicao));
+    double *pontuacao = malloc(linhas * k * sizeof(double));
+    int *num_candidatos = calloc(linhas, sizeof(int));
+    size_t *leituras = malloc(linhas * sizeof(size_t));
+    size_t *estados = malloc(linhas * sizeof(size_t));
+    if (r) r->pontos = malloc(linhas * sizeof(PontoCasado));
+    if (!r || !r->pontos || !candidatos || !transicoes || !pontuacao || !num_candidatos || !leituras || !estados) {
+        goto erro;
+    }
+    r->num_pontos = n;
+    size_t capacidade = 0, capacidade_trechos = 0;
+
+    // Leituras casadas do trecho atual (índices no trajeto)
+    size_t num_trecho = 0;
+    double x_anterior = 0.0, y_anterior = 0.0;
+    for (size_t i = 0; i <= n; i++) {
+        int fechar = i == n;
+        double x = 0.0, y = 0.0;
+        if (i < n) {
+            r->pontos[i].aresta = NENHUM;
+            projetar(c, trajeto->pontos[i].lat, trajeto->pontos[i].lon, &x, &y);
+            num_candidatos[i] = (int)arestas_proximas(c->indice, trajeto->pontos[i].lat, trajeto->pontos[i].lon,
+                                                      p->raio_busca_m, candidatos + i * k, k);
+            if (num_candidatos[i] == 0) {
+                r->num_nao_casados++;
+                continue;
+            }
+
+            // Log-verossimilhanças: emissão gaussiana na distância até a via,
+            // transição exponencial na diferença entre rede e linha reta
+            int alcancado = num_trecho == 0;
+            if (num_trecho > 0) {
+                size_t ant = leituras[num_trecho - 1];
+                double reta = hypot(x - x_anterior, y - y_anterior);
+                double limite = (p->fator_rota * reta + 2.0 * p->raio_busca_m) / 1000.0;
+                for (int b = 0; b < num_candidatos[i]; b++) {
+                    double melhor = -DBL_MAX;
+                    for (int a = 0; a < num_candidatos[ant]; a++) {
+                        if (pontuacao[ant * k + a] == -DBL_MAX) continue;
+                        Transicao t;
+                        double rota = distancia_transicao(w, &candidatos[ant * k + a], &candidatos[i * k + b],
+                                                          limite, &t);
+                        if (rota == DBL_MAX) continue;
+                        double s = pontuacao[ant * k + a] - fabs(rota - reta) / p->beta_m;
+                        if (s > melhor) {
+                            melhor = s;
+                            t.anterior = (size_t)a;
+                            transicoes[i * k + b] = t;
+                        }
+                    }
+                    pontuacao[i * k + b] = melhor;
+                    if (melhor != -DBL_MAX) alcancado = 1;
+                }
+            }
+            if (!alcancado) {
+                // Sem rota possível: fecha o trecho e recomeça nesta leitura
+                fechar = 1;
+            } else {
+                for (int b = 0; b < num_candidatos[i]; b++) {
+                    double d = candidatos[i * k + b].distancia_m / p->sigma_gps_m;
+                    if (num_trecho == 0) pontuacao[i * k + b] = 0.0;
+                    if (pontuacao[i * k + b] != -DBL_MAX) pontuacao[i * k + b] -= 0.5 * d * d;
+                }
+                leituras[num_trecho++] = i;
+                x_anterior = x;
+                y_anterior = y;
+            }
+        }
+
+        if (fechar && num_trecho > 0) {
+            // Melhor estado final e volta pelas transições
+            size_t ultima = leituras[num_trecho - 1];
+            size_t melhor = 0;
+            for (int b = 1; b < num_candidatos[ultima]; b++) {
+                if (pontuacao[ultima * k + b] > pontuacao[ultima * k + melhor]) melhor = (size_t)b;
+            }
+            for (size_t j = num_trecho; j-- > 0;) {
+                estados[j] = melhor;
+                const Candidato *cand = &candidatos[leituras[j] * k + melhor];
+                PontoCasado *pc = &r->pontos[leituras[j]];
+                pc->aresta = cand->aresta;
+                pc->fracao = cand->fracao;
+                pc->distancia_m = cand->distancia_m;
+                pc->lat = cand->lat;
+                pc->lon = cand->lon;
+                if (j > 0) melhor = transicoes[leituras[j] * k + melhor].anterior;
+            }
+            if (montar_trecho(w, r, &capacidade, &capacidade_trechos, candidatos, transicoes, k,
+                              leituras, estados, num_trecho) != 0) {
+                goto erro;
+            }
+            num_trecho = 0;
+
+            // A leitura que quebrou o modelo abre o trecho seguinte
+            if (i < n) {
+                for (int b = 0; b < num_candidatos[i]; b++) {
+                    double d = candidatos[i * k + b].distancia_m / p->sigma_gps_m;
+                    pontuacao[i * k + b] = -0.5 * d * d;
+                }
+                leituras[num_trecho++] = i;
+                x_anterior = x;
+                y_anterior = y;
+            }
+        }
+    }
+
+    r->buscas = w->buscas - buscas_antes;
+    r->acertos_cache = w->acertos - acertos_antes;
+    r->tempo_ms = agora_ms() - inicio;
+    free(candidatos);
+    free(transicoes);
+    free(pontuacao);
+    free(num_candidatos);
+    free(leituras);
+    free(estados);
+    return r;
+
+erro:
+    liberar_resultado_combinacao(r);
+    free(candidatos);
+    free(transicoes);
+    free(pontuacao);
+    free(num_candidatos);
+    free(leituras);
+    free(estados);
+    return NULL;
+}
+
+ResultadoCombinacao* combinar_trajeto(CombinadorMapa *combinador, const TrajetoGPS *trajeto) {
+    if (!combinador || !trajeto || (trajeto->num_pontos && !trajeto->pontos)) return NULL;
+    Trabalhador *w = criar_trabalhador(combinador);
+    if (!w) return NULL;
+    ResultadoCombinacao *r = combinar_com_trabalhador(w, trajeto);
+    liberar_trabalhador(w);
+    return r;
+}
+
+// Estado compartilhado pelas threads: cada uma pega o próximo trajeto livre
+typedef struct {
+    const CombinadorMapa *combinador;
+    const ConjuntoTrajetos *conjunto;
+    ResultadoCombinacao **resultados;
+    atomic_size_t proximo;
+    atomic_int erro;
+} TrabalhoCombinacao;
+
+static void* trabalhar_combinacao(void *arg) {
+    TrabalhoCombinacao *t = arg;
+    Trabalhador *w = criar_trabalhador(t->combinador);
+    if (!w) {
+        atomic_store(&t->erro, 1);
+        return NULL;
+    }
+    for (;;) {
+        size_t i = atomic_fetch_add(&t->proximo, 1);
+        if (i >= t->conjunto->num_trajetos || atomic_load(&t->erro)) break;
+        t->resultados[i] = combinar_com_trabalhador(w, &t->conjunto->trajetos[i]);
+        if (!t->resultados[i]) atomic_store(&t->erro, 1);
+    }
+    liberar_trabalhador(w);
+    return NULL;
+}
+
+ResultadoCombinacao** combinar_trajetos(CombinadorMapa *combinador, const ConjuntoTrajetos *conjunto,
+                                        int num_threads) {
+    if (!combinador || !conjunto || (conjunto->num_trajetos && !conjunto->trajetos)) return NULL;
+    size_t n = conjunto->num_trajetos;
+    ResultadoCombinacao **resultados = calloc(n ? n : 1, sizeof(ResultadoCombinacao *));
+    if (!resultados) return NULL;
+
+    if (num_threads <= 0) {
+        long processadores = sysconf(_SC_NPROCESSORS_ONLN);
+        num_threads = processadores > 0 ? (int)processadores : 1;
+    }
+    if ((size_t)num_threads > n) num_threads = n ? (int)n : 1;
+
+    TrabalhoCombinacao trabalho = {.combinador = combinador, .conjunto = conjunto, .resultados = resultados};
+    atomic_init(&trabalho.proximo, 0);
+    atomic_init(&trabalho.erro, 0);
+
+    // A thread principal também trabalha; se alguma não puder ser criada,
+    // os trajetos dela ficam para as demais
+    pthread_t *threads = calloc((size_t)num_threads, sizeof(pthread_t));
+    int threads_criadas = 1;
+    for (int t = 1; threads && t < num_threads; t++) {
+        if (pthread_create(&threads[t], NULL, trabalhar_combinacao, &trabalho) != 0) break;
+        threads_criadas++;
+    }
+    trabalhar_combinacao(&trabalho);
+    for (int t = 1; t < threads_criadas; t++) pthread_join(threads[t], NULL);
+    free(threads);
+
+    if (atomic_load(&trabalho.erro)) {
+        liberar_resultados_combinacao(resultados, n);
+        return NULL;
+    }
+    return resultados;
+}
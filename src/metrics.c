@@ -0,0 +1,134 @@
+#include "../include/metrics.h"
+#include "../include/arena.h"
+#include <float.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Valores da tag highway por classe (as variantes _link caem na classe base)
+static const struct {
+    const char* valor;
+    ClasseVia classe;
+} CLASSES_TAG[] = {
+    {"motorway", VIA_MOTORWAY},       {"trunk", VIA_TRUNK},
+    {"primary", VIA_PRIMARY},         {"secondary", VIA_SECONDARY},
+    {"tertiary", VIA_TERTIARY},       {"unclassified", VIA_UNCLASSIFIED},
+    {"residential", VIA_RESIDENTIAL}, {"living_street", VIA_LIVING_STREET},
+    {"service", VIA_SERVICE},         {"track", VIA_TRACK},
+    {"footway", VIA_PEDESTRE},        {"path", VIA_PEDESTRE},
+    {"pedestrian", VIA_PEDESTRE},     {"cycleway", VIA_PEDESTRE},
+    {"steps", VIA_PEDESTRE},          {"bridleway", VIA_PEDESTRE},
+};
+
+// km/h por classe, indexado por ClasseVia
+static const double VELOCIDADES_PADRAO[NUM_CLASSES_VIA] = {
+    [VIA_DESCONHECIDA] = 40.0, [VIA_MOTORWAY] = 110.0,  [VIA_TRUNK] = 90.0,
+    [VIA_PRIMARY] = 70.0,      [VIA_SECONDARY] = 60.0,  [VIA_TERTIARY] = 50.0,
+    [VIA_UNCLASSIFIED] = 40.0, [VIA_RESIDENTIAL] = 30.0, [VIA_LIVING_STREET] = 10.0,
+    [VIA_SERVICE] = 20.0,      [VIA_TRACK] = 15.0,      [VIA_PEDESTRE] = 5.0,
+};
+
+#define KMH_POR_MPH 1.609344
+
+ClasseVia classe_via_da_tag(const char* valor) {
+    if (!valor) return VIA_DESCONHECIDA;
+    for (size_t i = 0; i < sizeof(CLASSES_TAG) / sizeof(CLASSES_TAG[0]); ++i) {
+        size_t n = strlen(CLASSES_TAG[i].valor);
+        if (strncmp(valor, CLASSES_TAG[i].valor, n) == 0 &&
+            (valor[n] == '\0' || strcmp(valor + n, "_link") == 0)) {
+            return CLASSES_TAG[i].classe;
+        }
+    }
+    return VIA_DESCONHECIDA;
+}
+
+const char* tag_da_classe_via(ClasseVia classe) {
+    for (size_t i = 0; i < sizeof(CLASSES_TAG) / sizeof(CLASSES_TAG[0]); ++i) {
+        if (CLASSES_TAG[i].classe == classe) return CLASSES_TAG[i].valor;
+    }
+    return "unclassified";
+}
+
+double velocidade_da_tag(const char* valor) {
+    if (!valor) return 0.0;
+    char* fim;
+    double velocidade = strtod(valor, &fim);
+    if (fim == valor || !(velocidade > 0.0)) return 0.0;
+    while (*fim == ' ') fim++;
+    if (strncmp(fim, "mph", 3) == 0) velocidade *= KMH_POR_MPH;
+    return velocidade;
+}
+
+double velocidade_padrao(ClasseVia classe) {
+    if ((int)classe < 0 || classe >= NUM_CLASSES_VIA) classe = VIA_DESCONHECIDA;
+    return VELOCIDADES_PADRAO[classe];
+}
+
+double velocidade_aresta(const Grafo* grafo, size_t aresta) {
+    if (!grafo->classe_via || aresta >= grafo->num_arestas) return velocidade_padrao(VIA_DESCONHECIDA);
+    if (grafo->velocidade_kmh[aresta] > 0.0f) return grafo->velocidade_kmh[aresta];
+    return velocidade_padrao((ClasseVia)grafo->classe_via[aresta]);
+}
+
+double custo_aresta(const Grafo* grafo, size_t aresta, Metrica metrica) {
+    if (!grafo || aresta >= grafo->num_arestas) return DBL_MAX;
+    double km = grafo->arestas[aresta].peso;
+    if (metrica == METRICA_DISTANCIA) return km;
+    double segundos = km / velocidade_aresta(grafo, aresta) * 3600.0;
+    if (metrica == METRICA_PERSONALIZADA && grafo->penalidade_s) segundos += grafo->penalidade_s[aresta];
+    return segundos;
+}
+
+const double* obter_pesos_metrica(Grafo* grafo, Metrica metrica) {
+    if ((int)metrica < 0 || metrica >= NUM_METRICAS || !obter_indices(grafo)) return NULL;
+    IndicesGrafo* indices = grafo->indices;
+    if (!indices->peso_metrica[metrica]) {
+        double* pesos = arena_alocar(indices->arena, (indices->num_arcos ? indices->num_arcos : 1) * sizeof(double));
+        if (!pesos) return NULL;
+        for (size_t k = 0; k < indices->num_arcos; ++k) {
+            pesos[k] = custo_aresta(grafo, indices->arcos[k].aresta, metrica);
+        }
+        indices->peso_metrica[metrica] = pesos;
+    }
+    return indices->peso_metrica[metrica];
+}
+
+int definir_penalidade(Grafo* grafo, size_t aresta, double segundos) {
+    if (!grafo || aresta >= grafo->num_arestas || !(segundos >= 0.0) || segundos > FLT_MAX) return -1;
+    if (garantir_atributos_arestas(grafo) != 0) return -1;
+    grafo->penalidade_s[aresta] = (float)segundos;
+    if (grafo->indices && grafo->indices->peso_metrica[METRICA_PERSONALIZADA]) {
+        size_t arcos[2];
+        size_t n = arcos_da_aresta(grafo, aresta, arcos);
+        for (size_t j = 0; j < n; ++j) {
+            grafo->indices->peso_metrica[METRICA_PERSONALIZADA][arcos[j]] =
+                custo_aresta(grafo, aresta, METRICA_PERSONALIZADA);
+        }
+    }
+    return 0;
+}
+
+int metricas_caminho(Grafo* grafo, const long* caminho, int tamanho, Metrica metrica,
+                     double custos[NUM_METRICAS]) {
+    for (int m = 0; m < NUM_METRICAS; ++m) custos[m] = 0.0;
+    const double* pesos = obter_pesos_metrica(grafo, metrica);
+    if (!pesos || !caminho || tamanho < 1) return -1;
+    const IndicesGrafo* indices = grafo->indices;
+
+    for (int i = 1; i < tamanho; ++i) {
+        ssize_t u = buscar_indice_ponto(grafo, caminho[i - 1]);
+        ssize_t v = buscar_indice_ponto(grafo, caminho[i]);
+        if (u < 0 || v < 0) return -1;
+        size_t melhor = (size_t)-1;
+        for (size_t k = indices->inicio_arcos[u]; k < indices->inicio_arcos[u + 1]; ++k) {
+            if (indices->arcos[k].destino == (size_t)v && (melhor == (size_t)-1 || pesos[k] < pesos[melhor])) {
+                melhor = k;
+            }
+        }
+        if (melhor == (size_t)-1) return -1;
+        for (int m = 0; m < NUM_METRICAS; ++m) {
+            custos[m] += custo_aresta(grafo, indices->arcos[melhor].aresta, (Metrica)m);
+        }
+    }
+    return 0;
+}
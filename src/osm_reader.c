@@ -1,4 +1,6 @@
 #include "../include/osm_reader.h"
+#include "../include/graph.h"
+#include "../include/metrics.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -25,30 +27,34 @@ static double haversine(double lat1, double lon1, double lat2, double lon2) {
     return R * c;
 }
 
-// Função para liberar o grafo
+// Copia o valor do atributo v="..." de uma linha <tag> (vazio se não houver)
+static void valor_da_tag(const char* linha, char* valor, size_t tamanho) {
+    const char* inicio = strstr(linha, "v=\"");
+    size_t n = 0;
+    if (inicio) {
+        inicio += 3;
+        while (inicio[n] != '"' && inicio[n] != '\0' && n + 1 < tamanho) {
+            valor[n] = inicio[n];
+            n++;
+        }
+    }
+    valor[n] = '\0';
+}
+
+// Função para liberar o grafo (os índices derivados saem com a arena deles)
 void liberar_grafo(Grafo* grafo) {
     if (grafo) {
+        liberar_indices_grafo(grafo);
         free(grafo->pontos);
         free(grafo->arestas);
+        free(grafo->classe_via);
+        free(grafo->velocidade_kmh);
+        free(grafo->penalidade_s);
         free(grafo);
     }
 }
 
 
-// Struct temporária para armazenar nós durante a leitura do OSM
-typedef struct {
-    long long id;
-    double lat;
-    double lon;
-} NodeTemp;
-
-// Struct temporária para armazenar arestas durante a leitura do OSM
-typedef struct {
-    long long origem;
-    long long destino;
-    int is_bidirectional; // 1 se bidirecional, 0 se mão única
-} EdgeTemp;
-
 // Função principal para ler o arquivo OSM
 Grafo* ler_osm(const char* caminho_arquivo_osm) {
     // Set C locale to ensure decimal point parsing
@@ -59,16 +65,22 @@ Grafo* ler_osm(const char* caminho_arquivo_osm) {
         return NULL;
     }
 
-    NodeTemp* nodes = NULL;
-    size_t nodes_cap = 0, nodes_count = 0;
-    EdgeTemp* edges = NULL;
-    size_t edges_cap = 0, edges_count = 0;
+    // Pontos e arestas vão direto para o grafo, que cresce geometricamente
+    Grafo* grafo = criar_grafo();
+    if (!grafo) {
+        fclose(f);
+        return NULL;
+    }
+    Aresta segmentos[127];
 
     char linha[LINHA_MAX];
     int in_way = 0;
     long long way_nodes[128];
     int way_nodes_count = 0;
     int is_oneway = 0;  // Flag para detectar vias de mão única
+    ClasseVia classe = VIA_DESCONHECIDA;  // Tag highway da way atual
+    double velocidade = 0.0;              // Tag maxspeed da way atual (0: ausente)
+    char valor[64];
 
     while (fgets(linha, LINHA_MAX, f)) {
         // Parse node - improved parsing for complex OSM format
@@ -120,19 +132,10 @@ Grafo* ler_osm(const char* caminho_arquivo_osm) {
                 parsed = 1;
             }
             
-            if (parsed) {
-                if (nodes_count == nodes_cap) {
-                    nodes_cap = nodes_cap ? nodes_cap*2 : 1024;
-                    NodeTemp* new_nodes = realloc(nodes, nodes_cap * sizeof(NodeTemp));
-                    if (!new_nodes) {
-                        free(nodes);
-                        free(edges);
-                        fclose(f);
-                        return NULL;
-                    }
-                    nodes = new_nodes;
-                }
-                nodes[nodes_count++] = (NodeTemp){id, lat, lon};
+            if (parsed && adicionar_ponto(grafo, id, lat, lon) != 0) {
+                liberar_grafo(grafo);
+                fclose(f);
+                return NULL;
             }
             continue;
         }
@@ -142,6 +145,8 @@ Grafo* ler_osm(const char* caminho_arquivo_osm) {
             in_way = 1;
             way_nodes_count = 0;
             is_oneway = 0;  // Reset flag para cada way
+            classe = VIA_DESCONHECIDA;
+            velocidade = 0.0;
             continue;
         }
         if (in_way && strstr(linha, "<nd ref=")) {
@@ -152,8 +157,15 @@ Grafo* ler_osm(const char* caminho_arquivo_osm) {
             }
             continue;
         }
-        // Detectar tags de via única
+        // Detectar tags de via única, classe da via e velocidade máxima
         if (in_way && strstr(linha, "<tag")) {
+            if (strstr(linha, "k=\"highway\"")) {
+                valor_da_tag(linha, valor, sizeof(valor));
+                classe = classe_via_da_tag(valor);
+            } else if (strstr(linha, "k=\"maxspeed\"")) {
+                valor_da_tag(linha, valor, sizeof(valor));
+                velocidade = velocidade_da_tag(valor);
+            }
             if (strstr(linha, "k=\"oneway\"")) {
                 if (strstr(linha, "v=\"yes\"") || strstr(linha, "v=\"true\"") || strstr(linha, "v=\"1\"")) {
                     is_oneway = 1;
@@ -164,42 +176,38 @@ Grafo* ler_osm(const char* caminho_arquivo_osm) {
             continue;
         }
         if (in_way && strstr(linha, "</way>")) {
-            // Adiciona arestas entre os nós do caminho
+            // Adiciona arestas entre os nós do caminho; o peso é calculado
+            // no fim, quando todos os nós já foram lidos
+            int num_segmentos = 0;
             for (int i = 1; i < way_nodes_count; ++i) {
-                // Check if we need more space (considering we might add 2 edges)
-                if (edges_count + 1 >= edges_cap) {
-                    edges_cap = edges_cap ? edges_cap*2 : 1024;
-                    EdgeTemp* new_edges = realloc(edges, edges_cap * sizeof(EdgeTemp));
-                    if (!new_edges) {
-                        free(nodes);
-                        free(edges);
-                        fclose(f);
-                        return NULL;
-                    }
-                    edges = new_edges;
-                }
-                
+                // Cada segmento gera um único registro, mesmo em vias de mão dupla
                 if (is_oneway == 0) {
-                    // Via bidirecional - adicionar ambas as direções
-                    if (edges_count + 1 >= edges_cap) {
-                        edges_cap = edges_cap*2;
-                        EdgeTemp* new_edges = realloc(edges, edges_cap * sizeof(EdgeTemp));
-                        if (!new_edges) {
-                            free(nodes);
-                            free(edges);
-                            fclose(f);
-                            return NULL;
-                        }
-                        edges = new_edges;
-                    }
-                    edges[edges_count++] = (EdgeTemp){way_nodes[i-1], way_nodes[i], 1};
-                    edges[edges_count++] = (EdgeTemp){way_nodes[i], way_nodes[i-1], 1};
+                    // Via bidirecional - um registro, percorrível nos dois sentidos
+                    segmentos[num_segmentos++] = (Aresta){way_nodes[i-1], way_nodes[i], 0.0, 1};
                 } else if (is_oneway == 1) {
                     // Via de mão única normal
-                    edges[edges_count++] = (EdgeTemp){way_nodes[i-1], way_nodes[i], 0};
+                    segmentos[num_segmentos++] = (Aresta){way_nodes[i-1], way_nodes[i], 0.0, 0};
                 } else if (is_oneway == -1) {
                     // Via de mão única reversa
-                    edges[edges_count++] = (EdgeTemp){way_nodes[i], way_nodes[i-1], 0};
+                    segmentos[num_segmentos++] = (Aresta){way_nodes[i], way_nodes[i-1], 0.0, 0};
+                }
+            }
+            size_t primeira = grafo->num_arestas;
+            if (adicionar_arestas(grafo, segmentos, num_segmentos) != 0) {
+                liberar_grafo(grafo);
+                fclose(f);
+                return NULL;
+            }
+            // Atributos da way vão para os vetores paralelos das arestas
+            if (num_segmentos > 0 && (classe != VIA_DESCONHECIDA || velocidade > 0.0)) {
+                if (garantir_atributos_arestas(grafo) != 0) {
+                    liberar_grafo(grafo);
+                    fclose(f);
+                    return NULL;
+                }
+                for (size_t i = primeira; i < grafo->num_arestas; ++i) {
+                    grafo->classe_via[i] = (unsigned char)classe;
+                    grafo->velocidade_kmh[i] = (float)velocidade;
                 }
             }
             in_way = 0;
@@ -208,59 +216,21 @@ Grafo* ler_osm(const char* caminho_arquivo_osm) {
     }
     fclose(f);
 
-    // Monta o grafo final
-    Grafo* grafo = malloc(sizeof(Grafo));
-    if (!grafo) {
-        free(nodes);
-        free(edges);
-        return NULL;
-    }
-    
-    grafo->num_pontos = nodes_count;
-    grafo->pontos = malloc(nodes_count * sizeof(Ponto));
-    if (!grafo->pontos) {
-        free(grafo);
-        free(nodes);
-        free(edges);
-        return NULL;
-    }
-    
-    for (size_t i = 0; i < nodes_count; ++i) {
-        grafo->pontos[i].id = nodes[i].id;
-        grafo->pontos[i].lat = nodes[i].lat;
-        grafo->pontos[i].lon = nodes[i].lon;
-    }
-    
-    grafo->num_arestas = edges_count;
-    grafo->arestas = malloc(edges_count * sizeof(Aresta));
-    if (!grafo->arestas) {
-        free(grafo->pontos);
-        free(grafo);
-        free(nodes);
-        free(edges);
-        return NULL;
-    }
-    for (size_t i = 0; i < edges_count; ++i) {
-        // Busca os pontos de origem e destino
-        double lat1 = 0, lon1 = 0, lat2 = 0, lon2 = 0;
-        for (size_t j = 0; j < nodes_count; ++j) {
-            if (nodes[j].id == edges[i].origem) {
-                lat1 = nodes[j].lat;
-                lon1 = nodes[j].lon;
-            }
-            if (nodes[j].id == edges[i].destino) {
-                lat2 = nodes[j].lat;
-                lon2 = nodes[j].lon;
-            }
-        }
-        grafo->arestas[i].origem = edges[i].origem;
-        grafo->arestas[i].destino = edges[i].destino;
-        grafo->arestas[i].peso = haversine(lat1, lon1, lat2, lon2) / 1000.0; // Convert to km
-        grafo->arestas[i].is_bidirectional = edges[i].is_bidirectional;
+    // Pesos: localizar as extremidades pelo mapa de IDs.
+    // Extremidades ausentes do arquivo ficam com coordenadas (0, 0).
+    for (size_t i = 0; i < grafo->num_arestas; ++i) {
+        Aresta* a = &grafo->arestas[i];
+        ssize_t o = buscar_indice_ponto(grafo, a->origem);
+        ssize_t d = buscar_indice_ponto(grafo, a->destino);
+        double lat1 = o >= 0 ? grafo->pontos[o].lat : 0.0, lon1 = o >= 0 ? grafo->pontos[o].lon : 0.0;
+        double lat2 = d >= 0 ? grafo->pontos[d].lat : 0.0, lon2 = d >= 0 ? grafo->pontos[d].lon : 0.0;
+        a->peso = haversine(lat1, lon1, lat2, lon2) / 1000.0; // Convert to km
     }
+    // A adjacência foi montada com pesos provisórios
+    invalidar_adjacencia(grafo);
     
-    free(nodes);
-    free(edges);
+    // Ways sobrepostas podem repetir o mesmo segmento
+    canonicalizar_arestas(grafo);
     
     return grafo;
 }
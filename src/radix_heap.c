@@ -0,0 +1,147 @@
+#include "radix_heap.h"
+#include "graph.h"
+#include "components.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Balde de uma chave: 0 se igual à última extraída, senão 1 + posição do bit
+// mais alto em que as duas diferem
+static inline size_t balde_da_chave(uint64_t chave, uint64_t ultima) {
+    uint64_t diferenca = chave ^ ultima;
+    return diferenca ? (size_t)(64 - __builtin_clzll(diferenca)) : 0;
+}
+
+static int empilhar_no_balde(BaldeRadix *balde, uint64_t chave, size_t valor) {
+    if (balde->tamanho == balde->capacidade) {
+        size_t nova = balde->capacidade ? balde->capacidade * 2 : 16;
+        ItemRadix *novos = realloc(balde->itens, nova * sizeof(ItemRadix));
+        if (!novos) return -1;
+        balde->itens = novos;
+        balde->capacidade = nova;
+    }
+    balde->itens[balde->tamanho++] = (ItemRadix){chave, valor};
+    return 0;
+}
+
+void iniciar_fila_radix(FilaRadix *fila) {
+    memset(fila, 0, sizeof(FilaRadix));
+}
+
+void liberar_fila_radix(FilaRadix *fila) {
+    if (!fila) return;
+    for (size_t b = 0; b < NUM_BALDES_RADIX; b++) {
+        free(fila->baldes[b].itens);
+    }
+    memset(fila, 0, sizeof(FilaRadix));
+}
+
+int inserir_fila_radix(FilaRadix *fila, uint64_t chave, size_t valor) {
+    if (empilhar_no_balde(&fila->baldes[balde_da_chave(chave, fila->ultima)], chave, valor) != 0) {
+        return -1;
+    }
+    fila->tamanho++;
+    return 0;
+}
+
+ItemRadix extrair_minimo_radix(FilaRadix *fila) {
+    if (fila->baldes[0].tamanho == 0) {
+        // Primeiro balde não vazio: seu mínimo vira a nova referência e todos
+        // os itens dele caem em baldes de índice menor
+        size_t b = 1;
+        while (fila->baldes[b].tamanho == 0) b++;
+        BaldeRadix *balde = &fila->baldes[b];
+        uint64_t minimo = balde->itens[0].chave;
+        for (size_t i = 1; i < balde->tamanho; i++) {
+            if (balde->itens[i].chave < minimo) minimo = balde->itens[i].chave;
+        }
+        fila->ultima = minimo;
+        for (size_t i = 0; i < balde->tamanho; i++) {
+            ItemRadix item = balde->itens[i];
+            // Como em inserir_fila_prioridade, falta de memória descarta o item
+            empilhar_no_balde(&fila->baldes[balde_da_chave(item.chave, minimo)], item.chave, item.valor);
+        }
+        balde->tamanho = 0;
+    }
+    fila->tamanho--;
+    return fila->baldes[0].itens[--fila->baldes[0].tamanho];
+}
+
+ResultadoDijkstra* dijkstra_radix(Grafo *grafo, long origem_id, long destino_id) {
+    if (!grafo || grafo->num_pontos == 0) return NULL;
+
+    const IndicesGrafo *indices = obter_pesos_inteiros(grafo);
+    if (!indices) return NULL;
+
+    ssize_t origem = buscar_indice_ponto(grafo, origem_id);
+    ssize_t destino = buscar_indice_ponto(grafo, destino_id);
+    if (origem < 0 || destino < 0) return NULL;
+
+    ResultadoDijkstra *resultado = calloc(1, sizeof(ResultadoDijkstra));
+    if (!resultado) return NULL;
+    resultado->distancia_total = -1.0;
+
+    // Mesma rejeição e poda por componente do dijkstra()
+    if (!alcance_possivel(grafo, (size_t)origem, (size_t)destino)) return resultado;
+    const size_t *componente = indices->componente_forte;
+    size_t componente_destino = componente ? componente[destino] : 0;
+
+    size_t n = grafo->num_pontos;
+    uint64_t *distancias = malloc(n * sizeof(uint64_t));
+    size_t *predecessores = malloc(n * sizeof(size_t));
+    if (!distancias || !predecessores) {
+        free(distancias);
+        free(predecessores);
+        free(resultado);
+        return NULL;
+    }
+    for (size_t i = 0; i < n; i++) {
+        distancias[i] = UINT64_MAX;
+        predecessores[i] = (size_t)-1;
+    }
+
+    FilaRadix fila;
+    iniciar_fila_radix(&fila);
+    distancias[origem] = 0;
+    inserir_fila_radix(&fila, 0, (size_t)origem);
+
+    while (!fila_radix_vazia(&fila)) {
+        ItemRadix item = extrair_minimo_radix(&fila);
+        size_t atual = item.valor;
+        // Entrada obsoleta: o ponto já foi estabelecido com distância menor
+        if (item.chave != distancias[atual]) continue;
+        resultado->nos_visitados++;
+        if (atual == (size_t)destino) break;
+
+        for (size_t k = indices->inicio_arcos[atual]; k < indices->inicio_arcos[atual + 1]; k++) {
+            size_t vizinho = indices->arcos[k].destino;
+            if (componente && componente[vizinho] < componente_destino) continue;
+            uint64_t nova = item.chave + indices->peso_mm[k];
+            if (nova < distancias[vizinho]) {
+                distancias[vizinho] = nova;
+                predecessores[vizinho] = atual;
+                inserir_fila_radix(&fila, nova, vizinho);
+            }
+        }
+    }
+    liberar_fila_radix(&fila);
+
+    if (distancias[destino] != UINT64_MAX) {
+        int contador = 0;
+        for (size_t v = (size_t)destino; v != (size_t)-1; v = predecessores[v]) contador++;
+        resultado->caminho = malloc(sizeof(long) * contador);
+        if (resultado->caminho) {
+            int posicao = contador - 1;
+            for (size_t v = (size_t)destino; v != (size_t)-1; v = predecessores[v]) {
+                resultado->caminho[posicao--] = grafo->pontos[v].id;
+            }
+            resultado->tamanho_caminho = contador;
+        }
+        resultado->distancia_total = distancias[destino] / MM_POR_KM;
+        resultado->sucesso = 1;
+    }
+
+    free(distancias);
+    free(predecessores);
+    return resultado;
+}
@@ -0,0 +1,156 @@
+#include "reorder.h"
+#include "graph.h"
+#include <stdlib.h>
+#include <stdint.h>
+
+// Resolução da grade usada para discretizar as coordenadas (2^16 x 2^16)
+#define LADO_GRADE_HILBERT 65536u
+
+// Converte (x, y) na posição ao longo da curva de Hilbert de lado n
+static uint64_t hilbert_xy_para_d(uint32_t n, uint32_t x, uint32_t y) {
+    uint64_t d = 0;
+    for (uint32_t s = n / 2; s > 0; s /= 2) {
+        uint32_t rx = (x & s) > 0;
+        uint32_t ry = (y & s) > 0;
+        d += (uint64_t)s * s * ((3 * rx) ^ ry);
+        // Rotacionar o quadrante para manter a curva contínua
+        if (ry == 0) {
+            if (rx == 1) {
+                x = n - 1 - x;
+                y = n - 1 - y;
+            }
+            uint32_t t = x;
+            x = y;
+            y = t;
+        }
+    }
+    return d;
+}
+
+typedef struct {
+    uint64_t chave;
+    size_t indice;
+} ChaveOrdenacao;
+
+static int comparar_chaves(const void *a, const void *b) {
+    const ChaveOrdenacao *ka = a;
+    const ChaveOrdenacao *kb = b;
+    if (ka->chave != kb->chave) return (ka->chave > kb->chave) - (ka->chave < kb->chave);
+    return (ka->indice > kb->indice) - (ka->indice < kb->indice);
+}
+
+// Arestas ordenadas pelos novos índices das pontas, comparados campo a campo
+// (empacotá-los num inteiro de 64 bits colidiria a partir de 2^32 pontos)
+typedef struct {
+    size_t origem;
+    size_t destino;
+    size_t indice;
+} ChaveAresta;
+
+static int comparar_chaves_arestas(const void *a, const void *b) {
+    const ChaveAresta *ka = a;
+    const ChaveAresta *kb = b;
+    if (ka->origem != kb->origem) return (ka->origem > kb->origem) - (ka->origem < kb->origem);
+    if (ka->destino != kb->destino) return (ka->destino > kb->destino) - (ka->destino < kb->destino);
+    return (ka->indice > kb->indice) - (ka->indice < kb->indice);
+}
+
+static uint32_t discretizar(double valor, double minimo, double faixa) {
+    if (faixa <= 0.0) return 0;
+    double t = (valor - minimo) / faixa * (LADO_GRADE_HILBERT - 1);
+    if (t < 0.0) t = 0.0;
+    if (t > LADO_GRADE_HILBERT - 1) t = LADO_GRADE_HILBERT - 1;
+    return (uint32_t)t;
+}
+
+int reordenar_hilbert(Grafo *grafo) {
+    if (!grafo) return -1;
+    size_t n = grafo->num_pontos;
+    size_t m = grafo->num_arestas;
+    if (n < 2) return 0;
+
+    double min_lat = grafo->pontos[0].lat, max_lat = min_lat;
+    double min_lon = grafo->pontos[0].lon, max_lon = min_lon;
+    for (size_t i = 1; i < n; i++) {
+        const Ponto *p = &grafo->pontos[i];
+        if (p->lat < min_lat) min_lat = p->lat;
+        if (p->lat > max_lat) max_lat = p->lat;
+        if (p->lon < min_lon) min_lon = p->lon;
+        if (p->lon > max_lon) max_lon = p->lon;
+    }
+
+    ChaveOrdenacao *chaves = malloc(n * sizeof(ChaveOrdenacao));
+    Ponto *novos_pontos = malloc(n * sizeof(Ponto));
+    ChaveAresta *chaves_arestas = malloc((m ? m : 1) * sizeof(ChaveAresta));
+    Aresta *novas_arestas = malloc((m ? m : 1) * sizeof(Aresta));
+    // Atributos por aresta, quando existem, seguem a mesma permutação
+    int com_atributos = grafo->classe_via != NULL;
+    unsigned char *novas_classes = com_atributos ? malloc(m ? m : 1) : NULL;
+    float *novas_velocidades = com_atributos ? malloc((m ? m : 1) * sizeof(float)) : NULL;
+    float *novas_penalidades = com_atributos ? malloc((m ? m : 1) * sizeof(float)) : NULL;
+    if (!chaves || !novos_pontos || !chaves_arestas || !novas_arestas ||
+        (com_atributos && (!novas_classes || !novas_velocidades || !novas_penalidades))) {
+        free(chaves);
+        free(novos_pontos);
+        free(chaves_arestas);
+        free(novas_arestas);
+        free(novas_classes);
+        free(novas_velocidades);
+        free(novas_penalidades);
+        return -1;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        uint32_t x = discretizar(grafo->pontos[i].lon, min_lon, max_lon - min_lon);
+        uint32_t y = discretizar(grafo->pontos[i].lat, min_lat, max_lat - min_lat);
+        chaves[i].chave = hilbert_xy_para_d(LADO_GRADE_HILBERT, x, y);
+        chaves[i].indice = i;
+    }
+    qsort(chaves, n, sizeof(ChaveOrdenacao), comparar_chaves);
+
+    for (size_t i = 0; i < n; i++) {
+        novos_pontos[i] = grafo->pontos[chaves[i].indice];
+    }
+    free(grafo->pontos);
+    grafo->pontos = novos_pontos;
+    grafo->capacidade_pontos = n;
+    free(chaves);
+
+    // O mapa de IDs é refeito para a nova numeração
+    invalidar_indices(grafo);
+
+    // Ordenar as arestas pelo novo índice da origem (e do destino)
+    for (size_t i = 0; i < m; i++) {
+        ssize_t o = buscar_indice_ponto(grafo, grafo->arestas[i].origem);
+        ssize_t d = buscar_indice_ponto(grafo, grafo->arestas[i].destino);
+        chaves_arestas[i].origem = o < 0 ? n : (size_t)o;
+        chaves_arestas[i].destino = d < 0 ? n : (size_t)d;
+        chaves_arestas[i].indice = i;
+    }
+    qsort(chaves_arestas, m, sizeof(ChaveAresta), comparar_chaves_arestas);
+    for (size_t i = 0; i < m; i++) {
+        novas_arestas[i] = grafo->arestas[chaves_arestas[i].indice];
+    }
+    free(grafo->arestas);
+    grafo->arestas = novas_arestas;
+    if (com_atributos) {
+        for (size_t i = 0; i < m; i++) {
+            size_t antiga = chaves_arestas[i].indice;
+            novas_classes[i] = grafo->classe_via[antiga];
+            novas_velocidades[i] = grafo->velocidade_kmh[antiga];
+            novas_penalidades[i] = grafo->penalidade_s[antiga];
+        }
+        free(grafo->classe_via);
+        free(grafo->velocidade_kmh);
+        free(grafo->penalidade_s);
+        grafo->classe_via = novas_classes;
+        grafo->velocidade_kmh = novas_velocidades;
+        grafo->penalidade_s = novas_penalidades;
+    }
+    grafo->capacidade_arestas = m;
+    free(chaves_arestas);
+
+    // A adjacência referencia índices de arestas: reconstruir na nova ordem
+    invalidar_adjacencia(grafo);
+    return 0;
+}
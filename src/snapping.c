@@ -0,0 +1,258 @@
+#include "snapping.h"
+#include "metrics.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define NENHUM ((size_t)-1)
+
+// Metros por grau de latitude (esfera de raio 6371 km, como em ler_osm)
+#define METROS_POR_GRAU (6371000.0 * M_PI / 180.0)
+
+// Plano em metros em torno da coordenada consultada
+typedef struct {
+    double lat, lon, cos_lat;
+} PlanoLocal;
+
+static PlanoLocal plano_em(double lat, double lon) {
+    PlanoLocal plano = {lat, lon, cos(lat * M_PI / 180.0)};
+    if (plano.cos_lat < 1e-6) plano.cos_lat = 1e-6;
+    return plano;
+}
+
+static inline void projetar(const PlanoLocal *plano, const Ponto *p, double *x, double *y) {
+    *x = (p->lon - plano->lon) * METROS_POR_GRAU * plano->cos_lat;
+    *y = (p->lat - plano->lat) * METROS_POR_GRAU;
+}
+
+// Projeta a consulta (origem do plano) na aresta e: fração e distância em
+// metros. Retorna -1 se a aresta não está no índice.
+static int projetar_na_aresta(const IndiceEspacial *indice, const PlanoLocal *plano, size_t e,
+                              ProjecaoAresta *projecao) {
+    size_t o, d;
+    if (pontas_segmento(indice, e, &o, &d) != 0) return -1;
+    const Ponto *a = &grafo_indice(indice)->pontos[o];
+    const Ponto *b = &grafo_indice(indice)->pontos[d];
+    double ax, ay, bx, by;
+    projetar(plano, a, &ax, &ay);
+    projetar(plano, b, &bx, &by);
+    double dx = bx - ax, dy = by - ay;
+    double comprimento2 = dx * dx + dy * dy;
+    double t = comprimento2 > 0.0 ? -(ax * dx + ay * dy) / comprimento2 : 0.0;
+    t = t < 0.0 ? 0.0 : t > 1.0 ? 1.0 : t;
+    projecao->aresta = e;
+    projecao->fracao = t;
+    projecao->lat = a->lat + t * (b->lat - a->lat);
+    projecao->lon = a->lon + t * (b->lon - a->lon);
+    projecao->distancia_m = hypot(ax + t * dx, ay + t * dy);
+    return 0;
+}
+
+// Arestas cujo retângulo toca o quadrado de raio_m metros em volta da
+// consulta: contém todas as que estão a até raio_m dela
+static int arestas_no_raio(const IndiceEspacial *indice, const PlanoLocal *plano, double raio_m,
+                           ListaIndices *saida) {
+    double dlat = raio_m / METROS_POR_GRAU * (1.0 + 1e-9) + 1e-12;
+    double dlon = raio_m / (METROS_POR_GRAU * plano->cos_lat) * (1.0 + 1e-9) + 1e-12;
+    return segmentos_na_caixa(indice, plano->lat - dlat, plano->lon - dlon, plano->lat + dlat, plano->lon + dlon,
+                              saida);
+}
+
+int aresta_mais_proxima(const IndiceEspacial *indice, double lat, double lon, double raio_max_m,
+                        ProjecaoAresta *projecao) {
+    if (!indice || !projecao) return -1;
+    PlanoLocal plano = plano_em(lat, lon);
+    // Um grau de longitude é o menor lado: raio_max_m metros cabem nesse raio em graus
+    double raio_graus = raio_max_m > 0.0 ? raio_max_m / (METROS_POR_GRAU * plano.cos_lat) : 0.0;
+    size_t e;
+    ProjecaoAresta melhor;
+    if (segmento_mais_proximo(indice, lat, lon, raio_graus, &e) != 0 ||
+        projetar_na_aresta(indice, &plano, e, &melhor) != 0)
+        return -1;
+
+    // O mais próximo em graus não é sempre o mais próximo em metros, mas está
+    // a melhor.distancia_m: o vencedor em metros está na caixa desse raio
+    ListaIndices *lista = criar_lista_indices();
+    if (!lista) return -1;
+    double raio = raio_max_m > 0.0 ? fmin(melhor.distancia_m, raio_max_m) : melhor.distancia_m;
+    int erro = arestas_no_raio(indice, &plano, raio, lista);
+    for (size_t k = 0; !erro && k < lista->quantidade; k++) {
+        ProjecaoAresta candidata;
+        if (projetar_na_aresta(indice, &plano, lista->itens[k], &candidata) == 0 &&
+            (candidata.distancia_m < melhor.distancia_m ||
+             (candidata.distancia_m == melhor.distancia_m && candidata.aresta < melhor.aresta))) {
+            melhor = candidata;
+        }
+    }
+    liberar_lista_indices(lista);
+    if (erro || (raio_max_m > 0.0 && melhor.distancia_m > raio_max_m)) return -1;
+    *projecao = melhor;
+    return 0;
+}
+
+size_t arestas_proximas(const IndiceEspacial *indice, double lat, double lon, double raio_m,
+                        ProjecaoAresta *saida, size_t max_saida) {
+    if (!indice || !saida || max_saida == 0 || !(raio_m >= 0.0)) return 0;
+    PlanoLocal plano = plano_em(lat, lon);
+    ListaIndices *lista = criar_lista_indices();
+    if (!lista) return 0;
+    size_t num = 0;
+    if (arestas_no_raio(indice, &plano, raio_m, lista) == 0) {
+        for (size_t k = 0; k < lista->quantidade; k++) {
+            ProjecaoAresta candidata;
+            if (projetar_na_aresta(indice, &plano, lista->itens[k], &candidata) != 0 ||
+                candidata.distancia_m > raio_m)
+                continue;
+            // Inserção ordenada por (distância, aresta), mantendo as max_saida melhores
+            size_t pos = num;
+            while (pos > 0 && (saida[pos - 1].distancia_m > candidata.distancia_m ||
+                               (saida[pos - 1].distancia_m == candidata.distancia_m &&
+                                saida[pos - 1].aresta > candidata.aresta))) {
+                pos--;
+            }
+            if (pos >= max_saida) continue;
+            size_t mover = (num < max_saida ? num : max_saida - 1) - pos;
+            memmove(saida + pos + 1, saida + pos, mover * sizeof(ProjecaoAresta));
+            if (num < max_saida) num++;
+            saida[pos] = candidata;
+        }
+    }
+    liberar_lista_indices(lista);
+    return num;
+}
+
+int projecao_no_ponto(const IndiceEspacial *indice, long long id, ProjecaoAresta *projecao) {
+    if (!indice || !projecao) return -1;
+    const Grafo *grafo = grafo_indice(indice);
+    ssize_t v = buscar_indice_ponto(grafo, id);
+    if (v < 0) return -1;
+    // O retângulo de uma aresta que toca o ponto contém o ponto
+    const Ponto *p = &grafo->pontos[v];
+    ListaIndices *lista = criar_lista_indices();
+    if (!lista) return -1;
+    int resultado = -1;
+    if (segmentos_na_caixa(indice, p->lat, p->lon, p->lat, p->lon, lista) == 0) {
+        for (size_t k = 0; k < lista->quantidade && resultado != 0; k++) {
+            size_t e = lista->itens[k], o, d;
+            if (pontas_segmento(indice, e, &o, &d) != 0 || (o != (size_t)v && d != (size_t)v)) continue;
+            projecao->aresta = e;
+            projecao->fracao = o == (size_t)v ? 0.0 : 1.0;
+            projecao->lat = p->lat;
+            projecao->lon = p->lon;
+            projecao->distancia_m = 0.0;
+            resultado = 0;
+        }
+    }
+    liberar_lista_indices(lista);
+    return resultado;
+}
+
+// Rotula v com custo vindo de anterior, se melhorar o rótulo atual
+static void relaxar(EspacoBusca *espaco, size_t v, double custo, size_t anterior) {
+    if (espaco->estabelecido[v] == espaco->epoca) return;
+    if (espaco->marca[v] != espaco->epoca || custo < espaco->distancias[v]) {
+        espaco->marca[v] = espaco->epoca;
+        espaco->distancias[v] = custo;
+        espaco->predecessores[v] = anterior;
+        inserir_fila_prioridade(espaco->fila, (long)v, custo);
+    }
+}
+
+ResultadoDijkstra* dijkstra_projecoes(Grafo *grafo, EspacoBusca *espaco, const ProjecaoAresta *origem,
+                                      const ProjecaoAresta *destino) {
+    if (!grafo || !espaco || !origem || !destino || espaco->num_pontos != grafo->num_pontos) return NULL;
+    if (origem->aresta >= grafo->num_arestas || destino->aresta >= grafo->num_arestas) return NULL;
+    if (!(origem->fracao >= 0.0 && origem->fracao <= 1.0) || !(destino->fracao >= 0.0 && destino->fracao <= 1.0)) {
+        return NULL;
+    }
+    const IndicesGrafo *indices = obter_indices(grafo);
+    if (!indices) return NULL;
+    const double *pesos = NULL;
+    if (espaco->metrica != METRICA_DISTANCIA && !(pesos = obter_pesos_metrica(grafo, espaco->metrica))) return NULL;
+
+    const Aresta *ea = &grafo->arestas[origem->aresta];
+    const Aresta *eb = &grafo->arestas[destino->aresta];
+    ssize_t a_origem = buscar_indice_ponto(grafo, ea->origem), a_destino = buscar_indice_ponto(grafo, ea->destino);
+    ssize_t b_origem = buscar_indice_ponto(grafo, eb->origem), b_destino = buscar_indice_ponto(grafo, eb->destino);
+    if (a_origem < 0 || a_destino < 0 || b_origem < 0 || b_destino < 0) return NULL;
+    double t = origem->fracao, s = destino->fracao;
+    double custo_a = custo_aresta(grafo, origem->aresta, espaco->metrica);
+    double custo_b = custo_aresta(grafo, destino->aresta, espaco->metrica);
+
+    ResultadoDijkstra *resultado = calloc(1, sizeof(ResultadoDijkstra));
+    if (!resultado) return NULL;
+    resultado->distancia_total = -1.0;
+
+    // Trecho direto, sem sair da aresta (contra o sentido só em mão dupla)
+    double melhor = DBL_MAX;
+    size_t chegada = NENHUM;
+    if (origem->aresta == destino->aresta && (s >= t || ea->is_bidirectional)) melhor = fabs(s - t) * custo_a;
+
+    // Sementes: as pontas alcançáveis a partir da projeção de origem (a
+    // origem da aresta só em mão dupla). Projeção numa ponta semeia só ela,
+    // para que o caminho comece pelo próprio ponto.
+    reiniciar_espaco_busca(espaco);
+    if (t > 0.0) relaxar(espaco, (size_t)a_destino, (1.0 - t) * custo_a, NENHUM);
+    if (t < 1.0 && (ea->is_bidirectional || t == 0.0)) relaxar(espaco, (size_t)a_origem, t * custo_a, NENHUM);
+
+    // Entradas na aresta de destino e o custo do pedaço até a projeção, com
+    // a mesma regra para as pontas
+    size_t entradas[2] = {(size_t)b_origem, (size_t)b_destino};
+    double custos_entrada[2] = {s * custo_b, (1.0 - s) * custo_b};
+    int usar_entrada[2] = {s < 1.0, s > 0.0 && (eb->is_bidirectional || s == 1.0)};
+
+    while (!fila_vazia(espaco->fila)) {
+        NoFilaPrioridade no = extrair_minimo(espaco->fila);
+        if (no.distancia >= melhor) break;
+        size_t atual = (size_t)no.ponto_id;
+        if (espaco->estabelecido[atual] == espaco->epoca) continue;
+        espaco->estabelecido[atual] = espaco->epoca;
+        resultado->nos_visitados++;
+        for (int i = 0; i < 2; i++) {
+            if (usar_entrada[i] && atual == entradas[i] && no.distancia + custos_entrada[i] < melhor) {
+                melhor = no.distancia + custos_entrada[i];
+                chegada = atual;
+            }
+        }
+        for (size_t k = indices->inicio_arcos[atual]; k < indices->inicio_arcos[atual + 1]; k++) {
+            relaxar(espaco, indices->arcos[k].destino, no.distancia + (pesos ? pesos[k] : indices->arcos[k].peso),
+                    atual);
+        }
+    }
+    if (melhor == DBL_MAX) return resultado;
+
+    // Projeções sobre pontos do grafo entram no caminho mesmo no trecho direto
+    size_t ponto_inicio = t == 0.0 ? (size_t)a_origem : t == 1.0 ? (size_t)a_destino : NENHUM;
+    size_t ponto_fim = s == 0.0 ? (size_t)b_origem : s == 1.0 ? (size_t)b_destino : NENHUM;
+    size_t primeiro = ponto_inicio, ultimo = ponto_inicio;
+    int contador = 0;
+    for (size_t v = chegada; v != NENHUM; v = espaco->predecessores[v]) {
+        if (contador++ == 0) ultimo = v;
+        primeiro = v;
+    }
+    int antes = ponto_inicio != NENHUM && (contador == 0 || primeiro != ponto_inicio);
+    int depois = ponto_fim != NENHUM && ultimo != ponto_fim;
+    contador += antes + depois;
+    if (contador > 0) {
+        resultado->caminho = malloc(sizeof(long) * contador);
+        if (!resultado->caminho) {
+            liberar_resultado_dijkstra(resultado);
+            return NULL;
+        }
+        int posicao = contador - 1;
+        if (depois) resultado->caminho[posicao--] = grafo->pontos[ponto_fim].id;
+        for (size_t v = chegada; v != NENHUM; v = espaco->predecessores[v]) {
+            resultado->caminho[posicao--] = grafo->pontos[v].id;
+        }
+        if (antes) resultado->caminho[posicao--] = grafo->pontos[ponto_inicio].id;
+    }
+    resultado->tamanho_caminho = contador;
+    resultado->distancia_total = melhor;
+    resultado->sucesso = 1;
+    return resultado;
+}
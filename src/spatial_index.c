@@ -0,0 +1,570 @@
+#include "spatial_index.h"
+#include "graph.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+
+// Marca de fim de lista / elemento fora da grade
+#define SEM_ELEMENTO UINT32_MAX
+
+// Cada nível tem metade das colunas e linhas do anterior; com no máximo
+// ~2 células por ponto, 64 níveis sobram
+#define MAX_NIVEIS 64
+
+typedef struct {
+    uint32_t celula;   // Posição da célula (SEM_ELEMENTO se fora da grade)
+    uint32_t proximo;  // Próximo elemento da mesma célula
+} Elemento;
+
+typedef struct {
+    size_t colunas, linhas;
+    size_t primeira;   // Posição da célula (0, 0) do nível em primeiro_segmento
+    double lado;       // Em graus
+} Nivel;
+
+struct IndiceEspacial {
+    const Grafo *grafo;
+    double celula_pedida;       // Parâmetro da criação, reusado ao refazer a grade
+    double min_lon, min_lat;    // Canto da grade
+    Nivel niveis[MAX_NIVEIS];   // niveis[0] é também a grade dos pontos
+    size_t num_niveis;
+
+    uint32_t *primeiro_ponto;   // Por célula do nível 0
+    Elemento *pontos;           // Por ponto do grafo
+    size_t num_pontos, capacidade_pontos;
+
+    uint32_t *primeiro_segmento;  // Por célula de todos os níveis
+    Elemento *segmentos;          // Por aresta do grafo
+    uint32_t *pontas;             // Duas por aresta: índices das pontas em grafo->pontos
+    size_t num_segmentos, capacidade_segmentos;
+
+    // Limites dos pontos (válidos só se limites_validos)
+    double min_lat_pontos, max_lat_pontos, min_lon_pontos, max_lon_pontos;
+    int limites_validos;
+};
+
+ListaIndices* criar_lista_indices(void) {
+    return calloc(1, sizeof(ListaIndices));
+}
+
+void liberar_lista_indices(ListaIndices *lista) {
+    if (lista) {
+        free(lista->itens);
+        free(lista);
+    }
+}
+
+static int acrescentar_item(ListaIndices *lista, size_t item) {
+    if (lista->quantidade == lista->capacidade) {
+        size_t nova = lista->capacidade ? 2 * lista->capacidade : 256;
+        size_t *itens = realloc(lista->itens, nova * sizeof(size_t));
+        if (!itens) return -1;
+        lista->itens = itens;
+        lista->capacidade = nova;
+    }
+    lista->itens[lista->quantidade++] = item;
+    return 0;
+}
+
+// Faixa [*i0, *i1] de células (de 'quantidade', com a primeira começando em
+// 'inicio') que cobre o intervalo [min, max]. Retorna 0 se a faixa é vazia.
+static int faixa_celulas(double inicio, double lado, size_t quantidade, double min, double max, size_t *i0,
+                         size_t *i1) {
+    double a = floor((min - inicio) / lado), b = floor((max - inicio) / lado);
+    if (!(b >= 0.0) || !(a < (double)quantidade) || a > b) return 0;
+    *i0 = a < 0.0 ? 0 : (size_t)a;
+    *i1 = b >= (double)quantidade ? quantidade - 1 : (size_t)b;
+    return 1;
+}
+
+// Célula do nível 0 que contém a coordenada; -1 se está fora da grade
+static int celula_do_ponto(const IndiceEspacial *indice, double lat, double lon, uint32_t *celula) {
+    const Nivel *nivel = &indice->niveis[0];
+    double c = floor((lon - indice->min_lon) / nivel->lado);
+    double l = floor((lat - indice->min_lat) / nivel->lado);
+    if (!(c >= 0.0 && c < (double)nivel->colunas && l >= 0.0 && l < (double)nivel->linhas)) return -1;
+    *celula = (uint32_t)((size_t)l * nivel->colunas + (size_t)c);
+    return 0;
+}
+
+// Célula do segmento: a do centro do retângulo envolvente, no nível mais fino
+// cujo lado é pelo menos a maior dimensão do retângulo
+static uint32_t celula_do_segmento(const IndiceEspacial *indice, size_t o, size_t d) {
+    const Ponto *a = &indice->grafo->pontos[o], *b = &indice->grafo->pontos[d];
+    double extensao = fmax(fabs(a->lon - b->lon), fabs(a->lat - b->lat));
+    size_t k = 0;
+    while (k + 1 < indice->num_niveis && indice->niveis[k].lado < extensao) k++;
+    const Nivel *nivel = &indice->niveis[k];
+    double c = floor(((a->lon + b->lon) / 2.0 - indice->min_lon) / nivel->lado);
+    double l = floor(((a->lat + b->lat) / 2.0 - indice->min_lat) / nivel->lado);
+    size_t coluna = !(c > 0.0) ? 0 : c >= (double)nivel->colunas ? nivel->colunas - 1 : (size_t)c;
+    size_t linha = !(l > 0.0) ? 0 : l >= (double)nivel->linhas ? nivel->linhas - 1 : (size_t)l;
+    return (uint32_t)(nivel->primeira + linha * nivel->colunas + coluna);
+}
+
+static void ligar(uint32_t *primeiro, Elemento *elementos, size_t item, uint32_t celula) {
+    elementos[item].celula = celula;
+    elementos[item].proximo = SEM_ELEMENTO;
+    if (celula == SEM_ELEMENTO) return;
+    elementos[item].proximo = primeiro[celula];
+    primeiro[celula] = (uint32_t)item;
+}
+
+static void desligar(uint32_t *primeiro, Elemento *elementos, size_t item) {
+    if (elementos[item].celula == SEM_ELEMENTO) return;
+    uint32_t *elo = &primeiro[elementos[item].celula];
+    while (*elo != item) elo = &elementos[*elo].proximo;
+    *elo = elementos[item].proximo;
+}
+
+// O elemento 'de' passa a se chamar 'para' (já desligado), na mesma posição da lista
+static void renumerar(uint32_t *primeiro, Elemento *elementos, size_t de, size_t para) {
+    elementos[para] = elementos[de];
+    if (elementos[de].celula == SEM_ELEMENTO) return;
+    uint32_t *elo = &primeiro[elementos[de].celula];
+    while (*elo != de) elo = &elementos[*elo].proximo;
+    *elo = (uint32_t)para;
+}
+
+// Limites dos pontos pelas colunas e linhas extremas da grade: a busca para
+// na primeira coluna (ou linha) não vazia a partir de cada borda
+static void recalcular_limites(IndiceEspacial *indice) {
+    const Nivel *nivel = &indice->niveis[0];
+    const Ponto *pontos = indice->grafo->pontos;
+    indice->limites_validos = 0;
+    for (int lado = 0; lado < 4; lado++) {
+        int por_coluna = lado < 2;
+        size_t faixas = por_coluna ? nivel->colunas : nivel->linhas;
+        size_t largura = por_coluna ? nivel->linhas : nivel->colunas;
+        int encontrado = 0;
+        double valor = 0.0;
+        for (size_t f = 0; f < faixas && !encontrado; f++) {
+            size_t faixa = lado % 2 == 0 ? f : faixas - 1 - f;
+            for (size_t j = 0; j < largura; j++) {
+                size_t celula = por_coluna ? j * nivel->colunas + faixa : faixa * nivel->colunas + j;
+                for (uint32_t p = indice->primeiro_ponto[celula]; p != SEM_ELEMENTO; p = indice->pontos[p].proximo) {
+                    double v = por_coluna ? pontos[p].lon : pontos[p].lat;
+                    if (!encontrado || (lado % 2 == 0 ? v < valor : v > valor)) valor = v;
+                    encontrado = 1;
+                }
+            }
+        }
+        if (!encontrado) return;
+        switch (lado) {
+            case 0: indice->min_lon_pontos = valor; break;
+            case 1: indice->max_lon_pontos = valor; break;
+            case 2: indice->min_lat_pontos = valor; break;
+            default: indice->max_lat_pontos = valor; break;
+        }
+    }
+    indice->limites_validos = 1;
+}
+
+// (Re)constrói a grade sobre os limites atuais dos pontos e liga todos os
+// elementos. Retorna 0 ou -1.
+static int montar_grade(IndiceEspacial *indice) {
+    const Ponto *pontos = indice->grafo->pontos;
+    size_t n = indice->num_pontos, validos = 0;
+    double min_lat = 0.0, max_lat = 0.0, min_lon = 0.0, max_lon = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        if (!isfinite(pontos[i].lat) || !isfinite(pontos[i].lon)) continue;
+        if (validos++ == 0) {
+            min_lat = max_lat = pontos[i].lat;
+            min_lon = max_lon = pontos[i].lon;
+            continue;
+        }
+        if (pontos[i].lat < min_lat) min_lat = pontos[i].lat;
+        if (pontos[i].lat > max_lat) max_lat = pontos[i].lat;
+        if (pontos[i].lon < min_lon) min_lon = pontos[i].lon;
+        if (pontos[i].lon > max_lon) max_lon = pontos[i].lon;
+    }
+
+    // Automático: cerca de dois pontos por célula
+    double largura = max_lon - min_lon, altura = max_lat - min_lat;
+    double lado = indice->celula_pedida;
+    if (!(lado > 0.0)) {
+        double alvo = validos > 2 ? validos / 2.0 : 1.0;
+        lado = largura > 0.0 && altura > 0.0 ? sqrt(largura * altura / alvo) : fmax(largura, altura) / alvo;
+        if (!(lado > 0.0)) lado = 1e-3;
+    }
+    // Em grafos espalhados (ou com lado pedido pequeno demais), células maiores
+    while ((largura / lado + 1.0) * (altura / lado + 1.0) > 2.0 * (double)validos + 1024.0) lado *= 2.0;
+
+    indice->min_lon = min_lon;
+    indice->min_lat = min_lat;
+    size_t total = 0, k = 0;
+    size_t colunas = (size_t)(largura / lado) + 1, linhas = (size_t)(altura / lado) + 1;
+    for (;; k++) {
+        indice->niveis[k] = (Nivel){colunas, linhas, total, lado};
+        total += colunas * linhas;
+        if ((colunas == 1 && linhas == 1) || k + 1 == MAX_NIVEIS) break;
+        colunas = (colunas + 1) / 2;
+        linhas = (linhas + 1) / 2;
+        lado *= 2.0;
+    }
+    indice->num_niveis = k + 1;
+    if (total >= SEM_ELEMENTO) return -1;
+
+    free(indice->primeiro_ponto);
+    free(indice->primeiro_segmento);
+    size_t celulas_pontos = indice->niveis[0].colunas * indice->niveis[0].linhas;
+    indice->primeiro_ponto = malloc(celulas_pontos * sizeof(uint32_t));
+    indice->primeiro_segmento = malloc(total * sizeof(uint32_t));
+    if (!indice->primeiro_ponto || !indice->primeiro_segmento) return -1;
+    memset(indice->primeiro_ponto, 0xFF, celulas_pontos * sizeof(uint32_t));
+    memset(indice->primeiro_segmento, 0xFF, total * sizeof(uint32_t));
+
+    // Em ordem decrescente, para que cada lista saia em ordem crescente
+    for (size_t i = n; i-- > 0; ) {
+        uint32_t celula = SEM_ELEMENTO;
+        celula_do_ponto(indice, pontos[i].lat, pontos[i].lon, &celula);
+        ligar(indice->primeiro_ponto, indice->pontos, i, celula);
+    }
+    for (size_t e = indice->num_segmentos; e-- > 0; ) {
+        uint32_t o = indice->pontas[2 * e], d = indice->pontas[2 * e + 1];
+        int dentro = o != SEM_ELEMENTO && d != SEM_ELEMENTO && indice->pontos[o].celula != SEM_ELEMENTO &&
+                     indice->pontos[d].celula != SEM_ELEMENTO;
+        ligar(indice->primeiro_segmento, indice->segmentos, e, dentro ? celula_do_segmento(indice, o, d) : SEM_ELEMENTO);
+    }
+    recalcular_limites(indice);
+    return 0;
+}
+
+void liberar_indice_espacial(IndiceEspacial *indice) {
+    if (indice) {
+        free(indice->primeiro_ponto);
+        free(indice->pontos);
+        free(indice->primeiro_segmento);
+        free(indice->segmentos);
+        free(indice->pontas);
+        free(indice);
+    }
+}
+
+IndiceEspacial* criar_indice_espacial(const Grafo *grafo, double celula_graus) {
+    if (!grafo || grafo->num_pontos >= SEM_ELEMENTO || grafo->num_arestas >= SEM_ELEMENTO) return NULL;
+    IndiceEspacial *indice = calloc(1, sizeof(IndiceEspacial));
+    if (!indice) return NULL;
+    indice->grafo = grafo;
+    indice->celula_pedida = celula_graus;
+    size_t n = grafo->num_pontos, m = grafo->num_arestas;
+    indice->capacidade_pontos = n ? n : 1;
+    indice->capacidade_segmentos = m ? m : 1;
+    indice->pontos = malloc(indice->capacidade_pontos * sizeof(Elemento));
+    indice->segmentos = malloc(indice->capacidade_segmentos * sizeof(Elemento));
+    indice->pontas = malloc(2 * indice->capacidade_segmentos * sizeof(uint32_t));
+    if (!indice->pontos || !indice->segmentos || !indice->pontas) {
+        liberar_indice_espacial(indice);
+        return NULL;
+    }
+    indice->num_pontos = n;
+    indice->num_segmentos = m;
+    for (size_t e = 0; e < m; e++) {
+        ssize_t o = buscar_indice_ponto(grafo, grafo->arestas[e].origem);
+        ssize_t d = buscar_indice_ponto(grafo, grafo->arestas[e].destino);
+        indice->pontas[2 * e] = o >= 0 ? (uint32_t)o : SEM_ELEMENTO;
+        indice->pontas[2 * e + 1] = d >= 0 ? (uint32_t)d : SEM_ELEMENTO;
+    }
+    if (montar_grade(indice) != 0) {
+        liberar_indice_espacial(indice);
+        return NULL;
+    }
+    return indice;
+}
+
+int inserir_ponto_indice(IndiceEspacial *indice, size_t ponto) {
+    if (!indice || ponto != indice->num_pontos || ponto >= indice->grafo->num_pontos ||
+        ponto + 1 >= SEM_ELEMENTO)
+        return -1;
+    if (ponto == indice->capacidade_pontos) {
+        size_t nova = 2 * indice->capacidade_pontos;
+        Elemento *pontos = realloc(indice->pontos, nova * sizeof(Elemento));
+        if (!pontos) return -1;
+        indice->pontos = pontos;
+        indice->capacidade_pontos = nova;
+    }
+    indice->num_pontos++;
+
+    const Ponto *p = &indice->grafo->pontos[ponto];
+    uint32_t celula;
+    if (celula_do_ponto(indice, p->lat, p->lon, &celula) != 0) {
+        // Fora da área coberta: refazer a grade com os novos limites
+        if (isfinite(p->lat) && isfinite(p->lon)) return montar_grade(indice);
+        ligar(indice->primeiro_ponto, indice->pontos, ponto, SEM_ELEMENTO);
+        return 0;
+    }
+    ligar(indice->primeiro_ponto, indice->pontos, ponto, celula);
+    if (indice->limites_validos) {
+        if (p->lat < indice->min_lat_pontos) indice->min_lat_pontos = p->lat;
+        if (p->lat > indice->max_lat_pontos) indice->max_lat_pontos = p->lat;
+        if (p->lon < indice->min_lon_pontos) indice->min_lon_pontos = p->lon;
+        if (p->lon > indice->max_lon_pontos) indice->max_lon_pontos = p->lon;
+    }
+    return 0;
+}
+
+// Segmentos cujas células podem conter algo no retângulo: em cada nível, o
+// retângulo cresce meio lado (mais uma margem para arredondamentos), pois o
+// centro de um segmento do nível fica a no máximo meio lado de qualquer
+// ponto dele
+typedef void (*VisitanteIndice)(const IndiceEspacial *indice, size_t item, void *dados);
+
+static void visitar_segmentos(const IndiceEspacial *indice, double min_lat, double min_lon, double max_lat,
+                              double max_lon, VisitanteIndice visitar, void *dados) {
+    for (size_t k = 0; k < indice->num_niveis; k++) {
+        const Nivel *nivel = &indice->niveis[k];
+        double folga = nivel->lado * (0.5 + 1e-6);
+        size_t c0, c1, l0, l1;
+        if (!faixa_celulas(indice->min_lon, nivel->lado, nivel->colunas, min_lon - folga, max_lon + folga, &c0, &c1) ||
+            !faixa_celulas(indice->min_lat, nivel->lado, nivel->linhas, min_lat - folga, max_lat + folga, &l0, &l1))
+            continue;
+        for (size_t l = l0; l <= l1; l++) {
+            for (size_t c = c0; c <= c1; c++) {
+                uint32_t e = indice->primeiro_segmento[nivel->primeira + l * nivel->colunas + c];
+                for (; e != SEM_ELEMENTO; e = indice->segmentos[e].proximo) visitar(indice, e, dados);
+            }
+        }
+    }
+}
+
+static void visitar_pontos(const IndiceEspacial *indice, double min_lat, double min_lon, double max_lat,
+                           double max_lon, VisitanteIndice visitar, void *dados) {
+    const Nivel *nivel = &indice->niveis[0];
+    size_t c0, c1, l0, l1;
+    if (!faixa_celulas(indice->min_lon, nivel->lado, nivel->colunas, min_lon, max_lon, &c0, &c1) ||
+        !faixa_celulas(indice->min_lat, nivel->lado, nivel->linhas, min_lat, max_lat, &l0, &l1))
+        return;
+    for (size_t l = l0; l <= l1; l++) {
+        for (size_t c = c0; c <= c1; c++) {
+            uint32_t p = indice->primeiro_ponto[l * nivel->colunas + c];
+            for (; p != SEM_ELEMENTO; p = indice->pontos[p].proximo) visitar(indice, p, dados);
+        }
+    }
+}
+
+typedef struct {
+    uint32_t de, para;
+} Renumeracao;
+
+static void renumerar_pontas(const IndiceEspacial *indice, size_t aresta, void *dados) {
+    const Renumeracao *r = dados;
+    uint32_t *pontas = &indice->pontas[2 * aresta];
+    if (pontas[0] == r->de) pontas[0] = r->para;
+    if (pontas[1] == r->de) pontas[1] = r->para;
+}
+
+int remover_ponto_indice(IndiceEspacial *indice, size_t ponto) {
+    if (!indice || ponto >= indice->num_pontos) return -1;
+    size_t ultimo = indice->num_pontos - 1;
+    desligar(indice->primeiro_ponto, indice->pontos, ponto);
+    if (ponto != ultimo) {
+        renumerar(indice->primeiro_ponto, indice->pontos, ultimo, ponto);
+        // Os segmentos que tocam o ponto movido estão nas células em volta dele
+        // (o grafo já o trouxe para a posição removida)
+        const Ponto *p = &indice->grafo->pontos[ponto];
+        Renumeracao r = {(uint32_t)ultimo, (uint32_t)ponto};
+        if (indice->pontos[ponto].celula != SEM_ELEMENTO) {
+            visitar_segmentos(indice, p->lat, p->lon, p->lat, p->lon, renumerar_pontas, &r);
+        }
+    }
+    indice->num_pontos--;
+    indice->limites_validos = 0;
+    return 0;
+}
+
+int inserir_aresta_indice(IndiceEspacial *indice, size_t aresta, size_t origem, size_t destino) {
+    if (!indice || aresta != indice->num_segmentos || aresta + 1 >= SEM_ELEMENTO || origem >= indice->num_pontos ||
+        destino >= indice->num_pontos)
+        return -1;
+    if (aresta == indice->capacidade_segmentos) {
+        size_t nova = 2 * indice->capacidade_segmentos;
+        Elemento *segmentos = realloc(indice->segmentos, nova * sizeof(Elemento));
+        if (!segmentos) return -1;
+        indice->segmentos = segmentos;
+        uint32_t *pontas = realloc(indice->pontas, 2 * nova * sizeof(uint32_t));
+        if (!pontas) return -1;
+        indice->pontas = pontas;
+        indice->capacidade_segmentos = nova;
+    }
+    indice->num_segmentos++;
+    indice->pontas[2 * aresta] = (uint32_t)origem;
+    indice->pontas[2 * aresta + 1] = (uint32_t)destino;
+    int dentro = indice->pontos[origem].celula != SEM_ELEMENTO && indice->pontos[destino].celula != SEM_ELEMENTO;
+    ligar(indice->primeiro_segmento, indice->segmentos, aresta,
+          dentro ? celula_do_segmento(indice, origem, destino) : SEM_ELEMENTO);
+    return 0;
+}
+
+int remover_aresta_indice(IndiceEspacial *indice, size_t aresta) {
+    if (!indice || aresta >= indice->num_segmentos) return -1;
+    size_t ultimo = indice->num_segmentos - 1;
+    desligar(indice->primeiro_segmento, indice->segmentos, aresta);
+    if (aresta != ultimo) {
+        renumerar(indice->primeiro_segmento, indice->segmentos, ultimo, aresta);
+        indice->pontas[2 * aresta] = indice->pontas[2 * ultimo];
+        indice->pontas[2 * aresta + 1] = indice->pontas[2 * ultimo + 1];
+    }
+    indice->num_segmentos--;
+    return 0;
+}
+
+int limites_indice(IndiceEspacial *indice, double *min_lat, double *max_lat, double *min_lon, double *max_lon) {
+    if (!indice || indice->num_pontos == 0) return -1;
+    if (!indice->limites_validos) recalcular_limites(indice);
+    if (!indice->limites_validos) return -1;
+    *min_lat = indice->min_lat_pontos;
+    *max_lat = indice->max_lat_pontos;
+    *min_lon = indice->min_lon_pontos;
+    *max_lon = indice->max_lon_pontos;
+    return 0;
+}
+
+const Grafo* grafo_indice(const IndiceEspacial *indice) {
+    return indice ? indice->grafo : NULL;
+}
+
+int pontas_segmento(const IndiceEspacial *indice, size_t aresta, size_t *origem, size_t *destino) {
+    if (!indice || aresta >= indice->num_segmentos || indice->segmentos[aresta].celula == SEM_ELEMENTO) return -1;
+    size_t a = indice->pontas[2 * aresta], b = indice->pontas[2 * aresta + 1];
+    int invertida = indice->grafo->pontos[a].id != indice->grafo->arestas[aresta].origem;
+    *origem = invertida ? b : a;
+    *destino = invertida ? a : b;
+    return 0;
+}
+
+// Distância da coordenada ao segmento, no plano lon/lat
+static double distancia_segmento(const Ponto *a, const Ponto *b, double lat, double lon) {
+    double dx = b->lon - a->lon, dy = b->lat - a->lat;
+    double c2 = dx * dx + dy * dy;
+    double t = c2 > 0.0 ? ((lon - a->lon) * dx + (lat - a->lat) * dy) / c2 : 0.0;
+    t = t < 0.0 ? 0.0 : t > 1.0 ? 1.0 : t;
+    return hypot(lon - (a->lon + t * dx), lat - (a->lat + t * dy));
+}
+
+// Os k melhores vistos até agora, em ordem de distância
+typedef struct {
+    double lat, lon, raio_max;
+    int segmentos;
+    size_t k, encontrados;
+    size_t *saida;
+    double *distancias;
+} Vizinhos;
+
+static void considerar_vizinho(const IndiceEspacial *indice, size_t item, void *dados) {
+    Vizinhos *v = dados;
+    const Ponto *pontos = indice->grafo->pontos;
+    double d;
+    if (v->segmentos) {
+        d = distancia_segmento(&pontos[indice->pontas[2 * item]], &pontos[indice->pontas[2 * item + 1]], v->lat,
+                               v->lon);
+    } else {
+        d = hypot(pontos[item].lon - v->lon, pontos[item].lat - v->lat);
+    }
+    if (v->raio_max > 0.0 && d > v->raio_max) return;
+    if (v->encontrados == v->k) {
+        double pior = v->distancias[v->k - 1];
+        if (d > pior || (d == pior && item > v->saida[v->k - 1])) return;
+        v->encontrados--;
+    }
+    size_t pos = v->encontrados++;
+    while (pos > 0 && (v->distancias[pos - 1] > d || (v->distancias[pos - 1] == d && v->saida[pos - 1] > item))) {
+        v->distancias[pos] = v->distancias[pos - 1];
+        v->saida[pos] = v->saida[pos - 1];
+        pos--;
+    }
+    v->distancias[pos] = d;
+    v->saida[pos] = item;
+}
+
+static size_t mais_proximos(const IndiceEspacial *indice, int segmentos, double lat, double lon, double raio_max,
+                            size_t k, size_t *saida, double *distancias) {
+    if (!indice || !saida || k == 0 || (segmentos ? indice->num_segmentos : indice->num_pontos) == 0) return 0;
+    double *dist = distancias ? distancias : malloc(k * sizeof(double));
+    if (!dist) return 0;
+    Vizinhos v = {lat, lon, raio_max, segmentos, k, 0, saida, dist};
+
+    // Quadrados crescentes até o k-ésimo caber no raio já coberto (o que está
+    // fora do quadrado fica a mais que r) ou o quadrado cobrir a grade inteira
+    const Nivel *nivel = &indice->niveis[0];
+    double max_lon = indice->min_lon + nivel->colunas * nivel->lado;
+    double max_lat = indice->min_lat + nivel->linhas * nivel->lado;
+    double r = nivel->lado;
+    if (raio_max > 0.0 && raio_max < r) r = raio_max;
+    for (;;) {
+        v.encontrados = 0;
+        if (segmentos) {
+            visitar_segmentos(indice, lat - r, lon - r, lat + r, lon + r, considerar_vizinho, &v);
+        } else {
+            visitar_pontos(indice, lat - r, lon - r, lat + r, lon + r, considerar_vizinho, &v);
+        }
+        if (v.encontrados == k && dist[k - 1] <= r) break;
+        if (lon - r <= indice->min_lon && lon + r >= max_lon && lat - r <= indice->min_lat && lat + r >= max_lat)
+            break;
+        if (!isfinite(r) || (raio_max > 0.0 && r >= raio_max)) break;
+        r *= 2.0;
+        if (raio_max > 0.0 && r > raio_max) r = raio_max;
+    }
+    if (!distancias) free(dist);
+    return v.encontrados;
+}
+
+int ponto_mais_proximo(const IndiceEspacial *indice, double lat, double lon, double raio_max, size_t *ponto) {
+    return mais_proximos(indice, 0, lat, lon, raio_max, 1, ponto, NULL) == 1 ? 0 : -1;
+}
+
+int segmento_mais_proximo(const IndiceEspacial *indice, double lat, double lon, double raio_max, size_t *aresta) {
+    return mais_proximos(indice, 1, lat, lon, raio_max, 1, aresta, NULL) == 1 ? 0 : -1;
+}
+
+size_t pontos_mais_proximos(const IndiceEspacial *indice, double lat, double lon, double raio_max, size_t k,
+                            size_t *saida, double *distancias) {
+    return mais_proximos(indice, 0, lat, lon, raio_max, k, saida, distancias);
+}
+
+size_t segmentos_mais_proximos(const IndiceEspacial *indice, double lat, double lon, double raio_max, size_t k,
+                               size_t *saida, double *distancias) {
+    return mais_proximos(indice, 1, lat, lon, raio_max, k, saida, distancias);
+}
+
+typedef struct {
+    double min_lat, min_lon, max_lat, max_lon;
+    ListaIndices *saida;
+    int erro;
+} Caixa;
+
+static void coletar_ponto(const IndiceEspacial *indice, size_t item, void *dados) {
+    Caixa *caixa = dados;
+    const Ponto *p = &indice->grafo->pontos[item];
+    if (p->lat >= caixa->min_lat && p->lat <= caixa->max_lat && p->lon >= caixa->min_lon && p->lon <= caixa->max_lon &&
+        acrescentar_item(caixa->saida, item) != 0)
+        caixa->erro = 1;
+}
+
+static void coletar_segmento(const IndiceEspacial *indice, size_t item, void *dados) {
+    Caixa *caixa = dados;
+    const Ponto *a = &indice->grafo->pontos[indice->pontas[2 * item]];
+    const Ponto *b = &indice->grafo->pontos[indice->pontas[2 * item + 1]];
+    if (fmax(a->lat, b->lat) >= caixa->min_lat && fmin(a->lat, b->lat) <= caixa->max_lat &&
+        fmax(a->lon, b->lon) >= caixa->min_lon && fmin(a->lon, b->lon) <= caixa->max_lon &&
+        acrescentar_item(caixa->saida, item) != 0)
+        caixa->erro = 1;
+}
+
+int pontos_na_caixa(const IndiceEspacial *indice, double min_lat, double min_lon, double max_lat, double max_lon,
+                    ListaIndices *saida) {
+    if (!indice || !saida) return -1;
+    saida->quantidade = 0;
+    Caixa caixa = {min_lat, min_lon, max_lat, max_lon, saida, 0};
+    visitar_pontos(indice, min_lat, min_lon, max_lat, max_lon, coletar_ponto, &caixa);
+    return caixa.erro ? -1 : 0;
+}
+
+int segmentos_na_caixa(const IndiceEspacial *indice, double min_lat, double min_lon, double max_lat,
+                       double max_lon, ListaIndices *saida) {
+    if (!indice || !saida) return -1;
+    saida->quantidade = 0;
+    Caixa caixa = {min_lat, min_lon, max_lat, max_lon, saida, 0};
+    visitar_segmentos(indice, min_lat, min_lon, max_lat, max_lon, coletar_segmento, &caixa);
+    return caixa.erro ? -1 : 0;
+}
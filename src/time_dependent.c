@@ -0,0 +1,308 @@
+#include "time_dependent.h"
+#include "graph.h"
+#include "components.h"
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NENHUM ((size_t)-1)
+
+TabelaPerfis* criar_tabela_perfis(const Grafo *grafo, double velocidade_kmh) {
+    if (!grafo || !(velocidade_kmh > 0.0)) return NULL;
+    TabelaPerfis *tabela = calloc(1, sizeof(TabelaPerfis));
+    if (!tabela) return NULL;
+    tabela->num_arestas = grafo->num_arestas;
+    tabela->velocidade_kmh = velocidade_kmh;
+    tabela->perfil_aresta = malloc((grafo->num_arestas > 0 ? grafo->num_arestas : 1) * sizeof(uint32_t));
+    tabela->inicio_perfil = malloc(sizeof(size_t));
+    if (!tabela->perfil_aresta || !tabela->inicio_perfil) {
+        liberar_tabela_perfis(tabela);
+        return NULL;
+    }
+    for (size_t i = 0; i < grafo->num_arestas; i++) tabela->perfil_aresta[i] = PERFIL_CONSTANTE;
+    tabela->inicio_perfil[0] = 0;
+    return tabela;
+}
+
+void liberar_tabela_perfis(TabelaPerfis *tabela) {
+    if (tabela) {
+        free(tabela->perfil_aresta);
+        free(tabela->inicio_perfil);
+        free(tabela->pontos);
+        free(tabela->tabela_hash);
+        free(tabela);
+    }
+}
+
+// FNV-1a sobre os pontos do perfil
+static uint64_t hash_perfil(const PontoPerfil *pontos, size_t quantidade) {
+    uint64_t h = 1469598103934665603ULL;
+    for (size_t i = 0; i < quantidade; i++) {
+        uint32_t fator;
+        memcpy(&fator, &pontos[i].fator, sizeof(fator));
+        uint32_t palavras[2] = {pontos[i].instante, fator};
+        const unsigned char *bytes = (const unsigned char *)palavras;
+        for (size_t b = 0; b < sizeof(palavras); b++) {
+            h ^= bytes[b];
+            h *= 1099511628211ULL;
+        }
+    }
+    return h;
+}
+
+static int mesmo_perfil(const TabelaPerfis *tabela, uint32_t perfil, const PontoPerfil *pontos, size_t quantidade) {
+    size_t inicio = tabela->inicio_perfil[perfil];
+    if (tabela->inicio_perfil[perfil + 1] - inicio != quantidade) return 0;
+    for (size_t i = 0; i < quantidade; i++) {
+        if (tabela->pontos[inicio + i].instante != pontos[i].instante ||
+            tabela->pontos[inicio + i].fator != pontos[i].fator) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Dobra a tabela hash (endereçamento aberto) e reinsere os perfis existentes
+static int crescer_hash(TabelaPerfis *tabela) {
+    size_t capacidade = tabela->capacidade_hash ? tabela->capacidade_hash * 2 : 64;
+    uint32_t *slots = calloc(capacidade, sizeof(uint32_t));
+    if (!slots) return -1;
+    for (size_t p = 0; p < tabela->num_perfis; p++) {
+        size_t inicio = tabela->inicio_perfil[p];
+        uint64_t h = hash_perfil(&tabela->pontos[inicio], tabela->inicio_perfil[p + 1] - inicio);
+        size_t s = (size_t)h & (capacidade - 1);
+        while (slots[s]) s = (s + 1) & (capacidade - 1);
+        slots[s] = (uint32_t)p + 1;
+    }
+    free(tabela->tabela_hash);
+    tabela->tabela_hash = slots;
+    tabela->capacidade_hash = capacidade;
+    return 0;
+}
+
+static int perfil_valido(const PontoPerfil *pontos, size_t quantidade) {
+    if (!pontos || quantidade == 0) return 0;
+    for (size_t i = 0; i < quantidade; i++) {
+        if (pontos[i].instante >= SEGUNDOS_POR_DIA) return 0;
+        if (!(pontos[i].fator > 0.0f) || isinf(pontos[i].fator)) return 0;
+        if (i > 0 && pontos[i].instante <= pontos[i - 1].instante) return 0;
+    }
+    return 1;
+}
+
+// Maior queda do fator por segundo entre os trechos do perfil, inclusive o
+// que dá a volta para o dia seguinte (0 se o fator nunca cai)
+static double queda_maxima(const PontoPerfil *pontos, size_t quantidade) {
+    double maior = 0.0;
+    for (size_t i = 0; i < quantidade && quantidade > 1; i++) {
+        const PontoPerfil *a = &pontos[i];
+        const PontoPerfil *b = &pontos[(i + 1) % quantidade];
+        double duracao = (double)b->instante - a->instante;
+        if (duracao <= 0.0) duracao += SEGUNDOS_POR_DIA;
+        double queda = ((double)a->fator - b->fator) / duracao;
+        if (queda > maior) maior = queda;
+    }
+    return maior;
+}
+
+long registrar_perfil(TabelaPerfis *tabela, const PontoPerfil *pontos, size_t quantidade) {
+    if (!tabela || !perfil_valido(pontos, quantidade)) return -1;
+    if (tabela->num_perfis >= PERFIL_CONSTANTE - 1) return -1;
+
+    // Perfil já registrado: reaproveita o id
+    uint64_t h = hash_perfil(pontos, quantidade);
+    if (tabela->capacidade_hash) {
+        size_t s = (size_t)h & (tabela->capacidade_hash - 1);
+        while (tabela->tabela_hash[s]) {
+            uint32_t perfil = tabela->tabela_hash[s] - 1;
+            if (mesmo_perfil(tabela, perfil, pontos, quantidade)) return perfil;
+            s = (s + 1) & (tabela->capacidade_hash - 1);
+        }
+    }
+
+    if (tabela->num_pontos + quantidade > tabela->capacidade_pontos) {
+        size_t capacidade = tabela->capacidade_pontos ? tabela->capacidade_pontos * 2 : 64;
+        while (capacidade < tabela->num_pontos + quantidade) capacidade *= 2;
+        PontoPerfil *novos = realloc(tabela->pontos, capacidade * sizeof(PontoPerfil));
+        if (!novos) return -1;
+        tabela->pontos = novos;
+        tabela->capacidade_pontos = capacidade;
+    }
+    if (tabela->num_perfis + 1 >= tabela->capacidade_perfis) {
+        size_t capacidade = tabela->capacidade_perfis ? tabela->capacidade_perfis * 2 : 16;
+        size_t *novos = realloc(tabela->inicio_perfil, (capacidade + 1) * sizeof(size_t));
+        if (!novos) return -1;
+        tabela->inicio_perfil = novos;
+        tabela->capacidade_perfis = capacidade;
+    }
+    // Mantém a ocupação da tabela hash em no máximo metade
+    if (2 * (tabela->num_perfis + 1) > tabela->capacidade_hash && crescer_hash(tabela) < 0) return -1;
+
+    uint32_t perfil = (uint32_t)tabela->num_perfis;
+    memcpy(&tabela->pontos[tabela->num_pontos], pontos, quantidade * sizeof(PontoPerfil));
+    tabela->num_pontos += quantidade;
+    tabela->num_perfis++;
+    tabela->inicio_perfil[tabela->num_perfis] = tabela->num_pontos;
+
+    size_t s = (size_t)h & (tabela->capacidade_hash - 1);
+    while (tabela->tabela_hash[s]) s = (s + 1) & (tabela->capacidade_hash - 1);
+    tabela->tabela_hash[s] = perfil + 1;
+    return perfil;
+}
+
+int associar_perfil(TabelaPerfis *tabela, const Grafo *grafo, size_t aresta, uint32_t perfil) {
+    if (!tabela || !grafo || aresta >= tabela->num_arestas || aresta >= grafo->num_arestas) return -1;
+    if (perfil != PERFIL_CONSTANTE) {
+        if (perfil >= tabela->num_perfis) return -1;
+        // FIFO: chegada = t + livre * fator(t) não pode diminuir, ou seja, o
+        // fator não pode cair mais rápido que 1 / livre por segundo
+        double livre = grafo->arestas[aresta].peso / tabela->velocidade_kmh * 3600.0;
+        size_t inicio = tabela->inicio_perfil[perfil];
+        if (queda_maxima(&tabela->pontos[inicio], tabela->inicio_perfil[perfil + 1] - inicio) * livre > 1.0) {
+            return -1;
+        }
+    }
+    tabela->perfil_aresta[aresta] = perfil;
+    return 0;
+}
+
+double fator_perfil(const TabelaPerfis *tabela, uint32_t perfil, double instante) {
+    if (!tabela || perfil >= tabela->num_perfis) return 1.0;
+    const PontoPerfil *p = &tabela->pontos[tabela->inicio_perfil[perfil]];
+    size_t n = tabela->inicio_perfil[perfil + 1] - tabela->inicio_perfil[perfil];
+    if (n == 1) return p[0].fator;
+
+    double t = fmod(instante, (double)SEGUNDOS_POR_DIA);
+    if (t < 0.0) t += SEGUNDOS_POR_DIA;
+
+    // Último ponto com instante <= t; antes do primeiro, o trecho que vem do dia anterior
+    size_t baixo = 0, alto = n;
+    while (baixo < alto) {
+        size_t meio = (baixo + alto) / 2;
+        if (p[meio].instante <= t) baixo = meio + 1;
+        else alto = meio;
+    }
+    const PontoPerfil *a, *b;
+    double inicio, fim;
+    if (baixo == 0 || baixo == n) {
+        a = &p[n - 1];
+        b = &p[0];
+        inicio = a->instante;
+        fim = (double)b->instante + SEGUNDOS_POR_DIA;
+        if (baixo == 0) t += SEGUNDOS_POR_DIA;
+    } else {
+        a = &p[baixo - 1];
+        b = &p[baixo];
+        inicio = a->instante;
+        fim = b->instante;
+    }
+    return a->fator + (b->fator - a->fator) * (t - inicio) / (fim - inicio);
+}
+
+double tempo_travessia(const TabelaPerfis *tabela, const Grafo *grafo, size_t aresta, double instante) {
+    if (!tabela || !grafo || aresta >= grafo->num_arestas) return -1.0;
+    double livre = grafo->arestas[aresta].peso / tabela->velocidade_kmh * 3600.0;
+    if (aresta >= tabela->num_arestas || tabela->perfil_aresta[aresta] == PERFIL_CONSTANTE) return livre;
+    return livre * fator_perfil(tabela, tabela->perfil_aresta[aresta], instante);
+}
+
+size_t memoria_tabela_perfis(const TabelaPerfis *tabela) {
+    if (!tabela) return 0;
+    return sizeof(TabelaPerfis) +
+           tabela->num_arestas * sizeof(uint32_t) +
+           (tabela->capacidade_perfis + 1) * sizeof(size_t) +
+           tabela->capacidade_pontos * sizeof(PontoPerfil) +
+           tabela->capacidade_hash * sizeof(uint32_t);
+}
+
+ResultadoDijkstra* dijkstra_dependente_tempo(Grafo *grafo, const TabelaPerfis *tabela,
+                                             long origem_id, long destino_id,
+                                             double partida, double *duracao) {
+    if (duracao) *duracao = -1.0;
+    if (!grafo || !tabela || grafo->num_pontos == 0) return NULL;
+    const IndicesGrafo *indices = obter_indices(grafo);
+    if (!indices) return NULL;
+    ssize_t origem = buscar_indice_ponto(grafo, origem_id);
+    ssize_t destino = buscar_indice_ponto(grafo, destino_id);
+    if (origem < 0 || destino < 0) return NULL;
+
+    ResultadoDijkstra *resultado = calloc(1, sizeof(ResultadoDijkstra));
+    if (!resultado) return NULL;
+    resultado->distancia_total = -1.0;
+    if (!alcance_possivel(grafo, (size_t)origem, (size_t)destino)) return resultado;
+
+    size_t n = grafo->num_pontos;
+    double *chegada = malloc(n * sizeof(double));
+    double *km = malloc(n * sizeof(double));
+    size_t *predecessores = malloc(n * sizeof(size_t));
+    unsigned char *estabelecido = calloc(n, 1);
+    FilaPrioridade *fila = criar_fila_prioridade(64);
+    if (!chegada || !km || !predecessores || !estabelecido || !fila) {
+        free(chegada);
+        free(km);
+        free(predecessores);
+        free(estabelecido);
+        liberar_fila_prioridade(fila);
+        free(resultado);
+        return NULL;
+    }
+    for (size_t i = 0; i < n; i++) {
+        chegada[i] = DBL_MAX;
+        predecessores[i] = NENHUM;
+    }
+
+    // Com FIFO, o Dijkstra sobre instantes de chegada é exato: relaxar um
+    // arco a partir da chegada mais cedo nunca é pior que sair mais tarde
+    chegada[origem] = partida;
+    km[origem] = 0.0;
+    inserir_fila_prioridade(fila, (long)origem, partida);
+    while (!fila_vazia(fila)) {
+        NoFilaPrioridade no = extrair_minimo(fila);
+        size_t atual = (size_t)no.ponto_id;
+        if (estabelecido[atual]) continue;
+        estabelecido[atual] = 1;
+        resultado->nos_visitados++;
+        if (atual == (size_t)destino) break;
+
+        for (size_t k = indices->inicio_arcos[atual]; k < indices->inicio_arcos[atual + 1]; k++) {
+            const Arco *arco = &indices->arcos[k];
+            if (estabelecido[arco->destino]) continue;
+            double tempo = arco->peso / tabela->velocidade_kmh * 3600.0;
+            if (arco->aresta < tabela->num_arestas && tabela->perfil_aresta[arco->aresta] != PERFIL_CONSTANTE) {
+                tempo *= fator_perfil(tabela, tabela->perfil_aresta[arco->aresta], no.distancia);
+            }
+            double nova = no.distancia + tempo;
+            if (nova < chegada[arco->destino]) {
+                chegada[arco->destino] = nova;
+                km[arco->destino] = km[atual] + arco->peso;
+                predecessores[arco->destino] = atual;
+                inserir_fila_prioridade(fila, (long)arco->destino, nova);
+            }
+        }
+    }
+
+    if (estabelecido[destino]) {
+        int contador = 0;
+        for (size_t v = (size_t)destino; v != NENHUM; v = predecessores[v]) contador++;
+        resultado->caminho = malloc(sizeof(long) * contador);
+        if (resultado->caminho) {
+            int posicao = contador - 1;
+            for (size_t v = (size_t)destino; v != NENHUM; v = predecessores[v]) {
+                resultado->caminho[posicao--] = grafo->pontos[v].id;
+            }
+            resultado->tamanho_caminho = contador;
+        }
+        resultado->distancia_total = km[destino];
+        resultado->sucesso = 1;
+        if (duracao) *duracao = chegada[destino] - partida;
+    }
+
+    free(chegada);
+    free(km);
+    free(predecessores);
+    free(estabelecido);
+    liberar_fila_prioridade(fila);
+    return resultado;
+}
@@ -0,0 +1,12 @@
+// clock_gettime() e CLOCK_MONOTONIC são POSIX: com -std=c11 o <time.h> só os
+// declara se a macro vier antes de qualquer inclusão
+#define _POSIX_C_SOURCE 200809L
+
+#include "../include/timing.h"
+#include <time.h>
+
+double agora_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
@@ -0,0 +1,250 @@
+#include "tour.h"
+#include "distance_matrix.h"
+#include "timing.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Custo usado no lugar de pares sem caminho: grande o bastante para que a
+// otimização os evite sempre que houver alternativa
+#define CUSTO_SEM_CAMINHO 1e9
+#define MAX_SEGMENTO_OR_OPT 3
+
+// Estado da melhoria. A ordem tem n + 1 posições: a última é o depósito
+// (circuito) ou um fim virtual de custo zero (caminho aberto), o que deixa
+// 2-opt e Or-opt iguais nos dois casos. ida[k] e volta[k] acumulam o custo
+// dos arcos entre as posições 0..k em cada sentido, para avaliar em O(1)
+// a inversão de um segmento com custos assimétricos.
+typedef struct {
+    size_t n;
+    const double *custos;
+    size_t *ordem;
+    size_t *auxiliar;
+    double *ida;
+    double *volta;
+    double prazo;  // Instante limite (<= 0: sem limite)
+} Otimizador;
+
+static inline double arco(const Otimizador *o, size_t a, size_t b) {
+    if (a == o->n || b == o->n) return 0.0;
+    return o->custos[a * o->n + b];
+}
+
+static void acumular(Otimizador *o) {
+    o->ida[0] = o->volta[0] = 0.0;
+    for (size_t k = 0; k < o->n; k++) {
+        o->ida[k + 1] = o->ida[k] + arco(o, o->ordem[k], o->ordem[k + 1]);
+        o->volta[k + 1] = o->volta[k] + arco(o, o->ordem[k + 1], o->ordem[k]);
+    }
+}
+
+static inline double tolerancia(const Otimizador *o) {
+    return 1e-9 * (1.0 + o->ida[o->n]);
+}
+
+static inline int sem_tempo(const Otimizador *o) {
+    return o->prazo > 0.0 && agora_ms() > o->prazo;
+}
+
+// Ordem inicial: a partir do depósito, sempre a parada não visitada mais
+// barata de alcançar (auxiliar serve de marca de visitada)
+static void vizinho_mais_proximo(Otimizador *o, int circuito) {
+    size_t n = o->n;
+    size_t *visitada = o->auxiliar;
+    memset(visitada, 0, n * sizeof(size_t));
+    o->ordem[0] = 0;
+    visitada[0] = 1;
+    for (size_t k = 1; k < n; k++) {
+        size_t atual = o->ordem[k - 1], melhor = n;
+        for (size_t j = 0; j < n; j++) {
+            if (visitada[j]) continue;
+            if (melhor == n || arco(o, atual, j) < arco(o, atual, melhor)) melhor = j;
+        }
+        visitada[melhor] = 1;
+        o->ordem[k] = melhor;
+    }
+    o->ordem[n] = circuito ? 0 : n;
+}
+
+// Inverte ordem[i+1..j]: troca os arcos (i, i+1) e (j, j+1) por (i, j) e
+// (i+1, j+1). Primeira melhoria; retorna o número de movimentos aplicados
+// ou -1 se o prazo acabou.
+static long passada_2opt(Otimizador *o) {
+    long aplicados = 0;
+    size_t *t = o->ordem;
+    for (size_t i = 0; i + 2 < o->n; i++) {
+        if (sem_tempo(o)) return -1;
+        for (size_t j = i + 2; j < o->n; j++) {
+            double delta = arco(o, t[i], t[j]) + (o->volta[j] - o->volta[i + 1]) + arco(o, t[i + 1], t[j + 1])
+                         - arco(o, t[i], t[i + 1]) - (o->ida[j] - o->ida[i + 1]) - arco(o, t[j], t[j + 1]);
+            if (delta < -tolerancia(o)) {
+                for (size_t a = i + 1, b = j; a < b; a++, b--) {
+                    size_t troca = t[a];
+                    t[a] = t[b];
+                    t[b] = troca;
+                }
+                acumular(o);
+                aplicados++;
+            }
+        }
+    }
+    return aplicados;
+}
+
+// Move o segmento ordem[s..s+L-1] (L = 1..3) para entre as posições k e
+// k + 1, no sentido original ou invertido
+static long passada_or_opt(Otimizador *o) {
+    long aplicados = 0;
+    size_t n = o->n;
+    size_t *t = o->ordem;
+    for (size_t tamanho = 1; tamanho <= MAX_SEGMENTO_OR_OPT; tamanho++) {
+        for (size_t s = 1; s + tamanho <= n; s++) {
+            if (sem_tempo(o)) return -1;
+            size_t fim = s + tamanho - 1;
+            size_t a = t[s], b = t[fim];
+            double remocao = arco(o, t[s - 1], a) + arco(o, b, t[fim + 1]) - arco(o, t[s - 1], t[fim + 1]);
+            double interno = o->ida[fim] - o->ida[s];
+            double interno_invertido = o->volta[fim] - o->volta[s];
+
+            size_t melhor_k = n;
+            int inverter = 0;
+            double melhor_delta = -tolerancia(o);
+            for (size_t k = 0; k < n; k++) {
+                if (k + 1 >= s && k <= fim) continue;
+                double aberto = arco(o, t[k], t[k + 1]);
+                double direto = arco(o, t[k], a) + arco(o, b, t[k + 1]) - aberto - remocao;
+                double invertido = arco(o, t[k], b) + interno_invertido + arco(o, a, t[k + 1])
+                                 - interno - aberto - remocao;
+                if (direto < melhor_delta) {
+                    melhor_delta = direto;
+                    melhor_k = k;
+                    inverter = 0;
+                }
+                if (invertido < melhor_delta) {
+                    melhor_delta = invertido;
+                    melhor_k = k;
+                    inverter = 1;
+                }
+            }
+            if (melhor_k == n) continue;
+
+            // Remonta a ordem em auxiliar: sem o segmento, reinserido após k
+            size_t p = 0;
+            for (size_t k = 0; k <= n; k++) {
+                if (k >= s && k <= fim) continue;
+                o->auxiliar[p++] = t[k];
+                if (k == melhor_k) {
+                    for (size_t m = 0; m < tamanho; m++) {
+                        o->auxiliar[p++] = inverter ? t[fim - m] : t[s + m];
+                    }
+                }
+            }
+            memcpy(t, o->auxiliar, (n + 1) * sizeof(size_t));
+            acumular(o);
+            aplicados++;
+        }
+    }
+    return aplicados;
+}
+
+// Custo real da ordem (-1 se algum arco não tem caminho)
+static double custo_ordem(const Otimizador *o) {
+    double total = 0.0;
+    for (size_t k = 0; k < o->n; k++) {
+        if (o->ordem[k + 1] == o->n) continue;
+        double c = arco(o, o->ordem[k], o->ordem[k + 1]);
+        if (c >= CUSTO_SEM_CAMINHO) return -1.0;
+        total += c;
+    }
+    return total;
+}
+
+void liberar_tour(Tour *tour) {
+    if (tour) {
+        free(tour->ordem);
+        liberar_rota_paradas(tour->rota);
+        free(tour);
+    }
+}
+
+Tour* otimizar_tour(Grafo *grafo, const long *paradas, size_t num_paradas, Metrica metrica,
+                    int circuito, double orcamento_ms) {
+    if (!grafo || !paradas || num_paradas == 0 || (int)metrica < 0 || metrica >= NUM_METRICAS) return NULL;
+    for (size_t i = 0; i < num_paradas; i++) {
+        if (buscar_indice_ponto(grafo, paradas[i]) < 0) return NULL;
+    }
+
+    size_t n = num_paradas;
+    Tour *tour = calloc(1, sizeof(Tour));
+    Otimizador o = {n, NULL, NULL, NULL, NULL, NULL, 0.0};
+    o.ordem = malloc((n + 1) * sizeof(size_t));
+    o.auxiliar = malloc((n + 1) * sizeof(size_t));
+    o.ida = malloc((n + 1) * sizeof(double));
+    o.volta = malloc((n + 1) * sizeof(double));
+    int ok = tour && o.ordem && o.auxiliar && o.ida && o.volta;
+
+    // Matriz de custos: uma busca um-para-muitos por parada (em paralelo),
+    // que para assim que todas as paradas são estabelecidas
+    double inicio = agora_ms();
+    MatrizDistancias *matriz = ok ? matriz_distancias_metrica(grafo, paradas, n, paradas, n, metrica, 0, 0) : NULL;
+    ok = ok && matriz;
+    for (size_t c = 0; ok && c < n * n; c++) {
+        if (matriz->distancias[c] < 0.0) matriz->distancias[c] = CUSTO_SEM_CAMINHO;
+    }
+
+    if (ok) {
+        tour->num_paradas = n;
+        tour->circuito = circuito ? 1 : 0;
+        tour->tempo_matriz_ms = agora_ms() - inicio;
+        o.custos = matriz->distancias;
+
+        inicio = agora_ms();
+        o.prazo = orcamento_ms > 0.0 ? inicio + orcamento_ms : 0.0;
+        vizinho_mais_proximo(&o, tour->circuito);
+        acumular(&o);
+        tour->custo_vizinho = custo_ordem(&o);
+
+        // Alterna as duas vizinhanças até nenhuma melhorar a ordem
+        for (;;) {
+            long melhorias_2opt = passada_2opt(&o);
+            long melhorias_or = melhorias_2opt < 0 ? -1 : passada_or_opt(&o);
+            if (melhorias_2opt > 0) tour->melhorias += (size_t)melhorias_2opt;
+            if (melhorias_or > 0) tour->melhorias += (size_t)melhorias_or;
+            if (melhorias_2opt < 0 || melhorias_or < 0) {
+                tour->tempo_esgotado = 1;
+                break;
+            }
+            if (melhorias_2opt == 0 && melhorias_or == 0) break;
+        }
+        tour->tempo_otimizacao_ms = agora_ms() - inicio;
+        tour->custo = custo_ordem(&o);
+        tour->completo = tour->custo >= 0.0;
+
+        tour->ordem = malloc(n * sizeof(size_t));
+        ok = tour->ordem != NULL;
+        if (ok) memcpy(tour->ordem, o.ordem, n * sizeof(size_t));
+    }
+
+    // Caminho completo na ordem final (mesma métrica, trechos em paralelo)
+    if (ok && tour->completo && n + tour->circuito >= 2) {
+        long *ids = malloc((n + 1) * sizeof(long));
+        ok = ids != NULL;
+        if (ok) {
+            for (size_t k = 0; k < n; k++) ids[k] = paradas[tour->ordem[k]];
+            ids[n] = paradas[0];
+            tour->rota = rota_por_paradas(grafo, ids, n + tour->circuito, metrica, 0);
+            ok = tour->rota != NULL;
+        }
+        free(ids);
+    }
+
+    liberar_matriz_distancias(matriz);
+    free(o.ordem);
+    free(o.auxiliar);
+    free(o.ida);
+    free(o.volta);
+    if (!ok) {
+        liberar_tour(tour);
+        return NULL;
+    }
+    return tour;
+}
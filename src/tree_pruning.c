@@ -0,0 +1,277 @@
+#include "tree_pruning.h"
+#include "graph.h"
+#include "components.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+void liberar_nucleo_roteamento(NucleoRoteamento *nucleo) {
+    if (nucleo) {
+        liberar_grafo_comprimido(nucleo->nucleo_comprimido);
+        liberar_grafo(nucleo->nucleo);
+        free(nucleo->pai);
+        free(nucleo->raiz);
+        free(nucleo->distancia_raiz);
+        free(nucleo->profundidade);
+        free(nucleo);
+    }
+}
+
+NucleoRoteamento* construir_nucleo_roteamento(Grafo *grafo) {
+    if (!grafo) return NULL;
+
+    size_t n = grafo->num_pontos;
+    size_t m = grafo->num_arestas;
+    NucleoRoteamento *nr = calloc(1, sizeof(NucleoRoteamento));
+    ssize_t *origem = malloc((m ? m : 1) * sizeof(ssize_t));
+    ssize_t *destino = malloc((m ? m : 1) * sizeof(ssize_t));
+    size_t *inicio = calloc(n + 1, sizeof(size_t));
+    size_t *incidencia = malloc((2 * m + 1) * sizeof(size_t));
+    size_t *grau = calloc(n ? n : 1, sizeof(size_t));
+    unsigned char *removida = calloc(m ? m : 1, 1);
+    size_t *fila = malloc((n ? n : 1) * sizeof(size_t));   // Ordem de poda
+    double *peso_pai = malloc((n ? n : 1) * sizeof(double));
+    if (nr) {
+        nr->original = grafo;
+        nr->pai = malloc((n ? n : 1) * sizeof(ssize_t));
+        nr->raiz = malloc((n ? n : 1) * sizeof(size_t));
+        nr->distancia_raiz = malloc((n ? n : 1) * sizeof(double));
+        nr->profundidade = malloc((n ? n : 1) * sizeof(size_t));
+    }
+    if (!nr || !origem || !destino || !inicio || !incidencia || !grau || !removida || !fila ||
+        !peso_pai || !nr->pai || !nr->raiz || !nr->distancia_raiz || !nr->profundidade) {
+        liberar_nucleo_roteamento(nr);
+        nr = NULL;
+        goto fim;
+    }
+
+    // Incidência não direcionada; registros com extremos desconhecidos são ignorados
+    for (size_t i = 0; i < m; i++) {
+        origem[i] = buscar_indice_ponto(grafo, grafo->arestas[i].origem);
+        destino[i] = buscar_indice_ponto(grafo, grafo->arestas[i].destino);
+        if (origem[i] < 0 || destino[i] < 0) {
+            removida[i] = 1;
+            continue;
+        }
+        inicio[origem[i] + 1]++;
+        inicio[destino[i] + 1]++;
+        grau[origem[i]]++;
+        grau[destino[i]]++;
+    }
+    for (size_t v = 0; v < n; v++) inicio[v + 1] += inicio[v];
+    {
+        size_t *proximo = malloc((n ? n : 1) * sizeof(size_t));
+        if (!proximo) {
+            liberar_nucleo_roteamento(nr);
+            nr = NULL;
+            goto fim;
+        }
+        memcpy(proximo, inicio, n * sizeof(size_t));
+        for (size_t i = 0; i < m; i++) {
+            if (removida[i]) continue;
+            incidencia[proximo[origem[i]]++] = i;
+            incidencia[proximo[destino[i]]++] = i;
+        }
+        free(proximo);
+    }
+
+    for (size_t v = 0; v < n; v++) nr->pai[v] = -1;
+
+    // Poda: um ponto de grau 1 cuja única via é de mão dupla é uma folha.
+    // A fila cresce enquanto é percorrida, pois podar uma folha pode expor outra.
+    size_t num_fila = 0;
+    for (size_t v = 0; v < n; v++) {
+        if (grau[v] == 1) fila[num_fila++] = v;
+    }
+    size_t num_podados = 0;
+    for (size_t f = 0; f < num_fila; f++) {
+        size_t v = fila[f];
+        if (grau[v] != 1) continue;
+
+        size_t registro = 0;
+        int achou = 0;
+        for (size_t k = inicio[v]; k < inicio[v + 1]; k++) {
+            if (!removida[incidencia[k]]) {
+                registro = incidencia[k];
+                achou = 1;
+                break;
+            }
+        }
+        if (!achou || !grafo->arestas[registro].is_bidirectional) continue;
+        size_t u = (size_t)origem[registro] == v ? (size_t)destino[registro] : (size_t)origem[registro];
+        if (u == v) continue;
+
+        removida[registro] = 1;
+        grau[v] = 0;
+        grau[u]--;
+        nr->pai[v] = (ssize_t)u;
+        peso_pai[v] = grafo->arestas[registro].peso;
+        fila[num_podados++] = v; // Reaproveita o início da fila para guardar a ordem de poda
+        if (grau[u] == 1) fila[num_fila++] = u;
+    }
+    nr->num_podados = num_podados;
+
+    // Raízes e distâncias: o pai de um ponto podado foi podado depois dele
+    // (ou está no núcleo), então percorremos a ordem de poda ao contrário
+    for (size_t v = 0; v < n; v++) {
+        nr->raiz[v] = v;
+        nr->distancia_raiz[v] = 0.0;
+        nr->profundidade[v] = 0;
+    }
+    for (size_t f = num_podados; f-- > 0; ) {
+        size_t v = fila[f];
+        size_t p = (size_t)nr->pai[v];
+        nr->raiz[v] = nr->raiz[p];
+        nr->distancia_raiz[v] = nr->distancia_raiz[p] + peso_pai[v];
+        nr->profundidade[v] = nr->profundidade[p] + 1;
+    }
+
+    // Núcleo: pontos não podados e as arestas que restaram
+    nr->nucleo = criar_grafo_com_capacidade(n - num_podados, m - num_podados);
+    if (!nr->nucleo) {
+        liberar_nucleo_roteamento(nr);
+        nr = NULL;
+        goto fim;
+    }
+    for (size_t v = 0; v < n; v++) {
+        if (nr->pai[v] < 0) nr->nucleo->pontos[nr->nucleo->num_pontos++] = grafo->pontos[v];
+    }
+    invalidar_indices(nr->nucleo);  // Mapa de IDs dos pontos copiados
+    for (size_t i = 0; i < m; i++) {
+        if (!removida[i]) nr->nucleo->arestas[nr->nucleo->num_arestas++] = grafo->arestas[i];
+    }
+
+fim:
+    free(origem);
+    free(destino);
+    free(inicio);
+    free(incidencia);
+    free(grau);
+    free(removida);
+    free(fila);
+    free(peso_pai);
+    return nr;
+}
+
+int comprimir_nucleo_roteamento(NucleoRoteamento *nucleo) {
+    if (!nucleo || !nucleo->nucleo) return -1;
+    liberar_grafo_comprimido(nucleo->nucleo_comprimido);
+    nucleo->nucleo_comprimido = comprimir_grafo(nucleo->nucleo);
+    return nucleo->nucleo_comprimido ? 0 : -1;
+}
+
+// Resultado com o caminho já montado
+static ResultadoDijkstra* criar_resultado(long *caminho, int tamanho, double distancia, int nos_visitados) {
+    ResultadoDijkstra *resultado = malloc(sizeof(ResultadoDijkstra));
+    if (!resultado) {
+        free(caminho);
+        return NULL;
+    }
+    resultado->caminho = caminho;
+    resultado->tamanho_caminho = tamanho;
+    resultado->distancia_total = caminho ? distancia : -1.0;
+    resultado->sucesso = caminho != NULL;
+    resultado->nos_visitados = nos_visitados;
+    return resultado;
+}
+
+// Caminho entre dois pontos da mesma árvore (ou o mesmo ponto do núcleo):
+// passa pelo ancestral comum, sem busca
+static ResultadoDijkstra* caminho_na_arvore(NucleoRoteamento *nr, size_t s, size_t t) {
+    const Ponto *pontos = nr->original->pontos;
+    size_t a = s, b = t;
+    while (nr->profundidade[a] > nr->profundidade[b]) a = (size_t)nr->pai[a];
+    while (nr->profundidade[b] > nr->profundidade[a]) b = (size_t)nr->pai[b];
+    while (a != b) {
+        a = (size_t)nr->pai[a];
+        b = (size_t)nr->pai[b];
+    }
+    size_t ancestral = a;
+    int subida = (int)(nr->profundidade[s] - nr->profundidade[ancestral]);
+    int descida = (int)(nr->profundidade[t] - nr->profundidade[ancestral]);
+    long *caminho = malloc(sizeof(long) * (subida + descida + 1));
+    if (!caminho) return NULL;
+    int pos = 0;
+    for (size_t v = s; v != ancestral; v = (size_t)nr->pai[v]) caminho[pos++] = pontos[v].id;
+    caminho[pos] = pontos[ancestral].id;
+    pos = subida + descida;
+    for (size_t v = t; v != ancestral; v = (size_t)nr->pai[v]) caminho[pos--] = pontos[v].id;
+    double distancia = nr->distancia_raiz[s] + nr->distancia_raiz[t] - 2.0 * nr->distancia_raiz[ancestral];
+    return criar_resultado(caminho, subida + descida + 1, distancia, 0);
+}
+
+// Acrescenta os trechos de árvore (subida até a raiz de s, descida da raiz
+// de t) ao caminho encontrado no núcleo. Consome meio.
+static ResultadoDijkstra* anexar_arvores(NucleoRoteamento *nr, size_t s, size_t t, ResultadoDijkstra *meio) {
+    if (!meio) return NULL;
+    if (!meio->sucesso) return meio;
+
+    const Ponto *pontos = nr->original->pontos;
+    size_t raiz_s = nr->raiz[s], raiz_t = nr->raiz[t];
+    int subida = (int)nr->profundidade[s];
+    int descida = (int)nr->profundidade[t];
+    int tamanho = subida + meio->tamanho_caminho + descida;
+    long *caminho = malloc(sizeof(long) * tamanho);
+    if (!caminho) {
+        liberar_resultado_dijkstra(meio);
+        return NULL;
+    }
+    int pos = 0;
+    for (size_t v = s; v != raiz_s; v = (size_t)nr->pai[v]) caminho[pos++] = pontos[v].id;
+    memcpy(caminho + pos, meio->caminho, sizeof(long) * meio->tamanho_caminho);
+    pos = tamanho - 1;
+    for (size_t v = t; v != raiz_t; v = (size_t)nr->pai[v]) caminho[pos--] = pontos[v].id;
+
+    double distancia = nr->distancia_raiz[s] + meio->distancia_total + nr->distancia_raiz[t];
+    int nos_visitados = meio->nos_visitados;
+    liberar_resultado_dijkstra(meio);
+    return criar_resultado(caminho, tamanho, distancia, nos_visitados);
+}
+
+ResultadoDijkstra* dijkstra_nucleo(NucleoRoteamento *nr, long origem_id, long destino_id) {
+    if (!nr || !nr->original || !nr->nucleo) return NULL;
+
+    ssize_t s = buscar_indice_ponto(nr->original, origem_id);
+    ssize_t t = buscar_indice_ponto(nr->original, destino_id);
+    if (s < 0 || t < 0) return NULL;
+
+    const Ponto *pontos = nr->original->pontos;
+
+    // Mesma árvore (ou mesmo ponto do núcleo): o caminho passa pelo ancestral comum
+    if (nr->raiz[s] == nr->raiz[t]) return caminho_na_arvore(nr, (size_t)s, (size_t)t);
+
+    // Árvores diferentes: subir até a raiz, buscar no núcleo e descer até o destino
+    if (!alcance_possivel(nr->original, (size_t)s, (size_t)t)) {
+        return criar_resultado(NULL, 0, -1.0, 0);
+    }
+    size_t raiz_s = nr->raiz[s], raiz_t = nr->raiz[t];
+    ResultadoDijkstra *meio = nr->nucleo_comprimido
+        ? dijkstra_comprimido(nr->nucleo_comprimido, pontos[raiz_s].id, pontos[raiz_t].id)
+        : dijkstra(nr->nucleo, pontos[raiz_s].id, pontos[raiz_t].id);
+    return anexar_arvores(nr, (size_t)s, (size_t)t, meio);
+}
+
+ResultadoDijkstra* dijkstra_nucleo_incremental(NucleoRoteamento *nr, BuscaIncremental **busca,
+                                               long origem_id, long destino_id) {
+    if (!nr || !nr->original || !nr->nucleo || !busca) return NULL;
+
+    ssize_t s = buscar_indice_ponto(nr->original, origem_id);
+    ssize_t t = buscar_indice_ponto(nr->original, destino_id);
+    if (s < 0 || t < 0) return NULL;
+
+    if (nr->raiz[s] == nr->raiz[t]) return caminho_na_arvore(nr, (size_t)s, (size_t)t);
+    if (!alcance_possivel(nr->original, (size_t)s, (size_t)t)) {
+        return criar_resultado(NULL, 0, -1.0, 0);
+    }
+
+    // A busca roda no núcleo a partir da raiz: origens na mesma árvore
+    // pendurada compartilham o mesmo estado
+    long raiz_s = nr->original->pontos[nr->raiz[s]].id;
+    long raiz_t = nr->original->pontos[nr->raiz[t]].id;
+    if (!*busca || (*busca)->grafo != nr->nucleo || (*busca)->origem_id != raiz_s) {
+        liberar_busca_incremental(*busca);
+        *busca = criar_busca_incremental(nr->nucleo, raiz_s);
+        if (!*busca) return NULL;
+    }
+    return anexar_arvores(nr, (size_t)s, (size_t)t, continuar_busca_incremental(*busca, raiz_t));
+}
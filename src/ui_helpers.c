@@ -1,5 +1,6 @@
 #include "ui_helpers.h"
 #include <gtk/gtk.h>
+#include <stdlib.h>
 
 // Função para atualizar o status bar
 void update_status(AppData *app, const char *message) {
@@ -30,6 +31,23 @@ gboolean is_edge_in_shortest_path(AppData *app, long node1_id, long node2_id) {
     return FALSE;
 }
 
+// Função para obter a rota alternativa (1, 2, ...) que usa uma aresta, ou 0
+size_t alternative_of_edge(AppData *app, long node1_id, long node2_id) {
+    if (!app->alternatives) return 0;
+    
+    // A rota 0 é a mais curta, já desenhada por is_edge_in_shortest_path()
+    for (size_t r = 1; r < app->alternatives->num_rotas; r++) {
+        const ResultadoDijkstra *rota = app->alternatives->rotas[r].caminho;
+        for (int i = 0; i + 1 < rota->tamanho_caminho; i++) {
+            if ((rota->caminho[i] == node1_id && rota->caminho[i + 1] == node2_id) ||
+                (rota->caminho[i] == node2_id && rota->caminho[i + 1] == node1_id)) {
+                return r;
+            }
+        }
+    }
+    return 0;
+}
+
 // Função para atualizar as informações do arquivo
 void update_file_info(AppData *app) {
     if (!app) return;
@@ -53,6 +71,14 @@ void update_file_info(AppData *app) {
                                           app->grafo->num_arestas,
                                           oneway_count,
                                           bidirectional_count);
+            const IndicesGrafo *indices = obter_componentes(app->grafo);
+            if (indices) {
+                gchar *with_components = g_strdup_printf("%s\nComponents: %zu strong, %zu weak", stats,
+                                                         indices->num_componentes_fortes,
+                                                         indices->num_componentes_fracas);
+                g_free(stats);
+                stats = with_components;
+            }
             gtk_label_set_text(GTK_LABEL(app->stats_label), stats);
             g_free(stats);
         } else {
@@ -61,8 +87,158 @@ void update_file_info(AppData *app) {
     }
 }
 
+// Função para descartar estruturas de roteamento derivadas do grafo (após edições)
+void invalidate_routing_data(AppData *app) {
+    if (!app) return;
+    
+    // A busca incremental aponta para o núcleo: sai junto com ele
+    liberar_busca_incremental(app->busca_incremental);
+    app->busca_incremental = NULL;
+    liberar_nucleo_roteamento(app->nucleo_roteamento);
+    app->nucleo_roteamento = NULL;
+    
+    // Os índices da região mudam com o grafo; o espaço de busca é mantido
+    app->isochrone_valid = FALSE;
+    liberar_particao_voronoi(app->voronoi);
+    app->voronoi = NULL;
+    liberar_alternativas(app->alternatives);
+    app->alternatives = NULL;
+    
+    // As projeções guardam índices de arestas, que as edições renumeram
+    app->start_snapped = FALSE;
+    app->end_snapped = FALSE;
+    app->snapped_route = FALSE;
+}
+
+// Função para obter o núcleo de roteamento, reconstruindo-o se necessário
+NucleoRoteamento* get_routing_core(AppData *app) {
+    if (!app || !app->grafo) return NULL;
+    
+    if (!app->nucleo_roteamento) {
+        // Só a poda de becos sem saída: a busca incremental roda no núcleo sem
+        // compressão, então colapsar as cadeias aqui seria trabalho descartado
+        app->nucleo_roteamento = construir_nucleo_roteamento(app->grafo);
+    }
+    return app->nucleo_roteamento;
+}
+
+// Função para obter o índice espacial do grafo, construindo-o se necessário
+IndiceEspacial* get_spatial_index(AppData *app) {
+    if (!app || !app->grafo) return NULL;
+    
+    if (!app->edit_state.indice_espacial) {
+        app->edit_state.indice_espacial = criar_indice_espacial(app->grafo, 0.0);
+    }
+    return app->edit_state.indice_espacial;
+}
+
+// Função para descartar o índice espacial (antes de trocar ou liberar o grafo)
+void discard_spatial_index(AppData *app) {
+    if (!app) return;
+    
+    liberar_indice_espacial(app->edit_state.indice_espacial);
+    app->edit_state.indice_espacial = NULL;
+}
+
+// Função para obter os limites dos pontos do grafo: mantidos pelo índice
+// espacial, com a varredura dos pontos só se ele não puder ser construído
+gboolean get_graph_bounds(AppData *app, double *min_lat, double *max_lat, double *min_lon, double *max_lon) {
+    if (!app || !app->grafo || app->grafo->num_pontos == 0) return FALSE;
+    
+    IndiceEspacial *indice = get_spatial_index(app);
+    if (indice) return limites_indice(indice, min_lat, max_lat, min_lon, max_lon) == 0;
+    
+    *min_lat = 90.0, *max_lat = -90.0;
+    *min_lon = 180.0, *max_lon = -180.0;
+    for (size_t i = 0; i < app->grafo->num_pontos; i++) {
+        Ponto *p = &app->grafo->pontos[i];
+        if (p->lat < *min_lat) *min_lat = p->lat;
+        if (p->lat > *max_lat) *max_lat = p->lat;
+        if (p->lon < *min_lon) *min_lon = p->lon;
+        if (p->lon > *max_lon) *max_lon = p->lon;
+    }
+    return TRUE;
+}
+
+// Função para obter a métrica escolhida no combo (distância se não houver)
+Metrica get_selected_metric(AppData *app) {
+    if (!app || !app->metric_combo) return METRICA_DISTANCIA;
+    
+    gint ativa = gtk_combo_box_get_active(GTK_COMBO_BOX(app->metric_combo));
+    return ativa > 0 && ativa < NUM_METRICAS ? (Metrica)ativa : METRICA_DISTANCIA;
+}
+
+// Função para obter a isócrona do ponto inicial, recalculando-a se necessário
+RegiaoAlcancavel* get_isochrone(AppData *app) {
+    if (!app || !app->grafo || !app->show_isochrone || !app->has_start_point) return NULL;
+    if (app->isochrone_valid) return app->isochrone_region;
+    
+    // Só realoca o espaço quando o número de pontos muda
+    if (app->isochrone_space && app->isochrone_space->num_pontos != app->grafo->num_pontos) {
+        liberar_espaco_busca(app->isochrone_space);
+        app->isochrone_space = NULL;
+    }
+    if (!app->isochrone_space) app->isochrone_space = criar_espaco_busca(app->grafo->num_pontos);
+    if (!app->isochrone_region) app->isochrone_region = criar_regiao_alcancavel();
+    if (!app->isochrone_space || !app->isochrone_region) return NULL;
+    
+    // Alcance em km para distância e em minutos para as métricas de tempo
+    Metrica metrica = get_selected_metric(app);
+    double alcance = app->isochrone_spin ? gtk_spin_button_get_value(GTK_SPIN_BUTTON(app->isochrone_spin)) : 1.0;
+    app->isochrone_space->metrica = metrica;
+    double limite = metrica == METRICA_DISTANCIA ? alcance : alcance * 60.0;
+    if (busca_limitada(app->grafo, app->isochrone_space, app->selected_start_id, limite, app->isochrone_region) != 0) {
+        return NULL;
+    }
+    app->isochrone_valid = TRUE;
+    return app->isochrone_region;
+}
+
+// Função para obter a partição de Voronoi das instalações, recalculando-a se necessário
+ParticaoVoronoi* get_voronoi(AppData *app) {
+    if (!app || !app->grafo || !app->show_voronoi) return NULL;
+    
+    Metrica metrica = get_selected_metric(app);
+    if (app->voronoi && app->voronoi->metrica == metrica) return app->voronoi;
+    liberar_particao_voronoi(app->voronoi);
+    
+    // Instalações cujo ponto foi apagado na edição saem da lista
+    size_t validas = 0;
+    for (size_t i = 0; i < app->num_facilities; i++) {
+        if (buscar_indice_ponto(app->grafo, app->facility_ids[i]) >= 0) {
+            app->facility_ids[validas++] = app->facility_ids[i];
+        }
+    }
+    app->num_facilities = validas;
+    
+    app->voronoi = particao_voronoi(app->grafo, app->facility_ids, app->num_facilities, metrica);
+    return app->voronoi;
+}
+
+// Função para marcar ou desmarcar um ponto como instalação
+void toggle_facility(AppData *app, long long id) {
+    if (!app) return;
+    
+    liberar_particao_voronoi(app->voronoi);
+    app->voronoi = NULL;
+    
+    for (size_t i = 0; i < app->num_facilities; i++) {
+        if (app->facility_ids[i] == id) {
+            app->facility_ids[i] = app->facility_ids[--app->num_facilities];
+            return;
+        }
+    }
+    
+    long *ids = realloc(app->facility_ids, (app->num_facilities + 1) * sizeof(long));
+    if (!ids) return;
+    app->facility_ids = ids;
+    app->facility_ids[app->num_facilities++] = id;
+}
+
 // Função para limpar dados da aplicação
 void cleanup_app_data(AppData *app) {
+    invalidate_routing_data(app);
+    discard_spatial_index(app);
     if (app->grafo) {
         liberar_grafo(app->grafo);
     }
@@ -73,10 +249,6 @@ void cleanup_app_data(AppData *app) {
 Ponto* buscar_ponto_por_id(Grafo *grafo, long long id) {
     if (!grafo) return NULL;
     
-    for (size_t i = 0; i < grafo->num_pontos; i++) {
-        if (grafo->pontos[i].id == id) {
-            return &grafo->pontos[i];
-        }
-    }
-    return NULL;
+    ssize_t indice = buscar_indice_ponto(grafo, id);
+    return indice >= 0 ? &grafo->pontos[indice] : NULL;
 }
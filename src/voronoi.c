@@ -0,0 +1,100 @@
+#include "voronoi.h"
+#include "dijkstra.h"
+#include "metrics.h"
+#include <stdlib.h>
+
+void liberar_particao_voronoi(ParticaoVoronoi *particao) {
+    if (particao) {
+        free(particao->pontos_fonte);
+        free(particao->dono);
+        free(particao->custos);
+        free(particao->tamanho_celula);
+        free(particao);
+    }
+}
+
+ParticaoVoronoi* particao_voronoi(Grafo *grafo, const long *fontes, size_t num_fontes, Metrica metrica) {
+    if (!grafo || (num_fontes && !fontes) || num_fontes >= SEM_DONO) return NULL;
+    const IndicesGrafo *indices = obter_indices(grafo);
+    const double *pesos = obter_pesos_metrica(grafo, metrica);
+    if (!indices || !pesos) return NULL;
+
+    size_t n = grafo->num_pontos;
+    ParticaoVoronoi *particao = calloc(1, sizeof(ParticaoVoronoi));
+    if (!particao) return NULL;
+    particao->num_pontos = n;
+    particao->num_fontes = num_fontes;
+    particao->metrica = metrica;
+    particao->pontos_fonte = malloc((num_fontes ? num_fontes : 1) * sizeof(size_t));
+    particao->dono = malloc((n ? n : 1) * sizeof(uint32_t));
+    particao->custos = malloc((n ? n : 1) * sizeof(double));
+    particao->tamanho_celula = calloc(num_fontes ? num_fontes : 1, sizeof(size_t));
+    unsigned char *estabelecido = calloc(n ? n : 1, 1);
+    FilaPrioridade *fila = criar_fila_prioridade(num_fontes > 64 ? (int)num_fontes : 64);
+    if (!particao->pontos_fonte || !particao->dono || !particao->custos ||
+        !particao->tamanho_celula || !estabelecido || !fila) {
+        free(estabelecido);
+        liberar_fila_prioridade(fila);
+        liberar_particao_voronoi(particao);
+        return NULL;
+    }
+    for (size_t v = 0; v < n; v++) {
+        particao->dono[v] = SEM_DONO;
+        particao->custos[v] = -1.0;
+    }
+
+    // Todas as fontes entram na fila a custo 0; uma fonte repetida fica com
+    // a primeira posição
+    for (size_t f = 0; f < num_fontes; f++) {
+        ssize_t ponto = buscar_indice_ponto(grafo, fontes[f]);
+        if (ponto < 0) {
+            free(estabelecido);
+            liberar_fila_prioridade(fila);
+            liberar_particao_voronoi(particao);
+            return NULL;
+        }
+        particao->pontos_fonte[f] = (size_t)ponto;
+        if (particao->dono[ponto] != SEM_DONO) continue;
+        particao->dono[ponto] = (uint32_t)f;
+        particao->custos[ponto] = 0.0;
+        inserir_fila_prioridade(fila, (long)ponto, 0.0);
+    }
+
+    size_t atribuidos = 0;
+    while (!fila_vazia(fila)) {
+        size_t atual = (size_t)extrair_minimo(fila).ponto_id;
+        if (estabelecido[atual]) continue;
+        estabelecido[atual] = 1;
+        atribuidos++;
+        uint32_t dono = particao->dono[atual];
+        particao->tamanho_celula[dono]++;
+
+        double base = particao->custos[atual];
+        for (size_t k = indices->inicio_arcos[atual]; k < indices->inicio_arcos[atual + 1]; k++) {
+            size_t vizinho = indices->arcos[k].destino;
+            if (estabelecido[vizinho]) continue;
+            double nova = base + pesos[k];
+            double anterior = particao->custos[vizinho];
+            if (anterior < 0.0 || nova < anterior) {
+                particao->custos[vizinho] = nova;
+                particao->dono[vizinho] = dono;
+                inserir_fila_prioridade(fila, (long)vizinho, nova);
+            } else if (nova == anterior && dono < particao->dono[vizinho]) {
+                // Empate: a chave na fila não muda, só o dono
+                particao->dono[vizinho] = dono;
+            }
+        }
+    }
+    particao->num_inalcancaveis = n - atribuidos;
+
+    free(estabelecido);
+    liberar_fila_prioridade(fila);
+    return particao;
+}
+
+long fonte_mais_proxima(const Grafo *grafo, const ParticaoVoronoi *particao, long ponto_id) {
+    if (!grafo || !particao || particao->num_pontos != grafo->num_pontos) return -1;
+    ssize_t ponto = buscar_indice_ponto(grafo, ponto_id);
+    if (ponto < 0 || particao->dono[ponto] == SEM_DONO) return -1;
+    return grafo->pontos[particao->pontos_fonte[particao->dono[ponto]]].id;
+}
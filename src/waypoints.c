@@ -0,0 +1,89 @@
+#include "waypoints.h"
+#include "batch_query.h"
+#include <stdlib.h>
+
+void liberar_rota_paradas(RotaParadas *rota) {
+    if (rota) {
+        liberar_resultado_dijkstra(rota->rota);
+        free(rota->custos_trechos);
+        free(rota->inicio_trechos);
+        free(rota);
+    }
+}
+
+RotaParadas* rota_por_paradas(Grafo *grafo, const long *paradas, size_t num_paradas,
+                              Metrica metrica, int num_threads) {
+    if (!grafo || !paradas || num_paradas < 2) return NULL;
+    for (size_t i = 0; i < num_paradas; i++) {
+        if (buscar_indice_ponto(grafo, paradas[i]) < 0) return NULL;
+    }
+
+    size_t num_trechos = num_paradas - 1;
+    ParConsulta *pares = malloc(num_trechos * sizeof(ParConsulta));
+    if (!pares) return NULL;
+    for (size_t t = 0; t < num_trechos; t++) {
+        pares[t].origem = paradas[t];
+        pares[t].destino = paradas[t + 1];
+    }
+    ResultadoLote *lote = executar_lote_metrica(grafo, pares, num_trechos, metrica, num_threads);
+    free(pares);
+    if (!lote) return NULL;
+
+    RotaParadas *rota = calloc(1, sizeof(RotaParadas));
+    if (rota) {
+        rota->num_trechos = num_trechos;
+        rota->trecho_falho = num_trechos;
+        rota->custos_trechos = malloc(num_trechos * sizeof(double));
+        rota->inicio_trechos = malloc(num_trechos * sizeof(int));
+        rota->rota = calloc(1, sizeof(ResultadoDijkstra));
+    }
+    if (!rota || !rota->custos_trechos || !rota->inicio_trechos || !rota->rota) {
+        liberar_resultado_lote(lote);
+        liberar_rota_paradas(rota);
+        return NULL;
+    }
+
+    // Tamanho final: cada trecho contribui com seus pontos menos a junção
+    // com o anterior
+    int tamanho = 1;
+    double total = 0.0;
+    for (size_t t = 0; t < num_trechos; t++) {
+        const ResultadoDijkstra *r = lote->consultas[t].resultado;
+        rota->rota->nos_visitados += r ? r->nos_visitados : 0;
+        if (!r || !r->sucesso) {
+            rota->custos_trechos[t] = -1.0;
+            if (rota->trecho_falho == num_trechos) rota->trecho_falho = t;
+            continue;
+        }
+        rota->custos_trechos[t] = r->distancia_total;
+        total += r->distancia_total;
+        tamanho += r->tamanho_caminho - 1;
+    }
+
+    if (rota->trecho_falho == num_trechos) {
+        rota->rota->caminho = malloc((size_t)tamanho * sizeof(long));
+        if (!rota->rota->caminho) {
+            liberar_resultado_lote(lote);
+            liberar_rota_paradas(rota);
+            return NULL;
+        }
+        int posicao = 0;
+        for (size_t t = 0; t < num_trechos; t++) {
+            const ResultadoDijkstra *r = lote->consultas[t].resultado;
+            // A partir do segundo trecho, o primeiro ponto é a junção já copiada
+            rota->inicio_trechos[t] = t == 0 ? 0 : posicao - 1;
+            for (int i = t == 0 ? 0 : 1; i < r->tamanho_caminho; i++) {
+                rota->rota->caminho[posicao++] = r->caminho[i];
+            }
+        }
+        rota->rota->tamanho_caminho = tamanho;
+        rota->rota->distancia_total = total;
+        rota->rota->sucesso = 1;
+    } else {
+        rota->rota->distancia_total = -1.0;
+        for (size_t t = 0; t < num_trechos; t++) rota->inicio_trechos[t] = -1;
+    }
+
+    liberar_resultado_lote(lote);
+    return rota;
+}
@@ -0,0 +1,106 @@
+/**
+ * Benchmark: rotas alternativas (Yen com A* guiado pela busca reversa a
+ * partir do destino). Para cada consulta mostra o tempo de cada rota, o
+ * número de buscas (desvios de Yen + penalidade) e os pontos estabelecidos
+ * por busca, e compara com o custo estimado de refazer um dijkstra() do zero
+ * a cada busca (tempo médio de dijkstra() entre pares sorteados x buscas).
+ *
+ * Uso: ./bench_alternatives [arquivo.osm | lado_da_grade] [k] [max_sobreposicao]
+ * Sem argumentos, usa uma grade sintética 300x300, k = 3 e sobreposição 0.8.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/osm_reader.h"
+#include "../include/graph.h"
+#include "../include/dijkstra.h"
+#include "../include/reorder.h"
+#include "../include/components.h"
+#include "../include/alternatives.h"
+#include "../include/timing.h"
+#include "fixtures.h"
+
+int main(int argc, char *argv[]) {
+    Grafo *grafo = NULL;
+    if (argc > 1 && strstr(argv[1], ".osm")) {
+        grafo = ler_osm(argv[1]);
+    } else {
+        int lado = argc > 1 ? atoi(argv[1]) : 300;
+        grafo = criar_grade(lado > 1 ? lado : 300, 29);
+    }
+    if (!grafo || grafo->num_pontos == 0) {
+        printf("ERROR: Failed to build graph\n");
+        return 1;
+    }
+    size_t k = argc > 2 ? (size_t)atoi(argv[2]) : 3;
+    if (k < 1) k = 3;
+    double max_sobreposicao = argc > 3 ? atof(argv[3]) : 0.8;
+
+    reordenar_hilbert(grafo);
+    const IndicesGrafo *indices = obter_componentes(grafo);
+    if (!indices) {
+        printf("ERROR: Failed to compute components\n");
+        return 1;
+    }
+    long *conexos = malloc(grafo->num_pontos * sizeof(long));
+    size_t num_conexos = 0;
+    for (size_t v = 0; v < grafo->num_pontos; v++) {
+        if (indices->componente_forte[v] == indices->maior_componente_forte) conexos[num_conexos++] = grafo->pontos[v].id;
+    }
+
+    // Custo de uma busca do zero: dijkstra() entre pares sorteados
+    unsigned int estado = 5;
+    const int amostras = 10;
+    double inicio = agora_ms();
+    for (int q = 0; q < amostras; q++) {
+        long a = conexos[proximo_aleatorio(&estado) % num_conexos];
+        long b = conexos[proximo_aleatorio(&estado) % num_conexos];
+        liberar_resultado_dijkstra(dijkstra(grafo, a, b));
+    }
+    double por_busca = (agora_ms() - inicio) / amostras;
+
+    printf("=== Alternative Routes Benchmark ===\n");
+    printf("Graph: %zu nodes, %zu edges; k = %zu, max overlap %.0f%%\n", grafo->num_pontos, grafo->num_arestas,
+           k, max_sobreposicao * 100.0);
+    printf("dijkstra() from scratch: %.1f ms per search\n\n", por_busca);
+    printf("%-6s %10s %-28s %10s %14s %12s %14s\n", "Query", "Best (km)", "Per route (ms)", "Spur+pen",
+           "Settled/search", "Total (ms)", "Scratch* (ms)");
+
+    double total_yen = 0.0, total_zero = 0.0;
+    for (int q = 0; q < 10; q++) {
+        long origem = conexos[proximo_aleatorio(&estado) % num_conexos];
+        long destino = conexos[proximo_aleatorio(&estado) % num_conexos];
+        inicio = agora_ms();
+        Alternativas *alt = rotas_alternativas(grafo, origem, destino, k, METRICA_DISTANCIA, max_sobreposicao);
+        double tempo = agora_ms() - inicio;
+        if (!alt || alt->num_rotas == 0) {
+            printf("%-6d no route\n", q + 1);
+            liberar_alternativas(alt);
+            continue;
+        }
+
+        char tempos[64] = "";
+        for (size_t r = 0; r < alt->num_rotas; r++) {
+            size_t usado = strlen(tempos);
+            snprintf(tempos + usado, sizeof(tempos) - usado, "%s%.1f", r ? " / " : "", alt->rotas[r].tempo_ms);
+        }
+        // Todas as buscas A* (desvios de Yen e por penalidade) mais a reversa
+        size_t buscas = alt->buscas_desvio + alt->buscas_penalidade + 1;
+        double zero = por_busca * (double)buscas;
+        char desvios[32];
+        snprintf(desvios, sizeof(desvios), "%zu+%zu", alt->buscas_desvio, alt->buscas_penalidade);
+        printf("%-6d %10.2f %-28s %10s %14.0f %12.1f %14.0f\n", q + 1, alt->rotas[0].caminho->distancia_total,
+               tempos, desvios, (double)alt->pontos_estabelecidos / buscas, tempo, zero);
+        total_yen += tempo;
+        total_zero += zero;
+        liberar_alternativas(alt);
+    }
+    printf("\nTotal: %.0f ms with reverse-tree A* searches vs ~%.0f ms rerunning dijkstra() per search (%.0fx)\n",
+           total_yen, total_zero, total_zero / total_yen);
+    printf("* Estimated: searches x mean dijkstra() time.\n");
+
+    free(conexos);
+    liberar_grafo(grafo);
+    return 0;
+}
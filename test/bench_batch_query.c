@@ -0,0 +1,94 @@
+/**
+ * Benchmark: vazão do motor de consultas em lote (pares origem/destino
+ * distribuídos com roubo de trabalho) de 1 a N threads, contra chamadas
+ * sequenciais de dijkstra().
+ *
+ * Uso: ./bench_batch_query [arquivo.osm | lado_da_grade] [num_consultas] [max_threads]
+ * Sem argumentos, usa uma grade sintética 300x300, 2000 consultas e até 8 threads.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../include/osm_reader.h"
+#include "../include/graph.h"
+#include "../include/dijkstra.h"
+#include "../include/reorder.h"
+#include "../include/components.h"
+#include "../include/batch_query.h"
+#include "../include/timing.h"
+#include "fixtures.h"
+
+int main(int argc, char *argv[]) {
+    Grafo *grafo = NULL;
+    if (argc > 1 && strstr(argv[1], ".osm")) {
+        grafo = ler_osm(argv[1]);
+    } else {
+        int lado = argc > 1 ? atoi(argv[1]) : 300;
+        grafo = criar_grade(lado > 1 ? lado : 300, 29);
+    }
+    if (!grafo || grafo->num_pontos == 0) {
+        printf("ERROR: Failed to build graph\n");
+        return 1;
+    }
+    int num_consultas = argc > 2 ? atoi(argv[2]) : 2000;
+    if (num_consultas < 1) num_consultas = 2000;
+    int max_threads = argc > 3 ? atoi(argv[3]) : 8;
+    if (max_threads < 1) max_threads = 8;
+
+    reordenar_hilbert(grafo);
+    obter_componentes(grafo);
+
+    ParConsulta *pares = malloc(num_consultas * sizeof(ParConsulta));
+    unsigned int estado = 3;
+    for (int q = 0; q < num_consultas; q++) {
+        pares[q].origem = grafo->pontos[proximo_aleatorio(&estado) % grafo->num_pontos].id;
+        pares[q].destino = grafo->pontos[proximo_aleatorio(&estado) % grafo->num_pontos].id;
+    }
+
+    printf("=== Batch Query Benchmark ===\n");
+    printf("Graph: %zu nodes, %zu edges, %d queries\n\n", grafo->num_pontos, grafo->num_arestas, num_consultas);
+
+    double *distancias = malloc(num_consultas * sizeof(double));
+    double inicio = agora_ms();
+    for (int q = 0; q < num_consultas; q++) {
+        ResultadoDijkstra *r = dijkstra(grafo, pares[q].origem, pares[q].destino);
+        distancias[q] = (r && r->sucesso) ? r->distancia_total : -1.0;
+        liberar_resultado_dijkstra(r);
+    }
+    double tempo_sequencial = agora_ms() - inicio;
+    printf("%-26s %10.2f ms %10.1f queries/s\n", "Sequential dijkstra():", tempo_sequencial,
+           num_consultas / (tempo_sequencial / 1000.0));
+
+    int divergencias = 0;
+    double tempo_uma = 0.0;
+    for (int t = 1; t <= max_threads; t *= 2) {
+        ResultadoLote *lote = executar_lote(grafo, pares, num_consultas, t);
+        if (!lote) {
+            printf("ERROR: Batch failed\n");
+            return 1;
+        }
+        if (t == 1) tempo_uma = lote->tempo_total_ms;
+        double mais_lenta = 0.0, soma = 0.0;
+        for (int q = 0; q < num_consultas; q++) {
+            const ResultadoConsulta *c = &lote->consultas[q];
+            double d = (c->resultado && c->resultado->sucesso) ? c->resultado->distancia_total : -1.0;
+            if (fabs(d - distancias[q]) > 1e-9) divergencias++;
+            soma += c->tempo_ms;
+            if (c->tempo_ms > mais_lenta) mais_lenta = c->tempo_ms;
+        }
+        printf("Batch %2d thread(s):        %10.2f ms %10.1f queries/s  %5.2fx vs 1 thread  "
+               "(mean %.3f ms, max %.3f ms, %zu steals)\n",
+               t, lote->tempo_total_ms, num_consultas / (lote->tempo_total_ms / 1000.0),
+               tempo_uma / lote->tempo_total_ms, soma / num_consultas, mais_lenta, lote->roubos);
+        liberar_resultado_lote(lote);
+    }
+
+    printf("\n%s Batch distances identical to sequential dijkstra() (%d mismatches)\n",
+           divergencias ? "✗" : "✓", divergencias);
+    free(distancias);
+    free(pares);
+    liberar_grafo(grafo);
+    return divergencias ? 1 : 0;
+}
@@ -0,0 +1,107 @@
+/**
+ * Benchmark: memória por aresta e tempo de consulta da adjacência compacta
+ * (delta + varint, pesos em decímetros) contra a adjacência CSR.
+ *
+ * Uso: ./bench_compact_adjacency [arquivo.osm | lado_da_grade] [num_consultas]
+ * Sem argumentos, usa uma grade sintética 500x500 com 20% de vias de mão única.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../include/osm_reader.h"
+#include "../include/graph.h"
+#include "../include/dijkstra.h"
+#include "../include/reorder.h"
+#include "../include/compact_graph.h"
+#include "../include/timing.h"
+#include "fixtures.h"
+
+int main(int argc, char *argv[]) {
+    Grafo *grafo = NULL;
+    if (argc > 1 && strstr(argv[1], ".osm")) {
+        grafo = ler_osm(argv[1]);
+    } else {
+        int lado = argc > 1 ? atoi(argv[1]) : 500;
+        grafo = criar_grade_mao_unica(lado > 1 ? lado : 500, 11, 5, 1.0);
+    }
+    if (!grafo || grafo->num_pontos == 0) {
+        printf("ERROR: Failed to build graph\n");
+        return 1;
+    }
+    int num_consultas = argc > 2 ? atoi(argv[2]) : 100;
+    if (num_consultas < 1) num_consultas = 100;
+
+    // Mesma ordem usada pela interface: vizinhos próximos têm índices próximos
+    reordenar_hilbert(grafo);
+
+    printf("=== Compressed Adjacency Benchmark ===\n");
+    printf("Graph: %zu nodes, %zu edges, %d queries\n\n", grafo->num_pontos, grafo->num_arestas, num_consultas);
+
+    double inicio = agora_ms();
+    const IndicesGrafo *indices = obter_indices(grafo);
+    double tempo_csr = agora_ms() - inicio;
+    inicio = agora_ms();
+    AdjacenciaCompacta *compacta = compactar_adjacencia(grafo);
+    double tempo_compacta = agora_ms() - inicio;
+    if (!indices || !compacta) {
+        printf("ERROR: Failed to build adjacency\n");
+        return 1;
+    }
+
+    double m = (double)grafo->num_arestas;
+    size_t bytes_arestas = grafo->num_arestas * sizeof(Aresta);
+    size_t bytes_csr = (indices->num_pontos + 1) * sizeof(size_t) + indices->num_arcos * sizeof(Arco);
+    size_t bytes_compacta = bytes_adjacencia_compacta(compacta);
+    printf("%-22s %12s %12s %10s\n", "", "bytes", "bytes/edge", "build ms");
+    printf("%-22s %12zu %12.2f %10s\n", "Aresta records:", bytes_arestas, bytes_arestas / m, "-");
+    printf("%-22s %12zu %12.2f %10.2f\n", "CSR adjacency:", bytes_csr, bytes_csr / m, tempo_csr);
+    printf("%-22s %12zu %12.2f %10.2f\n", "Compressed adjacency:", bytes_compacta, bytes_compacta / m, tempo_compacta);
+    printf("  (encoded lists: %.2f bytes per entry, %zu entries)\n\n",
+           (double)compacta->tamanho_dados / (compacta->num_entradas ? compacta->num_entradas : 1),
+           compacta->num_entradas);
+
+    size_t *pares = malloc(2 * num_consultas * sizeof(size_t));
+    unsigned int estado = 5;
+    for (int q = 0; q < 2 * num_consultas; q++) {
+        pares[q] = proximo_aleatorio(&estado) % grafo->num_pontos;
+    }
+
+    double *distancias = malloc(num_consultas * sizeof(double));
+    int *tamanhos = malloc(num_consultas * sizeof(int));
+    inicio = agora_ms();
+    for (int q = 0; q < num_consultas; q++) {
+        ResultadoDijkstra *r = dijkstra(grafo, grafo->pontos[pares[2 * q]].id, grafo->pontos[pares[2 * q + 1]].id);
+        distancias[q] = (r && r->sucesso) ? r->distancia_total : -1.0;
+        tamanhos[q] = r ? r->tamanho_caminho : 0;
+        liberar_resultado_dijkstra(r);
+    }
+    double tempo_consultas_csr = agora_ms() - inicio;
+
+    int divergencias = 0;
+    inicio = agora_ms();
+    for (int q = 0; q < num_consultas; q++) {
+        ResultadoDijkstra *r = dijkstra_compacto(compacta, grafo, pares[2 * q], pares[2 * q + 1]);
+        double d = (r && r->sucesso) ? r->distancia_total : -1.0;
+        // Cada aresta do caminho acumula no máximo meio decímetro de arredondamento
+        double tolerancia = (tamanhos[q] + 1) * 0.00005 + 1e-9;
+        if ((d < 0) != (distancias[q] < 0) || fabs(d - distancias[q]) > tolerancia) divergencias++;
+        liberar_resultado_dijkstra(r);
+    }
+    double tempo_consultas_compacta = agora_ms() - inicio;
+
+    printf("%-22s %10.2f ms total %8.3f ms/query\n", "CSR Dijkstra:",
+           tempo_consultas_csr, tempo_consultas_csr / num_consultas);
+    printf("%-22s %10.2f ms total %8.3f ms/query\n", "Compressed Dijkstra:",
+           tempo_consultas_compacta, tempo_consultas_compacta / num_consultas);
+    printf("\n%s Distances agree within quantization (%d mismatches)\n",
+           divergencias ? "✗" : "✓", divergencias);
+
+    free(pares);
+    free(distancias);
+    free(tamanhos);
+    liberar_adjacencia_compacta(compacta);
+    liberar_grafo(grafo);
+    return divergencias ? 1 : 0;
+}
@@ -0,0 +1,75 @@
+/**
+ * Benchmark: escalabilidade do delta-stepping paralelo de 1 a N threads,
+ * comparado a um Dijkstra completo a partir da mesma origem.
+ *
+ * Uso: ./bench_delta_stepping [arquivo.osm | lado_da_grade] [max_threads] [delta_km]
+ * Sem argumentos, usa uma grade sintética 1000x1000 e até 8 threads.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include "../include/osm_reader.h"
+#include "../include/graph.h"
+#include "../include/dijkstra.h"
+#include "../include/reorder.h"
+#include "../include/delta_stepping.h"
+#include "../include/timing.h"
+#include "fixtures.h"
+
+int main(int argc, char *argv[]) {
+    Grafo *grafo = NULL;
+    if (argc > 1 && strstr(argv[1], ".osm")) {
+        grafo = ler_osm(argv[1]);
+    } else {
+        int lado = argc > 1 ? atoi(argv[1]) : 1000;
+        grafo = criar_grade(lado > 1 ? lado : 1000, 17);
+    }
+    if (!grafo || grafo->num_pontos == 0) {
+        printf("ERROR: Failed to build graph\n");
+        return 1;
+    }
+    int max_threads = argc > 2 ? atoi(argv[2]) : 8;
+    if (max_threads < 1) max_threads = 8;
+    double delta = argc > 3 ? atof(argv[3]) : 0.0;
+
+    reordenar_hilbert(grafo);
+    obter_indices(grafo); // Construção dos índices fora da medição
+    long origem = grafo->pontos[grafo->num_pontos / 2].id;
+
+    printf("=== Delta-Stepping Scaling Benchmark ===\n");
+    printf("Graph: %zu nodes, %zu edges, delta %s\n\n", grafo->num_pontos, grafo->num_arestas,
+           delta > 0.0 ? argv[3] : "auto");
+
+    double inicio = agora_ms();
+    double *referencia = dijkstra_distancias(grafo, origem);
+    double tempo_dijkstra = agora_ms() - inicio;
+    printf("%-22s %10.2f ms\n", "Dijkstra (1 thread):", tempo_dijkstra);
+
+    int divergencias = 0;
+    double tempo_uma = 0.0;
+    for (int t = 1; t <= max_threads; t *= 2) {
+        inicio = agora_ms();
+        double *distancias = delta_stepping(grafo, origem, delta, t);
+        double tempo = agora_ms() - inicio;
+        if (t == 1) tempo_uma = tempo;
+        int iguais = distancias != NULL;
+        for (size_t i = 0; iguais && i < grafo->num_pontos; i++) {
+            if ((referencia[i] == DBL_MAX) != (distancias[i] == DBL_MAX) ||
+                (referencia[i] != DBL_MAX && fabs(referencia[i] - distancias[i]) > 1e-9 * (1.0 + referencia[i]))) {
+                iguais = 0;
+            }
+        }
+        if (!iguais) divergencias++;
+        printf("Delta-stepping %2d thr: %10.2f ms   speedup %5.2fx vs 1 thread, %5.2fx vs Dijkstra %s\n",
+               t, tempo, tempo_uma / tempo, tempo_dijkstra / tempo, iguais ? "" : "(MISMATCH)");
+        free(distancias);
+    }
+
+    printf("\n%s Distance arrays identical to Dijkstra\n", divergencias ? "✗" : "✓");
+    free(referencia);
+    liberar_grafo(grafo);
+    return divergencias ? 1 : 0;
+}
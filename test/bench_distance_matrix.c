@@ -0,0 +1,105 @@
+/**
+ * Benchmark: tabelas de distância 100x100 e 1000x1000 pela API de matriz
+ * (uma busca por origem, com parada quando todos os destinos são
+ * estabelecidos) contra uma chamada de dijkstra() por par.
+ *
+ * Uso: ./bench_distance_matrix [arquivo.osm | lado_da_grade] [max_threads]
+ * Sem argumentos, usa uma grade sintética 300x300 e até 4 threads.
+ * Por par, dijkstra() é medido numa amostra e extrapolado para a tabela.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../include/osm_reader.h"
+#include "../include/graph.h"
+#include "../include/dijkstra.h"
+#include "../include/reorder.h"
+#include "../include/components.h"
+#include "../include/distance_matrix.h"
+#include "../include/timing.h"
+#include "fixtures.h"
+
+#define AMOSTRA_POR_PAR 200
+
+static int medir_tabela(Grafo *grafo, size_t tamanho, int max_threads) {
+    unsigned int estado = (unsigned int)tamanho;
+    long *origens = malloc(tamanho * sizeof(long));
+    long *destinos = malloc(tamanho * sizeof(long));
+    for (size_t i = 0; i < tamanho; i++) {
+        origens[i] = grafo->pontos[proximo_aleatorio(&estado) % grafo->num_pontos].id;
+        destinos[i] = grafo->pontos[proximo_aleatorio(&estado) % grafo->num_pontos].id;
+    }
+
+    printf("--- %zu x %zu table ---\n", tamanho, tamanho);
+
+    // Uma chamada de dijkstra() por par, numa amostra de pares
+    double inicio = agora_ms();
+    double *esperado = malloc(AMOSTRA_POR_PAR * sizeof(double));
+    size_t *celulas = malloc(AMOSTRA_POR_PAR * sizeof(size_t));
+    for (int q = 0; q < AMOSTRA_POR_PAR; q++) {
+        size_t i = proximo_aleatorio(&estado) % tamanho, j = proximo_aleatorio(&estado) % tamanho;
+        celulas[q] = i * tamanho + j;
+        ResultadoDijkstra *r = dijkstra(grafo, origens[i], destinos[j]);
+        esperado[q] = (r && r->sucesso) ? r->distancia_total : -1.0;
+        liberar_resultado_dijkstra(r);
+    }
+    double por_par = (agora_ms() - inicio) / AMOSTRA_POR_PAR;
+    double estimado = por_par * tamanho * tamanho;
+    printf("%-24s %12.2f ms (estimated from %d pairs, %.3f ms/pair)\n",
+           "dijkstra() per pair:", estimado, AMOSTRA_POR_PAR, por_par);
+
+    int divergencias = 0;
+    double tempo_uma = 0.0;
+    for (int t = 1; t <= max_threads; t *= 2) {
+        inicio = agora_ms();
+        MatrizDistancias *m = matriz_distancias(grafo, origens, tamanho, destinos, tamanho, 0, t);
+        double tempo = agora_ms() - inicio;
+        if (t == 1) tempo_uma = tempo;
+        int erros = !m;
+        for (int q = 0; m && q < AMOSTRA_POR_PAR; q++) {
+            if (fabs(m->distancias[celulas[q]] - esperado[q]) > 1e-9) erros++;
+        }
+        divergencias += erros;
+        printf("Matrix API %2d thread(s): %12.2f ms   %6.1fx vs per pair, %5.2fx vs 1 thread %s\n",
+               t, tempo, estimado / tempo, tempo_uma / tempo, erros ? "(MISMATCH)" : "");
+        liberar_matriz_distancias(m);
+    }
+    printf("\n");
+
+    free(esperado);
+    free(celulas);
+    free(origens);
+    free(destinos);
+    return divergencias;
+}
+
+int main(int argc, char *argv[]) {
+    Grafo *grafo = NULL;
+    if (argc > 1 && strstr(argv[1], ".osm")) {
+        grafo = ler_osm(argv[1]);
+    } else {
+        int lado = argc > 1 ? atoi(argv[1]) : 300;
+        grafo = criar_grade(lado > 1 ? lado : 300, 23);
+    }
+    if (!grafo || grafo->num_pontos == 0) {
+        printf("ERROR: Failed to build graph\n");
+        return 1;
+    }
+    int max_threads = argc > 2 ? atoi(argv[2]) : 4;
+    if (max_threads < 1) max_threads = 4;
+
+    reordenar_hilbert(grafo);
+    obter_componentes(grafo); // Índices e componentes fora da medição
+
+    printf("=== Distance Matrix Benchmark ===\n");
+    printf("Graph: %zu nodes, %zu edges\n\n", grafo->num_pontos, grafo->num_arestas);
+
+    int divergencias = medir_tabela(grafo, 100, max_threads);
+    divergencias += medir_tabela(grafo, 1000, max_threads);
+
+    printf("%s Sampled cells identical to dijkstra() (%d mismatches)\n", divergencias ? "✗" : "✓", divergencias);
+    liberar_grafo(grafo);
+    return divergencias ? 1 : 0;
+}
@@ -0,0 +1,157 @@
+/**
+ * Benchmark: tempo de consulta e falhas de cache do Dijkstra antes e depois
+ * da reordenação dos pontos pela curva de Hilbert.
+ *
+ * Uso: ./bench_hilbert_reorder [arquivo.osm | lado_da_grade] [num_consultas]
+ * Sem argumentos, usa uma grade sintética 400x400 com pontos embaralhados.
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../include/osm_reader.h"
+#include "../include/graph.h"
+#include "../include/dijkstra.h"
+#include "../include/reorder.h"
+#include "../include/timing.h"
+#include "fixtures.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Contador de falhas de cache via perf_event_open (-1 se indisponível)
+static int abrir_contador_cache(void) {
+#ifdef __linux__
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+    return -1;
+#endif
+}
+
+static void iniciar_contador(int fd) {
+#ifdef __linux__
+    if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#else
+    (void)fd;
+#endif
+}
+
+static long long parar_contador(int fd) {
+#ifdef __linux__
+    long long valor = -1;
+    if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(fd, &valor, sizeof(valor)) != sizeof(valor)) valor = -1;
+    }
+    return valor;
+#else
+    (void)fd;
+    return -1;
+#endif
+}
+
+// Grade lado x lado com pontos gravados em ordem aleatória (como IDs de um
+// arquivo OSM sem relação com a geografia)
+static Grafo* criar_grade_embaralhada(int lado) {
+    Grafo *grafo = criar_grade(lado, 42);
+    if (!grafo) return NULL;
+    unsigned int estado = 42;
+    for (size_t i = grafo->num_pontos; i-- > 1;) {
+        size_t j = proximo_aleatorio(&estado) % (i + 1);
+        Ponto t = grafo->pontos[i];
+        grafo->pontos[i] = grafo->pontos[j];
+        grafo->pontos[j] = t;
+    }
+    invalidar_indices(grafo);
+    return grafo;
+}
+
+static void executar_consultas(Grafo *grafo, long *pares, int num_consultas, double *distancias,
+                               const char *rotulo, int fd) {
+    obter_indices(grafo); // Construção dos índices fora da medição
+    iniciar_contador(fd);
+    double inicio = agora_ms();
+    for (int q = 0; q < num_consultas; q++) {
+        ResultadoDijkstra *r = dijkstra(grafo, pares[2 * q], pares[2 * q + 1]);
+        distancias[q] = (r && r->sucesso) ? r->distancia_total : -1.0;
+        liberar_resultado_dijkstra(r);
+    }
+    double total = agora_ms() - inicio;
+    long long falhas = parar_contador(fd);
+    if (falhas >= 0) {
+        printf("%-18s %10.2f ms total %8.3f ms/query %14lld cache misses\n",
+               rotulo, total, total / num_consultas, falhas);
+    } else {
+        printf("%-18s %10.2f ms total %8.3f ms/query %14s\n",
+               rotulo, total, total / num_consultas, "(perf n/a)");
+    }
+}
+
+int main(int argc, char *argv[]) {
+    Grafo *grafo = NULL;
+    if (argc > 1 && strstr(argv[1], ".osm")) {
+        grafo = ler_osm(argv[1]);
+    } else {
+        int lado = argc > 1 ? atoi(argv[1]) : 400;
+        grafo = criar_grade_embaralhada(lado > 1 ? lado : 400);
+    }
+    if (!grafo || grafo->num_pontos == 0) {
+        printf("ERROR: Failed to build graph\n");
+        return 1;
+    }
+    int num_consultas = argc > 2 ? atoi(argv[2]) : 50;
+    if (num_consultas < 1) num_consultas = 50;
+
+    printf("=== Hilbert Reordering Benchmark ===\n");
+    printf("Graph: %zu nodes, %zu edges, %d queries\n\n", grafo->num_pontos, grafo->num_arestas, num_consultas);
+
+    long *pares = malloc(2 * num_consultas * sizeof(long));
+    double *antes = malloc(num_consultas * sizeof(double));
+    double *depois = malloc(num_consultas * sizeof(double));
+    unsigned int estado = 7;
+    for (int q = 0; q < 2 * num_consultas; q++) {
+        pares[q] = grafo->pontos[proximo_aleatorio(&estado) % grafo->num_pontos].id;
+    }
+
+    int fd = abrir_contador_cache();
+    executar_consultas(grafo, pares, num_consultas, antes, "File order:", fd);
+
+    double inicio = agora_ms();
+    reordenar_hilbert(grafo);
+    printf("%-18s %10.2f ms\n", "Reorder pass:", agora_ms() - inicio);
+
+    executar_consultas(grafo, pares, num_consultas, depois, "Hilbert order:", fd);
+
+    int divergencias = 0;
+    for (int q = 0; q < num_consultas; q++) {
+        if (fabs(antes[q] - depois[q]) > 1e-9) divergencias++;
+    }
+    printf("\n%s Distances identical before/after reordering (%d mismatches)\n",
+           divergencias ? "✗" : "✓", divergencias);
+
+#ifdef __linux__
+    if (fd >= 0) close(fd);
+#endif
+    free(pares);
+    free(antes);
+    free(depois);
+    liberar_grafo(grafo);
+    return divergencias ? 1 : 0;
+}
@@ -0,0 +1,118 @@
+/**
+ * Benchmark: isócronas repetidas com a origem em movimento. Compara a busca
+ * limitada com espaço reaproveitado (trabalho proporcional à região) contra
+ * a mesma busca com vetores do tamanho do grafo alocados e inicializados a
+ * cada consulta, como em dijkstra().
+ *
+ * Uso: ./bench_isochrone [arquivo.osm | lado_da_grade] [num_consultas]
+ * Sem argumentos, usa uma grade sintética 1000x1000 e 200 consultas para
+ * alcances de 0.5, 2 e 8 km.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include "../include/osm_reader.h"
+#include "../include/graph.h"
+#include "../include/dijkstra.h"
+#include "../include/reorder.h"
+#include "../include/distance_matrix.h"
+#include "../include/isochrone.h"
+#include "../include/timing.h"
+#include "fixtures.h"
+
+// Mesma busca limitada, mas com vetores alocados e preenchidos a cada consulta
+static size_t busca_limitada_alocando(Grafo *grafo, long origem_id, double limite) {
+    const IndicesGrafo *indices = obter_indices(grafo);
+    size_t n = grafo->num_pontos;
+    double *distancias = malloc(n * sizeof(double));
+    unsigned char *estabelecido = calloc(n, 1);
+    for (size_t v = 0; v < n; v++) distancias[v] = DBL_MAX;
+    FilaPrioridade *fila = criar_fila_prioridade(64);
+    size_t origem = (size_t)buscar_indice_ponto(grafo, origem_id);
+    distancias[origem] = 0.0;
+    inserir_fila_prioridade(fila, (long)origem, 0.0);
+    size_t alcancados = 0;
+    while (!fila_vazia(fila)) {
+        NoFilaPrioridade no = extrair_minimo(fila);
+        size_t atual = (size_t)no.ponto_id;
+        if (estabelecido[atual]) continue;
+        estabelecido[atual] = 1;
+        alcancados++;
+        for (size_t k = indices->inicio_arcos[atual]; k < indices->inicio_arcos[atual + 1]; k++) {
+            size_t vizinho = indices->arcos[k].destino;
+            double nova = no.distancia + indices->arcos[k].peso;
+            if (!estabelecido[vizinho] && nova < distancias[vizinho] && nova <= limite) {
+                distancias[vizinho] = nova;
+                inserir_fila_prioridade(fila, (long)vizinho, nova);
+            }
+        }
+    }
+    liberar_fila_prioridade(fila);
+    free(estabelecido);
+    free(distancias);
+    return alcancados;
+}
+
+int main(int argc, char *argv[]) {
+    Grafo *grafo = NULL;
+    if (argc > 1 && strstr(argv[1], ".osm")) {
+        grafo = ler_osm(argv[1]);
+    } else {
+        int lado = argc > 1 ? atoi(argv[1]) : 1000;
+        grafo = criar_grade(lado > 1 ? lado : 1000, 29);
+    }
+    if (!grafo || grafo->num_pontos == 0) {
+        printf("ERROR: Failed to build graph\n");
+        return 1;
+    }
+    int num_consultas = argc > 2 ? atoi(argv[2]) : 200;
+    if (num_consultas < 1) num_consultas = 200;
+
+    reordenar_hilbert(grafo);
+    obter_indices(grafo);
+
+    // Origem "arrastada": cada consulta parte de um vizinho da anterior
+    long *origens = malloc(num_consultas * sizeof(long));
+    unsigned int estado = 7;
+    size_t atual = proximo_aleatorio(&estado) % grafo->num_pontos;
+    for (int q = 0; q < num_consultas; q++) {
+        const IndicesGrafo *indices = grafo->indices;
+        size_t grau = indices->inicio_arcos[atual + 1] - indices->inicio_arcos[atual];
+        if (grau > 0) atual = indices->arcos[indices->inicio_arcos[atual] + proximo_aleatorio(&estado) % grau].destino;
+        origens[q] = grafo->pontos[atual].id;
+    }
+
+    EspacoBusca *espaco = criar_espaco_busca(grafo->num_pontos);
+    RegiaoAlcancavel *regiao = criar_regiao_alcancavel();
+
+    printf("=== Isochrone Benchmark ===\n");
+    printf("Graph: %zu nodes, %zu edges, %d queries per range\n\n",
+           grafo->num_pontos, grafo->num_arestas, num_consultas);
+    printf("%-10s %12s %14s %16s %10s\n", "Range", "Avg points", "Reused (ms)", "Allocating (ms)", "Speedup");
+
+    const double alcances[] = {0.5, 2.0, 8.0};
+    for (size_t a = 0; a < sizeof(alcances) / sizeof(alcances[0]); a++) {
+        size_t total_pontos = 0;
+        double inicio = agora_ms();
+        for (int q = 0; q < num_consultas; q++) {
+            busca_limitada(grafo, espaco, origens[q], alcances[a], regiao);
+            total_pontos += regiao->num_pontos;
+        }
+        double reaproveitado = agora_ms() - inicio;
+
+        inicio = agora_ms();
+        for (int q = 0; q < num_consultas; q++) busca_limitada_alocando(grafo, origens[q], alcances[a]);
+        double alocando = agora_ms() - inicio;
+
+        printf("%-7.1f km %12.0f %14.4f %16.4f %9.1fx\n", alcances[a], (double)total_pontos / num_consultas,
+               reaproveitado / num_consultas, alocando / num_consultas, alocando / reaproveitado);
+    }
+
+    free(origens);
+    liberar_espaco_busca(espaco);
+    liberar_regiao_alcancavel(regiao);
+    liberar_grafo(grafo);
+    return 0;
+}
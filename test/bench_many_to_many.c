@@ -0,0 +1,91 @@
+/**
+ * Benchmark: tabelas de distância 100x100 e 1000x1000 pelo algoritmo de
+ * baldes sobre a hierarquia de contração, contra uma busca por origem
+ * (matriz_distancias). Inclui o tempo de pré-processamento.
+ *
+ * Uso: ./bench_many_to_many [arquivo.osm | lado_da_grade] [num_threads]
+ * Sem argumentos, usa uma grade sintética 200x200 e uma thread.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../include/osm_reader.h"
+#include "../include/graph.h"
+#include "../include/reorder.h"
+#include "../include/components.h"
+#include "../include/distance_matrix.h"
+#include "../include/contraction.h"
+#include "../include/timing.h"
+#include "fixtures.h"
+
+static int medir_tabela(Grafo *grafo, const HierarquiaContracao *h, size_t tamanho, int num_threads) {
+    unsigned int estado = (unsigned int)tamanho * 3;
+    long *origens = malloc(tamanho * sizeof(long));
+    long *destinos = malloc(tamanho * sizeof(long));
+    for (size_t i = 0; i < tamanho; i++) {
+        origens[i] = grafo->pontos[proximo_aleatorio(&estado) % grafo->num_pontos].id;
+        destinos[i] = grafo->pontos[proximo_aleatorio(&estado) % grafo->num_pontos].id;
+    }
+
+    double inicio = agora_ms();
+    MatrizDistancias *simples = matriz_distancias(grafo, origens, tamanho, destinos, tamanho, 0, num_threads);
+    double tempo_simples = agora_ms() - inicio;
+    inicio = agora_ms();
+    MatrizDistancias *baldes = matriz_distancias_hierarquia(h, grafo, origens, tamanho, destinos, tamanho, 0, num_threads);
+    double tempo_baldes = agora_ms() - inicio;
+
+    int divergencias = !simples || !baldes;
+    for (size_t c = 0; !divergencias && c < tamanho * tamanho; c++) {
+        if (fabs(simples->distancias[c] - baldes->distancias[c]) > 1e-9) divergencias++;
+    }
+    printf("--- %zu x %zu table ---\n", tamanho, tamanho);
+    printf("%-28s %12.2f ms\n", "One search per source:", tempo_simples);
+    printf("%-28s %12.2f ms   %6.1fx faster %s\n\n", "Bucket many-to-many (CH):", tempo_baldes,
+           tempo_simples / tempo_baldes, divergencias ? "(MISMATCH)" : "");
+
+    liberar_matriz_distancias(simples);
+    liberar_matriz_distancias(baldes);
+    free(origens);
+    free(destinos);
+    return divergencias;
+}
+
+int main(int argc, char *argv[]) {
+    Grafo *grafo = NULL;
+    if (argc > 1 && strstr(argv[1], ".osm")) {
+        grafo = ler_osm(argv[1]);
+    } else {
+        int lado = argc > 1 ? atoi(argv[1]) : 200;
+        grafo = criar_grade(lado > 1 ? lado : 200, 23);
+    }
+    if (!grafo || grafo->num_pontos == 0) {
+        printf("ERROR: Failed to build graph\n");
+        return 1;
+    }
+    int num_threads = argc > 2 ? atoi(argv[2]) : 1;
+    if (num_threads < 1) num_threads = 1;
+
+    reordenar_hilbert(grafo);
+    obter_componentes(grafo);
+
+    printf("=== Many-to-Many Benchmark ===\n");
+    printf("Graph: %zu nodes, %zu edges, %d thread(s)\n\n", grafo->num_pontos, grafo->num_arestas, num_threads);
+
+    double inicio = agora_ms();
+    HierarquiaContracao *h = construir_hierarquia(grafo);
+    if (!h) {
+        printf("ERROR: Failed to build hierarchy\n");
+        return 1;
+    }
+    printf("Hierarchy: %zu shortcuts, preprocessing %.2f ms\n\n", h->num_atalhos, agora_ms() - inicio);
+
+    int divergencias = medir_tabela(grafo, h, 100, num_threads);
+    divergencias += medir_tabela(grafo, h, 1000, num_threads);
+
+    printf("%s Tables identical to per-source searches\n", divergencias ? "✗" : "✓");
+    liberar_hierarquia(h);
+    liberar_grafo(grafo);
+    return divergencias ? 1 : 0;
+}
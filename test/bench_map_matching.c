@@ -0,0 +1,195 @@
+/**
+ * Benchmark: vazão do casamento de trajetos GPS (HMM/Viterbi) em leituras
+ * por segundo, de 1 a N threads, e o efeito do cache de buscas limitadas
+ * (com cache contra só a última busca reaproveitada).
+ *
+ * Uso: ./bench_map_matching [arquivo.osm [trajetos.gpx] | lado_da_grade] [num_trajetos] [max_threads]
+ * Sem argumentos, usa uma grade sintética 200x200 com vias de ~55 m, 300
+ * trajetos sintéticos (rotas sorteadas, uma leitura a cada 15 m com ruído
+ * de 5 m) e até 8 threads.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../include/osm_reader.h"
+#include "../include/graph.h"
+#include "../include/dijkstra.h"
+#include "../include/reorder.h"
+#include "../include/components.h"
+#include "../include/map_matching.h"
+#include "../include/timing.h"
+#include "fixtures.h"
+
+#define METROS_POR_GRAU (6371000.0 * 3.14159265358979323846 / 180.0)
+
+static double ruido(unsigned int *estado, double sigma) {
+    double u1 = (proximo_aleatorio(estado) % 1000000 + 1) / 1000001.0;
+    double u2 = (proximo_aleatorio(estado) % 1000000) / 1000000.0;
+    return sigma * sqrt(-2.0 * log(u1)) * cos(2.0 * 3.14159265358979323846 * u2);
+}
+
+// Grade com pesos iguais ao comprimento das vias (o modelo compara rede e
+// linha reta) e uma via de mão única a cada sete
+static Grafo* criar_grade_vias(int lado) {
+    Grafo *grafo = criar_grade(lado, 29);
+    if (!grafo) return NULL;
+    unsigned int estado = 29;
+    double vertical = 0.0005 * METROS_POR_GRAU / 1000.0;
+    double horizontal = vertical * cos(16.7 * 3.14159265358979323846 / 180.0);
+    for (size_t e = 0; e < grafo->num_arestas; e++) {
+        Aresta *a = &grafo->arestas[e];
+        a->peso = a->destino - a->origem == 1 ? horizontal : vertical;
+        a->is_bidirectional = proximo_aleatorio(&estado) % 7 != 0;
+    }
+    invalidar_indices(grafo);
+    return grafo;
+}
+
+// Leituras a cada 15 m ao longo do caminho, com ruído de 5 m
+static TrajetoGPS amostrar_caminho(Grafo *grafo, const long *caminho, int tamanho, unsigned int *estado) {
+    size_t capacidade = 256;
+    TrajetoGPS t = {malloc(capacidade * sizeof(PontoGPS)), 0};
+    double sobra = 0.0;
+    for (int i = 0; i + 1 < tamanho; i++) {
+        const Ponto *a = &grafo->pontos[buscar_indice_ponto(grafo, caminho[i])];
+        const Ponto *b = &grafo->pontos[buscar_indice_ponto(grafo, caminho[i + 1])];
+        double cos_lat = cos(a->lat * 3.14159265358979323846 / 180.0);
+        double dx = (b->lon - a->lon) * METROS_POR_GRAU * cos_lat, dy = (b->lat - a->lat) * METROS_POR_GRAU;
+        double comprimento = hypot(dx, dy);
+        for (double s = sobra; s < comprimento; s += 15.0) {
+            if (t.num_pontos == capacidade) {
+                capacidade *= 2;
+                t.pontos = realloc(t.pontos, capacidade * sizeof(PontoGPS));
+            }
+            double f = s / comprimento;
+            t.pontos[t.num_pontos].lat = a->lat + f * (b->lat - a->lat) + ruido(estado, 5.0) / METROS_POR_GRAU;
+            t.pontos[t.num_pontos].lon = a->lon + f * (b->lon - a->lon) +
+                                         ruido(estado, 5.0) / (METROS_POR_GRAU * cos_lat);
+            t.num_pontos++;
+            sobra = s + 15.0 - comprimento;
+        }
+    }
+    return t;
+}
+
+int main(int argc, char *argv[]) {
+    Grafo *grafo = NULL;
+    const char *arquivo_gpx = NULL;
+    int arg = 1;
+    if (argc > arg && strstr(argv[arg], ".osm")) {
+        grafo = ler_osm(argv[arg++]);
+        if (argc > arg && strstr(argv[arg], ".gpx")) arquivo_gpx = argv[arg++];
+    } else {
+        int lado = argc > arg ? atoi(argv[arg++]) : 200;
+        grafo = criar_grade_vias(lado > 1 ? lado : 200);
+    }
+    if (!grafo || grafo->num_pontos == 0) {
+        printf("ERROR: Failed to build graph\n");
+        return 1;
+    }
+    size_t num_trajetos = argc > arg ? (size_t)atoi(argv[arg++]) : 300;
+    int max_threads = argc > arg ? atoi(argv[arg++]) : 8;
+    if (num_trajetos < 1) num_trajetos = 300;
+    if (max_threads < 1) max_threads = 8;
+
+    reordenar_hilbert(grafo);
+    ConjuntoTrajetos *conjunto = NULL;
+    if (arquivo_gpx) {
+        conjunto = ler_trajetos_gpx(arquivo_gpx);
+        if (!conjunto) {
+            printf("ERROR: Failed to read %s\n", arquivo_gpx);
+            return 1;
+        }
+    } else {
+        // Rotas sorteadas dentro da maior componente forte
+        const IndicesGrafo *indices = obter_componentes(grafo);
+        if (!indices) {
+            printf("ERROR: Failed to compute components\n");
+            return 1;
+        }
+        long *conexos = malloc(grafo->num_pontos * sizeof(long));
+        size_t num_conexos = 0;
+        for (size_t v = 0; v < grafo->num_pontos; v++) {
+            if (indices->componente_forte[v] == indices->maior_componente_forte) conexos[num_conexos++] = grafo->pontos[v].id;
+        }
+        conjunto = calloc(1, sizeof(ConjuntoTrajetos));
+        conjunto->trajetos = calloc(num_trajetos, sizeof(TrajetoGPS));
+        unsigned int estado = 47;
+        while (conjunto->num_trajetos < num_trajetos) {
+            long a = conexos[proximo_aleatorio(&estado) % num_conexos];
+            long b = conexos[proximo_aleatorio(&estado) % num_conexos];
+            ResultadoDijkstra *rota = dijkstra(grafo, a, b);
+            if (rota && rota->sucesso && rota->tamanho_caminho > 1) {
+                conjunto->trajetos[conjunto->num_trajetos++] =
+                    amostrar_caminho(grafo, rota->caminho, rota->tamanho_caminho, &estado);
+            }
+            liberar_resultado_dijkstra(rota);
+        }
+        free(conexos);
+    }
+    size_t total_leituras = 0;
+    for (size_t t = 0; t < conjunto->num_trajetos; t++) total_leituras += conjunto->trajetos[t].num_pontos;
+
+    printf("=== Map Matching Benchmark ===\n");
+    printf("Graph: %zu nodes, %zu edges; %zu traces, %zu fixes\n\n", grafo->num_pontos, grafo->num_arestas,
+           conjunto->num_trajetos, total_leituras);
+
+    // Cache de buscas: mesma resposta, menos buscas limitadas
+    ParametrosCombinacao parametros = parametros_combinacao_padrao();
+    printf("%-22s %12s %12s %14s %12s\n", "Search reuse", "Searches", "Cache hits", "Fixes/s", "Time (ms)");
+    size_t tamanhos[2] = {0, parametros.tamanho_cache};
+    const char *nomes[2] = {"last search only", "cache (32 origins)"};
+    for (int c = 0; c < 2; c++) {
+        parametros.tamanho_cache = tamanhos[c];
+        CombinadorMapa *combinador = criar_combinador_mapa(grafo, &parametros);
+        double inicio = agora_ms();
+        ResultadoCombinacao **resultados = combinar_trajetos(combinador, conjunto, 1);
+        double tempo = agora_ms() - inicio;
+        if (!resultados) {
+            printf("ERROR: Matching failed\n");
+            return 1;
+        }
+        size_t buscas = 0, acertos = 0;
+        for (size_t t = 0; t < conjunto->num_trajetos; t++) {
+            buscas += resultados[t]->buscas;
+            acertos += resultados[t]->acertos_cache;
+        }
+        printf("%-22s %12zu %12zu %14.0f %12.1f\n", nomes[c], buscas, acertos,
+               total_leituras / (tempo / 1000.0), tempo);
+        liberar_resultados_combinacao(resultados, conjunto->num_trajetos);
+        liberar_combinador_mapa(combinador);
+    }
+
+    // Escalabilidade: trajetos distribuídos entre as threads
+    CombinadorMapa *combinador = criar_combinador_mapa(grafo, NULL);
+    size_t nao_casadas = 0, trechos = 0;
+    printf("\n%-8s %14s %12s %10s\n", "Threads", "Fixes/s", "Time (ms)", "Speedup");
+    double base = 0.0;
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        double inicio = agora_ms();
+        ResultadoCombinacao **resultados = combinar_trajetos(combinador, conjunto, threads);
+        double tempo = agora_ms() - inicio;
+        if (!resultados) {
+            printf("ERROR: Matching failed\n");
+            return 1;
+        }
+        if (threads == 1) {
+            base = tempo;
+            for (size_t t = 0; t < conjunto->num_trajetos; t++) {
+                nao_casadas += resultados[t]->num_nao_casados;
+                trechos += resultados[t]->num_trechos;
+            }
+        }
+        printf("%-8d %14.0f %12.1f %9.2fx\n", threads, total_leituras / (tempo / 1000.0), tempo, base / tempo);
+        liberar_resultados_combinacao(resultados, conjunto->num_trajetos);
+    }
+    printf("\nUnmatched fixes: %zu; matched pieces: %zu for %zu traces\n", nao_casadas, trechos,
+           conjunto->num_trajetos);
+
+    liberar_combinador_mapa(combinador);
+    liberar_conjunto_trajetos(conjunto);
+    liberar_grafo(grafo);
+    return 0;
+}
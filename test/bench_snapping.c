@@ -0,0 +1,142 @@
+/**
+ * Benchmark: aresta mais próxima de coordenadas arbitrárias pelo índice
+ * espacial contra a varredura de todas as arestas, em microssegundos por
+ * consulta, e o custo de rotear entre os pontos projetados dividindo as
+ * arestas virtualmente (dijkstra_projecoes com espaço reaproveitado).
+ *
+ * Uso: ./bench_snapping [arquivo.osm | lado_da_grade] [consultas]
+ * Sem argumentos, usa uma grade sintética 700x700 (~1M arestas) e 100000
+ * consultas (a varredura roda em 200 delas).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include "../include/osm_reader.h"
+#include "../include/graph.h"
+#include "../include/dijkstra.h"
+#include "../include/reorder.h"
+#include "../include/distance_matrix.h"
+#include "../include/snapping.h"
+#include "../include/timing.h"
+#include "fixtures.h"
+
+// Varredura linear, como find_closest_point() faz com os pontos, na mesma
+// projeção em torno da consulta que as buscas pelo índice
+static size_t varrer_arestas(const IndiceEspacial *indice, double lat, double lon) {
+    const Grafo *grafo = grafo_indice(indice);
+    const double metros_por_grau = 6371000.0 * 3.14159265358979323846 / 180.0;
+    double c = cos(lat * 3.14159265358979323846 / 180.0);
+    size_t melhor = (size_t)-1;
+    double melhor_d = DBL_MAX;
+    for (size_t e = 0; e < grafo->num_arestas; e++) {
+        size_t o, d;
+        if (pontas_segmento(indice, e, &o, &d) != 0) continue;
+        const Ponto *a = &grafo->pontos[o], *b = &grafo->pontos[d];
+        double ax = (a->lon - lon) * metros_por_grau * c, ay = (a->lat - lat) * metros_por_grau;
+        double dx = (b->lon - lon) * metros_por_grau * c - ax, dy = (b->lat - lat) * metros_por_grau - ay;
+        double c2 = dx * dx + dy * dy;
+        double t = c2 > 0.0 ? -(ax * dx + ay * dy) / c2 : 0.0;
+        t = t < 0.0 ? 0.0 : t > 1.0 ? 1.0 : t;
+        double dist = hypot(ax + t * dx, ay + t * dy);
+        if (dist < melhor_d) {
+            melhor_d = dist;
+            melhor = e;
+        }
+    }
+    return melhor;
+}
+
+int main(int argc, char *argv[]) {
+    Grafo *grafo = NULL;
+    if (argc > 1 && strstr(argv[1], ".osm")) {
+        grafo = ler_osm(argv[1]);
+    } else {
+        int lado = argc > 1 ? atoi(argv[1]) : 700;
+        grafo = criar_grade(lado > 1 ? lado : 700, 29);
+    }
+    if (!grafo || grafo->num_pontos == 0 || grafo->num_arestas == 0) {
+        printf("ERROR: Failed to build graph\n");
+        return 1;
+    }
+    int consultas = argc > 2 ? atoi(argv[2]) : 100000;
+    if (consultas < 1) consultas = 100000;
+    reordenar_hilbert(grafo);
+
+    double inicio = agora_ms();
+    IndiceEspacial *indice = criar_indice_espacial(grafo, 0.0);
+    double construcao = agora_ms() - inicio;
+    if (!indice) {
+        printf("ERROR: Failed to build spatial index\n");
+        return 1;
+    }
+
+    double min_lat = 90.0, max_lat = -90.0, min_lon = 180.0, max_lon = -180.0;
+    for (size_t i = 0; i < grafo->num_pontos; i++) {
+        if (grafo->pontos[i].lat < min_lat) min_lat = grafo->pontos[i].lat;
+        if (grafo->pontos[i].lat > max_lat) max_lat = grafo->pontos[i].lat;
+        if (grafo->pontos[i].lon < min_lon) min_lon = grafo->pontos[i].lon;
+        if (grafo->pontos[i].lon > max_lon) max_lon = grafo->pontos[i].lon;
+    }
+    double *lats = malloc(consultas * sizeof(double));
+    double *lons = malloc(consultas * sizeof(double));
+    unsigned int estado = 7;
+    for (int q = 0; q < consultas; q++) {
+        lats[q] = min_lat + (proximo_aleatorio(&estado) % 1000000) / 1e6 * (max_lat - min_lat);
+        lons[q] = min_lon + (proximo_aleatorio(&estado) % 1000000) / 1e6 * (max_lon - min_lon);
+    }
+
+    printf("=== Nearest-Edge Snapping Benchmark ===\n");
+    printf("Graph: %zu nodes, %zu edges; spatial index built in %.1f ms\n\n", grafo->num_pontos, grafo->num_arestas,
+           construcao);
+
+    // Índice: todas as consultas
+    ProjecaoAresta *projecoes = malloc(consultas * sizeof(ProjecaoAresta));
+    inicio = agora_ms();
+    for (int q = 0; q < consultas; q++) aresta_mais_proxima(indice, lats[q], lons[q], 0.0, &projecoes[q]);
+    double tempo_indice = agora_ms() - inicio;
+
+    // Varredura: uma amostra, conferindo a resposta
+    int amostra = consultas < 200 ? consultas : 200;
+    int divergencias = 0;
+    inicio = agora_ms();
+    for (int q = 0; q < amostra; q++) {
+        if (varrer_arestas(indice, lats[q], lons[q]) != projecoes[q].aresta) divergencias++;
+    }
+    double tempo_varredura = agora_ms() - inicio;
+
+    double us_indice = tempo_indice * 1000.0 / consultas;
+    double us_varredura = tempo_varredura * 1000.0 / amostra;
+    printf("%-22s %12s %14s\n", "Nearest edge", "Queries", "us/query");
+    printf("%-22s %12d %14.2f\n", "spatial index", consultas, us_indice);
+    printf("%-22s %12d %14.2f\n", "linear scan", amostra, us_varredura);
+    printf("Speedup: %.0fx; %d of %d answers differ from the scan\n\n", us_varredura / us_indice, divergencias,
+           amostra);
+
+    // Rotas entre pares de pontos projetados
+    EspacoBusca *espaco = criar_espaco_busca(grafo->num_pontos);
+    int rotas = consultas / 2 < 20 ? consultas / 2 : 20, encontradas = 0;
+    long visitados = 0;
+    inicio = agora_ms();
+    for (int q = 0; q < rotas; q++) {
+        ResultadoDijkstra *r = dijkstra_projecoes(grafo, espaco, &projecoes[2 * q], &projecoes[2 * q + 1]);
+        if (r && r->sucesso) {
+            encontradas++;
+            visitados += r->nos_visitados;
+        }
+        liberar_resultado_dijkstra(r);
+    }
+    double tempo_rotas = agora_ms() - inicio;
+    printf("Routes between projected points: %d of %d found, %.1f ms and %.0f settled nodes per route\n",
+           encontradas, rotas, rotas ? tempo_rotas / rotas : 0.0, encontradas ? (double)visitados / encontradas : 0.0);
+
+    liberar_espaco_busca(espaco);
+    free(projecoes);
+    free(lats);
+    free(lons);
+    liberar_indice_espacial(indice);
+    liberar_grafo(grafo);
+    return 0;
+}
@@ -0,0 +1,184 @@
+/**
+ * Benchmark: seleção de pontos por clique com o índice espacial contra a
+ * varredura de todos os pontos (como find_closest_point() fazia), k vizinhos,
+ * consultas por retângulo do tamanho de uma tela ampliada e o custo de manter
+ * o índice nas edições (criar, conectar e apagar pontos).
+ *
+ * Uso: ./bench_spatial_index [arquivo.osm | lado_da_grade] [consultas]
+ * Sem argumentos, usa uma grade sintética 1415x1415 (~2M pontos) e 100000
+ * consultas (a varredura roda em 50 delas).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include "../include/osm_reader.h"
+#include "../include/graph.h"
+#include "../include/reorder.h"
+#include "../include/spatial_index.h"
+#include "../include/timing.h"
+#include "fixtures.h"
+
+// Grade com os pontos deslocados até 1e-4 grau, para não haver empates
+static Grafo* criar_grade_irregular(int lado) {
+    Grafo *grafo = criar_grade(lado, 29);
+    if (!grafo) return NULL;
+    unsigned int estado = 29;
+    for (size_t i = 0; i < grafo->num_pontos; i++) {
+        grafo->pontos[i].lat += (proximo_aleatorio(&estado) % 100) / 1e6;
+        grafo->pontos[i].lon += (proximo_aleatorio(&estado) % 100) / 1e6;
+    }
+    invalidar_indices(grafo);
+    return grafo;
+}
+
+// Varredura linear, como find_closest_point() fazia
+static size_t varrer_pontos(const Grafo *grafo, double lat, double lon) {
+    size_t melhor = (size_t)-1;
+    double melhor_d = DBL_MAX;
+    for (size_t i = 0; i < grafo->num_pontos; i++) {
+        double d = hypot(grafo->pontos[i].lon - lon, grafo->pontos[i].lat - lat);
+        if (d < melhor_d) {
+            melhor_d = d;
+            melhor = i;
+        }
+    }
+    return melhor;
+}
+
+int main(int argc, char *argv[]) {
+    Grafo *grafo = NULL;
+    if (argc > 1 && strstr(argv[1], ".osm")) {
+        grafo = ler_osm(argv[1]);
+    } else {
+        int lado = argc > 1 ? atoi(argv[1]) : 1415;
+        grafo = criar_grade_irregular(lado > 1 ? lado : 1415);
+    }
+    if (!grafo || grafo->num_pontos < 2) {
+        printf("ERROR: Failed to build graph\n");
+        return 1;
+    }
+    int consultas = argc > 2 ? atoi(argv[2]) : 100000;
+    if (consultas < 1) consultas = 100000;
+    reordenar_hilbert(grafo);
+    obter_indices(grafo);
+
+    double inicio = agora_ms();
+    IndiceEspacial *indice = criar_indice_espacial(grafo, 0.0);
+    double construcao = agora_ms() - inicio;
+    double min_lat, max_lat, min_lon, max_lon;
+    if (!indice || limites_indice(indice, &min_lat, &max_lat, &min_lon, &max_lon) != 0) {
+        printf("ERROR: Failed to build spatial index\n");
+        return 1;
+    }
+
+    double *lats = malloc(consultas * sizeof(double));
+    double *lons = malloc(consultas * sizeof(double));
+    size_t *respostas = malloc(consultas * sizeof(size_t));
+    unsigned int estado = 7;
+    for (int q = 0; q < consultas; q++) {
+        lats[q] = min_lat + (proximo_aleatorio(&estado) % 1000000) / 1e6 * (max_lat - min_lat);
+        lons[q] = min_lon + (proximo_aleatorio(&estado) % 1000000) / 1e6 * (max_lon - min_lon);
+    }
+
+    printf("=== Spatial Index Benchmark ===\n");
+    printf("Graph: %zu nodes, %zu edges; index built in %.1f ms\n\n", grafo->num_pontos, grafo->num_arestas,
+           construcao);
+
+    // Clique: ponto mais próximo a até 20 px numa tela de 1000 px sem zoom
+    double raio_clique = 20.0 * fmax(max_lat - min_lat, max_lon - min_lon) / 1000.0;
+    inicio = agora_ms();
+    int achados = 0;
+    for (int q = 0; q < consultas; q++) {
+        achados += ponto_mais_proximo(indice, lats[q], lons[q], raio_clique, &respostas[q]) == 0;
+    }
+    double tempo_clique = agora_ms() - inicio;
+
+    inicio = agora_ms();
+    for (int q = 0; q < consultas; q++) ponto_mais_proximo(indice, lats[q], lons[q], 0.0, &respostas[q]);
+    double tempo_indice = agora_ms() - inicio;
+
+    int amostra = consultas < 50 ? consultas : 50, divergencias = 0;
+    inicio = agora_ms();
+    for (int q = 0; q < amostra; q++) divergencias += varrer_pontos(grafo, lats[q], lons[q]) != respostas[q];
+    double tempo_varredura = agora_ms() - inicio;
+
+    size_t vizinhos[10];
+    inicio = agora_ms();
+    for (int q = 0; q < consultas; q++) pontos_mais_proximos(indice, lats[q], lons[q], 0.0, 10, vizinhos, NULL);
+    double tempo_knn = agora_ms() - inicio;
+
+    inicio = agora_ms();
+    for (int q = 0; q < consultas; q++) segmento_mais_proximo(indice, lats[q], lons[q], 0.0, &respostas[q]);
+    double tempo_segmento = agora_ms() - inicio;
+
+    printf("%-28s %10s %12s\n", "Query", "Queries", "us/query");
+    printf("%-28s %10d %12.2f   (%d hits)\n", "click pick (20 px radius)", consultas, tempo_clique * 1000.0 / consultas,
+           achados);
+    printf("%-28s %10d %12.2f\n", "nearest point", consultas, tempo_indice * 1000.0 / consultas);
+    printf("%-28s %10d %12.2f\n", "linear scan", amostra, tempo_varredura * 1000.0 / amostra);
+    printf("%-28s %10d %12.2f\n", "10 nearest points", consultas, tempo_knn * 1000.0 / consultas);
+    printf("%-28s %10d %12.2f\n", "nearest segment", consultas, tempo_segmento * 1000.0 / consultas);
+    printf("Speedup over the scan: %.0fx; %d of %d answers differ from it\n\n",
+           tempo_varredura / amostra / (tempo_indice / consultas), divergencias, amostra);
+
+    // Retângulos de 1% da área (uma tela com zoom de 10x)
+    ListaIndices *lista = criar_lista_indices();
+    int caixas = consultas < 1000 ? consultas : 1000;
+    double meia_alt = (max_lat - min_lat) * 0.05, meia_larg = (max_lon - min_lon) * 0.05;
+    size_t total_pontos = 0, total_segmentos = 0;
+    inicio = agora_ms();
+    for (int q = 0; q < caixas; q++) {
+        pontos_na_caixa(indice, lats[q] - meia_alt, lons[q] - meia_larg, lats[q] + meia_alt, lons[q] + meia_larg, lista);
+        total_pontos += lista->quantidade;
+    }
+    double tempo_caixa = agora_ms() - inicio;
+    inicio = agora_ms();
+    for (int q = 0; q < caixas; q++) {
+        segmentos_na_caixa(indice, lats[q] - meia_alt, lons[q] - meia_larg, lats[q] + meia_alt, lons[q] + meia_larg,
+                           lista);
+        total_segmentos += lista->quantidade;
+    }
+    double tempo_caixa_segmentos = agora_ms() - inicio;
+    printf("Box of 1%% of the area: %.3f ms for %.0f points, %.3f ms for %.0f segments\n\n", tempo_caixa / caixas,
+           (double)total_pontos / caixas, tempo_caixa_segmentos / caixas, (double)total_segmentos / caixas);
+
+    // Edições mantendo o índice: só as chamadas do índice são cronometradas,
+    // e a primeira inserção (que dobra os vetores do índice) à parte
+    int edicoes = 1000;
+    size_t base = grafo->num_pontos;
+    double tempo_insercao = 0.0, tempo_remocao = 0.0, primeira_insercao = 0.0;
+    for (int q = 0; q < edicoes; q++) {
+        adicionar_ponto(grafo, 100000000LL + q, lats[q], lons[q]);
+        adicionar_aresta(grafo, grafo->pontos[grafo->num_pontos - 1].id, grafo->pontos[q].id, 0.05);
+        inicio = agora_ms();
+        inserir_ponto_indice(indice, grafo->num_pontos - 1);
+        inserir_aresta_indice(indice, grafo->num_arestas - 1, grafo->num_pontos - 1, (size_t)q);
+        if (q == 0) {
+            primeira_insercao = agora_ms() - inicio;
+        } else {
+            tempo_insercao += agora_ms() - inicio;
+        }
+    }
+    for (int q = edicoes; q-- > 0; ) {
+        remover_aresta(grafo, grafo->num_arestas - 1);
+        remover_ponto(grafo, grafo->num_pontos - 1);
+        inicio = agora_ms();
+        remover_aresta_indice(indice, grafo->num_arestas);
+        remover_ponto_indice(indice, base + (size_t)q);
+        tempo_remocao += agora_ms() - inicio;
+    }
+    printf("Index maintenance: %.2f us per inserted point + edge (first one %.1f ms, growing the vectors), "
+           "%.2f us per removed edge + point\n",
+           tempo_insercao * 1000.0 / (edicoes - 1), primeira_insercao, tempo_remocao * 1000.0 / edicoes);
+
+    liberar_lista_indices(lista);
+    free(lats);
+    free(lons);
+    free(respostas);
+    liberar_indice_espacial(indice);
+    liberar_grafo(grafo);
+    return 0;
+}
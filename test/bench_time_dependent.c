@@ -0,0 +1,120 @@
+/**
+ * Benchmark: custo de consulta do Dijkstra dependente do tempo contra o
+ * dijkstra() estático, e memória dos perfis compartilhados contra uma cópia
+ * do perfil por aresta.
+ *
+ * Uso: ./bench_time_dependent [arquivo.osm | lado_da_grade] [num_consultas] [num_padroes]
+ * Sem argumentos, usa uma grade sintética 300x300, 500 consultas e 8 padrões
+ * de trânsito de 12 pontos espalhados por 90% das arestas.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../include/osm_reader.h"
+#include "../include/graph.h"
+#include "../include/dijkstra.h"
+#include "../include/reorder.h"
+#include "../include/components.h"
+#include "../include/time_dependent.h"
+#include "../include/timing.h"
+#include "fixtures.h"
+
+#define PONTOS_POR_PADRAO 12
+
+// Tempo total de num_consultas buscas; com tabela == NULL usa dijkstra()
+static double medir(Grafo *grafo, const TabelaPerfis *tabela, const long *pares, int num_consultas,
+                    long *estabelecidos) {
+    *estabelecidos = 0;
+    double inicio = agora_ms();
+    for (int q = 0; q < num_consultas; q++) {
+        double partida = (q % 24) * 3600.0;
+        ResultadoDijkstra *r = tabela
+            ? dijkstra_dependente_tempo(grafo, tabela, pares[2 * q], pares[2 * q + 1], partida, NULL)
+            : dijkstra(grafo, pares[2 * q], pares[2 * q + 1]);
+        if (r) *estabelecidos += r->nos_visitados;
+        liberar_resultado_dijkstra(r);
+    }
+    return agora_ms() - inicio;
+}
+
+int main(int argc, char *argv[]) {
+    Grafo *grafo = NULL;
+    if (argc > 1 && strstr(argv[1], ".osm")) {
+        grafo = ler_osm(argv[1]);
+    } else {
+        int lado = argc > 1 ? atoi(argv[1]) : 300;
+        grafo = criar_grade(lado > 1 ? lado : 300, 29);
+    }
+    if (!grafo || grafo->num_pontos == 0) {
+        printf("ERROR: Failed to build graph\n");
+        return 1;
+    }
+    int num_consultas = argc > 2 ? atoi(argv[2]) : 500;
+    if (num_consultas < 1) num_consultas = 500;
+    int num_padroes = argc > 3 ? atoi(argv[3]) : 8;
+    if (num_padroes < 1) num_padroes = 8;
+
+    reordenar_hilbert(grafo);
+    obter_componentes(grafo);
+
+    long *pares = malloc(2 * num_consultas * sizeof(long));
+    unsigned int estado = 13;
+    for (int q = 0; q < 2 * num_consultas; q++) {
+        pares[q] = grafo->pontos[proximo_aleatorio(&estado) % grafo->num_pontos].id;
+    }
+
+    TabelaPerfis *sem_perfis = criar_tabela_perfis(grafo, 40.0);
+    TabelaPerfis *com_perfis = criar_tabela_perfis(grafo, 40.0);
+    if (!sem_perfis || !com_perfis) {
+        printf("ERROR: Failed to create profile tables\n");
+        return 1;
+    }
+
+    // Padrões suaves (queda limitada para manter FIFO), cada um com um pico
+    long *ids = malloc(num_padroes * sizeof(long));
+    for (int p = 0; p < num_padroes; p++) {
+        PontoPerfil pontos[PONTOS_POR_PADRAO];
+        unsigned int pico = proximo_aleatorio(&estado) % PONTOS_POR_PADRAO;
+        for (int i = 0; i < PONTOS_POR_PADRAO; i++) {
+            unsigned int distancia = (unsigned int)abs(i - (int)pico);
+            pontos[i].instante = (uint32_t)i * (SEGUNDOS_POR_DIA / PONTOS_POR_PADRAO);
+            pontos[i].fator = distancia == 0 ? 2.5f : (distancia == 1 ? 1.6f : 1.0f);
+        }
+        ids[p] = registrar_perfil(com_perfis, pontos, PONTOS_POR_PADRAO);
+    }
+    size_t com_perfil = 0;
+    for (size_t e = 0; e < grafo->num_arestas; e++) {
+        if (proximo_aleatorio(&estado) % 10 == 0) continue;
+        long id = ids[proximo_aleatorio(&estado) % num_padroes];
+        if (id >= 0 && associar_perfil(com_perfis, grafo, e, (uint32_t)id) == 0) com_perfil++;
+    }
+
+    printf("=== Time-Dependent Routing Benchmark ===\n");
+    printf("Graph: %zu nodes, %zu edges, %d queries, %zu profiles on %zu edges\n\n",
+           grafo->num_pontos, grafo->num_arestas, num_consultas, com_perfis->num_perfis, com_perfil);
+
+    long estabelecidos_estatico, estabelecidos_constante, estabelecidos_perfis;
+    double estatico = medir(grafo, NULL, pares, num_consultas, &estabelecidos_estatico);
+    double constante = medir(grafo, sem_perfis, pares, num_consultas, &estabelecidos_constante);
+    double perfis = medir(grafo, com_perfis, pares, num_consultas, &estabelecidos_perfis);
+    printf("%-32s %10.2f ms %8.3f ms/query %10ld settled\n", "Static dijkstra():", estatico,
+           estatico / num_consultas, estabelecidos_estatico);
+    printf("%-32s %10.2f ms %8.3f ms/query %10ld settled  %5.2fx\n", "Time-dependent, no profiles:",
+           constante, constante / num_consultas, estabelecidos_constante, constante / estatico);
+    printf("%-32s %10.2f ms %8.3f ms/query %10ld settled  %5.2fx\n", "Time-dependent, with profiles:",
+           perfis, perfis / num_consultas, estabelecidos_perfis, perfis / estatico);
+
+    size_t compartilhada = memoria_tabela_perfis(com_perfis);
+    size_t por_aresta = com_perfil * (PONTOS_POR_PADRAO * sizeof(PontoPerfil) + sizeof(size_t));
+    printf("\nProfile memory: %zu bytes shared (%.2f bytes/edge) vs %zu bytes with one copy per edge\n",
+           compartilhada, (double)compartilhada / grafo->num_arestas, por_aresta);
+
+    free(ids);
+    free(pares);
+    liberar_tabela_perfis(sem_perfis);
+    liberar_tabela_perfis(com_perfis);
+    liberar_grafo(grafo);
+    return 0;
+}
@@ -0,0 +1,88 @@
+/**
+ * Benchmark: otimização da ordem de visita (vizinho mais próximo + 2-opt /
+ * Or-opt) em conjuntos sintéticos de paradas, com vários orçamentos de
+ * tempo. Mostra o tempo da matriz de custos, o custo do vizinho mais
+ * próximo e o ganho da melhoria sobre ele.
+ *
+ * Uso: ./bench_tour [arquivo.osm | lado_da_grade] [max_paradas]
+ * Sem argumentos, usa uma grade sintética 300x300 e 50, 100 e 200 paradas
+ * em circuito a partir da primeira.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/osm_reader.h"
+#include "../include/graph.h"
+#include "../include/reorder.h"
+#include "../include/components.h"
+#include "../include/tour.h"
+#include "fixtures.h"
+
+int main(int argc, char *argv[]) {
+    Grafo *grafo = NULL;
+    if (argc > 1 && strstr(argv[1], ".osm")) {
+        grafo = ler_osm(argv[1]);
+    } else {
+        int lado = argc > 1 ? atoi(argv[1]) : 300;
+        grafo = criar_grade(lado > 1 ? lado : 300, 29);
+    }
+    if (!grafo || grafo->num_pontos == 0) {
+        printf("ERROR: Failed to build graph\n");
+        return 1;
+    }
+    size_t max_paradas = argc > 2 ? (size_t)atoi(argv[2]) : 200;
+    if (max_paradas < 2) max_paradas = 200;
+
+    reordenar_hilbert(grafo);
+
+    // Paradas sorteadas na maior componente forte, para que todas se alcancem
+    const IndicesGrafo *indices = obter_componentes(grafo);
+    if (!indices) {
+        printf("ERROR: Failed to compute components\n");
+        return 1;
+    }
+    long *conexos = malloc(grafo->num_pontos * sizeof(long));
+    size_t num_conexos = 0;
+    for (size_t v = 0; v < grafo->num_pontos; v++) {
+        if (indices->componente_forte[v] == indices->maior_componente_forte) conexos[num_conexos++] = grafo->pontos[v].id;
+    }
+
+    printf("=== Tour Optimization Benchmark ===\n");
+    printf("Graph: %zu nodes, %zu edges (largest component: %zu)\n\n", grafo->num_pontos, grafo->num_arestas,
+           num_conexos);
+    printf("%-6s %12s %12s %18s %18s %24s\n", "Stops", "Matrix (ms)", "NN (km)", "0.1 ms budget (km)",
+           "1 ms budget (km)", "Unlimited (km / ms)");
+
+    const size_t quantidades[] = {50, 100, 200};
+    const double orcamentos[] = {0.1, 1.0, 0.0};
+    unsigned int estado = 17;
+    for (size_t t = 0; t < sizeof(quantidades) / sizeof(quantidades[0]); t++) {
+        size_t num_paradas = quantidades[t] < max_paradas ? quantidades[t] : max_paradas;
+        long *paradas = malloc(num_paradas * sizeof(long));
+        for (size_t i = 0; i < num_paradas; i++) paradas[i] = conexos[proximo_aleatorio(&estado) % num_conexos];
+
+        Tour *tours[3];
+        for (int b = 0; b < 3; b++) {
+            tours[b] = otimizar_tour(grafo, paradas, num_paradas, METRICA_DISTANCIA, 1, orcamentos[b]);
+        }
+        if (tours[0] && tours[1] && tours[2]) {
+            double vizinho = tours[2]->custo_vizinho;
+            printf("%-6zu %12.1f %12.2f", num_paradas, tours[2]->tempo_matriz_ms, vizinho);
+            for (int b = 0; b < 2; b++) {
+                printf(" %10.2f (-%4.1f%%)", tours[b]->custo, 100.0 * (vizinho - tours[b]->custo) / vizinho);
+            }
+            printf(" %8.2f (-%4.1f%%) / %5.1f\n", tours[2]->custo, 100.0 * (vizinho - tours[2]->custo) / vizinho,
+                   tours[2]->tempo_otimizacao_ms);
+        } else {
+            printf("%-6zu failed\n", num_paradas);
+        }
+        for (int b = 0; b < 3; b++) liberar_tour(tours[b]);
+        free(paradas);
+        if (num_paradas == max_paradas) break;
+    }
+
+    free(conexos);
+    liberar_grafo(grafo);
+    return 0;
+}
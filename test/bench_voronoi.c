@@ -0,0 +1,86 @@
+/**
+ * Benchmark: partição de Voronoi pela rede numa única busca com várias
+ * fontes, contra uma busca completa por fonte (ficando com a menor
+ * distância de cada ponto).
+ *
+ * Uso: ./bench_voronoi [arquivo.osm | lado_da_grade] [max_buscas_separadas]
+ * Sem argumentos, usa uma grade sintética 300x300 e 10, 100 e 1000 fontes.
+ * As buscas separadas são medidas em no máximo 100 fontes e o tempo das
+ * demais é extrapolado (marcado com *).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/osm_reader.h"
+#include "../include/graph.h"
+#include "../include/reorder.h"
+#include "../include/distance_matrix.h"
+#include "../include/voronoi.h"
+#include "../include/timing.h"
+#include "fixtures.h"
+
+int main(int argc, char *argv[]) {
+    Grafo *grafo = NULL;
+    if (argc > 1 && strstr(argv[1], ".osm")) {
+        grafo = ler_osm(argv[1]);
+    } else {
+        int lado = argc > 1 ? atoi(argv[1]) : 300;
+        grafo = criar_grade(lado > 1 ? lado : 300, 29);
+    }
+    if (!grafo || grafo->num_pontos == 0) {
+        printf("ERROR: Failed to build graph\n");
+        return 1;
+    }
+    size_t max_separadas = argc > 2 ? (size_t)atoi(argv[2]) : 100;
+    if (max_separadas < 1) max_separadas = 100;
+
+    reordenar_hilbert(grafo);
+    obter_indices(grafo);
+    size_t n = grafo->num_pontos;
+
+    long *todos = malloc(n * sizeof(long));
+    for (size_t v = 0; v < n; v++) todos[v] = grafo->pontos[v].id;
+    double *linha = malloc(n * sizeof(double));
+    double *melhor = malloc(n * sizeof(double));
+    EspacoBusca *espaco = criar_espaco_busca(n);
+
+    printf("=== Network Voronoi Benchmark ===\n");
+    printf("Graph: %zu nodes, %zu edges\n\n", n, grafo->num_arestas);
+    printf("%-8s %16s %20s %10s\n", "Sources", "One pass (ms)", "Per source (ms)", "Speedup");
+
+    const size_t quantidades[] = {10, 100, 1000};
+    unsigned int estado = 3;
+    for (size_t t = 0; t < sizeof(quantidades) / sizeof(quantidades[0]); t++) {
+        size_t num_fontes = quantidades[t];
+        long *fontes = malloc(num_fontes * sizeof(long));
+        for (size_t f = 0; f < num_fontes; f++) fontes[f] = todos[proximo_aleatorio(&estado) % n];
+
+        double inicio = agora_ms();
+        ParticaoVoronoi *particao = particao_voronoi(grafo, fontes, num_fontes, METRICA_DISTANCIA);
+        double uma_passada = agora_ms() - inicio;
+
+        size_t medidas = num_fontes < max_separadas ? num_fontes : max_separadas;
+        for (size_t v = 0; v < n; v++) melhor[v] = -1.0;
+        inicio = agora_ms();
+        for (size_t f = 0; f < medidas; f++) {
+            distancias_um_para_muitos(grafo, espaco, fontes[f], todos, n, linha, NULL);
+            for (size_t v = 0; v < n; v++) {
+                if (linha[v] >= 0.0 && (melhor[v] < 0.0 || linha[v] < melhor[v])) melhor[v] = linha[v];
+            }
+        }
+        double separadas = (agora_ms() - inicio) * num_fontes / medidas;
+
+        printf("%-8zu %16.2f %19.1f%s %9.0fx\n", num_fontes, uma_passada, separadas,
+               medidas < num_fontes ? "*" : " ", separadas / uma_passada);
+        liberar_particao_voronoi(particao);
+        free(fontes);
+    }
+
+    liberar_espaco_busca(espaco);
+    free(todos);
+    free(linha);
+    free(melhor);
+    liberar_grafo(grafo);
+    return 0;
+}
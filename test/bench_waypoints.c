@@ -0,0 +1,78 @@
+/**
+ * Benchmark: rota com muitas paradas. Compara dijkstra() trecho a trecho
+ * (vetores alocados por trecho) com rota_por_paradas() em 1 thread (um
+ * espaço de busca reaproveitado) e com os trechos em paralelo.
+ *
+ * Uso: ./bench_waypoints [arquivo.osm | lado_da_grade] [num_paradas] [num_threads]
+ * Sem argumentos, usa uma grade sintética 500x500, 64 paradas e o número de
+ * processadores.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/osm_reader.h"
+#include "../include/graph.h"
+#include "../include/dijkstra.h"
+#include "../include/reorder.h"
+#include "../include/components.h"
+#include "../include/waypoints.h"
+#include "../include/timing.h"
+#include "fixtures.h"
+
+int main(int argc, char *argv[]) {
+    Grafo *grafo = NULL;
+    if (argc > 1 && strstr(argv[1], ".osm")) {
+        grafo = ler_osm(argv[1]);
+    } else {
+        int lado = argc > 1 ? atoi(argv[1]) : 500;
+        grafo = criar_grade(lado > 1 ? lado : 500, 29);
+    }
+    if (!grafo || grafo->num_pontos == 0) {
+        printf("ERROR: Failed to build graph\n");
+        return 1;
+    }
+    int num_paradas = argc > 2 ? atoi(argv[2]) : 64;
+    if (num_paradas < 2) num_paradas = 64;
+    int num_threads = argc > 3 ? atoi(argv[3]) : 0;
+
+    reordenar_hilbert(grafo);
+    obter_componentes(grafo);
+
+    long *paradas = malloc(num_paradas * sizeof(long));
+    unsigned int estado = 11;
+    for (int i = 0; i < num_paradas; i++) {
+        paradas[i] = grafo->pontos[proximo_aleatorio(&estado) % grafo->num_pontos].id;
+    }
+
+    printf("=== Waypoint Routing Benchmark ===\n");
+    printf("Graph: %zu nodes, %zu edges, %d stops\n\n", grafo->num_pontos, grafo->num_arestas, num_paradas);
+
+    double inicio = agora_ms();
+    double total = 0.0;
+    for (int i = 0; i + 1 < num_paradas; i++) {
+        ResultadoDijkstra *r = dijkstra(grafo, paradas[i], paradas[i + 1]);
+        if (r && r->sucesso) total += r->distancia_total;
+        liberar_resultado_dijkstra(r);
+    }
+    double separados = agora_ms() - inicio;
+    printf("%-36s %10.2f ms  (%.2f km)\n", "dijkstra() per leg:", separados, total);
+
+    inicio = agora_ms();
+    RotaParadas *rota = rota_por_paradas(grafo, paradas, num_paradas, METRICA_DISTANCIA, 1);
+    double sequencial = agora_ms() - inicio;
+    printf("%-36s %10.2f ms  (%.2f km) %5.2fx\n", "rota_por_paradas(), 1 thread:", sequencial,
+           rota ? rota->rota->distancia_total : -1.0, separados / sequencial);
+    liberar_rota_paradas(rota);
+
+    inicio = agora_ms();
+    rota = rota_por_paradas(grafo, paradas, num_paradas, METRICA_DISTANCIA, num_threads);
+    double paralelo = agora_ms() - inicio;
+    printf("%-36s %10.2f ms  (%.2f km) %5.2fx\n", "rota_por_paradas(), all threads:", paralelo,
+           rota ? rota->rota->distancia_total : -1.0, separados / paralelo);
+    liberar_rota_paradas(rota);
+
+    free(paradas);
+    liberar_grafo(grafo);
+    return 0;
+}
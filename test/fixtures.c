@@ -0,0 +1,57 @@
+#include "fixtures.h"
+#include "../include/graph.h"
+
+unsigned int proximo_aleatorio(unsigned int *estado) {
+    *estado = *estado * 1103515245u + 12345u;
+    return *estado >> 8;
+}
+
+double uniforme(unsigned int *estado) {
+    return (proximo_aleatorio(estado) % 1000000) / 1000000.0;
+}
+
+Grafo* criar_grade(int lado, unsigned int semente) {
+    Grafo *grafo = criar_grafo_com_capacidade((size_t)lado * lado, 2 * (size_t)lado * lado);
+    if (!grafo) return NULL;
+    unsigned int estado = semente;
+    for (int i = 0; i < lado * lado; i++) {
+        adicionar_ponto(grafo, i + 1, -16.7 + (i / lado) * 0.0005, -49.2 + (i % lado) * 0.0005);
+    }
+    for (int r = 0; r < lado; r++) {
+        for (int c = 0; c < lado; c++) {
+            long long id = (long long)r * lado + c + 1;
+            double peso = 0.03 + (proximo_aleatorio(&estado) % 100) / 1000.0;
+            if (c + 1 < lado) {
+                Aresta a = {id, id + 1, peso, 1};
+                adicionar_arestas(grafo, &a, 1);
+            }
+            if (r + 1 < lado) {
+                Aresta a = {id, id + lado, peso, 1};
+                adicionar_arestas(grafo, &a, 1);
+            }
+        }
+    }
+    return grafo;
+}
+
+Grafo* criar_grade_mao_unica(int lado, unsigned int semente, int mao_unica_a_cada, double fator_vertical) {
+    Grafo *grafo = criar_grafo_com_capacidade((size_t)lado * lado, 2 * (size_t)lado * lado);
+    if (!grafo) return NULL;
+    unsigned int estado = semente;
+    for (int i = 0; i < lado * lado; i++) adicionar_ponto(grafo, i + 1, (i / lado) * 0.001, (i % lado) * 0.001);
+    for (int r = 0; r < lado; r++) {
+        for (int c = 0; c < lado; c++) {
+            long long id = (long long)r * lado + c + 1;
+            double peso = 0.03 + (proximo_aleatorio(&estado) % 1000) / 10000.0;
+            if (c + 1 < lado) {
+                Aresta a = {id, id + 1, peso, proximo_aleatorio(&estado) % mao_unica_a_cada != 0};
+                adicionar_arestas(grafo, &a, 1);
+            }
+            if (r + 1 < lado) {
+                Aresta a = {id, id + lado, peso * fator_vertical, 1};
+                adicionar_arestas(grafo, &a, 1);
+            }
+        }
+    }
+    return grafo;
+}
@@ -0,0 +1,26 @@
+#ifndef FIXTURES_H
+#define FIXTURES_H
+
+#include "../include/osm_reader.h"
+
+// Dados sintéticos compartilhados pelos testes e benchmarks
+
+// Gerador congruencial linear: mesma sequência em qualquer plataforma, para
+// que os grafos e consultas sorteados sejam reproduzíveis
+unsigned int proximo_aleatorio(unsigned int *estado);
+
+// Valor em [0, 1) com passos de 1e-6
+double uniforme(unsigned int *estado);
+
+// Grade lado x lado a partir de (-16.7, -49.2), com 0.0005 grau entre
+// vizinhos: todas as vias de mão dupla, com pesos sorteados de 0.03 a 0.129
+// km (a horizontal e a vertical que saem de um ponto têm o mesmo peso)
+Grafo* criar_grade(int lado, unsigned int semente);
+
+// Grade lado x lado a partir de (0, 0), com 0.001 grau entre vizinhos e pesos
+// de 0.03 a 0.1299 km: cerca de uma em mao_unica_a_cada vias horizontais é
+// de mão única, e as verticais pesam fator_vertical vezes a horizontal que
+// sai do mesmo ponto
+Grafo* criar_grade_mao_unica(int lado, unsigned int semente, int mao_unica_a_cada, double fator_vertical);
+
+#endif // FIXTURES_H
@@ -10,8 +10,17 @@ echo
 CC="gcc"
 CFLAGS="-Wall -Wextra -std=c11 -O2 -g"
 INCLUDES="-I../include"
-LIBS="`pkg-config --cflags --libs libxml-2.0` -lm"
+LIBS="`pkg-config --cflags --libs libxml-2.0` -lm -lpthread"
 SRC_DIR="../src"
+CORE_SRCS="$SRC_DIR/osm_reader.c $SRC_DIR/graph.c $SRC_DIR/dijkstra.c $SRC_DIR/edit.c \
+    $SRC_DIR/compression.c $SRC_DIR/reorder.c $SRC_DIR/tree_pruning.c $SRC_DIR/components.c $SRC_DIR/arena.c $SRC_DIR/timing.c \
+    $SRC_DIR/compact_graph.c $SRC_DIR/radix_heap.c $SRC_DIR/delta_stepping.c $SRC_DIR/distance_matrix.c \
+    $SRC_DIR/contraction.c $SRC_DIR/batch_query.c $SRC_DIR/incremental_search.c \
+    $SRC_DIR/dynamic_sssp.c $SRC_DIR/time_dependent.c $SRC_DIR/metrics.c $SRC_DIR/isochrone.c \
+    $SRC_DIR/voronoi.c $SRC_DIR/waypoints.c $SRC_DIR/tour.c $SRC_DIR/alternatives.c $SRC_DIR/map_matching.c $SRC_DIR/snapping.c \
+    $SRC_DIR/spatial_index.c"
+# Grafos sintéticos e gerador aleatório compartilhados pelos testes e benchmarks
+TEST_SRCS="fixtures.c"
 
 # Função para compilar e executar um teste
 run_test() {
@@ -30,12 +39,11 @@ run_test() {
         "test_simple"|"test_casaprimo")
             # Testes simples, apenas OSM reader e graph
             compile_cmd="$CC $CFLAGS $INCLUDES -o \"$test_name\" \"$test_file\" \
-                \"$SRC_DIR/osm_reader.c\" \"$SRC_DIR/graph.c\" $LIBS"
+                \"$SRC_DIR/osm_reader.c\" \"$SRC_DIR/graph.c\" \"$SRC_DIR/arena.c\" \"$SRC_DIR/metrics.c\" $LIBS"
             ;;
         *)
             # Testes completos com GTK
-            compile_cmd="$CC $CFLAGS $INCLUDES -o \"$test_name\" \"$test_file\" \
-                \"$SRC_DIR/osm_reader.c\" \"$SRC_DIR/graph.c\" \"$SRC_DIR/dijkstra.c\" \"$SRC_DIR/edit.c\" \
+            compile_cmd="$CC $CFLAGS $INCLUDES -o \"$test_name\" \"$test_file\" $TEST_SRCS $CORE_SRCS \
                 $LIBS `pkg-config --cflags --libs gtk+-3.0`"
             ;;
     esac
@@ -44,7 +52,8 @@ run_test() {
         echo "✅ Compilação de $test_name bem-sucedida"
         echo "🚀 Executando $test_name..."
         echo "----------------------------------------"
-        ./"$test_name"
+        # Os testes abrem test.osm e test_oneway.osm pelo nome: rodar de test_data
+        (cd ../test_data && ../test/"$test_name")
         echo "----------------------------------------"
         echo "✅ Teste $test_name concluído"
         echo
@@ -62,6 +71,28 @@ echo "1. test_simple - Teste básico de carregamento de OSM"
 echo "2. test_casaprimo - Teste completo com casaPrimo.osm"
 echo "3. test_directed_graph - Teste de grafos direcionais"
 echo "4. test_final_demo - Demonstração final"
+echo "5. test_canonical_edges - Registro único para vias de mão dupla"
+echo "6. test_chain_compression - Compressão de cadeias de grau 2"
+echo "7. test_tree_pruning - Poda de becos sem saída (núcleo de roteamento)"
+echo "8. test_components - Componentes conexas e rejeição de consultas"
+echo "9. test_graph_builder - Construção do grafo em tempo linear e arena"
+echo "10. test_radix_dijkstra - Pesos inteiros e fila radix"
+echo "11. test_delta_stepping - Delta-stepping paralelo (todas as distâncias)"
+echo "12. test_distance_matrix - Matriz de distâncias origens x destinos"
+echo "13. test_contraction - Hierarquia de contração e muitos-para-muitos por baldes"
+echo "14. test_batch_query - Consultas em lote com roubo de trabalho"
+echo "15. test_incremental_search - Busca retomada ao trocar só o destino"
+echo "16. test_dynamic_sssp - Reparo da árvore de caminhos após mudanças de peso"
+echo "17. test_time_dependent - Perfis de tempo de viagem por hora do dia"
+echo "18. test_metrics - Métricas de distância, tempo e custo personalizado"
+echo "19. test_isochrone - Busca limitada por alcance (isócronas)"
+echo "20. test_voronoi - Instalação mais próxima com várias fontes (Voronoi)"
+echo "21. test_waypoints - Rotas com paradas intermediárias"
+echo "22. test_tour - Ordem de visita otimizada (vizinho mais próximo + 2-opt/Or-opt)"
+echo "23. test_alternatives - Rotas alternativas (k caminhos mais curtos de Yen)"
+echo "24. test_map_matching - Casamento de trajetos GPS com as vias (HMM/Viterbi)"
+echo "25. test_snapping - Projeção de coordenadas na via mais próxima e rotas entre projeções"
+echo "26. test_spatial_index - Índice espacial de pontos e segmentos contra força bruta, com edições"
 echo
 
 # Executar testes específicos ou todos
@@ -71,6 +102,28 @@ if [ "$1" = "all" ]; then
     run_test "test_casaprimo"
     run_test "test_directed_graph"
     run_test "test_final_demo"
+    run_test "test_canonical_edges"
+    run_test "test_chain_compression"
+    run_test "test_tree_pruning"
+    run_test "test_components"
+    run_test "test_graph_builder"
+    run_test "test_radix_dijkstra"
+    run_test "test_delta_stepping"
+    run_test "test_distance_matrix"
+    run_test "test_contraction"
+    run_test "test_batch_query"
+    run_test "test_incremental_search"
+    run_test "test_dynamic_sssp"
+    run_test "test_time_dependent"
+    run_test "test_metrics"
+    run_test "test_isochrone"
+    run_test "test_voronoi"
+    run_test "test_waypoints"
+    run_test "test_tour"
+    run_test "test_alternatives"
+    run_test "test_map_matching"
+    run_test "test_snapping"
+    run_test "test_spatial_index"
 elif [ -n "$1" ]; then
     echo "Executando teste específico: $1"
     run_test "$1"
@@ -78,6 +131,22 @@ else
     echo "Uso:"
     echo "  ./run_tests.sh all          - Executar todos os testes"
     echo "  ./run_tests.sh test_simple  - Executar teste específico"
+    echo "  ./run_tests.sh bench_hilbert_reorder - Benchmark da reordenação de Hilbert"
+    echo "  ./run_tests.sh bench_compact_adjacency - Benchmark da adjacência compacta (bytes/aresta)"
+    echo "  ./run_tests.sh bench_delta_stepping - Escalabilidade do delta-stepping de 1 a N threads"
+    echo "  ./run_tests.sh bench_distance_matrix - Tabelas 100x100 e 1000x1000 contra dijkstra() por par"
+    echo "  ./run_tests.sh bench_many_to_many - Baldes sobre a hierarquia contra uma busca por origem"
+    echo "  ./run_tests.sh bench_batch_query - Vazão das consultas em lote de 1 a N threads"
+    echo "  ./run_tests.sh bench_dynamic_sssp - Reparo da árvore contra recálculo, por tamanho de lote"
+    echo "  ./run_tests.sh bench_time_dependent - Custo da busca dependente do tempo e memória dos perfis"
+    echo "  ./run_tests.sh bench_isochrone - Isócronas com espaço reaproveitado contra vetores alocados por consulta"
+    echo "  ./run_tests.sh bench_voronoi - Uma busca com várias fontes contra uma busca por fonte"
+    echo "  ./run_tests.sh bench_waypoints - Rota com muitas paradas: trechos em lote contra dijkstra() por trecho"
+    echo "  ./run_tests.sh bench_tour - Ordem de 50 a 200 paradas: ganho sobre o vizinho mais próximo por orçamento de tempo"
+    echo "  ./run_tests.sh bench_alternatives - Rotas alternativas: A* guiado pela busca reversa contra dijkstra() por desvio"
+    echo "  ./run_tests.sh bench_map_matching - Leituras GPS casadas por segundo de 1 a N threads, com e sem cache de buscas"
+    echo "  ./run_tests.sh bench_snapping - Aresta mais próxima pelo índice espacial contra a varredura linear"
+    echo "  ./run_tests.sh bench_spatial_index - Seleção por clique, k vizinhos e retângulos num grafo de ~2M pontos contra a varredura"
     echo "  ./run_tests.sh              - Mostrar esta ajuda"
 fi
 
@@ -0,0 +1,176 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../include/osm_reader.h"
+#include "../include/graph.h"
+#include "../include/dijkstra.h"
+#include "../include/metrics.h"
+#include "../include/components.h"
+#include "../include/alternatives.h"
+#include "fixtures.h"
+
+// Custos de todos os caminhos sem ciclos até o destino (busca exaustiva)
+static void enumerar_caminhos(const IndicesGrafo *indices, size_t atual, size_t destino, double custo,
+                              int *no_caminho, double *custos, size_t *num_custos) {
+    if (atual == destino) {
+        custos[(*num_custos)++] = custo;
+        return;
+    }
+    no_caminho[atual] = 1;
+    for (size_t k = indices->inicio_arcos[atual]; k < indices->inicio_arcos[atual + 1]; k++) {
+        size_t v = indices->arcos[k].destino;
+        if (!no_caminho[v]) enumerar_caminhos(indices, v, destino, custo + indices->arcos[k].peso, no_caminho, custos, num_custos);
+    }
+    no_caminho[atual] = 0;
+}
+
+static int comparar_custos(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// Rota conexa, sem pontos repetidos, da origem ao destino
+static int rota_valida(Grafo *grafo, const ResultadoDijkstra *r, long origem, long destino) {
+    if (!r || !r->sucesso || r->caminho[0] != origem || r->caminho[r->tamanho_caminho - 1] != destino) return 0;
+    for (int i = 0; i < r->tamanho_caminho; i++) {
+        for (int j = i + 1; j < r->tamanho_caminho; j++) {
+            if (r->caminho[i] == r->caminho[j]) return 0;
+        }
+    }
+    double custos[NUM_METRICAS];
+    return metricas_caminho(grafo, r->caminho, r->tamanho_caminho, METRICA_DISTANCIA, custos) == 0;
+}
+
+int main() {
+    printf("=== Testing Alternative Routes ===\n\n");
+    int falhas = 0;
+
+    // Três vias paralelas de 1 a 5: por 2 (custo 3), por 3 (4) e por 4 (5)
+    Grafo *vias = criar_grafo();
+    for (int i = 1; i <= 5; i++) adicionar_ponto(vias, i, -16.7 + i * 0.001, -49.2);
+    adicionar_aresta(vias, 1, 2, 1.0);
+    adicionar_aresta(vias, 2, 5, 2.0);
+    adicionar_aresta(vias, 1, 3, 2.0);
+    adicionar_aresta(vias, 3, 5, 2.0);
+    adicionar_aresta(vias, 1, 4, 2.5);
+    adicionar_aresta(vias, 4, 5, 2.5);
+    Alternativas *alt = rotas_alternativas(vias, 1, 5, 5, METRICA_DISTANCIA, 1.0);
+    int tres = alt && alt->num_rotas == 3 && alt->rotas[0].caminho->distancia_total == 3.0 &&
+               alt->rotas[1].caminho->distancia_total == 4.0 && alt->rotas[2].caminho->distancia_total == 5.0 &&
+               alt->rotas[1].caminho->caminho[1] == 3 && alt->rotas[2].caminho->caminho[1] == 4 &&
+               alt->rotas[0].sobreposicao == 0.0 && alt->rotas[1].sobreposicao == 0.0;
+    printf("%s Three parallel roads give three ranked, disjoint routes\n", tres ? "✓" : "✗");
+    falhas += !tres;
+    liberar_alternativas(alt);
+
+    long desconhecido = 99;
+    adicionar_ponto(vias, 6, -16.8, -49.3);
+    alt = rotas_alternativas(vias, 1, 6, 3, METRICA_DISTANCIA, 1.0);
+    Alternativas *mesmo = rotas_alternativas(vias, 2, 2, 3, METRICA_DISTANCIA, 1.0);
+    int bordas = alt && alt->num_rotas == 0 && mesmo && mesmo->num_rotas == 1 &&
+                 mesmo->rotas[0].caminho->tamanho_caminho == 1 &&
+                 rotas_alternativas(vias, 1, desconhecido, 3, METRICA_DISTANCIA, 1.0) == NULL;
+    printf("%s Unreachable target gives no route, same point one, unknown id NULL\n", bordas ? "✓" : "✗");
+    falhas += !bordas;
+    liberar_alternativas(alt);
+    liberar_alternativas(mesmo);
+    liberar_grafo(vias);
+
+    // Grade 4x4 com pesos sorteados e algumas vias de mão única: os k
+    // primeiros custos batem com a enumeração de todos os caminhos simples
+    unsigned int estado = 46;
+    int iguais = 1;
+    for (int g = 0; g < 5; g++) {
+        Grafo *grade = criar_grafo();
+        for (int i = 0; i < 16; i++) adicionar_ponto(grade, i + 1, -16.7 + (i / 4) * 0.001, -49.2 + (i % 4) * 0.001);
+        for (int i = 0; i < 16; i++) {
+            int vizinhos[2] = {i % 4 < 3 ? i + 1 : -1, i < 12 ? i + 4 : -1};
+            for (int d = 0; d < 2; d++) {
+                if (vizinhos[d] < 0) continue;
+                double peso = 1.0 + (proximo_aleatorio(&estado) % 1000) / 100.0;
+                Aresta a = {i + 1, vizinhos[d] + 1, peso, proximo_aleatorio(&estado) % 4 != 0};
+                adicionar_arestas(grade, &a, 1);
+            }
+        }
+        const IndicesGrafo *indices = obter_indices(grade);
+        double custos[4096];
+        size_t num_custos = 0;
+        int no_caminho[16] = {0};
+        enumerar_caminhos(indices, 0, 15, 0.0, no_caminho, custos, &num_custos);
+        qsort(custos, num_custos, sizeof(double), comparar_custos);
+
+        alt = rotas_alternativas(grade, 1, 16, 12, METRICA_DISTANCIA, 1.0);
+        size_t esperadas = num_custos < 12 ? num_custos : 12;
+        if (!alt || alt->num_rotas != esperadas) iguais = 0;
+        for (size_t r = 0; alt && r < alt->num_rotas && r < esperadas; r++) {
+            if (fabs(alt->rotas[r].caminho->distancia_total - custos[r]) > 1e-9 ||
+                !rota_valida(grade, alt->rotas[r].caminho, 1, 16)) {
+                iguais = 0;
+            }
+        }
+        liberar_alternativas(alt);
+        liberar_grafo(grade);
+    }
+    printf("%s 12 shortest loopless paths match exhaustive enumeration on 5 random grids\n", iguais ? "✓" : "✗");
+    falhas += !iguais;
+
+    Grafo *grafo = ler_osm("test.osm");
+    if (!grafo) {
+        printf("ERROR: Failed to load test.osm\n");
+        return 1;
+    }
+    const IndicesGrafo *indices = obter_componentes(grafo);
+    long *conexos = malloc(grafo->num_pontos * sizeof(long));
+    size_t num_conexos = 0;
+    for (size_t v = 0; indices && v < grafo->num_pontos; v++) {
+        if (indices->componente_forte[v] == indices->maior_componente_forte) conexos[num_conexos++] = grafo->pontos[v].id;
+    }
+
+    // Em todas as métricas: a primeira rota é a de dijkstra_metrica(), as
+    // demais são válidas, distintas e em ordem de custo
+    int primeira = 1, ordenadas = 1, distintas = 1, validas = 1, filtradas = 1;
+    for (int q = 0; q < 15; q++) {
+        Metrica metrica = (Metrica)(q % NUM_METRICAS);
+        long origem = conexos[proximo_aleatorio(&estado) % num_conexos];
+        long destino = conexos[proximo_aleatorio(&estado) % num_conexos];
+        if (origem == destino) continue;
+        double limite = q % 2 ? 0.6 : 1.0;
+        alt = rotas_alternativas(grafo, origem, destino, 4, metrica, limite);
+        ResultadoDijkstra *ref = dijkstra_metrica(grafo, origem, destino, metrica);
+        if (!alt || alt->num_rotas == 0 || !ref || !ref->sucesso ||
+            fabs(alt->rotas[0].caminho->distancia_total - ref->distancia_total) > 1e-6) {
+            primeira = 0;
+        }
+        for (size_t r = 0; alt && r < alt->num_rotas; r++) {
+            const ResultadoDijkstra *c = alt->rotas[r].caminho;
+            double custos[NUM_METRICAS];
+            if (!rota_valida(grafo, c, origem, destino) ||
+                metricas_caminho(grafo, c->caminho, c->tamanho_caminho, metrica, custos) != 0 ||
+                fabs(custos[metrica] - c->distancia_total) > 1e-6 ||
+                alt->rotas[r].sobreposicao < 0.0 || alt->rotas[r].sobreposicao > 1.0 + 1e-9) {
+                validas = 0;
+            }
+            if (r > 0 && c->distancia_total < alt->rotas[r - 1].caminho->distancia_total - 1e-9) ordenadas = 0;
+            if (r > 0 && limite < 1.0 && alt->rotas[r].sobreposicao > limite + 1e-9) filtradas = 0;
+            for (size_t s = 0; s < r; s++) {
+                const ResultadoDijkstra *o = alt->rotas[s].caminho;
+                int igual = o->tamanho_caminho == c->tamanho_caminho;
+                for (int i = 0; igual && i < c->tamanho_caminho; i++) igual = o->caminho[i] == c->caminho[i];
+                if (igual) distintas = 0;
+            }
+        }
+        liberar_resultado_dijkstra(ref);
+        liberar_alternativas(alt);
+    }
+    printf("%s First route matches dijkstra_metrica() in every metric\n", primeira ? "✓" : "✗");
+    printf("%s Routes are loopless, connected and cost what the metric says\n", validas ? "✓" : "✗");
+    printf("%s Routes are distinct and ranked by cost\n", distintas && ordenadas ? "✓" : "✗");
+    printf("%s Overlap limit keeps alternatives within 60%% of the best route\n", filtradas ? "✓" : "✗");
+    falhas += !primeira || !validas || !distintas || !ordenadas || !filtradas;
+
+    free(conexos);
+    liberar_grafo(grafo);
+
+    printf("\n=== Test completed ===\n");
+    return falhas ? 1 : 0;
+}
@@ -0,0 +1,100 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../include/osm_reader.h"
+#include "../include/graph.h"
+#include "../include/dijkstra.h"
+#include "../include/batch_query.h"
+#include "fixtures.h"
+
+// Resultado do lote igual ao de dijkstra() para o mesmo par
+static int mesmo_resultado(const ResultadoDijkstra *esperado, const ResultadoDijkstra *obtido, const ParConsulta *par) {
+    if (!esperado || !obtido) return !esperado && !obtido;
+    if (esperado->sucesso != obtido->sucesso) return 0;
+    if (!esperado->sucesso) return obtido->distancia_total < 0;
+    return fabs(esperado->distancia_total - obtido->distancia_total) < 1e-9 &&
+           obtido->tamanho_caminho > 0 && obtido->caminho[0] == par->origem &&
+           obtido->caminho[obtido->tamanho_caminho - 1] == par->destino;
+}
+
+static int comparar(Grafo *grafo, const char *nome, size_t num_pares) {
+    unsigned int estado = 77;
+    ParConsulta *pares = malloc(num_pares * sizeof(ParConsulta));
+    for (size_t i = 0; i < num_pares; i++) {
+        pares[i].origem = grafo->pontos[proximo_aleatorio(&estado) % grafo->num_pontos].id;
+        // Primeira metade com destinos próximos (consultas curtas), segunda
+        // com destinos quaisquer: fatias desequilibradas forçam roubos
+        size_t d = i < num_pares / 2 ? (size_t)buscar_indice_ponto(grafo, pares[i].origem)
+                                     : proximo_aleatorio(&estado) % grafo->num_pontos;
+        pares[i].destino = grafo->pontos[d].id;
+    }
+    pares[0].destino = -12345;  // Id inexistente: resultado NULL, como em dijkstra()
+
+    ResultadoDijkstra **esperados = malloc(num_pares * sizeof(ResultadoDijkstra*));
+    for (size_t i = 0; i < num_pares; i++) esperados[i] = dijkstra(grafo, pares[i].origem, pares[i].destino);
+
+    int falhas = 0;
+    printf("%s: %zu queries\n", nome, num_pares);
+    for (int threads = 1; threads <= 4; threads *= 2) {
+        ResultadoLote *lote = executar_lote(grafo, pares, num_pares, threads);
+        int divergencias = 0, trabalhadores_ruins = 0;
+        for (size_t i = 0; lote && i < num_pares; i++) {
+            if (!mesmo_resultado(esperados[i], lote->consultas[i].resultado, &pares[i])) divergencias++;
+            if (lote->consultas[i].trabalhador < 0 || lote->consultas[i].trabalhador >= lote->num_threads ||
+                lote->consultas[i].tempo_ms < 0) trabalhadores_ruins++;
+        }
+        printf("  %s %d thread(s): results in input order match dijkstra() (%d mismatches, %zu steals, %.2f ms)\n",
+               lote && !divergencias && !trabalhadores_ruins ? "✓" : "✗", threads, divergencias,
+               lote ? lote->roubos : 0, lote ? lote->tempo_total_ms : 0.0);
+        falhas += !lote || divergencias || trabalhadores_ruins;
+        liberar_resultado_lote(lote);
+    }
+    printf("\n");
+
+    for (size_t i = 0; i < num_pares; i++) liberar_resultado_dijkstra(esperados[i]);
+    free(esperados);
+    free(pares);
+    return falhas;
+}
+
+int main() {
+    printf("=== Testing Batch Query Engine ===\n\n");
+    int falhas = 0;
+
+    Grafo *grafo = ler_osm("test.osm");
+    if (!grafo) {
+        printf("ERROR: Failed to load test.osm\n");
+        return 1;
+    }
+    falhas += comparar(grafo, "test.osm", 300);
+    liberar_grafo(grafo);
+
+    grafo = ler_osm("test_oneway.osm");
+    if (grafo) {
+        falhas += comparar(grafo, "test_oneway.osm", 40);
+        liberar_grafo(grafo);
+    }
+
+    grafo = criar_grade_mao_unica(120, 5, 5, 1.2);
+    falhas += comparar(grafo, "grid 120x120 (synthetic)", 200);
+    liberar_grafo(grafo);
+
+    // Lote vazio e lote com um único par
+    grafo = ler_osm("test_oneway.osm");
+    if (grafo) {
+        ResultadoLote *vazio = executar_lote(grafo, NULL, 0, 4);
+        ParConsulta par = {grafo->pontos[0].id, grafo->pontos[0].id};
+        ResultadoLote *unico = executar_lote(grafo, &par, 1, 4);
+        int ok = vazio && vazio->num_consultas == 0 && unico && unico->num_consultas == 1 &&
+                 unico->consultas[0].resultado && unico->consultas[0].resultado->sucesso &&
+                 unico->consultas[0].resultado->distancia_total == 0.0;
+        printf("%s Empty batch and single self-query handled\n\n", ok ? "✓" : "✗");
+        falhas += !ok;
+        liberar_resultado_lote(vazio);
+        liberar_resultado_lote(unico);
+        liberar_grafo(grafo);
+    }
+
+    printf("=== Test completed ===\n");
+    return falhas ? 1 : 0;
+}
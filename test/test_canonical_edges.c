@@ -0,0 +1,155 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "../include/osm_reader.h"
+#include "../include/graph.h"
+#include "../include/dijkstra.h"
+#include "../include/edit.h"
+#include "../include/metrics.h"
+
+static int falhas = 0;
+
+static void verificar(int condicao, const char *descricao) {
+    printf("  %s %s\n", condicao ? "✓" : "✗", descricao);
+    if (!condicao) falhas++;
+}
+
+int main() {
+    printf("=== Testing Canonical Bidirectional Edges ===\n\n");
+
+    // 1. Loading OSM: each two-way segment must be stored once
+    printf("1. Loading test_oneway.osm...\n");
+    Grafo *grafo = ler_osm("test_oneway.osm");
+    if (!grafo) {
+        printf("ERROR: Failed to load test_oneway.osm\n");
+        return 1;
+    }
+    printf("  Edges: %zu (oneway: %d, bidirectional: %d)\n",
+           grafo->num_arestas, count_oneway_edges(grafo), count_bidirectional_edges(grafo));
+    verificar(grafo->num_arestas == 6, "6 road segments stored as 6 records");
+    verificar(count_oneway_edges(grafo) + count_bidirectional_edges(grafo) == (int)grafo->num_arestas,
+              "oneway + bidirectional counts match segment count");
+
+    const IndicesGrafo *indices = obter_indices(grafo);
+    verificar(indices && indices->num_arcos == 9, "adjacency expands 3 two-way + 3 oneway into 9 arcs");
+
+    ResultadoDijkstra *r = dijkstra(grafo, 2, 1);
+    verificar(r && r->sucesso && r->tamanho_caminho == 2, "two-way segment traversable against stored orientation");
+    liberar_resultado_dijkstra(r);
+    r = dijkstra(grafo, 3, 2);
+    verificar(r && !r->sucesso, "oneway segment still blocked in reverse");
+    liberar_resultado_dijkstra(r);
+
+    // 2. Oneway flip on a segment stored in the opposite orientation
+    printf("\n2. Changing direction of segment 3-4 to oneway 4 -> 3...\n");
+    EditState estado_edicao;
+    init_edit_state(&estado_edicao);
+    verificar(set_connection_direction(grafo, &estado_edicao, 4, 3, 0), "direction changed");
+    r = dijkstra(grafo, 4, 3);
+    verificar(r && r->sucesso, "4 -> 3 allowed");
+    liberar_resultado_dijkstra(r);
+    r = dijkstra(grafo, 3, 4);
+    verificar(r && !r->sucesso, "3 -> 4 blocked");
+    liberar_resultado_dijkstra(r);
+    liberar_grafo(grafo);
+
+    // 3. Mirrored records built programmatically are merged
+    printf("\n3. Canonicalizing mirrored records...\n");
+    grafo = criar_grafo();
+    adicionar_ponto(grafo, 10, 0.0, 0.0);
+    adicionar_ponto(grafo, 11, 0.0, 0.001);
+    adicionar_ponto(grafo, 12, 0.0, 0.002);
+    adicionar_aresta(grafo, 10, 11, 1.0);
+    adicionar_aresta(grafo, 11, 10, 1.0);   // Espelho bidirecional
+    adicionar_aresta(grafo, 11, 12, 2.0);
+    adicionar_aresta(grafo, 12, 11, 2.0);
+    grafo->arestas[2].is_bidirectional = 0;
+    grafo->arestas[3].is_bidirectional = 0; // Duas mãos únicas opostas de mesmo peso
+    size_t removidas = canonicalizar_arestas(grafo);
+    verificar(removidas == 2 && grafo->num_arestas == 2, "4 records collapsed into 2 segments");
+    verificar(count_bidirectional_edges(grafo) == 2, "both segments are bidirectional");
+    r = dijkstra(grafo, 12, 10);
+    verificar(r && r->sucesso && r->distancia_total == 3.0, "12 -> 10 distance 3.0");
+    liberar_resultado_dijkstra(r);
+
+    // Registros paralelos com atributos diferentes: a rodovia mais longa é
+    // mais rápida que a rua residencial e precisa sobreviver à fusão
+    adicionar_aresta(grafo, 10, 12, 3.0);
+    adicionar_aresta(grafo, 12, 10, 3.5);
+    adicionar_aresta(grafo, 10, 12, 3.2);  // Cópia residencial mais lenta que a primeira
+    garantir_atributos_arestas(grafo);
+    size_t rua = grafo->num_arestas - 3, rodovia = grafo->num_arestas - 2;
+    grafo->classe_via[rua] = VIA_RESIDENTIAL;
+    grafo->classe_via[rodovia] = VIA_MOTORWAY;
+    grafo->classe_via[grafo->num_arestas - 1] = VIA_RESIDENTIAL;
+    removidas = canonicalizar_arestas(grafo);
+    int rapida = 0, curta = 0;
+    for (size_t i = 0; i < grafo->num_arestas; i++) {
+        rapida += grafo->classe_via[i] == VIA_MOTORWAY && grafo->arestas[i].peso == 3.5;
+        curta += grafo->classe_via[i] == VIA_RESIDENTIAL && grafo->arestas[i].peso == 3.0;
+    }
+    verificar(removidas == 1 && rapida == 1 && curta == 1,
+              "faster motorway kept beside shorter street, dominated copy dropped");
+    double custo_rapido = 0.0, custo_curto = 0.0;
+    for (size_t i = 0; i < grafo->num_arestas; i++) {
+        if (grafo->classe_via[i] == VIA_MOTORWAY) custo_rapido = custo_aresta(grafo, i, METRICA_TEMPO);
+        if (grafo->classe_via[i] == VIA_RESIDENTIAL && grafo->arestas[i].peso == 3.0)
+            custo_curto = custo_aresta(grafo, i, METRICA_TEMPO);
+    }
+    verificar(custo_rapido < custo_curto, "motorway is the faster record in the time metric");
+
+    // 4. A two-way self-loop expands into two arcs at the same point, and
+    //    weight updates must reach both of them
+    printf("\n4. Updating a two-way self-loop...\n");
+    adicionar_aresta(grafo, 12, 12, 0.5);
+    size_t laco = grafo->num_arestas - 1;
+    size_t arcos[2] = {0, 0};
+    size_t n = arcos_da_aresta(grafo, laco, arcos);
+    verificar(n == 2 && arcos[0] != arcos[1], "both arcs of the loop found, not the same one twice");
+    AtualizacaoPeso mudanca = {laco, 4.0};
+    atualizar_pesos(grafo, &mudanca, 1);
+    indices = obter_indices(grafo);
+    int atualizados = 0;
+    for (size_t k = 0; k < indices->num_arcos; k++) {
+        atualizados += indices->arcos[k].aresta == laco && indices->arcos[k].peso == 4.0;
+    }
+    verificar(atualizados == 2, "update reaches both arcs");
+    liberar_grafo(grafo);
+
+    // 5. Edits keep the id map up to date: lookups after an edit must not
+    //    rebuild the adjacency, and must still find every point
+    printf("\n5. Looking up ids after edits...\n");
+    grafo = criar_grafo();
+    for (long long id = 1; id <= 300; id++) adicionar_ponto(grafo, id * 7, -16.7 + id * 1e-4, -49.2);
+    for (long long id = 1; id < 300; id++) adicionar_aresta(grafo, id * 7, (id + 1) * 7, 0.01);
+    obter_indices(grafo);
+    init_edit_state(&estado_edicao);
+    update_node_ids(&estado_edicao, grafo);
+    long long novo = estado_edicao.next_node_id;
+    int editou = create_node_at_position(grafo, &estado_edicao, -16.6, -49.2) &&
+                 connect_nodes(grafo, &estado_edicao, novo, 7) &&
+                 delete_node(grafo, &estado_edicao, 70) &&
+                 set_connection_direction(grafo, &estado_edicao, 7, 14, 0);
+    verificar(editou, "create, connect, delete and direction edits applied");
+    int consistentes = buscar_indice_ponto(grafo, 70) < 0;
+    for (size_t i = 0; i < grafo->num_pontos; i++) {
+        consistentes &= buscar_indice_ponto(grafo, grafo->pontos[i].id) == (ssize_t)i;
+    }
+    verificar(consistentes, "every remaining id maps to its position, the deleted one to -1");
+    verificar(grafo->indices == NULL, "lookups after edits do not build the adjacency");
+
+    // Remoções em sequência exercitam a retirada de vagas no meio dos aglomerados
+    for (size_t k = 0; k < 150; k++) remover_ponto(grafo, (k * 37) % grafo->num_pontos);
+    consistentes = 1;
+    for (size_t i = 0; i < grafo->num_pontos; i++) {
+        consistentes &= buscar_indice_ponto(grafo, grafo->pontos[i].id) == (ssize_t)i;
+    }
+    int ausentes = 0;
+    for (long long id = 1; id <= 300; id++) ausentes += buscar_indice_ponto(grafo, id * 7) < 0;
+    ausentes += buscar_indice_ponto(grafo, novo) < 0;
+    verificar(consistentes && ausentes == 301 - (int)grafo->num_pontos,
+              "map stays consistent after 150 removals");
+    liberar_grafo(grafo);
+
+    printf("\n=== Test completed: %s ===\n", falhas ? "FAILURES" : "all checks passed");
+    return falhas ? 1 : 0;
+}
@@ -0,0 +1,107 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../include/osm_reader.h"
+#include "../include/graph.h"
+#include "../include/dijkstra.h"
+#include "../include/compression.h"
+
+// Verifica se o caminho percorre apenas arcos existentes e soma o peso correto
+static int caminho_valido(Grafo *grafo, ResultadoDijkstra *r, long origem, long destino) {
+    if (r->tamanho_caminho < 1 || r->caminho[0] != origem || r->caminho[r->tamanho_caminho - 1] != destino)
+        return 0;
+    const IndicesGrafo *indices = obter_indices(grafo);
+    double total = 0.0;
+    for (int i = 0; i + 1 < r->tamanho_caminho; i++) {
+        ssize_t u = buscar_indice_ponto(grafo, r->caminho[i]);
+        ssize_t v = buscar_indice_ponto(grafo, r->caminho[i + 1]);
+        double melhor = -1.0;
+        for (size_t k = indices->inicio_arcos[u]; k < indices->inicio_arcos[u + 1]; k++) {
+            if ((ssize_t)indices->arcos[k].destino == v &&
+                (melhor < 0 || indices->arcos[k].peso < melhor)) {
+                melhor = indices->arcos[k].peso;
+            }
+        }
+        if (melhor < 0) return 0;
+        total += melhor;
+    }
+    return fabs(total - r->distancia_total) < 1e-9;
+}
+
+int main() {
+    printf("=== Testing Degree-2 Chain Compression ===\n\n");
+
+    Grafo *grafo = ler_osm("test.osm");
+    if (!grafo) {
+        printf("ERROR: Failed to load test.osm\n");
+        return 1;
+    }
+    GrafoComprimido *comprimido = comprimir_grafo(grafo);
+    if (!comprimido) {
+        printf("ERROR: Compression failed\n");
+        return 1;
+    }
+    printf("Original: %zu nodes, %zu edges\n", grafo->num_pontos, grafo->num_arestas);
+    printf("Compressed core: %zu nodes, %zu edges\n\n",
+           comprimido->nucleo->num_pontos, comprimido->nucleo->num_arestas);
+
+    int falhas = 0, encontrados = 0;
+    long long visitados_original = 0, visitados_comprimido = 0;
+    unsigned int semente = 12345;
+    for (int q = 0; q < 300; q++) {
+        semente = semente * 1103515245u + 12345u;
+        long origem = grafo->pontos[(semente >> 8) % grafo->num_pontos].id;
+        semente = semente * 1103515245u + 12345u;
+        long destino = grafo->pontos[(semente >> 8) % grafo->num_pontos].id;
+
+        ResultadoDijkstra *r1 = dijkstra(grafo, origem, destino);
+        ResultadoDijkstra *r2 = dijkstra_comprimido(comprimido, origem, destino);
+        if (!r1 || !r2 || r1->sucesso != r2->sucesso ||
+            (r1->sucesso && fabs(r1->distancia_total - r2->distancia_total) > 1e-9) ||
+            (r2->sucesso && !caminho_valido(grafo, r2, origem, destino))) {
+            printf("  ✗ Mismatch for %ld -> %ld\n", origem, destino);
+            falhas++;
+        } else if (r1->sucesso) {
+            encontrados++;
+        }
+        if (r1) visitados_original += r1->nos_visitados;
+        if (r2) visitados_comprimido += r2->nos_visitados;
+        liberar_resultado_dijkstra(r1);
+        liberar_resultado_dijkstra(r2);
+    }
+
+    printf("  %s 300 random queries match plain Dijkstra (%d with a path)\n", falhas ? "✗" : "✓", encontrados);
+    printf("  Settled nodes: %lld (plain) vs %lld (compressed), %.1fx fewer\n",
+           visitados_original, visitados_comprimido,
+           visitados_comprimido ? (double)visitados_original / visitados_comprimido : 0.0);
+
+    liberar_grafo_comprimido(comprimido);
+    liberar_grafo(grafo);
+
+    // Todos os pares no grafo com vias de mão única (cadeias direcionais)
+    grafo = ler_osm("test_oneway.osm");
+    comprimido = grafo ? comprimir_grafo(grafo) : NULL;
+    int falhas_mao_unica = 0;
+    for (size_t i = 0; comprimido && i < grafo->num_pontos; i++) {
+        for (size_t j = 0; j < grafo->num_pontos; j++) {
+            long origem = grafo->pontos[i].id, destino = grafo->pontos[j].id;
+            ResultadoDijkstra *r1 = dijkstra(grafo, origem, destino);
+            ResultadoDijkstra *r2 = dijkstra_comprimido(comprimido, origem, destino);
+            if (!r1 || !r2 || r1->sucesso != r2->sucesso ||
+                (r1->sucesso && (fabs(r1->distancia_total - r2->distancia_total) > 1e-9 ||
+                                 !caminho_valido(grafo, r2, origem, destino)))) {
+                falhas_mao_unica++;
+            }
+            liberar_resultado_dijkstra(r1);
+            liberar_resultado_dijkstra(r2);
+        }
+    }
+    printf("  %s All pairs on test_oneway.osm respect oneway chains\n",
+           comprimido && !falhas_mao_unica ? "✓" : "✗");
+    falhas += falhas_mao_unica + (comprimido ? 0 : 1);
+    liberar_grafo_comprimido(comprimido);
+    liberar_grafo(grafo);
+
+    printf("\n=== Test completed ===\n");
+    return falhas ? 1 : 0;
+}
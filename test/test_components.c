@@ -0,0 +1,138 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "../include/osm_reader.h"
+#include "../include/graph.h"
+#include "../include/dijkstra.h"
+#include "../include/components.h"
+
+// Alcançabilidade de referência: busca em largura a partir da origem
+static unsigned char* alcancaveis(Grafo *grafo, size_t origem) {
+    const IndicesGrafo *indices = obter_indices(grafo);
+    size_t n = grafo->num_pontos;
+    unsigned char *marcado = calloc(n, 1);
+    size_t *fila = malloc(n * sizeof(size_t));
+    size_t inicio = 0, fim = 0;
+    marcado[origem] = 1;
+    fila[fim++] = origem;
+    while (inicio < fim) {
+        size_t v = fila[inicio++];
+        for (size_t k = indices->inicio_arcos[v]; k < indices->inicio_arcos[v + 1]; k++) {
+            size_t w = indices->arcos[k].destino;
+            if (!marcado[w]) {
+                marcado[w] = 1;
+                fila[fim++] = w;
+            }
+        }
+    }
+    free(fila);
+    return marcado;
+}
+
+// Todos os pares (ou uma amostra): a rejeição nunca pode descartar um destino alcançável
+static int verificar_pares(Grafo *grafo, const char *nome, size_t max_origens) {
+    size_t n = grafo->num_pontos;
+    size_t passo = n > max_origens ? n / max_origens : 1;
+    long long rejeitadas = 0, inalcancaveis = 0, erradas = 0, divergentes = 0;
+
+    for (size_t s = 0; s < n; s += passo) {
+        unsigned char *marcado = alcancaveis(grafo, s);
+        for (size_t t = 0; t < n; t++) {
+            int possivel = alcance_possivel(grafo, s, t);
+            if (!marcado[t]) inalcancaveis++;
+            if (!possivel) rejeitadas++;
+            if (!possivel && marcado[t]) erradas++;
+        }
+        // Dijkstra (com poda por componente) concorda com a busca em largura
+        for (size_t t = 0; t < n; t += passo) {
+            ResultadoDijkstra *r = dijkstra(grafo, grafo->pontos[s].id, grafo->pontos[t].id);
+            if (!r || r->sucesso != marcado[t]) divergentes++;
+            liberar_resultado_dijkstra(r);
+        }
+        free(marcado);
+    }
+
+    const IndicesGrafo *indices = obter_componentes(grafo);
+    printf("%s: %zu strong / %zu weak components\n", nome,
+           indices->num_componentes_fortes, indices->num_componentes_fracas);
+    printf("  %s No reachable destination rejected (%lld errors)\n", erradas ? "✗" : "✓", erradas);
+    printf("  %s Dijkstra agrees with BFS reachability (%lld mismatches)\n", divergentes ? "✗" : "✓", divergentes);
+    printf("  Rejected instantly: %lld of %lld unreachable pairs\n\n", rejeitadas, inalcancaveis);
+    return (erradas || divergentes) ? 1 : 0;
+}
+
+int main() {
+    printf("=== Testing Connected Components ===\n\n");
+    int falhas = 0;
+
+    // Ciclo de mão única 1->2->3->1, via 3->4, rua 4-5 e ilha 6-7
+    Grafo *grafo = criar_grafo();
+    for (int i = 1; i <= 7; i++) adicionar_ponto(grafo, i, 0.0, i * 0.001);
+    adicionar_aresta(grafo, 1, 2, 1.0);
+    adicionar_aresta(grafo, 2, 3, 1.0);
+    adicionar_aresta(grafo, 3, 1, 1.0);
+    adicionar_aresta(grafo, 3, 4, 1.0);
+    adicionar_aresta(grafo, 4, 5, 1.0);
+    adicionar_aresta(grafo, 6, 7, 1.0);
+    for (size_t i = 0; i < 4; i++) grafo->arestas[i].is_bidirectional = 0;
+    invalidar_indices(grafo);
+
+    const IndicesGrafo *indices = obter_componentes(grafo);
+    const size_t *forte = indices->componente_forte;
+    const size_t *fraca = indices->componente_fraca;
+    int ok = indices->num_componentes_fortes == 3 && indices->num_componentes_fracas == 2 &&
+             forte[0] == forte[1] && forte[1] == forte[2] && forte[3] == forte[4] &&
+             forte[2] > forte[3] && forte[5] == forte[6] && forte[5] != forte[0] &&
+             fraca[0] == fraca[4] && fraca[0] != fraca[5];
+    printf("%s Small graph: 3 strong, 2 weak components in topological order\n", ok ? "✓" : "✗");
+    falhas += !ok;
+
+    ok = alcance_possivel(grafo, 0, 4) && !alcance_possivel(grafo, 4, 0) && !alcance_possivel(grafo, 0, 5);
+    printf("%s Reachability hints: 1->5 possible, 5->1 and 1->6 rejected\n", ok ? "✓" : "✗");
+    falhas += !ok;
+
+    ResultadoDijkstra *r = dijkstra(grafo, 5, 1);
+    ok = r && !r->sucesso && r->nos_visitados == 0;
+    printf("%s Dijkstra 5->1 fails without settling any node\n", ok ? "✓" : "✗");
+    falhas += !ok;
+    liberar_resultado_dijkstra(r);
+    r = dijkstra(grafo, 2, 5);
+    ok = r && r->sucesso && r->distancia_total == 3.0;
+    printf("%s Dijkstra 2->5 still finds the path (distance %.1f)\n\n", ok ? "✓" : "✗", r ? r->distancia_total : -1.0);
+    falhas += !ok;
+    liberar_resultado_dijkstra(r);
+    liberar_grafo(grafo);
+
+    // Cadeia de mão única longa: Tarjan recursivo estouraria a pilha
+    const int tamanho_cadeia = 1000000;
+    grafo = criar_grafo_com_capacidade(tamanho_cadeia, tamanho_cadeia - 1);
+    for (int i = 0; i < tamanho_cadeia; i++) {
+        adicionar_ponto(grafo, i + 1, 0.0, i * 1e-5);
+        if (i > 0) {
+            Aresta via = {i, i + 1, 1.0, 0};
+            adicionar_arestas(grafo, &via, 1);
+        }
+    }
+    indices = obter_componentes(grafo);
+    r = dijkstra(grafo, tamanho_cadeia, 1);
+    ok = indices && indices->num_componentes_fortes == (size_t)tamanho_cadeia &&
+         indices->num_componentes_fracas == 1 && r && !r->sucesso && r->nos_visitados == 0;
+    printf("%s Oneway chain of %d nodes: one component per node, reverse query rejected\n\n",
+           ok ? "✓" : "✗", tamanho_cadeia);
+    falhas += !ok;
+    liberar_resultado_dijkstra(r);
+    liberar_grafo(grafo);
+
+    const char *arquivos[] = {"test_oneway.osm", "test.osm"};
+    for (int i = 0; i < 2; i++) {
+        grafo = ler_osm(arquivos[i]);
+        if (!grafo) {
+            printf("ERROR: Failed to load %s\n", arquivos[i]);
+            return 1;
+        }
+        falhas += verificar_pares(grafo, arquivos[i], 60);
+        liberar_grafo(grafo);
+    }
+
+    printf("=== Test completed ===\n");
+    return falhas ? 1 : 0;
+}
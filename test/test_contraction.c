@@ -0,0 +1,120 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../include/osm_reader.h"
+#include "../include/graph.h"
+#include "../include/dijkstra.h"
+#include "../include/distance_matrix.h"
+#include "../include/contraction.h"
+#include "../include/timing.h"
+#include "fixtures.h"
+
+// O predecessor precisa ser vizinho do destino e fechar a distância
+static int predecessor_valido(Grafo *grafo, long origem, long destino, double d, long anterior) {
+    if (d < 0 || origem == destino) return anterior == -1;
+    const IndicesGrafo *indices = obter_indices(grafo);
+    ssize_t u = buscar_indice_ponto(grafo, anterior);
+    ssize_t v = buscar_indice_ponto(grafo, destino);
+    if (u < 0 || v < 0) return 0;
+    ResultadoDijkstra *r = dijkstra(grafo, origem, anterior);
+    int ok = 0;
+    for (size_t k = indices->inicio_arcos[u]; r && r->sucesso && k < indices->inicio_arcos[u + 1]; k++) {
+        if ((ssize_t)indices->arcos[k].destino == v &&
+            fabs(r->distancia_total + indices->arcos[k].peso - d) < 1e-9) ok = 1;
+    }
+    liberar_resultado_dijkstra(r);
+    return ok;
+}
+
+static int comparar(Grafo *grafo, const char *nome, size_t num_origens, size_t num_destinos) {
+    double inicio = agora_ms();
+    HierarquiaContracao *h = construir_hierarquia(grafo);
+    double tempo = agora_ms() - inicio;
+    if (!h) {
+        printf("%s: ✗ Failed to build hierarchy\n\n", nome);
+        return 1;
+    }
+    printf("%s: %zu nodes, %zu shortcuts, built in %.2f ms\n", nome, grafo->num_pontos, h->num_atalhos, tempo);
+
+    // Níveis formam uma permutação e os arcos só sobem
+    int niveis_ok = 1;
+    unsigned char *visto = calloc(grafo->num_pontos, 1);
+    for (size_t v = 0; v < grafo->num_pontos; v++) {
+        if (h->nivel[v] >= grafo->num_pontos || visto[h->nivel[v]]) niveis_ok = 0;
+        else visto[h->nivel[v]] = 1;
+        for (size_t k = h->inicio_subida[v]; k < h->inicio_subida[v + 1]; k++)
+            if (h->nivel[h->subida[k].destino] <= h->nivel[v]) niveis_ok = 0;
+        for (size_t k = h->inicio_descida[v]; k < h->inicio_descida[v + 1]; k++)
+            if (h->nivel[h->descida[k].destino] <= h->nivel[v]) niveis_ok = 0;
+    }
+    free(visto);
+    printf("  %s Levels are a permutation and every arc goes up\n", niveis_ok ? "✓" : "✗");
+
+    unsigned int estado = 41;
+    long *origens = malloc(num_origens * sizeof(long));
+    long *destinos = malloc(num_destinos * sizeof(long));
+    for (size_t i = 0; i < num_origens; i++) origens[i] = grafo->pontos[proximo_aleatorio(&estado) % grafo->num_pontos].id;
+    for (size_t j = 0; j < num_destinos; j++) destinos[j] = grafo->pontos[proximo_aleatorio(&estado) % grafo->num_pontos].id;
+    // Casos de borda: destino repetido, destino igual a uma origem e id inexistente
+    destinos[1] = destinos[0];
+    destinos[2] = origens[0];
+    origens[num_origens - 1] = -12345;
+    destinos[num_destinos - 1] = -12345;
+
+    int falhas = !niveis_ok;
+    MatrizDistancias *referencia = matriz_distancias(grafo, origens, num_origens, destinos, num_destinos, 0, 1);
+    for (int threads = 1; threads <= 4; threads *= 4) {
+        MatrizDistancias *m = matriz_distancias_hierarquia(h, grafo, origens, num_origens,
+                                                           destinos, num_destinos, 1, threads);
+        int divergencias = 0, predecessores_ruins = 0;
+        for (size_t i = 0; m && referencia && i < num_origens; i++) {
+            for (size_t j = 0; j < num_destinos; j++) {
+                double esperado = distancia_na_matriz(referencia, i, j);
+                double obtido = distancia_na_matriz(m, i, j);
+                if ((esperado < 0) != (obtido < 0) || fabs(esperado - obtido) > 1e-9) divergencias++;
+                if ((i * num_destinos + j) % 17 == 0 &&
+                    !predecessor_valido(grafo, origens[i], destinos[j], obtido, m->predecessores[i * num_destinos + j]))
+                    predecessores_ruins++;
+            }
+        }
+        printf("  %s %d thread(s): bucket many-to-many matches per-source searches (%d mismatches)\n",
+               m && referencia && !divergencias ? "✓" : "✗", threads, divergencias);
+        printf("  %s %d thread(s): sampled predecessors close the distance\n",
+               m && !predecessores_ruins ? "✓" : "✗", threads);
+        falhas += !m || !referencia || divergencias || predecessores_ruins;
+        liberar_matriz_distancias(m);
+    }
+    printf("\n");
+
+    liberar_matriz_distancias(referencia);
+    free(origens);
+    free(destinos);
+    liberar_hierarquia(h);
+    return falhas;
+}
+
+int main() {
+    printf("=== Testing Contraction Hierarchy Many-to-Many ===\n\n");
+    int falhas = 0;
+
+    Grafo *grafo = ler_osm("test.osm");
+    if (!grafo) {
+        printf("ERROR: Failed to load test.osm\n");
+        return 1;
+    }
+    falhas += comparar(grafo, "test.osm", 15, 20);
+    liberar_grafo(grafo);
+
+    grafo = ler_osm("test_oneway.osm");
+    if (grafo) {
+        falhas += comparar(grafo, "test_oneway.osm", 10, 10);
+        liberar_grafo(grafo);
+    }
+
+    grafo = criar_grade_mao_unica(80, 13, 5, 1.2);
+    falhas += comparar(grafo, "grid 80x80 (synthetic)", 40, 50);
+    liberar_grafo(grafo);
+
+    printf("=== Test completed ===\n");
+    return falhas ? 1 : 0;
+}
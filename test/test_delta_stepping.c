@@ -0,0 +1,68 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <float.h>
+#include "../include/osm_reader.h"
+#include "../include/graph.h"
+#include "../include/dijkstra.h"
+#include "../include/delta_stepping.h"
+#include "fixtures.h"
+
+// Diferença permitida: a soma pode seguir outro caminho de mesmo comprimento
+static int distancias_iguais(const double *a, const double *b, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        if ((a[i] == DBL_MAX) != (b[i] == DBL_MAX)) return 0;
+        if (a[i] != DBL_MAX && fabs(a[i] - b[i]) > 1e-9 * (1.0 + a[i])) return 0;
+    }
+    return 1;
+}
+
+static int comparar(Grafo *grafo, const char *nome, int num_origens) {
+    int falhas = 0;
+    int threads[] = {1, 2, 4};
+    double deltas[] = {0.0, 0.05, 10.0}; // Padrão, estreito e largo (vira Bellman-Ford)
+    for (int q = 0; q < num_origens; q++) {
+        long origem = grafo->pontos[(size_t)q * 7919 % grafo->num_pontos].id;
+        double *referencia = dijkstra_distancias(grafo, origem);
+        for (int t = 0; t < 3; t++) {
+            for (int d = 0; d < 3; d++) {
+                double *paralelo = delta_stepping(grafo, origem, deltas[d], threads[t]);
+                if (!referencia || !paralelo || !distancias_iguais(referencia, paralelo, grafo->num_pontos)) {
+                    printf("  ✗ Mismatch from %ld with %d threads, delta %.2f\n", origem, threads[t], deltas[d]);
+                    falhas++;
+                }
+                free(paralelo);
+            }
+        }
+        free(referencia);
+    }
+    printf("%s %s: %d sources x {1,2,4} threads x 3 deltas match full Dijkstra\n",
+           falhas ? "✗" : "✓", nome, num_origens);
+    return falhas;
+}
+
+int main() {
+    printf("=== Testing Parallel Delta-Stepping ===\n\n");
+    int falhas = 0;
+
+    Grafo *grafo = ler_osm("test.osm");
+    if (!grafo) {
+        printf("ERROR: Failed to load test.osm\n");
+        return 1;
+    }
+    falhas += comparar(grafo, "test.osm", 10);
+    liberar_grafo(grafo);
+
+    grafo = ler_osm("test_oneway.osm");
+    if (grafo) {
+        falhas += comparar(grafo, "test_oneway.osm", 5);
+        liberar_grafo(grafo);
+    }
+
+    grafo = criar_grade_mao_unica(150, 3, 5, 0.7);
+    falhas += comparar(grafo, "grid 150x150 (synthetic)", 4);
+    liberar_grafo(grafo);
+
+    printf("\n=== Test completed ===\n");
+    return falhas ? 1 : 0;
+}
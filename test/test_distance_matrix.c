@@ -0,0 +1,117 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../include/osm_reader.h"
+#include "../include/graph.h"
+#include "../include/dijkstra.h"
+#include "../include/distance_matrix.h"
+#include "fixtures.h"
+
+// O predecessor precisa ser vizinho do destino e fechar a distância
+static int predecessor_valido(Grafo *grafo, const MatrizDistancias *m, long origem, long destino,
+                              size_t i, size_t j) {
+    double d = distancia_na_matriz(m, i, j);
+    long anterior = m->predecessores[i * m->num_destinos + j];
+    if (d < 0 || origem == destino) return anterior == -1;
+    const IndicesGrafo *indices = obter_indices(grafo);
+    ssize_t u = buscar_indice_ponto(grafo, anterior);
+    ssize_t v = buscar_indice_ponto(grafo, destino);
+    if (u < 0 || v < 0) return 0;
+    double *ate_anterior = dijkstra_distancias(grafo, origem);
+    int ok = 0;
+    for (size_t k = indices->inicio_arcos[u]; k < indices->inicio_arcos[u + 1]; k++) {
+        if ((ssize_t)indices->arcos[k].destino == v &&
+            fabs(ate_anterior[u] + indices->arcos[k].peso - d) < 1e-9) ok = 1;
+    }
+    free(ate_anterior);
+    return ok;
+}
+
+static int comparar(Grafo *grafo, const char *nome, size_t num_origens, size_t num_destinos) {
+    unsigned int estado = 31;
+    long *origens = malloc(num_origens * sizeof(long));
+    long *destinos = malloc(num_destinos * sizeof(long));
+    for (size_t i = 0; i < num_origens; i++) origens[i] = grafo->pontos[proximo_aleatorio(&estado) % grafo->num_pontos].id;
+    for (size_t j = 0; j < num_destinos; j++) destinos[j] = grafo->pontos[proximo_aleatorio(&estado) % grafo->num_pontos].id;
+    // Casos de borda: destino repetido, destino igual a uma origem e id inexistente
+    destinos[1] = destinos[0];
+    destinos[2] = origens[0];
+    origens[num_origens - 1] = -12345;
+    destinos[num_destinos - 1] = -12345;
+
+    int falhas = 0;
+    printf("%s: %zu x %zu table\n", nome, num_origens, num_destinos);
+    for (int threads = 1; threads <= 4; threads *= 4) {
+        MatrizDistancias *m = matriz_distancias(grafo, origens, num_origens, destinos, num_destinos, 1, threads);
+        int divergencias = 0, predecessores_ruins = 0, alcancados = 0;
+        for (size_t i = 0; m && i < num_origens; i++) {
+            for (size_t j = 0; j < num_destinos; j++) {
+                ResultadoDijkstra *r = dijkstra(grafo, origens[i], destinos[j]);
+                double esperado = (r && r->sucesso) ? r->distancia_total : -1.0;
+                double obtido = distancia_na_matriz(m, i, j);
+                if ((esperado < 0) != (obtido < 0) || fabs(esperado - obtido) > 1e-9) divergencias++;
+                if (obtido >= 0) alcancados++;
+                // Verificar predecessores numa amostra (cada verificação é uma busca completa)
+                if ((i * num_destinos + j) % 37 == 0 && !predecessor_valido(grafo, m, origens[i], destinos[j], i, j))
+                    predecessores_ruins++;
+                liberar_resultado_dijkstra(r);
+            }
+        }
+        printf("  %s %d thread(s): distances match dijkstra() (%d mismatches, %d reachable cells)\n",
+               m && !divergencias ? "✓" : "✗", threads, divergencias, alcancados);
+        printf("  %s %d thread(s): sampled predecessors close the distance\n",
+               m && !predecessores_ruins ? "✓" : "✗", threads);
+        falhas += !m || divergencias || predecessores_ruins;
+        liberar_matriz_distancias(m);
+    }
+
+    // Um espaço de busca reaproveitado por várias consultas dá as mesmas linhas
+    MatrizDistancias *referencia = matriz_distancias(grafo, origens, num_origens, destinos, num_destinos, 0, 1);
+    EspacoBusca *espaco = criar_espaco_busca(grafo->num_pontos);
+    double *linha = malloc(num_destinos * sizeof(double));
+    int linhas_diferentes = !referencia || !espaco || !linha;
+    for (size_t i = 0; !linhas_diferentes && i < num_origens; i++) {
+        if (distancias_um_para_muitos(grafo, espaco, origens[i], destinos, num_destinos, linha, NULL) != 0) {
+            linhas_diferentes++;
+            break;
+        }
+        for (size_t j = 0; j < num_destinos; j++) {
+            if (linha[j] != distancia_na_matriz(referencia, i, j)) linhas_diferentes++;
+        }
+    }
+    printf("  %s Reused workspace reproduces every row\n\n", linhas_diferentes ? "✗" : "✓");
+    falhas += linhas_diferentes != 0;
+
+    free(linha);
+    liberar_espaco_busca(espaco);
+    liberar_matriz_distancias(referencia);
+    free(origens);
+    free(destinos);
+    return falhas;
+}
+
+int main() {
+    printf("=== Testing Distance Matrix ===\n\n");
+    int falhas = 0;
+
+    Grafo *grafo = ler_osm("test.osm");
+    if (!grafo) {
+        printf("ERROR: Failed to load test.osm\n");
+        return 1;
+    }
+    falhas += comparar(grafo, "test.osm", 12, 15);
+    liberar_grafo(grafo);
+
+    grafo = ler_osm("test_oneway.osm");
+    if (grafo) {
+        falhas += comparar(grafo, "test_oneway.osm", 10, 10);
+        liberar_grafo(grafo);
+    }
+
+    grafo = criar_grade_mao_unica(60, 7, 5, 1.2);
+    falhas += comparar(grafo, "grid 60x60 (synthetic)", 20, 25);
+    liberar_grafo(grafo);
+
+    printf("=== Test completed ===\n");
+    return falhas ? 1 : 0;
+}
@@ -0,0 +1,162 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <float.h>
+#include <math.h>
+#include "../include/osm_reader.h"
+#include "../include/graph.h"
+#include "../include/dijkstra.h"
+#include "../include/dynamic_sssp.h"
+#include "fixtures.h"
+
+// Compara a árvore com um dijkstra_distancias() do zero sobre os pesos atuais
+static int arvore_correta(Grafo *grafo, const ArvoreDinamica *arvore) {
+    double *esperado = dijkstra_distancias(grafo, arvore->origem_id);
+    if (!esperado) return 0;
+    int ok = 1;
+    for (size_t i = 0; i < grafo->num_pontos && ok; i++) {
+        if (esperado[i] == DBL_MAX || arvore->distancias[i] == DBL_MAX) {
+            ok = esperado[i] == arvore->distancias[i];
+        } else {
+            ok = fabs(esperado[i] - arvore->distancias[i]) < 1e-9;
+        }
+    }
+    free(esperado);
+    return ok;
+}
+
+// Lote aleatório: metade dos pesos sobe (até 3x), metade desce (até 10x menor)
+static void sortear_lote(Grafo *grafo, AtualizacaoPeso *lote, size_t quantidade, unsigned int *estado) {
+    for (size_t i = 0; i < quantidade; i++) {
+        lote[i].aresta = proximo_aleatorio(estado) % grafo->num_arestas;
+        double fator = (proximo_aleatorio(estado) % 2) ? 1.0 + (proximo_aleatorio(estado) % 200) / 100.0
+                                                       : 0.1 + (proximo_aleatorio(estado) % 90) / 100.0;
+        lote[i].peso = grafo->arestas[lote[i].aresta].peso * fator;
+    }
+}
+
+int main() {
+    printf("=== Testing Dynamic Shortest-Path Tree Repair ===\n\n");
+    int falhas = 0;
+
+    Grafo *grafo = ler_osm("test.osm");
+    if (!grafo || grafo->num_arestas == 0) {
+        printf("ERROR: Failed to load test.osm\n");
+        return 1;
+    }
+
+    // Lote inválido é rejeitado sem alterar nada
+    double peso_antes = grafo->arestas[0].peso;
+    AtualizacaoPeso invalidas[2] = {{0, peso_antes * 2.0}, {grafo->num_arestas, 1.0}};
+    int rejeitado = atualizar_pesos(grafo, invalidas, 2) == -1 && grafo->arestas[0].peso == peso_antes;
+    AtualizacaoPeso negativa = {0, -1.0};
+    rejeitado = rejeitado && atualizar_pesos(grafo, &negativa, 1) == -1;
+    printf("%s Invalid batches are rejected before any weight changes\n", rejeitado ? "✓" : "✗");
+    falhas += !rejeitado;
+
+    // Os arcos corrigidos no lugar batem com índices reconstruídos do zero
+    unsigned int estado = 17;
+    AtualizacaoPeso lote[200];
+    const IndicesGrafo *indices = obter_indices(grafo);
+    sortear_lote(grafo, lote, 200, &estado);
+    int alteradas = atualizar_pesos(grafo, lote, 200);
+    size_t num_arcos = indices->num_arcos;
+    double *corrigidos = malloc(num_arcos * sizeof(double));
+    for (size_t k = 0; k < num_arcos; k++) corrigidos[k] = indices->arcos[k].peso;
+    invalidar_indices(grafo);
+    indices = obter_indices(grafo);
+    int iguais = indices && indices->num_arcos == num_arcos;
+    for (size_t k = 0; iguais && k < num_arcos; k++) iguais = corrigidos[k] == indices->arcos[k].peso;
+    free(corrigidos);
+    printf("%s Patched arc weights match a rebuilt index (%d edges changed)\n",
+           iguais && alteradas > 0 ? "✓" : "✗", alteradas);
+    falhas += !iguais || alteradas <= 0;
+
+    // Reparos sucessivos, de lotes pequenos e grandes, contra recálculo do zero
+    long origem = grafo->pontos[proximo_aleatorio(&estado) % grafo->num_pontos].id;
+    ArvoreDinamica *arvore = criar_arvore_dinamica(grafo, origem);
+    int inicial = arvore && arvore_correta(grafo, arvore);
+    printf("%s Initial tree matches dijkstra_distancias()\n", inicial ? "✓" : "✗");
+    falhas += !inicial;
+
+    size_t tamanhos[] = {1, 1, 5, 20, 200};
+    int rodadas_ok = 0, reparados = 0;
+    for (int r = 0; arvore && r < 50; r++) {
+        size_t quantidade = tamanhos[r % 5];
+        sortear_lote(grafo, lote, quantidade, &estado);
+        if (atualizar_pesos(grafo, lote, quantidade) < 0) break;
+        int n = reparar_arvore_dinamica(arvore, lote, quantidade);
+        if (n < 0 || !arvore_correta(grafo, arvore)) break;
+        reparados += n;
+        rodadas_ok++;
+    }
+    printf("%s 50 repaired batches match full recomputation (%d/50, %d points re-settled)\n",
+           rodadas_ok == 50 ? "✓" : "✗", rodadas_ok, reparados);
+    falhas += rodadas_ok != 50;
+
+    // Uma mudança fora da árvore que não encurta nada não reestabelece ninguém
+    int sem_trabalho = 0;
+    for (size_t e = 0; arvore && e < grafo->num_arestas && !sem_trabalho; e++) {
+        size_t arcos[2];
+        size_t n = arcos_da_aresta(grafo, e, arcos);
+        int na_arvore = 0;
+        for (size_t j = 0; j < n; j++) {
+            na_arvore |= arvore->arco_pai[indices->arcos[arcos[j]].destino] == arcos[j];
+        }
+        if (n == 0 || na_arvore) continue;
+        AtualizacaoPeso mais_pesada = {e, grafo->arestas[e].peso * 2.0 + 0.001};
+        atualizar_pesos(grafo, &mais_pesada, 1);
+        sem_trabalho = reparar_arvore_dinamica(arvore, &mais_pesada, 1) == 0 && arvore_correta(grafo, arvore);
+    }
+    printf("%s Raising a non-tree edge re-settles no points\n", sem_trabalho ? "✓" : "✗");
+    falhas += !sem_trabalho;
+
+    // Caminho pela árvore tem a mesma distância que o dijkstra()
+    int caminhos_ok = 1;
+    for (int q = 0; arvore && q < 50; q++) {
+        long destino = grafo->pontos[proximo_aleatorio(&estado) % grafo->num_pontos].id;
+        ResultadoDijkstra *esperado = dijkstra(grafo, origem, destino);
+        ResultadoDijkstra *obtido = caminho_arvore_dinamica(arvore, destino);
+        if (!esperado || !obtido || esperado->sucesso != obtido->sucesso ||
+            (obtido->sucesso && (fabs(esperado->distancia_total - obtido->distancia_total) > 1e-9 ||
+                                 obtido->caminho[0] != origem ||
+                                 obtido->caminho[obtido->tamanho_caminho - 1] != destino))) {
+            caminhos_ok = 0;
+        }
+        liberar_resultado_dijkstra(esperado);
+        liberar_resultado_dijkstra(obtido);
+    }
+    printf("%s Paths read from the tree match dijkstra()\n", caminhos_ok ? "✓" : "✗");
+    falhas += !caminhos_ok;
+
+    // Índices reconstruídos (grafo editado): a árvore é montada de novo
+    invalidar_indices(grafo);
+    int remontada = arvore && reparar_arvore_dinamica(arvore, NULL, 0) >= 0 && arvore_correta(grafo, arvore);
+    printf("%s Tree is rebuilt after the graph indices are invalidated\n", remontada ? "✓" : "✗");
+    falhas += !remontada;
+
+    liberar_arvore_dinamica(arvore);
+    liberar_grafo(grafo);
+
+    // Mão única 2->3 invertida no lugar, como set_connection_direction():
+    // mesmo número de arcos, e os índices novos podem reusar o endereço
+    Grafo *via = criar_grafo();
+    for (long long id = 1; id <= 4; id++) adicionar_ponto(via, id, -16.7, -49.2 + id * 0.001);
+    Aresta trechos[3] = {{1, 2, 1.0, 0}, {2, 3, 1.0, 0}, {3, 4, 1.0, 0}};
+    adicionar_arestas(via, trechos, 3);
+    ArvoreDinamica *arvore_via = criar_arvore_dinamica(via, 1);
+    via->arestas[1].origem = 3;
+    via->arestas[1].destino = 2;
+    invalidar_indices(via);
+    ResultadoDijkstra *ate_3 = NULL;
+    int invertida = arvore_via && reparar_arvore_dinamica(arvore_via, NULL, 0) >= 0 && arvore_correta(via, arvore_via);
+    if (invertida) ate_3 = caminho_arvore_dinamica(arvore_via, 3);
+    invertida = invertida && ate_3 && !ate_3->sucesso;
+    printf("%s Tree is rebuilt after a one-way edge is reversed in place\n", invertida ? "✓" : "✗");
+    falhas += !invertida;
+    liberar_resultado_dijkstra(ate_3);
+    liberar_arvore_dinamica(arvore_via);
+    liberar_grafo(via);
+
+    printf("\n=== Test completed ===\n");
+    return falhas ? 1 : 0;
+}
@@ -99,15 +99,18 @@ int main() {
     printf("📋 Original state:\n");
     print_edge_stats(grafo);
     
+    EditState edit_state;
+    init_edit_state(&edit_state);
+    
     printf("\n🔄 Converting bidirectional street 1↔2 to oneway 1→2:\n");
-    if (set_connection_direction(grafo, 1, 2, 0)) {
+    if (set_connection_direction(grafo, &edit_state, 1, 2, 0)) {
         print_edge_stats(grafo);
         test_path_with_explanation(grafo, 1, 2, "Testing modified street (forward)");
         test_path_with_explanation(grafo, 2, 1, "Testing modified street (reverse - should fail)");
     }
     
     printf("\n🔄 Restoring street 1↔2 to bidirectional:\n");
-    if (set_connection_direction(grafo, 1, 2, 1)) {
+    if (set_connection_direction(grafo, &edit_state, 1, 2, 1)) {
         print_edge_stats(grafo);
         test_path_with_explanation(grafo, 2, 1, "Testing restored bidirectional street");
     }
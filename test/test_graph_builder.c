@@ -0,0 +1,93 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdalign.h>
+#include "../include/osm_reader.h"
+#include "../include/graph.h"
+#include "../include/arena.h"
+#include "../include/dijkstra.h"
+#include "../include/timing.h"
+
+int main() {
+    printf("=== Testing Graph Builder and Arena ===\n\n");
+    int falhas = 0;
+    int ok;
+
+    // Arena: alinhamento, pedidos maiores que o bloco e liberação única
+    Arena *arena = arena_criar(256);
+    int alinhados = 1;
+    for (int i = 1; i < 200; i++) {
+        void *p = arena_alocar(arena, (size_t)i);
+        if (!p || (uintptr_t)p % alignof(max_align_t) != 0) alinhados = 0;
+    }
+    double *grande = arena_alocar_zerado(arena, 10000 * sizeof(double));
+    ok = alinhados && grande && grande[0] == 0.0 && grande[9999] == 0.0;
+    printf("%s Arena: 200 aligned allocations and one oversized block\n", ok ? "✓" : "✗");
+    falhas += !ok;
+    arena_liberar(arena);
+
+    // Inserção um a um: custo amortizado constante, capacidade no máximo o dobro
+    const int lado = 1000;
+    double inicio = agora_ms();
+    Grafo *grafo = criar_grafo();
+    for (int i = 0; i < lado * lado; i++) {
+        adicionar_ponto(grafo, i + 1, (i / lado) * 0.001, (i % lado) * 0.001);
+    }
+    for (int r = 0; r < lado; r++) {
+        for (int c = 0; c < lado; c++) {
+            long long id = (long long)r * lado + c + 1;
+            if (c + 1 < lado) adicionar_aresta(grafo, id, id + 1, 0.1);
+            if (r + 1 < lado) adicionar_aresta(grafo, id, id + lado, 0.1);
+        }
+    }
+    double tempo_individual = agora_ms() - inicio;
+    ok = grafo->num_pontos == (size_t)lado * lado && grafo->num_arestas == (size_t)2 * lado * (lado - 1) &&
+         grafo->capacidade_pontos < 2 * grafo->num_pontos && grafo->capacidade_arestas < 2 * grafo->num_arestas;
+    printf("%s One-by-one: %zu points, %zu edges in %.1f ms (capacity %zu / %zu)\n", ok ? "✓" : "✗",
+           grafo->num_pontos, grafo->num_arestas, tempo_individual,
+           grafo->capacidade_pontos, grafo->capacidade_arestas);
+    falhas += !ok;
+
+    // Em lote, com reserva: uma única alocação por vetor
+    inicio = agora_ms();
+    Grafo *lote = criar_grafo_com_capacidade(grafo->num_pontos, grafo->num_arestas);
+    Ponto *pontos_reservados = lote->pontos;
+    Aresta *arestas_reservadas = lote->arestas;
+    adicionar_pontos(lote, grafo->pontos, grafo->num_pontos);
+    adicionar_arestas(lote, grafo->arestas, grafo->num_arestas);
+    double tempo_lote = agora_ms() - inicio;
+    ok = lote->num_pontos == grafo->num_pontos && lote->num_arestas == grafo->num_arestas &&
+         lote->pontos == pontos_reservados && lote->arestas == arestas_reservadas &&
+         lote->pontos[lado * lado - 1].id == (long long)lado * lado;
+    printf("%s Bulk append into reserved graph: %.1f ms, no reallocation\n", ok ? "✓" : "✗", tempo_lote);
+    falhas += !ok;
+
+    // Os índices (e componentes) da cópia respondem como os do original
+    ResultadoDijkstra *r1 = dijkstra(grafo, 1, (long)lado * lado);
+    ResultadoDijkstra *r2 = dijkstra(lote, 1, (long)lado * lado);
+    ok = r1 && r2 && r1->sucesso && r2->sucesso && r1->distancia_total == r2->distancia_total;
+    printf("%s Corner-to-corner query identical on both graphs (%.1f km)\n", ok ? "✓" : "✗",
+           r1 ? r1->distancia_total : -1.0);
+    falhas += !ok;
+    liberar_resultado_dijkstra(r1);
+    liberar_resultado_dijkstra(r2);
+    liberar_grafo(grafo);
+    liberar_grafo(lote);
+
+    // Leitura de OSM direto no grafo
+    inicio = agora_ms();
+    grafo = ler_osm("test.osm");
+    double tempo_osm = agora_ms() - inicio;
+    ok = grafo && grafo->num_pontos > 0 && grafo->num_arestas > 0;
+    int pesos_ok = ok;
+    for (size_t i = 0; ok && i < grafo->num_arestas; i++) {
+        if (!(grafo->arestas[i].peso >= 0.0 && grafo->arestas[i].peso < 5.0)) pesos_ok = 0;
+    }
+    printf("%s test.osm: %zu points, %zu edges, plausible weights, %.1f ms\n", (ok && pesos_ok) ? "✓" : "✗",
+           grafo ? grafo->num_pontos : 0, grafo ? grafo->num_arestas : 0, tempo_osm);
+    falhas += !(ok && pesos_ok);
+    liberar_grafo(grafo);
+
+    printf("\n=== Test completed ===\n");
+    return falhas ? 1 : 0;
+}
@@ -0,0 +1,118 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../include/osm_reader.h"
+#include "../include/graph.h"
+#include "../include/dijkstra.h"
+#include "../include/tree_pruning.h"
+#include "../include/incremental_search.h"
+#include "../include/timing.h"
+#include "fixtures.h"
+
+static int mesmo_resultado(const ResultadoDijkstra *a, const ResultadoDijkstra *b, long origem, long destino) {
+    if (!a || !b) return !a && !b;
+    if (a->sucesso != b->sucesso) return 0;
+    if (!a->sucesso) return 1;
+    return fabs(a->distancia_total - b->distancia_total) < 1e-9 && b->tamanho_caminho > 0 &&
+           b->caminho[0] == origem && b->caminho[b->tamanho_caminho - 1] == destino;
+}
+
+int main() {
+    printf("=== Testing Incremental Search Reuse ===\n\n");
+    int falhas = 0;
+
+    Grafo *grafo = ler_osm("test.osm");
+    if (!grafo) {
+        printf("ERROR: Failed to load test.osm\n");
+        return 1;
+    }
+
+    // Uma origem, vários destinos: cada resposta igual à do dijkstra()
+    unsigned int estado = 11;
+    long origem = grafo->pontos[proximo_aleatorio(&estado) % grafo->num_pontos].id;
+    BuscaIncremental *busca = criar_busca_incremental(grafo, origem);
+    int divergencias = 0, total_visitados = 0;
+    for (int q = 0; busca && q < 200; q++) {
+        long destino = grafo->pontos[proximo_aleatorio(&estado) % grafo->num_pontos].id;
+        ResultadoDijkstra *esperado = dijkstra(grafo, origem, destino);
+        ResultadoDijkstra *obtido = continuar_busca_incremental(busca, destino);
+        if (!mesmo_resultado(esperado, obtido, origem, destino)) divergencias++;
+        if (obtido) total_visitados += obtido->nos_visitados;
+        liberar_resultado_dijkstra(esperado);
+        liberar_resultado_dijkstra(obtido);
+    }
+    printf("%s 200 destinations from one origin match dijkstra() (%d mismatches)\n",
+           busca && !divergencias ? "✓" : "✗", divergencias);
+    // Nenhum ponto é estabelecido duas vezes ao longo das consultas
+    int sem_repeticao = busca && (size_t)total_visitados == busca->num_estabelecidos &&
+                        busca->num_estabelecidos <= grafo->num_pontos;
+    printf("%s Settled %d points in total across all queries (graph has %zu)\n",
+           sem_repeticao ? "✓" : "✗", total_visitados, grafo->num_pontos);
+    falhas += !busca || divergencias || !sem_repeticao;
+
+    // A segunda consulta ao mesmo destino já o encontra estabelecido
+    int instantaneo = 1;
+    double inicio = agora_ms();
+    for (int q = 0; busca && q < 200; q++) {
+        long destino = grafo->pontos[q % grafo->num_pontos].id;
+        ResultadoDijkstra *r = continuar_busca_incremental(busca, destino);
+        if (!r) instantaneo = 0;
+        liberar_resultado_dijkstra(r);
+        r = continuar_busca_incremental(busca, destino);
+        if (!r || r->nos_visitados != 0) instantaneo = 0;
+        liberar_resultado_dijkstra(r);
+    }
+    printf("%s Re-querying settled destinations settles nothing (%.3f ms for 200 retargets)\n\n",
+           instantaneo ? "✓" : "✗", agora_ms() - inicio);
+    falhas += !instantaneo;
+    liberar_busca_incremental(busca);
+
+    // Pelo núcleo de roteamento, alternando origens (inclusive dentro de árvores podadas)
+    NucleoRoteamento *nucleo = construir_nucleo_roteamento(grafo);
+    BuscaIncremental *busca_nucleo = NULL;
+    divergencias = 0;
+    int reaproveitadas = 0;
+    for (int q = 0; nucleo && q < 300; q++) {
+        if (q % 30 == 0) origem = grafo->pontos[proximo_aleatorio(&estado) % grafo->num_pontos].id;
+        long destino = grafo->pontos[proximo_aleatorio(&estado) % grafo->num_pontos].id;
+        BuscaIncremental *anterior = busca_nucleo;
+        ResultadoDijkstra *esperado = dijkstra(grafo, origem, destino);
+        ResultadoDijkstra *obtido = dijkstra_nucleo_incremental(nucleo, &busca_nucleo, origem, destino);
+        if (!mesmo_resultado(esperado, obtido, origem, destino)) divergencias++;
+        if (anterior && anterior == busca_nucleo) reaproveitadas++;
+        liberar_resultado_dijkstra(esperado);
+        liberar_resultado_dijkstra(obtido);
+    }
+    printf("%s Routing core with resumed search matches dijkstra() (%d mismatches, %d queries reused the search)\n\n",
+           nucleo && !divergencias && reaproveitadas > 0 ? "✓" : "✗", divergencias, reaproveitadas);
+    falhas += !nucleo || divergencias || reaproveitadas == 0;
+    liberar_busca_incremental(busca_nucleo);
+    liberar_nucleo_roteamento(nucleo);
+    liberar_grafo(grafo);
+
+    // Vias de mão única: destinos inalcançáveis não estragam o estado
+    grafo = ler_osm("test_oneway.osm");
+    if (grafo) {
+        divergencias = 0;
+        for (size_t o = 0; o < grafo->num_pontos; o++) {
+            busca = criar_busca_incremental(grafo, grafo->pontos[o].id);
+            for (int volta = 0; volta < 2; volta++) {
+                for (size_t d = 0; d < grafo->num_pontos; d++) {
+                    ResultadoDijkstra *esperado = dijkstra(grafo, grafo->pontos[o].id, grafo->pontos[d].id);
+                    ResultadoDijkstra *obtido = continuar_busca_incremental(busca, grafo->pontos[d].id);
+                    if (!mesmo_resultado(esperado, obtido, grafo->pontos[o].id, grafo->pontos[d].id)) divergencias++;
+                    liberar_resultado_dijkstra(esperado);
+                    liberar_resultado_dijkstra(obtido);
+                }
+            }
+            liberar_busca_incremental(busca);
+        }
+        printf("%s test_oneway.osm: all pairs, twice each, match dijkstra() (%d mismatches)\n\n",
+               divergencias ? "✗" : "✓", divergencias);
+        falhas += divergencias != 0;
+        liberar_grafo(grafo);
+    }
+
+    printf("=== Test completed ===\n");
+    return falhas ? 1 : 0;
+}
@@ -0,0 +1,110 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../include/osm_reader.h"
+#include "../include/graph.h"
+#include "../include/distance_matrix.h"
+#include "../include/isochrone.h"
+#include "fixtures.h"
+
+// Compara a região com distâncias completas da origem a todos os pontos
+static int confere_regiao(Grafo *grafo, EspacoBusca *espaco, const RegiaoAlcancavel *regiao,
+                          const double *referencia, double limite) {
+    size_t esperados = 0;
+    for (size_t v = 0; v < grafo->num_pontos; v++) {
+        int dentro = referencia[v] >= 0.0 && referencia[v] <= limite;
+        esperados += dentro;
+        double custo = custo_alcancado(espaco, v);
+        if (dentro ? fabs(custo - referencia[v]) > 1e-9 : custo != -1.0) return 0;
+    }
+    if (regiao->num_pontos != esperados) return 0;
+    for (size_t i = 0; i < regiao->num_pontos; i++) {
+        if (fabs(regiao->custos[i] - referencia[regiao->pontos[i]]) > 1e-9) return 0;
+        if (i > 0 && regiao->custos[i] < regiao->custos[i - 1]) return 0;
+    }
+    return 1;
+}
+
+int main() {
+    printf("=== Testing Bounded-Range Search (Isochrones) ===\n\n");
+    int falhas = 0;
+
+    // Linha 1-2-3-4 com 1 km por trecho
+    Grafo *linha = criar_grafo();
+    for (int i = 1; i <= 4; i++) adicionar_ponto(linha, i, -16.7, -49.2 + i * 0.01);
+    for (int i = 1; i < 4; i++) adicionar_aresta(linha, i, i + 1, 1.0);
+    EspacoBusca *espaco_linha = criar_espaco_busca(linha->num_pontos);
+    RegiaoAlcancavel *regiao = criar_regiao_alcancavel();
+    int limitada = busca_limitada(linha, espaco_linha, 1, 2.0, regiao) == 0 && regiao->num_pontos == 3 &&
+                   regiao->custos[2] == 2.0 && custo_alcancado(espaco_linha, 3) == -1.0;
+    printf("%s Search stops at the limit, boundary point included (%zu points)\n",
+           limitada ? "✓" : "✗", regiao->num_pontos);
+    falhas += !limitada;
+
+    int erros = busca_limitada(linha, espaco_linha, 99, 2.0, regiao) == -1 && regiao->num_pontos == 0 &&
+                busca_limitada(linha, espaco_linha, 1, -1.0, regiao) == -1;
+    printf("%s Unknown origin and negative limit are rejected\n", erros ? "✓" : "✗");
+    falhas += !erros;
+
+    int faixas = faixa_alcance(0.0, 2.0, 4) == 0 && faixa_alcance(0.6, 2.0, 4) == 1 &&
+                 faixa_alcance(2.0, 2.0, 4) == 3 && faixa_alcance(2.1, 2.0, 4) == -1;
+    printf("%s Costs map to bands of equal width\n", faixas ? "✓" : "✗");
+    falhas += !faixas;
+    liberar_espaco_busca(espaco_linha);
+    liberar_grafo(linha);
+
+    Grafo *grafo = ler_osm("test.osm");
+    if (!grafo) {
+        printf("ERROR: Failed to load test.osm\n");
+        return 1;
+    }
+    EspacoBusca *pequeno = criar_espaco_busca(3);
+    int outro_tamanho = busca_limitada(grafo, pequeno, grafo->pontos[0].id, 1.0, regiao) == -1;
+    liberar_espaco_busca(pequeno);
+    printf("%s Search space sized for another graph is rejected\n", outro_tamanho ? "✓" : "✗");
+    falhas += !outro_tamanho;
+
+    long *todos = malloc(grafo->num_pontos * sizeof(long));
+    for (size_t v = 0; v < grafo->num_pontos; v++) todos[v] = grafo->pontos[v].id;
+    double *referencia = malloc(grafo->num_pontos * sizeof(double));
+    EspacoBusca *espaco_referencia = criar_espaco_busca(grafo->num_pontos);
+
+    // Origem movida a cada consulta com o mesmo espaço: nada da anterior vaza
+    EspacoBusca *espaco = criar_espaco_busca(grafo->num_pontos);
+    const IndicesGrafo *indices = obter_indices(grafo);
+    unsigned int estado = 17;
+    int corretas = 1, locais = 1;
+    for (int m = 0; m < 2; m++) {
+        espaco->metrica = espaco_referencia->metrica = m == 0 ? METRICA_DISTANCIA : METRICA_TEMPO;
+        for (int q = 0; q < 40; q++) {
+            long origem = grafo->pontos[proximo_aleatorio(&estado) % grafo->num_pontos].id;
+            double limite = m == 0 ? 0.2 + (q % 5) * 0.2 : 30.0 + (q % 5) * 30.0;
+            distancias_um_para_muitos(grafo, espaco_referencia, origem, todos, grafo->num_pontos, referencia, NULL);
+            if (busca_limitada(grafo, espaco, origem, limite, regiao) != 0 ||
+                !confere_regiao(grafo, espaco, regiao, referencia, limite)) {
+                corretas = 0;
+            }
+            // Só a região e os vizinhos dela recebem rótulo
+            size_t vizinhos = 0;
+            for (size_t i = 0; i < regiao->num_pontos; i++) {
+                size_t u = regiao->pontos[i];
+                vizinhos += indices->inicio_arcos[u + 1] - indices->inicio_arcos[u];
+            }
+            if (regiao->num_tocados > regiao->num_pontos + vizinhos) locais = 0;
+        }
+    }
+    printf("%s 80 isochrones (distance and time) match full searches while moving the origin\n",
+           corretas ? "✓" : "✗");
+    printf("%s Labels stay within the region and its frontier\n", locais ? "✓" : "✗");
+    falhas += !corretas || !locais;
+
+    free(todos);
+    free(referencia);
+    liberar_espaco_busca(espaco_referencia);
+    liberar_espaco_busca(espaco);
+    liberar_regiao_alcancavel(regiao);
+    liberar_grafo(grafo);
+
+    printf("\n=== Test completed ===\n");
+    return falhas ? 1 : 0;
+}
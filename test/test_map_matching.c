@@ -0,0 +1,279 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../include/osm_reader.h"
+#include "../include/graph.h"
+#include "../include/dijkstra.h"
+#include "../include/components.h"
+#include "../include/map_matching.h"
+#include "fixtures.h"
+
+#define METROS_POR_GRAU (6371000.0 * 3.14159265358979323846 / 180.0)
+
+// Ruído gaussiano (Box-Muller) com desvio padrão sigma
+static double ruido(unsigned int *estado, double sigma) {
+    double u1 = (proximo_aleatorio(estado) % 1000000 + 1) / 1000001.0;
+    double u2 = (proximo_aleatorio(estado) % 1000000) / 1000000.0;
+    return sigma * sqrt(-2.0 * log(u1)) * cos(2.0 * 3.14159265358979323846 * u2);
+}
+
+// Leituras a cada passo_m ao longo do caminho, com ruído de sigma_m metros
+static TrajetoGPS amostrar_caminho(Grafo *grafo, const long *caminho, int tamanho, double passo_m,
+                                   double sigma_m, unsigned int *estado) {
+    TrajetoGPS t = {malloc(4096 * sizeof(PontoGPS)), 0};
+    double sobra = 0.0;
+    for (int i = 0; i + 1 < tamanho && t.num_pontos < 4096; i++) {
+        const Ponto *a = &grafo->pontos[buscar_indice_ponto(grafo, caminho[i])];
+        const Ponto *b = &grafo->pontos[buscar_indice_ponto(grafo, caminho[i + 1])];
+        double cos_lat = cos(a->lat * 3.14159265358979323846 / 180.0);
+        double dx = (b->lon - a->lon) * METROS_POR_GRAU * cos_lat, dy = (b->lat - a->lat) * METROS_POR_GRAU;
+        double comprimento = hypot(dx, dy);
+        for (double s = sobra; s < comprimento && t.num_pontos < 4096; s += passo_m) {
+            double f = s / comprimento;
+            t.pontos[t.num_pontos].lat = a->lat + f * (b->lat - a->lat) + ruido(estado, sigma_m) / METROS_POR_GRAU;
+            t.pontos[t.num_pontos].lon = a->lon + f * (b->lon - a->lon) +
+                                         ruido(estado, sigma_m) / (METROS_POR_GRAU * cos_lat);
+            t.num_pontos++;
+            sobra = s + passo_m - comprimento;
+        }
+    }
+    const Ponto *fim = &grafo->pontos[buscar_indice_ponto(grafo, caminho[tamanho - 1])];
+    t.pontos[t.num_pontos++] = (PontoGPS){fim->lat, fim->lon};
+    return t;
+}
+
+// Há arco de u para v (respeitando mão única)?
+static int existe_arco(Grafo *grafo, long u, long v) {
+    const IndicesGrafo *indices = obter_indices(grafo);
+    ssize_t iu = buscar_indice_ponto(grafo, u), iv = buscar_indice_ponto(grafo, v);
+    if (iu < 0 || iv < 0) return 0;
+    for (size_t k = indices->inicio_arcos[iu]; k < indices->inicio_arcos[iu + 1]; k++) {
+        if (indices->arcos[k].destino == (size_t)iv) return 1;
+    }
+    return 0;
+}
+
+// Cada trecho do resultado é um caminho percorrível no grafo
+static int caminho_percorrivel(Grafo *grafo, const ResultadoCombinacao *r) {
+    for (size_t s = 0; s < r->num_trechos; s++) {
+        size_t fim = s + 1 < r->num_trechos ? r->inicio_trechos[s + 1] : r->tamanho_caminho;
+        for (size_t i = r->inicio_trechos[s]; i + 1 < fim; i++) {
+            if (!existe_arco(grafo, r->caminho[i], r->caminho[i + 1])) return 0;
+        }
+    }
+    return 1;
+}
+
+static int mesmos_caminhos(const ResultadoCombinacao *a, const ResultadoCombinacao *b) {
+    if (!a || !b || a->tamanho_caminho != b->tamanho_caminho || a->num_trechos != b->num_trechos) return 0;
+    for (size_t i = 0; i < a->tamanho_caminho; i++) {
+        if (a->caminho[i] != b->caminho[i]) return 0;
+    }
+    return 1;
+}
+
+int main() {
+    printf("=== Testing Map Matching ===\n\n");
+    int falhas = 0;
+
+    // GPX: dois <trk>, o primeiro com dois segmentos, o segundo numa linha só
+    FILE *f = fopen("test_map_matching.gpx", "w");
+    fprintf(f, "<?xml version=\"1.0\"?>\n<gpx version=\"1.1\" creator=\"test\">\n");
+    fprintf(f, "  <trk>\n    <name>a</name>\n    <trkseg>\n");
+    fprintf(f, "      <trkpt lat=\"-16.7001\" lon=\"-49.2001\"><time>2024-01-01T10:00:00Z</time></trkpt>\n");
+    fprintf(f, "      <trkpt lon=\"-49.2002\" lat=\"-16.7002\"/>\n    </trkseg>\n    <trkseg>\n");
+    fprintf(f, "      <trkpt lat='-16.7003' lon='-49.2003'/>\n    </trkseg>\n  </trk>\n");
+    fprintf(f, "  <wpt lat=\"1.0\" lon=\"1.0\"/>\n");
+    fprintf(f, "  <trk><trkseg><trkpt lat=\"-16.71\" lon=\"-49.21\"/><trkpt lat=\"-16.72\" lon=\"-49.22\"/></trkseg></trk>\n");
+    fprintf(f, "</gpx>\n");
+    fclose(f);
+    ConjuntoTrajetos *gpx = ler_trajetos_gpx("test_map_matching.gpx");
+    remove("test_map_matching.gpx");
+    int gpx_ok = gpx && gpx->num_trajetos == 2 && gpx->trajetos[0].num_pontos == 3 &&
+                 gpx->trajetos[1].num_pontos == 2 && gpx->trajetos[0].pontos[1].lat == -16.7002 &&
+                 gpx->trajetos[0].pontos[1].lon == -49.2002 && gpx->trajetos[1].pontos[1].lon == -49.22 &&
+                 ler_trajetos_gpx("nao_existe.gpx") == NULL;
+    printf("%s GPX tracks, segments, attribute order and one-line files are read\n", gpx_ok ? "✓" : "✗");
+    falhas += !gpx_ok;
+    liberar_conjunto_trajetos(gpx);
+
+    // Grade 10x10 de vias de mão dupla a cada ~100 m: leituras sem ruído ao
+    // longo de um caminho em L casam exatamente com ele
+    Grafo *grade = criar_grafo();
+    const double passo = 100.0 / METROS_POR_GRAU;
+    for (int i = 0; i < 100; i++) adicionar_ponto(grade, i + 1, -16.7 + (i / 10) * passo, -49.2 + (i % 10) * passo);
+    for (int i = 0; i < 100; i++) {
+        if (i % 10 < 9) adicionar_aresta(grade, i + 1, i + 2, 0.1);
+        if (i < 90) adicionar_aresta(grade, i + 1, i + 11, 0.1);
+    }
+    long em_l[] = {1, 2, 3, 4, 5, 15, 25, 35, 45};
+    unsigned int estado = 47;
+    TrajetoGPS l = amostrar_caminho(grade, em_l, 9, 30.0, 0.0, &estado);
+    CombinadorMapa *combinador = criar_combinador_mapa(grade, NULL);
+    ResultadoCombinacao *r = combinar_trajeto(combinador, &l);
+    int exato = r && r->num_trechos == 1 && r->num_nao_casados == 0 && r->tamanho_caminho == 9;
+    for (size_t i = 0; exato && i < 9; i++) exato = r->caminho[i] == em_l[i];
+    for (size_t i = 0; exato && i < r->num_pontos; i++) exato = r->pontos[i].distancia_m < 1.0;
+    printf("%s Noise-free trace on a grid matches the driven path exactly\n", exato ? "✓" : "✗");
+    falhas += !exato;
+    liberar_resultado_combinacao(r);
+
+    // Leitura longe de qualquer via fica de fora sem quebrar o trajeto
+    PontoGPS *com_desvio = malloc((l.num_pontos + 1) * sizeof(PontoGPS));
+    size_t meio = l.num_pontos / 2;
+    for (size_t i = 0, j = 0; i < l.num_pontos; i++) {
+        com_desvio[j++] = l.pontos[i];
+        if (i == meio) com_desvio[j++] = (PontoGPS){-16.7 - 0.01, -49.2 - 0.01};
+    }
+    TrajetoGPS desvio = {com_desvio, l.num_pontos + 1};
+    r = combinar_trajeto(combinador, &desvio);
+    int fora = r && r->num_nao_casados == 1 && r->pontos[meio + 1].aresta == (size_t)-1 &&
+               r->num_trechos == 1 && r->tamanho_caminho == 9;
+    printf("%s Off-road fix is left unmatched and the trace stays in one piece\n", fora ? "✓" : "✗");
+    falhas += !fora;
+    liberar_resultado_combinacao(r);
+    free(com_desvio);
+    liberar_combinador_mapa(combinador);
+
+    // Mão única: a via 1->2 só pode ser percorrida nesse sentido; leituras
+    // de 2 para 1 ao lado dela vão pela paralela de mão dupla
+    Grafo *vias = criar_grafo();
+    double d30 = 30.0 / METROS_POR_GRAU;
+    adicionar_ponto(vias, 1, -16.7, -49.2);
+    adicionar_ponto(vias, 2, -16.7, -49.2 + 10 * d30);
+    adicionar_ponto(vias, 3, -16.7 + 2 * d30, -49.2);
+    adicionar_ponto(vias, 4, -16.7 + 2 * d30, -49.2 + 10 * d30);
+    Aresta mao_unica = {1, 2, 0.3, 0};
+    adicionar_arestas(vias, &mao_unica, 1);
+    adicionar_aresta(vias, 3, 4, 0.3);
+    adicionar_aresta(vias, 1, 3, 0.06);
+    adicionar_aresta(vias, 2, 4, 0.06);
+    PontoGPS contramao[6];
+    for (int i = 0; i < 6; i++) contramao[i] = (PontoGPS){-16.7 + 0.9 * d30, -49.2 + (9 - i * 1.6) * d30};
+    TrajetoGPS volta = {contramao, 6};
+    combinador = criar_combinador_mapa(vias, NULL);
+    r = combinar_trajeto(combinador, &volta);
+    int sentido = r && caminho_percorrivel(vias, r) && r->num_trechos == 1;
+    for (size_t i = 0; sentido && i + 1 < r->tamanho_caminho; i++) {
+        sentido = !(r->caminho[i] == 2 && r->caminho[i + 1] == 1);
+    }
+    printf("%s One-way road is never matched against its direction\n", sentido ? "✓" : "✗");
+    falhas += !sentido;
+    liberar_resultado_combinacao(r);
+    liberar_combinador_mapa(combinador);
+    liberar_grafo(vias);
+
+    // Duas grades sem ligação: o modelo recomeça num novo trecho
+    Grafo *ilhas = criar_grafo();
+    for (int i = 0; i < 4; i++) adicionar_ponto(ilhas, i + 1, -16.7, -49.2 + i * passo * (i < 2 ? 1.0 : 1.5));
+    adicionar_aresta(ilhas, 1, 2, 0.1);
+    adicionar_aresta(ilhas, 3, 4, 0.15);
+    long pulo[] = {1, 2};
+    long pulo2[] = {3, 4};
+    TrajetoGPS t1 = amostrar_caminho(ilhas, pulo, 2, 20.0, 0.0, &estado);
+    TrajetoGPS t2 = amostrar_caminho(ilhas, pulo2, 2, 20.0, 0.0, &estado);
+    PontoGPS juntos[64];
+    size_t num_juntos = 0;
+    for (size_t i = 0; i < t1.num_pontos; i++) juntos[num_juntos++] = t1.pontos[i];
+    for (size_t i = 0; i < t2.num_pontos; i++) juntos[num_juntos++] = t2.pontos[i];
+    TrajetoGPS dois = {juntos, num_juntos};
+    combinador = criar_combinador_mapa(ilhas, NULL);
+    r = combinar_trajeto(combinador, &dois);
+    int quebra = r && r->num_trechos == 2 && r->tamanho_caminho == 4 && r->caminho[0] == 1 && r->caminho[1] == 2 &&
+                 r->caminho[2] == 3 && r->caminho[3] == 4 && r->inicio_trechos[1] == 2;
+    printf("%s Disconnected roads split the match into two pieces\n", quebra ? "✓" : "✗");
+    falhas += !quebra;
+    liberar_resultado_combinacao(r);
+    liberar_combinador_mapa(combinador);
+    free(t1.pontos);
+    free(t2.pontos);
+    liberar_grafo(ilhas);
+    free(l.pontos);
+    liberar_grafo(grade);
+
+    // test.osm: trajetos com ruído de 5 m ao longo de rotas reais
+    Grafo *grafo = ler_osm("test.osm");
+    if (!grafo) {
+        printf("ERROR: Failed to load test.osm\n");
+        return 1;
+    }
+    const IndicesGrafo *indices = obter_componentes(grafo);
+    long *conexos = malloc(grafo->num_pontos * sizeof(long));
+    size_t num_conexos = 0;
+    for (size_t v = 0; indices && v < grafo->num_pontos; v++) {
+        if (indices->componente_forte[v] == indices->maior_componente_forte) conexos[num_conexos++] = grafo->pontos[v].id;
+    }
+
+    ConjuntoTrajetos conjunto = {calloc(12, sizeof(TrajetoGPS)), 0};
+    ResultadoDijkstra *verdade[12];
+    while (conjunto.num_trajetos < 12) {
+        long a = conexos[proximo_aleatorio(&estado) % num_conexos];
+        long b = conexos[proximo_aleatorio(&estado) % num_conexos];
+        ResultadoDijkstra *rota = dijkstra(grafo, a, b);
+        if (!rota || !rota->sucesso || rota->distancia_total < 0.5) {
+            liberar_resultado_dijkstra(rota);
+            continue;
+        }
+        verdade[conjunto.num_trajetos] = rota;
+        conjunto.trajetos[conjunto.num_trajetos++] = amostrar_caminho(grafo, rota->caminho, rota->tamanho_caminho,
+                                                                      15.0, 5.0, &estado);
+    }
+
+    combinador = criar_combinador_mapa(grafo, NULL);
+    ResultadoCombinacao **paralelos = combinar_trajetos(combinador, &conjunto, 4);
+    int percorriveis = paralelos != NULL, iguais = paralelos != NULL;
+    double cobertura = 0.0;
+    for (size_t t = 0; paralelos && t < conjunto.num_trajetos; t++) {
+        r = paralelos[t];
+        if (!caminho_percorrivel(grafo, r)) percorriveis = 0;
+        // Fração dos trechos da rota verdadeira presentes no casamento
+        const ResultadoDijkstra *v = verdade[t];
+        int achados = 0;
+        for (int i = 0; i + 1 < v->tamanho_caminho; i++) {
+            for (size_t j = 0; j + 1 < r->tamanho_caminho; j++) {
+                if (r->caminho[j] == v->caminho[i] && r->caminho[j + 1] == v->caminho[i + 1]) {
+                    achados++;
+                    break;
+                }
+            }
+        }
+        cobertura += (double)achados / (v->tamanho_caminho - 1);
+
+        ResultadoCombinacao *sozinho = combinar_trajeto(combinador, &conjunto.trajetos[t]);
+        if (!mesmos_caminhos(sozinho, r)) iguais = 0;
+        liberar_resultado_combinacao(sozinho);
+    }
+    cobertura /= conjunto.num_trajetos;
+    liberar_combinador_mapa(combinador);
+
+    ParametrosCombinacao sem_cache = parametros_combinacao_padrao();
+    sem_cache.tamanho_cache = 0;
+    combinador = criar_combinador_mapa(grafo, &sem_cache);
+    ResultadoCombinacao **sem = combinar_trajetos(combinador, &conjunto, 1);
+    size_t buscas_com = 0, buscas_sem = 0;
+    for (size_t t = 0; sem && paralelos && t < conjunto.num_trajetos; t++) {
+        if (!mesmos_caminhos(sem[t], paralelos[t])) iguais = 0;
+        buscas_com += paralelos[t]->buscas;
+        buscas_sem += sem[t]->buscas;
+    }
+    if (!sem) iguais = 0;
+    liberar_combinador_mapa(combinador);
+
+    printf("%s Matched paths follow graph arcs in the allowed direction\n", percorriveis ? "✓" : "✗");
+    printf("%s Noisy traces (sigma 5 m) recover %.0f%% of the driven road segments\n",
+           cobertura >= 0.9 ? "✓" : "✗", cobertura * 100.0);
+    printf("%s Parallel, sequential and uncached matching agree (%zu vs %zu searches)\n",
+           iguais && buscas_com < buscas_sem ? "✓" : "✗", buscas_com, buscas_sem);
+    falhas += !percorriveis || cobertura < 0.9 || !iguais || buscas_com >= buscas_sem;
+
+    liberar_resultados_combinacao(paralelos, conjunto.num_trajetos);
+    liberar_resultados_combinacao(sem, conjunto.num_trajetos);
+    for (size_t t = 0; t < conjunto.num_trajetos; t++) liberar_resultado_dijkstra(verdade[t]);
+    for (size_t t = 0; t < conjunto.num_trajetos; t++) free(conjunto.trajetos[t].pontos);
+    free(conjunto.trajetos);
+    free(conexos);
+    liberar_grafo(grafo);
+
+    printf("\n=== Test completed ===\n");
+    return falhas ? 1 : 0;
+}
@@ -0,0 +1,180 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../include/osm_reader.h"
+#include "../include/graph.h"
+#include "../include/dijkstra.h"
+#include "../include/metrics.h"
+#include "../include/reorder.h"
+#include "../include/distance_matrix.h"
+#include "../include/edit.h"
+#include "fixtures.h"
+
+// Cópia do grafo com o peso de cada aresta trocado pelo custo na métrica:
+// o dijkstra() comum nela serve de referência para dijkstra_metrica()
+static Grafo* copia_com_metrica(const Grafo *grafo, Metrica metrica) {
+    Grafo *copia = criar_grafo_com_capacidade(grafo->num_pontos, grafo->num_arestas);
+    adicionar_pontos(copia, grafo->pontos, grafo->num_pontos);
+    adicionar_arestas(copia, grafo->arestas, grafo->num_arestas);
+    for (size_t i = 0; i < grafo->num_arestas; i++) copia->arestas[i].peso = custo_aresta(grafo, i, metrica);
+    invalidar_indices(copia);
+    return copia;
+}
+
+static double soma_metrica(const Grafo *grafo, Metrica metrica) {
+    double soma = 0.0;
+    for (size_t i = 0; i < grafo->num_arestas; i++) soma += custo_aresta(grafo, i, metrica);
+    return soma;
+}
+
+int main() {
+    printf("=== Testing Multi-Metric Weights ===\n\n");
+    int falhas = 0;
+
+    // Valores de tag
+    int tags_ok = classe_via_da_tag("tertiary_link") == VIA_TERTIARY &&
+                  classe_via_da_tag("residential") == VIA_RESIDENTIAL &&
+                  classe_via_da_tag("motorway_junction") == VIA_DESCONHECIDA &&
+                  fabs(velocidade_da_tag("30 mph") - 48.28032) < 1e-6 &&
+                  velocidade_da_tag("60") == 60.0 && velocidade_da_tag("none") == 0.0;
+    printf("%s highway and maxspeed tag values are parsed\n", tags_ok ? "✓" : "✗");
+    falhas += !tags_ok;
+
+    Grafo *grafo = ler_osm("test.osm");
+    if (!grafo) {
+        printf("ERROR: Failed to load test.osm\n");
+        return 1;
+    }
+    size_t residenciais = 0, terciarias = 0;
+    for (size_t i = 0; grafo->classe_via && i < grafo->num_arestas; i++) {
+        residenciais += grafo->classe_via[i] == VIA_RESIDENTIAL;
+        terciarias += grafo->classe_via[i] == VIA_TERTIARY;
+    }
+    int classes_ok = residenciais > 0 && terciarias > 0;
+    printf("%s Road classes read from ler_osm() (%zu residential, %zu tertiary edges)\n",
+           classes_ok ? "✓" : "✗", residenciais, terciarias);
+    falhas += !classes_ok;
+
+    // Cada métrica contra o dijkstra() comum numa cópia com aquele peso
+    Grafo *referencias[NUM_METRICAS];
+    for (int m = 0; m < NUM_METRICAS; m++) referencias[m] = copia_com_metrica(grafo, (Metrica)m);
+    definir_penalidade(grafo, 0, 120.0);
+    definir_penalidade(referencias[METRICA_PERSONALIZADA], 0, 0.0);
+    referencias[METRICA_PERSONALIZADA]->arestas[0].peso += 120.0;
+    invalidar_indices(referencias[METRICA_PERSONALIZADA]);
+
+    unsigned int estado = 23;
+    int divergencias = 0, mais_rapida_ok = 1;
+    for (int q = 0; q < 100; q++) {
+        long origem = grafo->pontos[proximo_aleatorio(&estado) % grafo->num_pontos].id;
+        long destino = grafo->pontos[proximo_aleatorio(&estado) % grafo->num_pontos].id;
+        double custos[NUM_METRICAS][NUM_METRICAS];
+        int sucesso[NUM_METRICAS];
+        for (int m = 0; m < NUM_METRICAS; m++) {
+            ResultadoDijkstra *obtido = dijkstra_metrica(grafo, origem, destino, (Metrica)m);
+            ResultadoDijkstra *esperado = dijkstra(referencias[m], origem, destino);
+            sucesso[m] = obtido && obtido->sucesso;
+            if (!obtido || !esperado || obtido->sucesso != esperado->sucesso ||
+                (obtido->sucesso && fabs(obtido->distancia_total - esperado->distancia_total) > 1e-6)) {
+                divergencias++;
+            }
+            if (sucesso[m] && metricas_caminho(grafo, obtido->caminho, obtido->tamanho_caminho,
+                                               (Metrica)m, custos[m]) != 0) {
+                divergencias++;
+            }
+            liberar_resultado_dijkstra(obtido);
+            liberar_resultado_dijkstra(esperado);
+        }
+        // A rota mais curta não é mais longa que a mais rápida, e vice-versa no tempo
+        if (sucesso[METRICA_DISTANCIA] && sucesso[METRICA_TEMPO] &&
+            (custos[METRICA_DISTANCIA][METRICA_DISTANCIA] > custos[METRICA_TEMPO][METRICA_DISTANCIA] + 1e-9 ||
+             custos[METRICA_TEMPO][METRICA_TEMPO] > custos[METRICA_DISTANCIA][METRICA_TEMPO] + 1e-9)) {
+            mais_rapida_ok = 0;
+        }
+    }
+    printf("%s dijkstra_metrica() matches plain dijkstra() on reweighted copies (%d mismatches)\n",
+           divergencias ? "✗" : "✓", divergencias);
+    printf("%s Shortest route is never longer, fastest route never slower\n", mais_rapida_ok ? "✓" : "✗");
+    falhas += divergencias != 0 || !mais_rapida_ok;
+    for (int m = 0; m < NUM_METRICAS; m++) liberar_grafo(referencias[m]);
+
+    // Espaço de busca reaproveitável (motor de lotes) também escolhe a métrica
+    EspacoBusca *espaco = criar_espaco_busca(grafo->num_pontos);
+    espaco->metrica = METRICA_TEMPO;
+    int espaco_ok = 1;
+    for (int q = 0; q < 30; q++) {
+        long origem = grafo->pontos[proximo_aleatorio(&estado) % grafo->num_pontos].id;
+        long destino = grafo->pontos[proximo_aleatorio(&estado) % grafo->num_pontos].id;
+        ResultadoDijkstra *a = dijkstra_metrica(grafo, origem, destino, METRICA_TEMPO);
+        ResultadoDijkstra *b = dijkstra_com_espaco(grafo, espaco, origem, destino);
+        if (!a || !b || a->sucesso != b->sucesso ||
+            (a->sucesso && fabs(a->distancia_total - b->distancia_total) > 1e-6)) {
+            espaco_ok = 0;
+        }
+        liberar_resultado_dijkstra(a);
+        liberar_resultado_dijkstra(b);
+    }
+    printf("%s dijkstra_com_espaco() honours the search space metric\n", espaco_ok ? "✓" : "✗");
+    falhas += !espaco_ok;
+
+    // Matriz em paralelo na métrica: linha a linha igual ao um-para-muitos
+    long ids[12];
+    for (int i = 0; i < 12; i++) ids[i] = grafo->pontos[proximo_aleatorio(&estado) % grafo->num_pontos].id;
+    MatrizDistancias *matriz = matriz_distancias_metrica(grafo, ids, 12, ids, 12, METRICA_TEMPO, 0, 3);
+    int matriz_ok = matriz != NULL;
+    for (int i = 0; matriz_ok && i < 12; i++) {
+        double linha[12];
+        distancias_um_para_muitos(grafo, espaco, ids[i], ids, 12, linha, NULL);
+        for (int j = 0; j < 12; j++) {
+            if (fabs(linha[j] - distancia_na_matriz(matriz, i, j)) > 1e-9) matriz_ok = 0;
+        }
+    }
+    printf("%s matriz_distancias_metrica() matches one-to-many searches in the metric\n", matriz_ok ? "✓" : "✗");
+    falhas += !matriz_ok;
+    liberar_matriz_distancias(matriz);
+    liberar_espaco_busca(espaco);
+
+    // Pesos por métrica acompanham atualizar_pesos() sem reconstruir os índices
+    const double *tempos = obter_pesos_metrica(grafo, METRICA_TEMPO);
+    AtualizacaoPeso mudanca = {3, grafo->arestas[3].peso * 2.0};
+    atualizar_pesos(grafo, &mudanca, 1);
+    size_t arcos[2];
+    size_t n = arcos_da_aresta(grafo, 3, arcos);
+    int corrigidos = tempos && n > 0;
+    for (size_t j = 0; corrigidos && j < n; j++) {
+        corrigidos = fabs(tempos[arcos[j]] - custo_aresta(grafo, 3, METRICA_TEMPO)) < 1e-9;
+    }
+    printf("%s Travel-time arc weights follow atualizar_pesos()\n", corrigidos ? "✓" : "✗");
+    falhas += !corrigidos;
+
+    // Reordenação e remoção levam os atributos junto com as arestas
+    double tempo_antes = soma_metrica(grafo, METRICA_PERSONALIZADA);
+    reordenar_hilbert(grafo);
+    double tempo_depois = soma_metrica(grafo, METRICA_PERSONALIZADA);
+    unsigned char classe_ultima = grafo->classe_via[grafo->num_arestas - 1];
+    float velocidade_ultima = grafo->velocidade_kmh[grafo->num_arestas - 1];
+    remover_aresta(grafo, 0);
+    int acompanham = fabs(tempo_antes - tempo_depois) < 1e-6 && grafo->classe_via[0] == classe_ultima &&
+                     grafo->velocidade_kmh[0] == velocidade_ultima;
+    printf("%s Edge attributes move with reordering and removal\n", acompanham ? "✓" : "✗");
+    falhas += !acompanham;
+
+    // Salvar e recarregar preserva classe e maxspeed
+    grafo->velocidade_kmh[1] = 80.0f;
+    int salvo = save_graph_to_osm(grafo, "/tmp/test_metrics.osm");
+    Grafo *recarregado = salvo ? ler_osm("/tmp/test_metrics.osm") : NULL;
+    int preservado = recarregado && recarregado->num_arestas == grafo->num_arestas &&
+                     recarregado->classe_via && recarregado->velocidade_kmh[1] == 80.0f;
+    for (size_t i = 0; preservado && i < grafo->num_arestas; i++) {
+        preservado = velocidade_aresta(recarregado, i) == velocidade_aresta(grafo, i);
+    }
+    printf("%s Saved graph keeps highway classes and maxspeed\n", preservado ? "✓" : "✗");
+    falhas += !preservado;
+    liberar_grafo(recarregado);
+    remove("/tmp/test_metrics.osm");
+
+    liberar_grafo(grafo);
+
+    printf("\n=== Test completed ===\n");
+    return falhas ? 1 : 0;
+}
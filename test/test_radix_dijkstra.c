@@ -0,0 +1,116 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../include/osm_reader.h"
+#include "../include/graph.h"
+#include "../include/dijkstra.h"
+#include "../include/radix_heap.h"
+#include "../include/timing.h"
+#include "fixtures.h"
+
+// Peso (em km, pesos double) do caminho devolvido, ou -1 se usar um arco inexistente
+static double peso_do_caminho(Grafo *grafo, const ResultadoDijkstra *r) {
+    const IndicesGrafo *indices = obter_indices(grafo);
+    double total = 0.0;
+    for (int i = 0; i + 1 < r->tamanho_caminho; i++) {
+        ssize_t u = buscar_indice_ponto(grafo, r->caminho[i]);
+        ssize_t v = buscar_indice_ponto(grafo, r->caminho[i + 1]);
+        double melhor = -1.0;
+        for (size_t k = indices->inicio_arcos[u]; k < indices->inicio_arcos[u + 1]; k++) {
+            if ((ssize_t)indices->arcos[k].destino == v && (melhor < 0 || indices->arcos[k].peso < melhor))
+                melhor = indices->arcos[k].peso;
+        }
+        if (melhor < 0) return -1.0;
+        total += melhor;
+    }
+    return total;
+}
+
+static int comparar(Grafo *grafo, const char *nome, int num_consultas) {
+    unsigned int estado = 2025;
+    int divergencias = 0, encontrados = 0;
+    double tempo_binario = 0.0, tempo_radix = 0.0;
+    obter_pesos_inteiros(grafo);
+
+    for (int q = 0; q < num_consultas; q++) {
+        long origem = grafo->pontos[proximo_aleatorio(&estado) % grafo->num_pontos].id;
+        long destino = grafo->pontos[proximo_aleatorio(&estado) % grafo->num_pontos].id;
+
+        double inicio = agora_ms();
+        ResultadoDijkstra *r1 = dijkstra(grafo, origem, destino);
+        tempo_binario += agora_ms() - inicio;
+        inicio = agora_ms();
+        ResultadoDijkstra *r2 = dijkstra_radix(grafo, origem, destino);
+        tempo_radix += agora_ms() - inicio;
+
+        int ok = r1 && r2 && r1->sucesso == r2->sucesso;
+        if (ok && r1->sucesso) {
+            encontrados++;
+            // Cada arco arredonda no máximo meio milímetro; o caminho inteiro
+            // do radix, medido com os pesos double, também precisa ser ótimo
+            double tolerancia = r2->tamanho_caminho * 0.5e-6 + 1e-9;
+            double peso = peso_do_caminho(grafo, r2);
+            ok = r2->caminho[0] == origem && r2->caminho[r2->tamanho_caminho - 1] == destino &&
+                 fabs(r1->distancia_total - r2->distancia_total) <= tolerancia &&
+                 peso >= 0 && fabs(peso - r1->distancia_total) <= tolerancia;
+        }
+        if (!ok) divergencias++;
+        liberar_resultado_dijkstra(r1);
+        liberar_resultado_dijkstra(r2);
+    }
+
+    printf("%s: %d queries (%d with a path)\n", nome, num_consultas, encontrados);
+    printf("  %s Radix heap paths optimal within rounding (%d mismatches)\n", divergencias ? "✗" : "✓", divergencias);
+    printf("  Binary heap %.2f ms, radix heap %.2f ms\n\n", tempo_binario, tempo_radix);
+    return divergencias ? 1 : 0;
+}
+
+int main() {
+    printf("=== Testing Radix Heap Dijkstra ===\n\n");
+    int falhas = 0;
+
+    // A fila sozinha: sequência monótona aleatória confere com a ordenação
+    FilaRadix fila;
+    iniciar_fila_radix(&fila);
+    unsigned int estado = 1;
+    uint64_t ultima = 0;
+    int ordem_ok = 1;
+    for (int rodada = 0; rodada < 2000; rodada++) {
+        int inserir = 1 + proximo_aleatorio(&estado) % 4;
+        for (int i = 0; i < inserir; i++) {
+            inserir_fila_radix(&fila, ultima + proximo_aleatorio(&estado) % 5000, (size_t)rodada);
+        }
+        ItemRadix item = extrair_minimo_radix(&fila);
+        if (item.chave < ultima) ordem_ok = 0;
+        ultima = item.chave;
+    }
+    while (!fila_radix_vazia(&fila)) {
+        ItemRadix item = extrair_minimo_radix(&fila);
+        if (item.chave < ultima) ordem_ok = 0;
+        ultima = item.chave;
+    }
+    liberar_fila_radix(&fila);
+    printf("%s Radix heap extracts keys in non-decreasing order\n\n", ordem_ok ? "✓" : "✗");
+    falhas += !ordem_ok;
+
+    Grafo *grafo = ler_osm("test.osm");
+    if (!grafo) {
+        printf("ERROR: Failed to load test.osm\n");
+        return 1;
+    }
+    falhas += comparar(grafo, "test.osm", 500);
+    liberar_grafo(grafo);
+
+    grafo = ler_osm("test_oneway.osm");
+    if (grafo) {
+        falhas += comparar(grafo, "test_oneway.osm", 200);
+        liberar_grafo(grafo);
+    }
+
+    grafo = criar_grade_mao_unica(200, 99, 6, 1.3);
+    falhas += comparar(grafo, "grid 200x200 (synthetic)", 100);
+    liberar_grafo(grafo);
+
+    printf("=== Test completed ===\n");
+    return falhas ? 1 : 0;
+}
@@ -0,0 +1,280 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <float.h>
+#include "../include/osm_reader.h"
+#include "../include/graph.h"
+#include "../include/dijkstra.h"
+#include "../include/distance_matrix.h"
+#include "../include/edit.h"
+#include "../include/snapping.h"
+#include "fixtures.h"
+
+#define METROS_POR_GRAU (6371000.0 * 3.14159265358979323846 / 180.0)
+
+// Distância em metros da coordenada até a aresta e, na projeção
+// equirretangular em torno da coordenada (a mesma das consultas)
+static double distancia_bruta(const Grafo *grafo, size_t e, double lat, double lon) {
+    double c = cos(lat * 3.14159265358979323846 / 180.0);
+    const Ponto *a = &grafo->pontos[buscar_indice_ponto(grafo, grafo->arestas[e].origem)];
+    const Ponto *b = &grafo->pontos[buscar_indice_ponto(grafo, grafo->arestas[e].destino)];
+    double ax = (a->lon - lon) * METROS_POR_GRAU * c, ay = (a->lat - lat) * METROS_POR_GRAU;
+    double dx = (b->lon - lon) * METROS_POR_GRAU * c - ax, dy = (b->lat - lat) * METROS_POR_GRAU - ay;
+    double c2 = dx * dx + dy * dy;
+    double t = c2 > 0.0 ? -(ax * dx + ay * dy) / c2 : 0.0;
+    t = t < 0.0 ? 0.0 : t > 1.0 ? 1.0 : t;
+    return hypot(ax + t * dx, ay + t * dy);
+}
+
+// Custo entre duas projeções pela força bruta: pontas alcançáveis de cada
+// lado combinadas com dijkstra_distancias() a partir de cada ponta de saída
+static double custo_bruto(Grafo *grafo, const ProjecaoAresta *a, const ProjecaoAresta *b) {
+    const Aresta *ea = &grafo->arestas[a->aresta], *eb = &grafo->arestas[b->aresta];
+    double melhor = DBL_MAX;
+    if (a->aresta == b->aresta && (b->fracao >= a->fracao || ea->is_bidirectional)) {
+        melhor = fabs(b->fracao - a->fracao) * ea->peso;
+    }
+    long saidas[2] = {ea->destino, ea->origem};
+    double custos_saida[2] = {(1.0 - a->fracao) * ea->peso, a->fracao * ea->peso};
+    long entradas[2] = {eb->origem, eb->destino};
+    double custos_entrada[2] = {b->fracao * eb->peso, (1.0 - b->fracao) * eb->peso};
+    for (int s = 0; s < (ea->is_bidirectional || a->fracao == 0.0 ? 2 : 1); s++) {
+        double *d = dijkstra_distancias(grafo, saidas[s]);
+        for (int e = 0; e < (eb->is_bidirectional || b->fracao == 1.0 ? 2 : 1); e++) {
+            double meio = d[buscar_indice_ponto(grafo, entradas[e])];
+            if (meio != DBL_MAX && custos_saida[s] + meio + custos_entrada[e] < melhor) {
+                melhor = custos_saida[s] + meio + custos_entrada[e];
+            }
+        }
+        free(d);
+    }
+    return melhor;
+}
+
+int main() {
+    printf("=== Testing Nearest-Edge Snapping ===\n\n");
+    int falhas = 0;
+
+    // Grade 20x20 de ~100 m com os pontos deslocados ao acaso, ligações à
+    // direita, abaixo e em algumas diagonais, peso igual ao comprimento e uma
+    // via em cada cinco de mão única
+    unsigned int estado = 13;
+    Grafo *grafo = criar_grafo();
+    const double lado = 2000.0 / METROS_POR_GRAU;
+    for (int i = 0; i < 400; i++) {
+        adicionar_ponto(grafo, i + 1, -16.7 + ((i / 20) + 0.6 * uniforme(&estado) - 0.3) * lado / 20,
+                        -49.2 + ((i % 20) + 0.6 * uniforme(&estado) - 0.3) * lado / 20);
+    }
+    for (int i = 0; i < 400; i++) {
+        int vizinhos[3] = {i % 20 < 19 ? i + 1 : -1, i < 380 ? i + 20 : -1,
+                           i % 20 < 19 && i < 380 && proximo_aleatorio(&estado) % 3 == 0 ? i + 21 : -1};
+        for (int v = 0; v < 3; v++) {
+            int j = vizinhos[v];
+            if (j < 0) continue;
+            const Ponto *a = &grafo->pontos[i], *b = &grafo->pontos[j];
+            double dx = (b->lon - a->lon) * METROS_POR_GRAU * cos(a->lat * 3.14159265358979323846 / 180.0);
+            double dy = (b->lat - a->lat) * METROS_POR_GRAU;
+            Aresta aresta = {i + 1, j + 1, hypot(dx, dy) / 1000.0, proximo_aleatorio(&estado) % 5 != 0};
+            adicionar_arestas(grafo, &aresta, 1);
+        }
+    }
+    IndiceEspacial *indice = criar_indice_espacial(grafo, 0.0);
+
+    // Mais próxima e vizinhas no raio contra a varredura de todas as arestas
+    int mais_proxima_ok = indice != NULL, proximas_ok = indice != NULL;
+    for (int q = 0; indice && q < 2000; q++) {
+        // Consultas também fora da área do grafo
+        double lat = -16.7 + (uniforme(&estado) * 1.4 - 0.2) * lado;
+        double lon = -49.2 + (uniforme(&estado) * 1.4 - 0.2) * lado;
+        size_t melhor = (size_t)-1;
+        double melhor_d = DBL_MAX;
+        size_t no_raio = 0;
+        for (size_t e = 0; e < grafo->num_arestas; e++) {
+            double d = distancia_bruta(grafo, e, lat, lon);
+            if (d < melhor_d) {
+                melhor_d = d;
+                melhor = e;
+            }
+            if (d <= 120.0) no_raio++;
+        }
+        ProjecaoAresta p;
+        if (aresta_mais_proxima(indice, lat, lon, 0.0, &p) != 0 || p.aresta != melhor ||
+            fabs(p.distancia_m - melhor_d) > 1e-6) {
+            mais_proxima_ok = 0;
+        }
+        // Limitada ao raio: só acha se a mais próxima estiver nele
+        int limitada = aresta_mais_proxima(indice, lat, lon, 60.0, &p);
+        if ((limitada == 0) != (melhor_d <= 60.0)) mais_proxima_ok = 0;
+
+        ProjecaoAresta saida[64];
+        size_t n = arestas_proximas(indice, lat, lon, 120.0, saida, 64);
+        if (n != (no_raio < 64 ? no_raio : 64)) proximas_ok = 0;
+        for (size_t i = 0; i < n; i++) {
+            if (saida[i].distancia_m > 120.0 || fabs(distancia_bruta(grafo, saida[i].aresta, lat, lon) -
+                                                     saida[i].distancia_m) > 1e-9) {
+                proximas_ok = 0;
+            }
+            if (i > 0 && (saida[i].distancia_m < saida[i - 1].distancia_m || saida[i].aresta == saida[i - 1].aresta)) {
+                proximas_ok = 0;
+            }
+        }
+        if (n > 0 && saida[0].aresta != melhor) proximas_ok = 0;
+    }
+    printf("%s Nearest edge matches a scan of all edges (2000 queries, in and around the graph)\n",
+           mais_proxima_ok ? "✓" : "✗");
+    falhas += !mais_proxima_ok;
+    printf("%s Edges within a radius come sorted, without repeats, as in a full scan\n", proximas_ok ? "✓" : "✗");
+    falhas += !proximas_ok;
+
+    // Rota entre projeções aleatórias contra a força bruta
+    EspacoBusca *espaco = criar_espaco_busca(grafo->num_pontos);
+    int rotas_ok = indice && espaco, alcancadas = 0;
+    for (int q = 0; rotas_ok && q < 200; q++) {
+        ProjecaoAresta a, b;
+        aresta_mais_proxima(indice, -16.7 + uniforme(&estado) * lado, -49.2 + uniforme(&estado) * lado, 0.0, &a);
+        aresta_mais_proxima(indice, -16.7 + uniforme(&estado) * lado, -49.2 + uniforme(&estado) * lado, 0.0, &b);
+        if (q % 10 == 0) b.aresta = a.aresta;  // Também na mesma aresta
+        ResultadoDijkstra *r = dijkstra_projecoes(grafo, espaco, &a, &b);
+        double esperado = custo_bruto(grafo, &a, &b);
+        if (!r || r->sucesso != (esperado != DBL_MAX)) {
+            rotas_ok = 0;
+        } else if (r->sucesso) {
+            alcancadas++;
+            if (fabs(r->distancia_total - esperado) > 1e-9) rotas_ok = 0;
+        }
+        liberar_resultado_dijkstra(r);
+    }
+    printf("%s Routes between projected points match the brute-force cost (%d of 200 reachable)\n",
+           rotas_ok ? "✓" : "✗", alcancadas);
+    falhas += !rotas_ok;
+    liberar_espaco_busca(espaco);
+    liberar_indice_espacial(indice);
+    liberar_grafo(grafo);
+
+    // Rua 1-2-3 de mão dupla e anel de mão única 4->5->6->4, trechos de 100 m
+    Grafo *vias = criar_grafo();
+    double d100 = 100.0 / METROS_POR_GRAU;
+    adicionar_ponto(vias, 1, -16.7, -49.2);
+    adicionar_ponto(vias, 2, -16.7, -49.2 + d100);
+    adicionar_ponto(vias, 3, -16.7, -49.2 + 2 * d100);
+    adicionar_ponto(vias, 4, -16.7 + 3 * d100, -49.2);
+    adicionar_ponto(vias, 5, -16.7 + 3 * d100, -49.2 + d100);
+    adicionar_ponto(vias, 6, -16.7 + 4 * d100, -49.2);
+    adicionar_aresta(vias, 1, 2, 0.1);
+    adicionar_aresta(vias, 2, 3, 0.1);
+    Aresta anel[3] = {{4, 5, 0.1, 0}, {5, 6, 0.14, 0}, {6, 4, 0.1, 0}};
+    adicionar_arestas(vias, anel, 3);
+    indice = criar_indice_espacial(vias, 0.0);
+    espaco = criar_espaco_busca(vias->num_pontos);
+
+    // Clique a 10 m da rua, no meio do primeiro quarteirão
+    ProjecaoAresta meio_12, meio_23;
+    int projecao_ok = aresta_mais_proxima(indice, -16.7 + 0.1 * d100, -49.2 + 0.5 * d100, 0.0, &meio_12) == 0 &&
+                      vias->arestas[meio_12.aresta].origem == 1 && vias->arestas[meio_12.aresta].destino == 2 &&
+                      fabs(meio_12.fracao - 0.5) < 1e-6 && fabs(meio_12.distancia_m - 10.0) < 0.01 &&
+                      fabs(meio_12.lat + 16.7) < 1e-9 && fabs(meio_12.lon - (-49.2 + 0.5 * d100)) < 1e-9;
+    printf("%s Mid-street click projects onto the street at the right fraction\n", projecao_ok ? "✓" : "✗");
+    falhas += !projecao_ok;
+
+    // Entre dois quarteirões: metade de cada um, passando pelo ponto 2
+    aresta_mais_proxima(indice, -16.7 - 0.05 * d100, -49.2 + 1.25 * d100, 0.0, &meio_23);
+    ResultadoDijkstra *r = dijkstra_projecoes(vias, espaco, &meio_12, &meio_23);
+    int divide_ok = r && r->sucesso && r->tamanho_caminho == 1 && r->caminho[0] == 2 &&
+                    fabs(r->distancia_total - 0.075) < 1e-9;
+    liberar_resultado_dijkstra(r);
+    // A volta também passa pelo ponto 2
+    r = dijkstra_projecoes(vias, espaco, &meio_23, &meio_12);
+    divide_ok = divide_ok && r && r->sucesso && r->tamanho_caminho == 1 && fabs(r->distancia_total - 0.075) < 1e-9;
+    liberar_resultado_dijkstra(r);
+    // Na mesma aresta, de trás para frente numa via de mão dupla: trecho direto
+    ProjecaoAresta perto = meio_12;
+    perto.fracao = 0.2;
+    r = dijkstra_projecoes(vias, espaco, &meio_12, &perto);
+    divide_ok = divide_ok && r && r->sucesso && r->tamanho_caminho == 0 && fabs(r->distancia_total - 0.03) < 1e-9;
+    liberar_resultado_dijkstra(r);
+    printf("%s Edges are split virtually at the projections (through node 2, or direct on one edge)\n",
+           divide_ok ? "✓" : "✗");
+    falhas += !divide_ok;
+
+    // Mão única: de 0.7 para 0.2 na aresta 4->5 é preciso dar a volta no anel
+    ProjecaoAresta frente, tras;
+    aresta_mais_proxima(indice, -16.7 + 3 * d100, -49.2 + 0.7 * d100, 0.0, &frente);
+    aresta_mais_proxima(indice, -16.7 + 3 * d100, -49.2 + 0.2 * d100, 0.0, &tras);
+    r = dijkstra_projecoes(vias, espaco, &frente, &tras);
+    int mao_unica_ok = r && r->sucesso && r->tamanho_caminho == 3 && r->caminho[0] == 5 && r->caminho[1] == 6 &&
+                       r->caminho[2] == 4 && fabs(r->distancia_total - (0.03 + 0.14 + 0.1 + 0.02)) < 1e-9;
+    liberar_resultado_dijkstra(r);
+    r = dijkstra_projecoes(vias, espaco, &tras, &frente);
+    mao_unica_ok = mao_unica_ok && r && r->sucesso && r->tamanho_caminho == 0 && fabs(r->distancia_total - 0.05) < 1e-9;
+    liberar_resultado_dijkstra(r);
+    // E entre a rua e o anel não há ligação
+    r = dijkstra_projecoes(vias, espaco, &meio_12, &frente);
+    mao_unica_ok = mao_unica_ok && r && !r->sucesso && r->distancia_total < 0.0;
+    liberar_resultado_dijkstra(r);
+    printf("%s One-way edges are only left and entered in their direction\n", mao_unica_ok ? "✓" : "✗");
+    falhas += !mao_unica_ok;
+
+    // Projeções nas pontas equivalem a rotear entre os pontos, em qualquer métrica
+    ProjecaoAresta no_1 = meio_12, no_3 = meio_23;
+    no_1.fracao = 0.0;
+    no_3.fracao = 1.0;
+    espaco->metrica = METRICA_TEMPO;
+    r = dijkstra_projecoes(vias, espaco, &no_1, &no_3);
+    ResultadoDijkstra *ref = dijkstra_metrica(vias, 1, 3, METRICA_TEMPO);
+    int pontas_ok = r && ref && r->sucesso && ref->sucesso && fabs(r->distancia_total - ref->distancia_total) < 1e-9 &&
+                    r->tamanho_caminho == 3 && r->caminho[0] == 1 && r->caminho[2] == 3;
+    liberar_resultado_dijkstra(r);
+    liberar_resultado_dijkstra(ref);
+    ProjecaoAresta em_5;
+    int no_ponto = projecao_no_ponto(indice, 5, &em_5) == 0 && em_5.distancia_m == 0.0 &&
+                   ((vias->arestas[em_5.aresta].origem == 5 && em_5.fracao == 0.0) ||
+                    (vias->arestas[em_5.aresta].destino == 5 && em_5.fracao == 1.0)) &&
+                   projecao_no_ponto(indice, 99, &em_5) == -1;
+    r = dijkstra_projecoes(vias, espaco, &frente, &em_5);
+    pontas_ok = pontas_ok && no_ponto && r && r->sucesso && r->tamanho_caminho == 1 && r->caminho[0] == 5;
+    liberar_resultado_dijkstra(r);
+    ProjecaoAresta invalida = no_1;
+    invalida.fracao = 1.5;
+    pontas_ok = pontas_ok && dijkstra_projecoes(vias, espaco, &invalida, &no_3) == NULL;
+    printf("%s Projections at nodes route like the nodes themselves (time metric)\n", pontas_ok ? "✓" : "✗");
+    falhas += !pontas_ok;
+
+    // Grafo sem arestas: nada a projetar
+    Grafo *vazio = criar_grafo();
+    adicionar_ponto(vazio, 1, -16.7, -49.2);
+    IndiceEspacial *indice_vazio = criar_indice_espacial(vazio, 0.0);
+    ProjecaoAresta p;
+    int vazio_ok = indice_vazio && aresta_mais_proxima(indice_vazio, -16.7, -49.2, 0.0, &p) == -1 &&
+                   arestas_proximas(indice_vazio, -16.7, -49.2, 100.0, &p, 1) == 0;
+    printf("%s Graph without edges yields no projection\n", vazio_ok ? "✓" : "✗");
+    falhas += !vazio_ok;
+    liberar_indice_espacial(indice_vazio);
+    liberar_grafo(vazio);
+
+    // As edições mantêm o índice: a projeção acompanha uma via invertida no
+    // lugar e acha uma via nova sem reconstruir nada
+    EditState estado_edicao;
+    init_edit_state(&estado_edicao);
+    update_node_ids(&estado_edicao, vias);
+    estado_edicao.indice_espacial = indice;
+    ProjecaoAresta invertida, nova;
+    int edicao_ok = set_connection_direction(vias, &estado_edicao, 2, 1, 0) &&
+                    aresta_mais_proxima(indice, -16.7 + 0.1 * d100, -49.2 + 0.25 * d100, 0.0, &invertida) == 0 &&
+                    vias->arestas[invertida.aresta].origem == 2 && fabs(invertida.fracao - 0.75) < 1e-6 &&
+                    create_node_at_position(vias, &estado_edicao, -16.7 - 2 * d100, -49.2 + d100);
+    long long novo_id = vias->pontos[vias->num_pontos - 1].id;
+    edicao_ok = edicao_ok && connect_nodes(vias, &estado_edicao, 2, novo_id) &&
+                aresta_mais_proxima(indice, -16.7 - 1.5 * d100, -49.2 + 1.1 * d100, 0.0, &nova) == 0 &&
+                vias->arestas[nova.aresta].destino == novo_id && fabs(nova.fracao - 0.75) < 1e-6 &&
+                fabs(nova.distancia_m - distancia_bruta(vias, nova.aresta, -16.7 - 1.5 * d100, -49.2 + 1.1 * d100)) < 1e-9 &&
+                estado_edicao.indice_espacial == indice;
+    printf("%s Snapping follows edits through the maintained spatial index\n", edicao_ok ? "✓" : "✗");
+    falhas += !edicao_ok;
+
+    liberar_espaco_busca(espaco);
+    liberar_indice_espacial(estado_edicao.indice_espacial);
+    liberar_grafo(vias);
+
+    printf("\n=== Test completed ===\n");
+    return falhas ? 1 : 0;
+}
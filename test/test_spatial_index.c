@@ -0,0 +1,260 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <float.h>
+#include "../include/osm_reader.h"
+#include "../include/graph.h"
+#include "../include/edit.h"
+#include "../include/spatial_index.h"
+#include "fixtures.h"
+
+// Distância da coordenada ao ponto ou à aresta pela força bruta (DBL_MAX se
+// a aresta tem ponta inexistente)
+static double distancia_bruta(Grafo *grafo, int segmento, size_t item, double lat, double lon) {
+    if (!segmento) return hypot(grafo->pontos[item].lon - lon, grafo->pontos[item].lat - lat);
+    ssize_t o = buscar_indice_ponto(grafo, grafo->arestas[item].origem);
+    ssize_t d = buscar_indice_ponto(grafo, grafo->arestas[item].destino);
+    if (o < 0 || d < 0) return DBL_MAX;
+    const Ponto *a = &grafo->pontos[o], *b = &grafo->pontos[d];
+    double dx = b->lon - a->lon, dy = b->lat - a->lat;
+    double c2 = dx * dx + dy * dy;
+    double t = c2 > 0.0 ? ((lon - a->lon) * dx + (lat - a->lat) * dy) / c2 : 0.0;
+    t = t < 0.0 ? 0.0 : t > 1.0 ? 1.0 : t;
+    return hypot(lon - (a->lon + t * dx), lat - (a->lat + t * dy));
+}
+
+// Os k mais próximos pela força bruta, em ordem de distância e índice
+static size_t k_brutos(Grafo *grafo, int segmento, double lat, double lon, double raio_max, size_t k, size_t *saida,
+                       double *distancias) {
+    size_t total = segmento ? grafo->num_arestas : grafo->num_pontos, encontrados = 0;
+    for (size_t i = 0; i < total; i++) {
+        double d = distancia_bruta(grafo, segmento, i, lat, lon);
+        if (d == DBL_MAX || (raio_max > 0.0 && d > raio_max)) continue;
+        if (encontrados == k && !(d < distancias[k - 1])) continue;
+        size_t pos = encontrados < k ? encontrados++ : k - 1;
+        while (pos > 0 && distancias[pos - 1] > d) {
+            distancias[pos] = distancias[pos - 1];
+            saida[pos] = saida[pos - 1];
+            pos--;
+        }
+        distancias[pos] = d;
+        saida[pos] = i;
+    }
+    return encontrados;
+}
+
+static int comparar_indices(const void *a, const void *b) {
+    size_t x = *(const size_t *)a, y = *(const size_t *)b;
+    return (x > y) - (x < y);
+}
+
+// Confere a caixa contra a força bruta (a lista volta ordenada)
+static int caixa_confere(Grafo *grafo, const IndiceEspacial *indice, int segmento, double min_lat, double min_lon,
+                         double max_lat, double max_lon, ListaIndices *lista) {
+    int r = segmento ? segmentos_na_caixa(indice, min_lat, min_lon, max_lat, max_lon, lista)
+                     : pontos_na_caixa(indice, min_lat, min_lon, max_lat, max_lon, lista);
+    if (r != 0) return 0;
+    qsort(lista->itens, lista->quantidade, sizeof(size_t), comparar_indices);
+    size_t j = 0, total = segmento ? grafo->num_arestas : grafo->num_pontos;
+    for (size_t i = 0; i < total; i++) {
+        int dentro;
+        if (segmento) {
+            ssize_t o = buscar_indice_ponto(grafo, grafo->arestas[i].origem);
+            ssize_t d = buscar_indice_ponto(grafo, grafo->arestas[i].destino);
+            if (o < 0 || d < 0) continue;
+            const Ponto *a = &grafo->pontos[o], *b = &grafo->pontos[d];
+            dentro = fmax(a->lat, b->lat) >= min_lat && fmin(a->lat, b->lat) <= max_lat &&
+                     fmax(a->lon, b->lon) >= min_lon && fmin(a->lon, b->lon) <= max_lon;
+        } else {
+            const Ponto *p = &grafo->pontos[i];
+            dentro = p->lat >= min_lat && p->lat <= max_lat && p->lon >= min_lon && p->lon <= max_lon;
+        }
+        if (!dentro) continue;
+        if (j >= lista->quantidade || lista->itens[j] != i) return 0;
+        j++;
+    }
+    return j == lista->quantidade;
+}
+
+// Consultas aleatórias (dentro e um pouco fora da área) contra a força bruta
+static int consultas_conferem(Grafo *grafo, const IndiceEspacial *indice, unsigned int *estado, int consultas,
+                              ListaIndices *lista) {
+    double min_lat = DBL_MAX, max_lat = -DBL_MAX, min_lon = DBL_MAX, max_lon = -DBL_MAX;
+    for (size_t i = 0; i < grafo->num_pontos; i++) {
+        min_lat = fmin(min_lat, grafo->pontos[i].lat);
+        max_lat = fmax(max_lat, grafo->pontos[i].lat);
+        min_lon = fmin(min_lon, grafo->pontos[i].lon);
+        max_lon = fmax(max_lon, grafo->pontos[i].lon);
+    }
+    double alt = max_lat - min_lat, larg = max_lon - min_lon;
+    for (int q = 0; q < consultas; q++) {
+        double lat = min_lat - 0.2 * alt + 1.4 * alt * uniforme(estado);
+        double lon = min_lon - 0.2 * larg + 1.4 * larg * uniforme(estado);
+        double raio = q % 3 == 0 ? 0.0 : 0.05 * larg * uniforme(estado);
+        for (int segmento = 0; segmento < 2; segmento++) {
+            size_t k = 1 + q % 7, saida[8], esperado[8];
+            double dist[8], dist_esperada[8];
+            size_t n = segmento ? segmentos_mais_proximos(indice, lat, lon, raio, k, saida, dist)
+                                : pontos_mais_proximos(indice, lat, lon, raio, k, saida, dist);
+            size_t n_bruto = k_brutos(grafo, segmento, lat, lon, raio, k, esperado, dist_esperada);
+            if (n != n_bruto) return 0;
+            for (size_t i = 0; i < n; i++) {
+                if (saida[i] != esperado[i] || fabs(dist[i] - dist_esperada[i]) > 1e-12) return 0;
+            }
+            size_t mais_proximo;
+            int r = segmento ? segmento_mais_proximo(indice, lat, lon, raio, &mais_proximo)
+                             : ponto_mais_proximo(indice, lat, lon, raio, &mais_proximo);
+            if (r != (n_bruto ? 0 : -1) || (n_bruto && mais_proximo != esperado[0])) return 0;
+
+            double meia_alt = alt * 0.1 * uniforme(estado), meia_larg = larg * 0.1 * uniforme(estado);
+            if (!caixa_confere(grafo, indice, segmento, lat - meia_alt, lon - meia_larg, lat + meia_alt,
+                               lon + meia_larg, lista))
+                return 0;
+        }
+    }
+    return 1;
+}
+
+static int limites_conferem(Grafo *grafo, IndiceEspacial *indice) {
+    double min_lat, max_lat, min_lon, max_lon;
+    if (limites_indice(indice, &min_lat, &max_lat, &min_lon, &max_lon) != 0) return grafo->num_pontos == 0;
+    double esperado[4] = {DBL_MAX, -DBL_MAX, DBL_MAX, -DBL_MAX};
+    for (size_t i = 0; i < grafo->num_pontos; i++) {
+        esperado[0] = fmin(esperado[0], grafo->pontos[i].lat);
+        esperado[1] = fmax(esperado[1], grafo->pontos[i].lat);
+        esperado[2] = fmin(esperado[2], grafo->pontos[i].lon);
+        esperado[3] = fmax(esperado[3], grafo->pontos[i].lon);
+    }
+    return min_lat == esperado[0] && max_lat == esperado[1] && min_lon == esperado[2] && max_lon == esperado[3];
+}
+
+int main() {
+    printf("=== Testing Spatial Index ===\n\n");
+    int falhas = 0;
+    unsigned int estado = 17;
+    ListaIndices *lista = criar_lista_indices();
+
+    // Bairro denso, pontos espalhados e vias curtas entre vizinhos, algumas
+    // vias longas atravessando o mapa e uma aresta com ponta inexistente
+    Grafo *grafo = criar_grafo();
+    for (int i = 0; i < 1500; i++) {
+        double espalhamento = i < 1000 ? 0.01 : 0.2;
+        adicionar_ponto(grafo, i + 1, -16.7 + espalhamento * uniforme(&estado),
+                        -49.2 + espalhamento * uniforme(&estado));
+    }
+    for (int i = 0; i < 1500; i++) {
+        int j = i < 1000 ? (i + 1 + (int)(proximo_aleatorio(&estado) % 5)) % 1000
+                         : 1000 + (int)(proximo_aleatorio(&estado) % 500);
+        if (j != i) adicionar_aresta(grafo, i + 1, j + 1, 1.0);
+    }
+    for (int i = 0; i < 20; i++) {
+        adicionar_aresta(grafo, 1 + proximo_aleatorio(&estado) % 1500, 1 + proximo_aleatorio(&estado) % 1500, 1.0);
+    }
+    adicionar_aresta(grafo, 1, 99999, 1.0);
+
+    IndiceEspacial *indice = criar_indice_espacial(grafo, 0.0);
+    int consultas_ok = indice && consultas_conferem(grafo, indice, &estado, 1500, lista);
+    printf("%s Nearest, k-nearest and box queries match brute force (points and segments)\n",
+           consultas_ok ? "✓" : "✗");
+    falhas += !consultas_ok;
+
+    int limites_ok = indice && limites_conferem(grafo, indice);
+    printf("%s Cached bounds match the points\n", limites_ok ? "✓" : "✗");
+    falhas += !limites_ok;
+
+    size_t fora;
+    int raio_ok = indice && ponto_mais_proximo(indice, 10.0, 10.0, 1.0, &fora) == -1 &&
+                  segmento_mais_proximo(indice, 10.0, 10.0, 1.0, &fora) == -1 &&
+                  ponto_mais_proximo(indice, 10.0, 10.0, 0.0, &fora) == 0;
+    printf("%s Radius limits the search; no radius always finds something\n", raio_ok ? "✓" : "✗");
+    falhas += !raio_ok;
+
+    // Um tamanho de célula pedido pequeno demais é aumentado, sem mudar as respostas
+    IndiceEspacial *fino = criar_indice_espacial(grafo, 1e-9);
+    int fino_ok = fino && consultas_conferem(grafo, fino, &estado, 200, lista);
+    printf("%s Tiny requested cell size still answers correctly\n", fino_ok ? "✓" : "✗");
+    falhas += !fino_ok;
+    liberar_indice_espacial(fino);
+
+    // Edições pelas funções de edit.c, que mantêm o índice: criar dentro e
+    // fora da área (a grade é refeita), apagar (pontos e arestas trazidos do
+    // fim do vetor), conectar, desconectar e mudar a direção de uma via com
+    // um registro espelhado (que é descartado)
+    EditState estado_edicao;
+    init_edit_state(&estado_edicao);
+    update_node_ids(&estado_edicao, grafo);
+    estado_edicao.indice_espacial = indice;
+    int edicoes_ok = indice != NULL;
+    for (int op = 0; op < 90 && edicoes_ok; op++) {
+        switch (op % 6) {
+            case 0: {
+                double alcance = op % 16 == 0 ? 0.5 : 0.2;
+                create_node_at_position(grafo, &estado_edicao, -16.75 + alcance * uniforme(&estado),
+                                        -49.25 + alcance * uniforme(&estado));
+                break;
+            }
+            case 1:
+            case 2: {
+                // Às vezes um ponto da borda, para forçar o recálculo dos limites
+                size_t alvo = proximo_aleatorio(&estado) % grafo->num_pontos;
+                if (op % 8 == 1) {
+                    for (size_t i = 0; i < grafo->num_pontos; i++) {
+                        if (grafo->pontos[i].lon < grafo->pontos[alvo].lon) alvo = i;
+                    }
+                }
+                delete_node(grafo, &estado_edicao, grafo->pontos[alvo].id);
+                break;
+            }
+            case 3: {
+                size_t a = proximo_aleatorio(&estado) % grafo->num_pontos;
+                size_t b = proximo_aleatorio(&estado) % grafo->num_pontos;
+                if (a != b) connect_nodes(grafo, &estado_edicao, grafo->pontos[a].id, grafo->pontos[b].id);
+                break;
+            }
+            case 4: {
+                const Aresta *alvo = &grafo->arestas[proximo_aleatorio(&estado) % grafo->num_arestas];
+                disconnect_nodes(grafo, &estado_edicao, alvo->origem, alvo->destino);
+                break;
+            }
+            default: {
+                size_t e = proximo_aleatorio(&estado) % grafo->num_arestas;
+                long long u = grafo->arestas[e].origem, v = grafo->arestas[e].destino;
+                ssize_t iu = buscar_indice_ponto(grafo, u), iv = buscar_indice_ponto(grafo, v);
+                if (iu >= 0 && iv >= 0 && adicionar_aresta(grafo, v, u, 1.0) == 0) {
+                    inserir_aresta_indice(indice, grafo->num_arestas - 1, (size_t)iv, (size_t)iu);
+                }
+                set_connection_direction(grafo, &estado_edicao, u, v, op % 12 == 5 ? 1 : -1);
+                break;
+            }
+        }
+        edicoes_ok = estado_edicao.indice_espacial == indice &&
+                     consultas_conferem(grafo, indice, &estado, 20, lista) && limites_conferem(grafo, indice);
+    }
+    printf("%s Index stays consistent through create/delete/connect/disconnect/direction edits\n",
+           edicoes_ok ? "✓" : "✗");
+    falhas += !edicoes_ok;
+    liberar_indice_espacial(estado_edicao.indice_espacial);
+    liberar_grafo(grafo);
+
+    // Grafo vazio: nada a encontrar, e o primeiro ponto inserido refaz a grade
+    Grafo *vazio = criar_grafo();
+    IndiceEspacial *indice_vazio = criar_indice_espacial(vazio, 0.0);
+    double a, b, c, d;
+    size_t item;
+    int vazio_ok = indice_vazio && ponto_mais_proximo(indice_vazio, 0.0, 0.0, 0.0, &item) == -1 &&
+                   limites_indice(indice_vazio, &a, &b, &c, &d) == -1 &&
+                   pontos_na_caixa(indice_vazio, -90.0, -180.0, 90.0, 180.0, lista) == 0 && lista->quantidade == 0;
+    adicionar_ponto(vazio, 7, -16.7, -49.2);
+    vazio_ok = vazio_ok && inserir_ponto_indice(indice_vazio, 0) == 0 &&
+               ponto_mais_proximo(indice_vazio, 0.0, 0.0, 0.0, &item) == 0 && item == 0 &&
+               limites_indice(indice_vazio, &a, &b, &c, &d) == 0 && a == -16.7 && d == -49.2;
+    printf("%s Empty graph, then a first inserted point\n", vazio_ok ? "✓" : "✗");
+    falhas += !vazio_ok;
+    liberar_indice_espacial(indice_vazio);
+    liberar_grafo(vazio);
+
+    liberar_lista_indices(lista);
+
+    printf("\n=== Test completed ===\n");
+    return falhas ? 1 : 0;
+}
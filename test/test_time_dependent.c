@@ -0,0 +1,191 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <float.h>
+#include <math.h>
+#include "../include/osm_reader.h"
+#include "../include/graph.h"
+#include "../include/dijkstra.h"
+#include "../include/time_dependent.h"
+#include "fixtures.h"
+
+#define HORA 3600u
+
+// Referência por correção de rótulos (Bellman-Ford sobre instantes de
+// chegada), sem depender da ordem de estabelecimento do Dijkstra
+static double chegada_referencia(Grafo *grafo, const TabelaPerfis *tabela, long origem_id,
+                                 long destino_id, double partida) {
+    const IndicesGrafo *indices = obter_indices(grafo);
+    size_t n = grafo->num_pontos;
+    double *chegada = malloc(n * sizeof(double));
+    for (size_t i = 0; i < n; i++) chegada[i] = DBL_MAX;
+    chegada[buscar_indice_ponto(grafo, origem_id)] = partida;
+    int mudou = 1;
+    while (mudou) {
+        mudou = 0;
+        for (size_t u = 0; u < n; u++) {
+            if (chegada[u] == DBL_MAX) continue;
+            for (size_t k = indices->inicio_arcos[u]; k < indices->inicio_arcos[u + 1]; k++) {
+                const Arco *arco = &indices->arcos[k];
+                double nova = chegada[u] + tempo_travessia(tabela, grafo, arco->aresta, chegada[u]);
+                if (nova < chegada[arco->destino] - 1e-9) {
+                    chegada[arco->destino] = nova;
+                    mudou = 1;
+                }
+            }
+        }
+    }
+    double resultado = chegada[buscar_indice_ponto(grafo, destino_id)];
+    free(chegada);
+    return resultado == DBL_MAX ? -1.0 : resultado - partida;
+}
+
+int main() {
+    printf("=== Testing Time-Dependent Routing ===\n\n");
+    int falhas = 0;
+
+    // Grafo pequeno: A-B direto (1 km, congestiona às 8h) ou A-C-B (1.5 km)
+    Grafo *pequeno = criar_grafo();
+    adicionar_ponto(pequeno, 1, -16.700, -49.200);
+    adicionar_ponto(pequeno, 2, -16.700, -49.190);
+    adicionar_ponto(pequeno, 3, -16.705, -49.195);
+    adicionar_aresta(pequeno, 1, 2, 1.0);
+    adicionar_aresta(pequeno, 1, 3, 0.75);
+    adicionar_aresta(pequeno, 3, 2, 0.75);
+    TabelaPerfis *tabela = criar_tabela_perfis(pequeno, 36.0);
+
+    PontoPerfil pico[] = {{6 * HORA, 1.0f}, {8 * HORA, 5.0f}, {12 * HORA, 1.0f}};
+    long id_pico = registrar_perfil(tabela, pico, 3);
+    double f7 = fator_perfil(tabela, (uint32_t)id_pico, 7 * HORA);
+    double f10 = fator_perfil(tabela, (uint32_t)id_pico, 10 * HORA);
+    double f_amanha = fator_perfil(tabela, (uint32_t)id_pico, 24 * HORA + 8 * HORA);
+    int interpolado = id_pico >= 0 && fabs(f7 - 3.0) < 1e-6 && fabs(f10 - 3.0) < 1e-6 && fabs(f_amanha - 5.0) < 1e-6;
+    printf("%s Profile interpolates between breakpoints and repeats daily (7h: %.2f, 10h: %.2f)\n",
+           interpolado ? "✓" : "✗", f7, f10);
+    falhas += !interpolado;
+
+    // Trecho que atravessa a meia-noite: do último ponto de volta ao primeiro
+    PontoPerfil noturno[] = {{6 * HORA, 1.0f}, {18 * HORA, 1.5f}};
+    long id_noturno = registrar_perfil(tabela, noturno, 2);
+    double meia_noite = fator_perfil(tabela, (uint32_t)id_noturno, 0.0);
+    int volta = id_noturno >= 0 && fabs(meia_noite - 1.25) < 1e-6;
+    printf("%s Segment wrapping past midnight is interpolated (0h: %.3f)\n", volta ? "✓" : "✗", meia_noite);
+    falhas += !volta;
+
+    PontoPerfil copia[] = {{6 * HORA, 1.0f}, {8 * HORA, 5.0f}, {12 * HORA, 1.0f}};
+    long id_copia = registrar_perfil(tabela, copia, 3);
+    int compartilhado = id_copia == id_pico && tabela->num_perfis == 2 && tabela->num_pontos == 5;
+    printf("%s Identical profiles share one stored copy (%zu profiles, %zu breakpoints)\n",
+           compartilhado ? "✓" : "✗", tabela->num_perfis, tabela->num_pontos);
+    falhas += !compartilhado;
+
+    PontoPerfil fora_de_ordem[] = {{8 * HORA, 1.0f}, {6 * HORA, 2.0f}};
+    PontoPerfil fator_zero[] = {{0, 0.0f}};
+    int rejeitados = registrar_perfil(tabela, fora_de_ordem, 2) == -1 &&
+                     registrar_perfil(tabela, fator_zero, 1) == -1;
+    printf("%s Unsorted and non-positive profiles are rejected\n", rejeitados ? "✓" : "✗");
+    falhas += !rejeitados;
+
+    // FIFO depende da aresta: o fator cai 2 em 10 min (1/300 por segundo), o
+    // que serve a uma via de 100 s em via livre mas não a uma de 500 s
+    Grafo *longo = criar_grafo();
+    adicionar_ponto(longo, 1, -16.700, -49.200);
+    adicionar_ponto(longo, 2, -16.700, -49.190);
+    adicionar_ponto(longo, 3, -16.700, -49.150);
+    adicionar_aresta(longo, 1, 2, 1.0);
+    adicionar_aresta(longo, 2, 3, 5.0);
+    TabelaPerfis *tabela_longo = criar_tabela_perfis(longo, 36.0);
+    PontoPerfil queda_brusca[] = {{8 * HORA, 3.0f}, {8 * HORA + 600, 1.0f}};
+    long id_queda = registrar_perfil(tabela_longo, queda_brusca, 2);
+    int fifo_por_aresta = id_queda >= 0 && associar_perfil(tabela_longo, longo, 0, (uint32_t)id_queda) == 0 &&
+                     associar_perfil(tabela_longo, longo, 1, (uint32_t)id_queda) == -1 &&
+                     tabela_longo->perfil_aresta[1] == PERFIL_CONSTANTE;
+    printf("%s Steep drop accepted on a 100 s edge, rejected on a 500 s edge (FIFO per edge)\n",
+           fifo_por_aresta ? "✓" : "✗");
+    falhas += !fifo_por_aresta;
+    liberar_tabela_perfis(tabela_longo);
+    liberar_grafo(longo);
+
+    // 36 km/h: 100 s por km em via livre
+    associar_perfil(tabela, pequeno, 0, (uint32_t)id_pico);
+    double duracao_madrugada, duracao_pico;
+    ResultadoDijkstra *madrugada = dijkstra_dependente_tempo(pequeno, tabela, 1, 2, 3 * HORA, &duracao_madrugada);
+    ResultadoDijkstra *rush = dijkstra_dependente_tempo(pequeno, tabela, 1, 2, 8 * HORA, &duracao_pico);
+    int desvio = madrugada && rush && madrugada->sucesso && rush->sucesso &&
+                 madrugada->tamanho_caminho == 2 && fabs(duracao_madrugada - 100.0) < 1e-6 &&
+                 rush->tamanho_caminho == 3 && fabs(duracao_pico - 150.0) < 1e-6 &&
+                 fabs(rush->distancia_total - 1.5) < 1e-9;
+    printf("%s Rush-hour departure takes the detour (3h: %.0f s direct, 8h: %.0f s via detour)\n",
+           desvio ? "✓" : "✗", duracao_madrugada, duracao_pico);
+    falhas += !desvio;
+    liberar_resultado_dijkstra(madrugada);
+    liberar_resultado_dijkstra(rush);
+    liberar_tabela_perfis(tabela);
+    liberar_grafo(pequeno);
+
+    Grafo *grafo = ler_osm("test.osm");
+    if (!grafo) {
+        printf("ERROR: Failed to load test.osm\n");
+        return 1;
+    }
+
+    // Sem perfis, o tempo é a distância do dijkstra() na velocidade livre
+    tabela = criar_tabela_perfis(grafo, 40.0);
+    unsigned int estado = 5;
+    int estaticos_ok = 1;
+    for (int q = 0; q < 100; q++) {
+        long origem = grafo->pontos[proximo_aleatorio(&estado) % grafo->num_pontos].id;
+        long destino = grafo->pontos[proximo_aleatorio(&estado) % grafo->num_pontos].id;
+        double duracao;
+        ResultadoDijkstra *esperado = dijkstra(grafo, origem, destino);
+        ResultadoDijkstra *obtido = dijkstra_dependente_tempo(grafo, tabela, origem, destino, 9 * HORA, &duracao);
+        if (!esperado || !obtido || esperado->sucesso != obtido->sucesso ||
+            (obtido->sucesso && fabs(esperado->distancia_total / 40.0 * 3600.0 - duracao) > 1e-6)) {
+            estaticos_ok = 0;
+        }
+        liberar_resultado_dijkstra(esperado);
+        liberar_resultado_dijkstra(obtido);
+    }
+    printf("%s Without profiles, travel times equal static distances at free-flow speed\n",
+           estaticos_ok ? "✓" : "✗");
+    falhas += !estaticos_ok;
+
+    // Quatro padrões de trânsito espalhados pelas arestas, contra a referência
+    PontoPerfil padroes[4][3] = {
+        {{7 * HORA, 1.0f}, {8 * HORA, 2.5f}, {10 * HORA, 1.0f}},
+        {{16 * HORA, 1.0f}, {18 * HORA, 3.0f}, {20 * HORA, 1.0f}},
+        {{0, 1.2f}, {12 * HORA, 1.8f}, {23 * HORA, 1.2f}},
+        {{5 * HORA, 0.8f}, {9 * HORA, 1.6f}, {21 * HORA, 0.8f}},
+    };
+    long ids[4];
+    for (int p = 0; p < 4; p++) ids[p] = registrar_perfil(tabela, padroes[p], 3);
+    for (size_t e = 0; e < grafo->num_arestas; e++) {
+        unsigned int escolha = proximo_aleatorio(&estado) % 5;
+        if (escolha < 4 && ids[escolha] >= 0) associar_perfil(tabela, grafo, e, (uint32_t)ids[escolha]);
+    }
+    int exatos = ids[0] >= 0 && ids[1] >= 0 && ids[2] >= 0 && ids[3] >= 0;
+    for (int q = 0; exatos && q < 40; q++) {
+        long origem = grafo->pontos[proximo_aleatorio(&estado) % grafo->num_pontos].id;
+        long destino = grafo->pontos[proximo_aleatorio(&estado) % grafo->num_pontos].id;
+        double partida = (proximo_aleatorio(&estado) % 24) * (double)HORA;
+        double duracao;
+        ResultadoDijkstra *r = dijkstra_dependente_tempo(grafo, tabela, origem, destino, partida, &duracao);
+        double esperado = chegada_referencia(grafo, tabela, origem, destino, partida);
+        if (!r || fabs(duracao - esperado) > 1e-6) exatos = 0;
+        liberar_resultado_dijkstra(r);
+    }
+    printf("%s 40 time-dependent queries match label-correcting reference\n", exatos ? "✓" : "✗");
+    falhas += !exatos;
+
+    size_t por_aresta = grafo->num_arestas * (3 * sizeof(PontoPerfil) + sizeof(size_t));
+    size_t memoria = memoria_tabela_perfis(tabela);
+    int compacta = memoria < por_aresta / 2;
+    printf("%s Shared profiles use %zu bytes for %zu edges (%zu bytes with one copy per edge)\n",
+           compacta ? "✓" : "✗", memoria, grafo->num_arestas, por_aresta);
+    falhas += !compacta;
+
+    liberar_tabela_perfis(tabela);
+    liberar_grafo(grafo);
+
+    printf("\n=== Test completed ===\n");
+    return falhas ? 1 : 0;
+}
@@ -0,0 +1,200 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../include/osm_reader.h"
+#include "../include/graph.h"
+#include "../include/dijkstra.h"
+#include "../include/metrics.h"
+#include "../include/distance_matrix.h"
+#include "../include/components.h"
+#include "../include/tour.h"
+#include "fixtures.h"
+
+// A ordem começa no depósito e visita cada parada exatamente uma vez
+static int ordem_valida(const Tour *tour, size_t n) {
+    if (!tour || tour->num_paradas != n || tour->ordem[0] != 0) return 0;
+    int *vista = calloc(n, sizeof(int));
+    int valida = 1;
+    for (size_t k = 0; k < n; k++) {
+        if (tour->ordem[k] >= n || vista[tour->ordem[k]]++) valida = 0;
+    }
+    free(vista);
+    return valida;
+}
+
+static double custo_da_ordem(const double *custos, size_t n, const size_t *ordem, int circuito) {
+    double total = 0.0;
+    for (size_t k = 0; k + 1 < n; k++) total += custos[ordem[k] * n + ordem[k + 1]];
+    if (circuito) total += custos[ordem[n - 1] * n + ordem[0]];
+    return total;
+}
+
+// Menor custo entre todas as ordens com o depósito fixo (n pequeno)
+static double melhor_por_forca_bruta(const double *custos, size_t n, size_t *ordem, size_t k, int circuito) {
+    if (k == n) return custo_da_ordem(custos, n, ordem, circuito);
+    double melhor = -1.0;
+    for (size_t i = k; i < n; i++) {
+        size_t troca = ordem[k]; ordem[k] = ordem[i]; ordem[i] = troca;
+        double c = melhor_por_forca_bruta(custos, n, ordem, k + 1, circuito);
+        if (melhor < 0.0 || c < melhor) melhor = c;
+        troca = ordem[k]; ordem[k] = ordem[i]; ordem[i] = troca;
+    }
+    return melhor;
+}
+
+int main() {
+    printf("=== Testing Tour Optimization ===\n\n");
+    int falhas = 0;
+
+    // Linha 1..10 com arestas de 1 km: o circuito ótimo custa 2 * 9
+    Grafo *linha = criar_grafo();
+    for (int i = 1; i <= 10; i++) adicionar_ponto(linha, i, -16.7, -49.2 + i * 0.01);
+    for (int i = 1; i < 10; i++) adicionar_aresta(linha, i, i + 1, 1.0);
+    long embaralhadas[] = {1, 7, 3, 10, 2, 9, 5, 4, 8, 6};
+    Tour *tour = otimizar_tour(linha, embaralhadas, 10, METRICA_DISTANCIA, 1, 0.0);
+    int circuito = ordem_valida(tour, 10) && tour->completo && fabs(tour->custo - 18.0) < 1e-9 &&
+                   tour->rota && tour->rota->rota->sucesso && fabs(tour->rota->rota->distancia_total - 18.0) < 1e-9 &&
+                   tour->rota->rota->caminho[tour->rota->rota->tamanho_caminho - 1] == 1 && !tour->tempo_esgotado;
+    printf("%s Shuffled stops on a line give the optimal closed tour (cost %.1f)\n", circuito ? "✓" : "✗",
+           tour ? tour->custo : -1.0);
+    falhas += !circuito;
+    liberar_tour(tour);
+
+    // Caminho aberto a partir do meio: vai até uma ponta e volta à outra
+    long do_meio[] = {4, 1, 10, 7};
+    tour = otimizar_tour(linha, do_meio, 4, METRICA_DISTANCIA, 0, 0.0);
+    int aberto = ordem_valida(tour, 4) && fabs(tour->custo - 12.0) < 1e-9 && tour->rota &&
+                 tour->rota->num_trechos == 3 && tour->rota->rota->caminho[0] == 4;
+    printf("%s Open tour from the middle ends at the far end (cost %.1f)\n", aberto ? "✓" : "✗",
+           tour ? tour->custo : -1.0);
+    falhas += !aberto;
+    liberar_tour(tour);
+
+    long uma[] = {5};
+    long desconhecida[] = {1, 99};
+    tour = otimizar_tour(linha, uma, 1, METRICA_DISTANCIA, 0, 0.0);
+    int trivial = ordem_valida(tour, 1) && tour->custo == 0.0 && tour->completo;
+    int erros = otimizar_tour(linha, desconhecida, 2, METRICA_DISTANCIA, 1, 0.0) == NULL &&
+                otimizar_tour(linha, uma, 0, METRICA_DISTANCIA, 1, 0.0) == NULL;
+    printf("%s Single stop is a trivial tour; unknown ids and empty sets are rejected\n",
+           trivial && erros ? "✓" : "✗");
+    falhas += !(trivial && erros);
+    liberar_tour(tour);
+
+    // Ponto isolado: a ordem sai, mas marcada como incompleta e sem caminho
+    adicionar_ponto(linha, 50, -16.8, -49.3);
+    long com_isolado[] = {1, 50, 5};
+    tour = otimizar_tour(linha, com_isolado, 3, METRICA_DISTANCIA, 1, 0.0);
+    int incompleto = ordem_valida(tour, 3) && !tour->completo && tour->custo < 0.0 && tour->rota == NULL;
+    printf("%s Unreachable stop marks the tour incomplete\n", incompleto ? "✓" : "✗");
+    falhas += !incompleto;
+    liberar_tour(tour);
+    liberar_grafo(linha);
+
+    // Mão única: 1 -> 2 -> 3 -> 4 -> 1 é barato, o sentido contrário não
+    Grafo *anel = criar_grafo();
+    for (int i = 1; i <= 4; i++) adicionar_ponto(anel, i, -16.7 + (i % 2) * 0.01, -49.2 + (i / 2) * 0.01);
+    for (int i = 1; i <= 4; i++) {
+        Aresta ida = {i, i % 4 + 1, 1.0, 0};
+        Aresta volta = {i % 4 + 1, i, 5.0, 0};
+        adicionar_arestas(anel, &ida, 1);
+        adicionar_arestas(anel, &volta, 1);
+    }
+    long contrario[] = {1, 4, 3, 2};
+    tour = otimizar_tour(anel, contrario, 4, METRICA_DISTANCIA, 1, 0.0);
+    int assimetrico = ordem_valida(tour, 4) && fabs(tour->custo - 4.0) < 1e-9;
+    printf("%s Asymmetric costs: the tour follows the cheap direction (cost %.1f)\n",
+           assimetrico ? "✓" : "✗", tour ? tour->custo : -1.0);
+    falhas += !assimetrico;
+    liberar_tour(tour);
+    liberar_grafo(anel);
+
+    Grafo *grafo = ler_osm("test.osm");
+    if (!grafo) {
+        printf("ERROR: Failed to load test.osm\n");
+        return 1;
+    }
+
+    // Paradas sorteadas na maior componente forte: todas se alcançam
+    const IndicesGrafo *indices = obter_componentes(grafo);
+    long *conexos = malloc(grafo->num_pontos * sizeof(long));
+    size_t num_conexos = 0;
+    for (size_t v = 0; indices && v < grafo->num_pontos; v++) {
+        if (indices->componente_forte[v] == indices->maior_componente_forte) conexos[num_conexos++] = grafo->pontos[v].id;
+    }
+    if (num_conexos < 8) {
+        printf("ERROR: Largest component too small\n");
+        return 1;
+    }
+
+    // Conjuntos pequenos: custo coerente com a matriz, nunca pior que o
+    // vizinho mais próximo e perto do ótimo por força bruta
+    unsigned int estado = 45;
+    EspacoBusca *espaco = criar_espaco_busca(grafo->num_pontos);
+    int coerentes = 1, caminhos = 1, testados = 0, otimos = 0;
+    double pior_diferenca = 0.0;
+    for (int q = 0; q < 20; q++) {
+        Metrica metrica = (Metrica)(q % NUM_METRICAS);
+        int fecha = q % 2;
+        size_t n = 4 + proximo_aleatorio(&estado) % 5;
+        long ids[8];
+        for (size_t i = 0; i < n; i++) ids[i] = conexos[proximo_aleatorio(&estado) % num_conexos];
+
+        double custos[64];
+        espaco->metrica = metrica;
+        for (size_t i = 0; i < n; i++) distancias_um_para_muitos(grafo, espaco, ids[i], ids, n, custos + i * n, NULL);
+        testados++;
+
+        tour = otimizar_tour(grafo, ids, n, metrica, fecha, 0.0);
+        if (!ordem_valida(tour, n) || !tour->completo ||
+            fabs(tour->custo - custo_da_ordem(custos, n, tour->ordem, fecha)) > 1e-6 ||
+            tour->custo > tour->custo_vizinho + 1e-9) {
+            coerentes = 0;
+            liberar_tour(tour);
+            continue;
+        }
+
+        size_t ordem[8];
+        for (size_t i = 0; i < n; i++) ordem[i] = i;
+        double otimo = melhor_por_forca_bruta(custos, n, ordem, 1, fecha);
+        double diferenca = otimo > 0.0 ? (tour->custo - otimo) / otimo : 0.0;
+        if (diferenca > pior_diferenca) pior_diferenca = diferenca;
+        otimos += diferenca < 1e-9;
+
+        double total[NUM_METRICAS];
+        const ResultadoDijkstra *r = tour->rota ? tour->rota->rota : NULL;
+        if (!r || !r->sucesso || fabs(r->distancia_total - tour->custo) > 1e-6 ||
+            metricas_caminho(grafo, r->caminho, r->tamanho_caminho, metrica, total) != 0 ||
+            fabs(total[metrica] - tour->custo) > 1e-6) {
+            caminhos = 0;
+        } else {
+            for (size_t t = 0; t < tour->rota->num_trechos; t++) {
+                if (r->caminho[tour->rota->inicio_trechos[t]] != ids[tour->ordem[t]]) caminhos = 0;
+            }
+        }
+        liberar_tour(tour);
+    }
+    liberar_espaco_busca(espaco);
+    int perto = testados > 0 && pior_diferenca < 0.10;
+    printf("%s %d tours agree with the cost matrix and never lose to nearest neighbour\n",
+           coerentes ? "✓" : "✗", testados);
+    printf("%s Full paths cost the tour cost and visit stops in tour order\n", caminhos ? "✓" : "✗");
+    printf("%s Within 10%% of brute force (%d/%d optimal, worst gap %.1f%%)\n", perto ? "✓" : "✗",
+           otimos, testados, pior_diferenca * 100.0);
+    falhas += !coerentes || !caminhos || !perto;
+
+    // Orçamento esgotado: ainda devolve uma ordem válida
+    long muitas[60];
+    for (int i = 0; i < 60; i++) muitas[i] = conexos[proximo_aleatorio(&estado) % num_conexos];
+    tour = otimizar_tour(grafo, muitas, 60, METRICA_DISTANCIA, 1, 1e-6);
+    int orcamento = ordem_valida(tour, 60) && tour->tempo_esgotado;
+    printf("%s Exhausted time budget still returns a valid order\n", orcamento ? "✓" : "✗");
+    falhas += !orcamento;
+    liberar_tour(tour);
+
+    free(conexos);
+    liberar_grafo(grafo);
+
+    printf("\n=== Test completed ===\n");
+    return falhas ? 1 : 0;
+}
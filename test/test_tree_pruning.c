@@ -0,0 +1,122 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../include/osm_reader.h"
+#include "../include/graph.h"
+#include "../include/dijkstra.h"
+#include "../include/tree_pruning.h"
+
+// Verifica se o caminho percorre apenas arcos existentes e soma o peso correto
+static int caminho_valido(Grafo *grafo, ResultadoDijkstra *r, long origem, long destino) {
+    if (r->tamanho_caminho < 1 || r->caminho[0] != origem || r->caminho[r->tamanho_caminho - 1] != destino)
+        return 0;
+    const IndicesGrafo *indices = obter_indices(grafo);
+    double total = 0.0;
+    for (int i = 0; i + 1 < r->tamanho_caminho; i++) {
+        ssize_t u = buscar_indice_ponto(grafo, r->caminho[i]);
+        ssize_t v = buscar_indice_ponto(grafo, r->caminho[i + 1]);
+        double melhor = -1.0;
+        for (size_t k = indices->inicio_arcos[u]; k < indices->inicio_arcos[u + 1]; k++) {
+            if ((ssize_t)indices->arcos[k].destino == v &&
+                (melhor < 0 || indices->arcos[k].peso < melhor)) {
+                melhor = indices->arcos[k].peso;
+            }
+        }
+        if (melhor < 0) return 0;
+        total += melhor;
+    }
+    return fabs(total - r->distancia_total) < 1e-9;
+}
+
+// Bairro sintético: grade de ruas com uma árvore de becos sem saída em cada cruzamento
+static Grafo* criar_bairro(int lado) {
+    Grafo *grafo = criar_grafo();
+    long long proximo_id = (long long)lado * lado + 1;
+    for (int i = 0; i < lado * lado; i++) {
+        adicionar_ponto(grafo, i + 1, (i / lado) * 0.001, (i % lado) * 0.001);
+    }
+    for (int r = 0; r < lado; r++) {
+        for (int c = 0; c < lado; c++) {
+            long long id = (long long)r * lado + c + 1;
+            if (c + 1 < lado) adicionar_aresta(grafo, id, id + 1, 0.1);
+            if (r + 1 < lado) adicionar_aresta(grafo, id, id + lado, 0.1);
+            // Beco com duas ramificações de profundidade 2
+            long long base = proximo_id;
+            adicionar_ponto(grafo, base, r * 0.001 + 0.0003, c * 0.001 + 0.0003);
+            adicionar_ponto(grafo, base + 1, r * 0.001 + 0.0005, c * 0.001 + 0.0003);
+            adicionar_ponto(grafo, base + 2, r * 0.001 + 0.0003, c * 0.001 + 0.0005);
+            adicionar_aresta(grafo, id, base, 0.03);
+            adicionar_aresta(grafo, base, base + 1, 0.02);
+            adicionar_aresta(grafo, base, base + 2, 0.02);
+            proximo_id += 3;
+        }
+    }
+    return grafo;
+}
+
+static int comparar_consultas(Grafo *grafo, NucleoRoteamento *nucleo, int num_consultas,
+                              long long *visitados_original, long long *visitados_nucleo) {
+    int falhas = 0;
+    unsigned int semente = 2024;
+    for (int q = 0; q < num_consultas; q++) {
+        semente = semente * 1103515245u + 12345u;
+        long origem = grafo->pontos[(semente >> 8) % grafo->num_pontos].id;
+        semente = semente * 1103515245u + 12345u;
+        long destino = grafo->pontos[(semente >> 8) % grafo->num_pontos].id;
+
+        ResultadoDijkstra *r1 = dijkstra(grafo, origem, destino);
+        ResultadoDijkstra *r2 = dijkstra_nucleo(nucleo, origem, destino);
+        if (!r1 || !r2 || r1->sucesso != r2->sucesso ||
+            (r1->sucesso && (fabs(r1->distancia_total - r2->distancia_total) > 1e-9 ||
+                             !caminho_valido(grafo, r2, origem, destino)))) {
+            printf("  ✗ Mismatch for %ld -> %ld\n", origem, destino);
+            falhas++;
+        }
+        if (r1) *visitados_original += r1->nos_visitados;
+        if (r2) *visitados_nucleo += r2->nos_visitados;
+        liberar_resultado_dijkstra(r1);
+        liberar_resultado_dijkstra(r2);
+    }
+    return falhas;
+}
+
+int main() {
+    printf("=== Testing Dead-End Tree Pruning ===\n\n");
+    int falhas = 0;
+
+    const char *nomes[] = {"test.osm", "suburb (synthetic)"};
+    for (int caso = 0; caso < 2; caso++) {
+        Grafo *grafo = caso == 0 ? ler_osm("test.osm") : criar_bairro(20);
+        if (!grafo) {
+            printf("ERROR: Failed to build %s\n", nomes[caso]);
+            return 1;
+        }
+        NucleoRoteamento *nucleo = construir_nucleo_roteamento(grafo);
+        if (!nucleo) {
+            printf("ERROR: Pruning failed\n");
+            return 1;
+        }
+        printf("%s: %zu nodes -> core %zu nodes (%zu pruned)\n", nomes[caso],
+               grafo->num_pontos, nucleo->nucleo->num_pontos, nucleo->num_podados);
+
+        long long visitados_original = 0, visitados_nucleo = 0;
+        int f = comparar_consultas(grafo, nucleo, 200, &visitados_original, &visitados_nucleo);
+        printf("  %s 200 random queries match plain Dijkstra (settled %lld vs %lld)\n",
+               f ? "✗" : "✓", visitados_original, visitados_nucleo);
+        falhas += f;
+
+        // Núcleo também comprimido
+        comprimir_nucleo_roteamento(nucleo);
+        visitados_original = visitados_nucleo = 0;
+        f = comparar_consultas(grafo, nucleo, 200, &visitados_original, &visitados_nucleo);
+        printf("  %s Same queries with compressed core (settled %lld vs %lld)\n\n",
+               f ? "✗" : "✓", visitados_original, visitados_nucleo);
+        falhas += f;
+
+        liberar_nucleo_roteamento(nucleo);
+        liberar_grafo(grafo);
+    }
+
+    printf("=== Test completed ===\n");
+    return falhas ? 1 : 0;
+}
@@ -0,0 +1,115 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../include/osm_reader.h"
+#include "../include/graph.h"
+#include "../include/distance_matrix.h"
+#include "../include/voronoi.h"
+#include "fixtures.h"
+
+// Referência: uma busca completa por fonte, ficando com a menor distância
+// (em empate, a fonte de menor posição)
+static int confere_particao(Grafo *grafo, const ParticaoVoronoi *particao, const long *fontes,
+                            size_t num_fontes, Metrica metrica) {
+    size_t n = grafo->num_pontos;
+    long *todos = malloc(n * sizeof(long));
+    double *linha = malloc(n * sizeof(double));
+    double *melhor = malloc(n * sizeof(double));
+    for (size_t v = 0; v < n; v++) {
+        todos[v] = grafo->pontos[v].id;
+        melhor[v] = -1.0;
+    }
+    EspacoBusca *espaco = criar_espaco_busca(n);
+    espaco->metrica = metrica;
+    for (size_t f = 0; f < num_fontes; f++) {
+        distancias_um_para_muitos(grafo, espaco, fontes[f], todos, n, linha, NULL);
+        for (size_t v = 0; v < n; v++) {
+            if (linha[v] >= 0.0 && (melhor[v] < 0.0 || linha[v] < melhor[v])) melhor[v] = linha[v];
+        }
+    }
+
+    int ok = particao->num_pontos == n;
+    size_t soma_celulas = 0;
+    for (size_t f = 0; f < num_fontes; f++) soma_celulas += particao->tamanho_celula[f];
+    ok = ok && soma_celulas + particao->num_inalcancaveis == n;
+    for (size_t v = 0; ok && v < n; v++) {
+        if (melhor[v] < 0.0) {
+            ok = particao->dono[v] == SEM_DONO && particao->custos[v] == -1.0;
+        } else {
+            // O custo bate com a referência e o dono de fato alcança o ponto com ele
+            ok = particao->dono[v] != SEM_DONO && fabs(particao->custos[v] - melhor[v]) < 1e-9;
+            if (ok) {
+                distancias_um_para_muitos(grafo, espaco, fontes[particao->dono[v]], &todos[v], 1, linha, NULL);
+                ok = fabs(linha[0] - melhor[v]) < 1e-9;
+            }
+        }
+    }
+    liberar_espaco_busca(espaco);
+    free(todos);
+    free(linha);
+    free(melhor);
+    return ok;
+}
+
+int main() {
+    printf("=== Testing Multi-Source Search (Network Voronoi) ===\n\n");
+    int falhas = 0;
+
+    // Linha 1-2-3-4-5, fontes nas pontas: 3 fica a 2 km de ambas (empate)
+    Grafo *linha = criar_grafo();
+    for (int i = 1; i <= 5; i++) adicionar_ponto(linha, i, -16.7, -49.2 + i * 0.01);
+    for (int i = 1; i < 5; i++) adicionar_aresta(linha, i, i + 1, 1.0);
+    long pontas[] = {5, 1};
+    ParticaoVoronoi *p = particao_voronoi(linha, pontas, 2, METRICA_DISTANCIA);
+    int empate = p && fonte_mais_proxima(linha, p, 3) == 5 && fonte_mais_proxima(linha, p, 2) == 1 &&
+                 p->custos[2] == 2.0 && p->tamanho_celula[0] == 3 && p->tamanho_celula[1] == 2;
+    printf("%s Nodes take the nearest source, ties go to the first listed\n", empate ? "✓" : "✗");
+    falhas += !empate;
+    liberar_particao_voronoi(p);
+
+    long repetidas[] = {2, 2, 4};
+    p = particao_voronoi(linha, repetidas, 3, METRICA_DISTANCIA);
+    int repetida = p && p->tamanho_celula[1] == 0 && p->tamanho_celula[0] + p->tamanho_celula[2] == 5;
+    printf("%s Repeated source keeps its first position\n", repetida ? "✓" : "✗");
+    falhas += !repetida;
+    liberar_particao_voronoi(p);
+
+    long desconhecida[] = {1, 99};
+    ParticaoVoronoi *vazia = particao_voronoi(linha, NULL, 0, METRICA_DISTANCIA);
+    int erros = particao_voronoi(linha, desconhecida, 2, METRICA_DISTANCIA) == NULL &&
+                vazia && vazia->num_inalcancaveis == 5 && fonte_mais_proxima(linha, vazia, 1) == -1;
+    printf("%s Unknown source is rejected, no sources leaves every node unreachable\n", erros ? "✓" : "✗");
+    falhas += !erros;
+    liberar_particao_voronoi(vazia);
+    liberar_grafo(linha);
+
+    Grafo *grafo = ler_osm("test.osm");
+    if (!grafo) {
+        printf("ERROR: Failed to load test.osm\n");
+        return 1;
+    }
+
+    unsigned int estado = 31;
+    const size_t quantidades[] = {1, 5, 25};
+    int corretas = 1;
+    for (int m = 0; m < 2; m++) {
+        Metrica metrica = m == 0 ? METRICA_DISTANCIA : METRICA_TEMPO;
+        for (size_t t = 0; t < sizeof(quantidades) / sizeof(quantidades[0]); t++) {
+            long fontes[25];
+            for (size_t f = 0; f < quantidades[t]; f++) {
+                fontes[f] = grafo->pontos[proximo_aleatorio(&estado) % grafo->num_pontos].id;
+            }
+            ParticaoVoronoi *particao = particao_voronoi(grafo, fontes, quantidades[t], metrica);
+            if (!particao || !confere_particao(grafo, particao, fontes, quantidades[t], metrica)) corretas = 0;
+            liberar_particao_voronoi(particao);
+        }
+    }
+    printf("%s Partitions for 1, 5 and 25 sources match one search per source (distance and time)\n",
+           corretas ? "✓" : "✗");
+    falhas += !corretas;
+
+    liberar_grafo(grafo);
+
+    printf("\n=== Test completed ===\n");
+    return falhas ? 1 : 0;
+}
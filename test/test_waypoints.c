@@ -0,0 +1,125 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../include/osm_reader.h"
+#include "../include/graph.h"
+#include "../include/dijkstra.h"
+#include "../include/metrics.h"
+#include "../include/batch_query.h"
+#include "../include/waypoints.h"
+#include "fixtures.h"
+
+int main() {
+    printf("=== Testing Waypoint Routing ===\n\n");
+    int falhas = 0;
+
+    // Linha 1-2-3-4-5 (mão dupla) e 5 -> 6 só de ida
+    Grafo *linha = criar_grafo();
+    for (int i = 1; i <= 6; i++) adicionar_ponto(linha, i, -16.7, -49.2 + i * 0.01);
+    for (int i = 1; i < 5; i++) adicionar_aresta(linha, i, i + 1, 1.0);
+    Aresta ida = {5, 6, 1.0, 0};
+    adicionar_arestas(linha, &ida, 1);
+
+    long paradas[] = {1, 4, 2, 5};
+    RotaParadas *rota = rota_por_paradas(linha, paradas, 4, METRICA_DISTANCIA, 2);
+    long esperado[] = {1, 2, 3, 4, 3, 2, 3, 4, 5};
+    int concatenada = rota && rota->rota->sucesso && rota->rota->tamanho_caminho == 9 &&
+                      rota->rota->distancia_total == 8.0 && rota->num_trechos == 3 &&
+                      rota->custos_trechos[1] == 2.0 && rota->inicio_trechos[2] == 5;
+    for (int i = 0; concatenada && i < 9; i++) concatenada = rota->rota->caminho[i] == esperado[i];
+    printf("%s Legs are concatenated without repeating the joining stop\n", concatenada ? "✓" : "✗");
+    falhas += !concatenada;
+    liberar_rota_paradas(rota);
+
+    long contramao[] = {1, 6, 5, 6, 1};
+    rota = rota_por_paradas(linha, contramao, 5, METRICA_DISTANCIA, 1);
+    int falho = rota && !rota->rota->sucesso && rota->trecho_falho == 1 && rota->custos_trechos[3] == -1.0 &&
+                rota->custos_trechos[2] == 1.0 &&
+                rota->custos_trechos[0] == 5.0 && rota->rota->caminho == NULL;
+    printf("%s Unreachable leg is reported (first failing leg: %zu)\n", falho ? "✓" : "✗",
+           rota ? rota->trecho_falho + 1 : 0);
+    falhas += !falho;
+    liberar_rota_paradas(rota);
+
+    long uma[] = {1};
+    long desconhecida[] = {1, 99};
+    int erros = rota_por_paradas(linha, uma, 1, METRICA_DISTANCIA, 1) == NULL &&
+                rota_por_paradas(linha, desconhecida, 2, METRICA_DISTANCIA, 1) == NULL;
+    printf("%s Fewer than two stops and unknown ids are rejected\n", erros ? "✓" : "✗");
+    falhas += !erros;
+    liberar_grafo(linha);
+
+    Grafo *grafo = ler_osm("test.osm");
+    if (!grafo) {
+        printf("ERROR: Failed to load test.osm\n");
+        return 1;
+    }
+
+    // Contra dijkstra_metrica() trecho a trecho, com 1 e 4 threads
+    unsigned int estado = 41;
+    int iguais = 1, continuas = 1;
+    for (int q = 0; q < 30; q++) {
+        Metrica metrica = (Metrica)(q % NUM_METRICAS);
+        size_t num_paradas = 2 + proximo_aleatorio(&estado) % 5;
+        long ids[6];
+        for (size_t i = 0; i < num_paradas; i++) {
+            ids[i] = grafo->pontos[proximo_aleatorio(&estado) % grafo->num_pontos].id;
+        }
+        double total = 0.0;
+        int sucesso = 1;
+        for (size_t i = 0; i + 1 < num_paradas; i++) {
+            ResultadoDijkstra *r = dijkstra_metrica(grafo, ids[i], ids[i + 1], metrica);
+            if (!r || !r->sucesso) sucesso = 0;
+            else total += r->distancia_total;
+            liberar_resultado_dijkstra(r);
+        }
+        for (int threads = 1; threads <= 4; threads += 3) {
+            rota = rota_por_paradas(grafo, ids, num_paradas, metrica, threads);
+            if (!rota || rota->rota->sucesso != sucesso ||
+                (sucesso && fabs(rota->rota->distancia_total - total) > 1e-6)) {
+                iguais = 0;
+            }
+            // O caminho concatenado custa o mesmo e passa por todas as paradas
+            double custos[NUM_METRICAS];
+            if (rota && sucesso) {
+                if (metricas_caminho(grafo, rota->rota->caminho, rota->rota->tamanho_caminho, metrica, custos) != 0 ||
+                    fabs(custos[metrica] - total) > 1e-6) {
+                    continuas = 0;
+                }
+                for (size_t t = 0; t < rota->num_trechos; t++) {
+                    if (rota->rota->caminho[rota->inicio_trechos[t]] != ids[t]) continuas = 0;
+                }
+                if (rota->rota->caminho[rota->rota->tamanho_caminho - 1] != ids[num_paradas - 1]) continuas = 0;
+            }
+            liberar_rota_paradas(rota);
+        }
+    }
+    printf("%s 30 multi-stop routes match leg-by-leg dijkstra_metrica() with 1 and 4 threads\n",
+           iguais ? "✓" : "✗");
+    printf("%s Concatenated paths are connected and pass every stop in order\n", continuas ? "✓" : "✗");
+    falhas += !iguais || !continuas;
+
+    // O lote por métrica resolve cada par como dijkstra_metrica()
+    ParConsulta pares[20];
+    for (int q = 0; q < 20; q++) {
+        pares[q].origem = grafo->pontos[proximo_aleatorio(&estado) % grafo->num_pontos].id;
+        pares[q].destino = grafo->pontos[proximo_aleatorio(&estado) % grafo->num_pontos].id;
+    }
+    ResultadoLote *lote = executar_lote_metrica(grafo, pares, 20, METRICA_TEMPO, 2);
+    int lote_ok = lote != NULL;
+    for (int q = 0; lote_ok && q < 20; q++) {
+        ResultadoDijkstra *r = dijkstra_metrica(grafo, pares[q].origem, pares[q].destino, METRICA_TEMPO);
+        const ResultadoDijkstra *obtido = lote->consultas[q].resultado;
+        lote_ok = r && obtido && r->sucesso == obtido->sucesso &&
+                  (!r->sucesso || fabs(r->distancia_total - obtido->distancia_total) < 1e-6);
+        liberar_resultado_dijkstra(r);
+    }
+    printf("%s executar_lote_metrica() minimizes travel time\n", lote_ok ? "✓" : "✗");
+    falhas += !lote_ok;
+    liberar_resultado_lote(lote);
+
+    liberar_grafo(grafo);
+
+    printf("\n=== Test completed ===\n");
+    return falhas ? 1 : 0;
+}
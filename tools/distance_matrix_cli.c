@@ -0,0 +1,133 @@
+/**
+ * Ferramenta de linha de comando: tabela de distâncias entre listas de pontos.
+ *
+ * Uso: distance-matrix mapa.osm origens.txt destinos.txt [--threads N] [--predecessores]
+ *
+ * Os arquivos de origens e destinos têm um id de ponto por linha (linhas
+ * vazias e iniciadas por '#' são ignoradas). A tabela sai em CSV na saída
+ * padrão, em km, com -1 para pares sem caminho; com --predecessores, uma
+ * segunda tabela traz o ponto anterior a cada destino no caminho.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/osm_reader.h"
+#include "../include/graph.h"
+#include "../include/distance_matrix.h"
+#include "../include/timing.h"
+
+// Lê um id por linha; retorna o vetor (free) e a quantidade, ou NULL
+static long* ler_ids(const char *caminho, size_t *quantidade) {
+    FILE *arquivo = fopen(caminho, "r");
+    if (!arquivo) {
+        fprintf(stderr, "Erro: não foi possível abrir %s\n", caminho);
+        return NULL;
+    }
+    size_t capacidade = 64;
+    long *ids = malloc(capacidade * sizeof(long));
+    char linha[256];
+    *quantidade = 0;
+    while (ids && fgets(linha, sizeof(linha), arquivo)) {
+        char *p = linha;
+        while (*p == ' ' || *p == '\t') p++;
+        if (*p == '#' || *p == '\n' || *p == '\r' || *p == '\0') continue;
+        char *fim;
+        long id = strtol(p, &fim, 10);
+        if (fim == p) {
+            fprintf(stderr, "Aviso: linha ignorada em %s: %s", caminho, linha);
+            continue;
+        }
+        if (*quantidade == capacidade) {
+            capacidade *= 2;
+            long *novos = realloc(ids, capacidade * sizeof(long));
+            if (!novos) {
+                free(ids);
+                ids = NULL;
+                break;
+            }
+            ids = novos;
+        }
+        ids[(*quantidade)++] = id;
+    }
+    fclose(arquivo);
+    return ids;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 4) {
+        fprintf(stderr, "Uso: %s mapa.osm origens.txt destinos.txt [--threads N] [--predecessores]\n", argv[0]);
+        return 1;
+    }
+    int num_threads = 0;
+    int com_predecessores = 0;
+    for (int i = 4; i < argc; i++) {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            num_threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--predecessores") == 0) {
+            com_predecessores = 1;
+        } else {
+            fprintf(stderr, "Opção desconhecida: %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    Grafo *grafo = ler_osm(argv[1]);
+    if (!grafo) {
+        fprintf(stderr, "Erro: falha ao carregar %s\n", argv[1]);
+        return 1;
+    }
+    size_t num_origens = 0, num_destinos = 0;
+    long *origens = ler_ids(argv[2], &num_origens);
+    long *destinos = ler_ids(argv[3], &num_destinos);
+    if (!origens || !destinos) {
+        free(origens);
+        free(destinos);
+        liberar_grafo(grafo);
+        return 1;
+    }
+
+    double inicio = agora_ms();
+    MatrizDistancias *matriz = matriz_distancias(grafo, origens, num_origens, destinos, num_destinos,
+                                                 com_predecessores, num_threads);
+    double tempo = agora_ms() - inicio;
+    if (!matriz) {
+        fprintf(stderr, "Erro: falha ao calcular a matriz\n");
+        free(origens);
+        free(destinos);
+        liberar_grafo(grafo);
+        return 1;
+    }
+    fprintf(stderr, "%zu x %zu table in %.2f ms\n", num_origens, num_destinos, tempo);
+
+    printf("origem");
+    for (size_t j = 0; j < num_destinos; j++) printf(",%ld", destinos[j]);
+    printf("\n");
+    for (size_t i = 0; i < num_origens; i++) {
+        printf("%ld", origens[i]);
+        for (size_t j = 0; j < num_destinos; j++) {
+            double d = distancia_na_matriz(matriz, i, j);
+            if (d < 0) printf(",-1");
+            else printf(",%.6f", d);
+        }
+        printf("\n");
+    }
+    if (com_predecessores) {
+        printf("\npredecessor");
+        for (size_t j = 0; j < num_destinos; j++) printf(",%ld", destinos[j]);
+        printf("\n");
+        for (size_t i = 0; i < num_origens; i++) {
+            printf("%ld", origens[i]);
+            for (size_t j = 0; j < num_destinos; j++) {
+                printf(",%ld", matriz->predecessores[i * num_destinos + j]);
+            }
+            printf("\n");
+        }
+    }
+
+    liberar_matriz_distancias(matriz);
+    free(origens);
+    free(destinos);
+    liberar_grafo(grafo);
+    return 0;
+}